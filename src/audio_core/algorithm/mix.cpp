@@ -0,0 +1,282 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <cstdlib>
+
+#include "audio_core/algorithm/mix.h"
+
+#ifdef ARCHITECTURE_x86_64
+#include <immintrin.h>
+#include "common/x64/cpu_detect.h"
+
+#ifdef _MSC_VER
+#define TARGET_ISA(isa)
+#else
+#define TARGET_ISA(isa) __attribute__((target(isa)))
+#endif
+#endif
+
+namespace AudioCore {
+namespace {
+
+/// Kernels processing whole frames, the vectorized ones give the exact same output as the generic
+/// ones. Gains are Q15 and products are computed in 64 bits before rounding like the DSP does.
+struct MixKernels {
+    void (*apply_mix)(s32* output, const s32* input, s32 gain, s32 sample_count);
+    s32 (*apply_mix_ramp)(s32* output, const s32* input, float gain, float delta,
+                          s32 sample_count);
+    void (*apply_gain)(s32* output, const s32* input, s32 gain, s32 delta, s32 sample_count);
+    void (*apply_gain_without_delta)(s32* output, const s32* input, s32 gain, s32 sample_count);
+};
+
+s32 MulQ15(s32 sample, s32 gain) {
+    return static_cast<s32>((static_cast<s64>(sample) * gain + 0x4000) >> 15);
+}
+
+/// Advances a gain by a number of samples, wrapping around like the DSP does.
+s32 AdvanceGain(s32 gain, s32 delta, s32 samples) {
+    return static_cast<s32>(static_cast<u32>(gain) +
+                            static_cast<u32>(delta) * static_cast<u32>(samples));
+}
+
+void ApplyMixGeneric(s32* output, const s32* input, s32 gain, s32 sample_count) {
+    for (s32 i = 0; i < sample_count; i++) {
+        output[i] += MulQ15(input[i], gain);
+    }
+}
+
+s32 ApplyMixRampGeneric(s32* output, const s32* input, float gain, float delta,
+                        s32 sample_count) {
+    s32 x = 0;
+    for (s32 i = 0; i < sample_count; i++) {
+        x = static_cast<s32>(static_cast<float>(input[i]) * gain);
+        output[i] += x;
+        gain += delta;
+    }
+    return x;
+}
+
+void ApplyGainGeneric(s32* output, const s32* input, s32 gain, s32 delta, s32 sample_count) {
+    for (s32 i = 0; i < sample_count; i++) {
+        output[i] = MulQ15(input[i], gain);
+        gain = AdvanceGain(gain, delta, 1);
+    }
+}
+
+void ApplyGainWithoutDeltaGeneric(s32* output, const s32* input, s32 gain, s32 sample_count) {
+    for (s32 i = 0; i < sample_count; i++) {
+        output[i] = MulQ15(input[i], gain);
+    }
+}
+
+#ifdef ARCHITECTURE_x86_64
+/// Multiplies four samples by four Q15 gains with 64-bit intermediates. Only the low 32 bits of
+/// the shifted products are kept, so a logical shift gives the same result as an arithmetic one.
+TARGET_ISA("sse4.1")
+__m128i MulQ15SSE41(__m128i samples, __m128i gains) {
+    const __m128i rounding = _mm_set1_epi64x(0x4000);
+    const __m128i even = _mm_srli_epi64(_mm_add_epi64(_mm_mul_epi32(samples, gains), rounding), 15);
+    const __m128i odd_products =
+        _mm_mul_epi32(_mm_srli_epi64(samples, 32), _mm_srli_epi64(gains, 32));
+    const __m128i odd = _mm_srli_epi64(_mm_add_epi64(odd_products, rounding), 15);
+    return _mm_blend_epi16(even, _mm_slli_epi64(odd, 32), 0xCC);
+}
+
+TARGET_ISA("sse4.1")
+void ApplyMixSSE41(s32* output, const s32* input, s32 gain, s32 sample_count) {
+    const __m128i gains = _mm_set1_epi32(gain);
+    s32 i = 0;
+    for (; i + 4 <= sample_count; i += 4) {
+        const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+        const __m128i mixed = _mm_loadu_si128(reinterpret_cast<const __m128i*>(output + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i),
+                         _mm_add_epi32(mixed, MulQ15SSE41(samples, gains)));
+    }
+    ApplyMixGeneric(output + i, input + i, gain, sample_count - i);
+}
+
+TARGET_ISA("sse4.1")
+s32 ApplyMixRampSSE41(s32* output, const s32* input, float gain, float delta, s32 sample_count) {
+    // Ramping gains are accumulated one sample at a time and that chain of additions bounds the
+    // generic loop already, only mixes at a steady volume are worth vectorizing
+    if (delta != 0.0f) {
+        return ApplyMixRampGeneric(output, input, gain, delta, sample_count);
+    }
+    const __m128 gains = _mm_set1_ps(gain);
+    s32 last = 0;
+    s32 i = 0;
+    for (; i + 4 <= sample_count; i += 4) {
+        const __m128 samples =
+            _mm_cvtepi32_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i)));
+        const __m128i scaled = _mm_cvttps_epi32(_mm_mul_ps(samples, gains));
+        const __m128i mixed = _mm_loadu_si128(reinterpret_cast<const __m128i*>(output + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), _mm_add_epi32(mixed, scaled));
+        last = _mm_extract_epi32(scaled, 3);
+    }
+    if (i == sample_count) {
+        return last;
+    }
+    return ApplyMixRampGeneric(output + i, input + i, gain, delta, sample_count - i);
+}
+
+TARGET_ISA("sse4.1")
+void ApplyGainSSE41(s32* output, const s32* input, s32 gain, s32 delta, s32 sample_count) {
+    const __m128i lane_deltas = _mm_mullo_epi32(_mm_set1_epi32(delta), _mm_setr_epi32(0, 1, 2, 3));
+    __m128i gains = _mm_add_epi32(_mm_set1_epi32(gain), lane_deltas);
+    const __m128i step = _mm_set1_epi32(AdvanceGain(0, delta, 4));
+    s32 i = 0;
+    for (; i + 4 <= sample_count; i += 4) {
+        const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), MulQ15SSE41(samples, gains));
+        gains = _mm_add_epi32(gains, step);
+    }
+    ApplyGainGeneric(output + i, input + i, AdvanceGain(gain, delta, i), delta, sample_count - i);
+}
+
+TARGET_ISA("sse4.1")
+void ApplyGainWithoutDeltaSSE41(s32* output, const s32* input, s32 gain, s32 sample_count) {
+    const __m128i gains = _mm_set1_epi32(gain);
+    s32 i = 0;
+    for (; i + 4 <= sample_count; i += 4) {
+        const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), MulQ15SSE41(samples, gains));
+    }
+    ApplyGainWithoutDeltaGeneric(output + i, input + i, gain, sample_count - i);
+}
+
+/// Eight lane version of MulQ15SSE41.
+TARGET_ISA("avx2")
+__m256i MulQ15AVX2(__m256i samples, __m256i gains) {
+    const __m256i rounding = _mm256_set1_epi64x(0x4000);
+    const __m256i even =
+        _mm256_srli_epi64(_mm256_add_epi64(_mm256_mul_epi32(samples, gains), rounding), 15);
+    const __m256i odd_products =
+        _mm256_mul_epi32(_mm256_srli_epi64(samples, 32), _mm256_srli_epi64(gains, 32));
+    const __m256i odd = _mm256_srli_epi64(_mm256_add_epi64(odd_products, rounding), 15);
+    return _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0xAA);
+}
+
+TARGET_ISA("avx2")
+void ApplyMixAVX2(s32* output, const s32* input, s32 gain, s32 sample_count) {
+    const __m256i gains = _mm256_set1_epi32(gain);
+    s32 i = 0;
+    for (; i + 8 <= sample_count; i += 8) {
+        const __m256i samples = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i));
+        const __m256i mixed = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(output + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i),
+                            _mm256_add_epi32(mixed, MulQ15AVX2(samples, gains)));
+    }
+    ApplyMixGeneric(output + i, input + i, gain, sample_count - i);
+}
+
+TARGET_ISA("avx2")
+s32 ApplyMixRampAVX2(s32* output, const s32* input, float gain, float delta, s32 sample_count) {
+    if (delta != 0.0f) {
+        return ApplyMixRampGeneric(output, input, gain, delta, sample_count);
+    }
+    const __m256 gains = _mm256_set1_ps(gain);
+    s32 last = 0;
+    s32 i = 0;
+    for (; i + 8 <= sample_count; i += 8) {
+        const __m256 samples =
+            _mm256_cvtepi32_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i)));
+        const __m256i scaled = _mm256_cvttps_epi32(_mm256_mul_ps(samples, gains));
+        const __m256i mixed = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(output + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i),
+                            _mm256_add_epi32(mixed, scaled));
+        last = _mm256_extract_epi32(scaled, 7);
+    }
+    if (i == sample_count) {
+        return last;
+    }
+    return ApplyMixRampGeneric(output + i, input + i, gain, delta, sample_count - i);
+}
+
+TARGET_ISA("avx2")
+void ApplyGainAVX2(s32* output, const s32* input, s32 gain, s32 delta, s32 sample_count) {
+    __m256i gains =
+        _mm256_add_epi32(_mm256_set1_epi32(gain),
+                         _mm256_mullo_epi32(_mm256_set1_epi32(delta),
+                                            _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7)));
+    const __m256i step = _mm256_set1_epi32(AdvanceGain(0, delta, 8));
+    s32 i = 0;
+    for (; i + 8 <= sample_count; i += 8) {
+        const __m256i samples = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i), MulQ15AVX2(samples, gains));
+        gains = _mm256_add_epi32(gains, step);
+    }
+    ApplyGainGeneric(output + i, input + i, AdvanceGain(gain, delta, i), delta, sample_count - i);
+}
+
+TARGET_ISA("avx2")
+void ApplyGainWithoutDeltaAVX2(s32* output, const s32* input, s32 gain, s32 sample_count) {
+    const __m256i gains = _mm256_set1_epi32(gain);
+    s32 i = 0;
+    for (; i + 8 <= sample_count; i += 8) {
+        const __m256i samples = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i), MulQ15AVX2(samples, gains));
+    }
+    ApplyGainWithoutDeltaGeneric(output + i, input + i, gain, sample_count - i);
+}
+#endif
+
+/// Returns the fastest kernels supported by the host CPU
+const MixKernels& GetMixKernels() {
+    static const MixKernels kernels = [] {
+#ifdef ARCHITECTURE_x86_64
+        const auto& caps = Common::GetCPUCaps();
+        if (caps.avx2) {
+            return MixKernels{&ApplyMixAVX2, &ApplyMixRampAVX2, &ApplyGainAVX2,
+                              &ApplyGainWithoutDeltaAVX2};
+        }
+        if (caps.sse4_1) {
+            return MixKernels{&ApplyMixSSE41, &ApplyMixRampSSE41, &ApplyGainSSE41,
+                              &ApplyGainWithoutDeltaSSE41};
+        }
+#endif
+        return MixKernels{&ApplyMixGeneric, &ApplyMixRampGeneric, &ApplyGainGeneric,
+                          &ApplyGainWithoutDeltaGeneric};
+    }();
+    return kernels;
+}
+
+} // Anonymous namespace
+
+void ApplyMix(s32* output, const s32* input, s32 gain, s32 sample_count) {
+    GetMixKernels().apply_mix(output, input, gain, sample_count);
+}
+
+s32 ApplyMixRamp(s32* output, const s32* input, float gain, float delta, s32 sample_count) {
+    return GetMixKernels().apply_mix_ramp(output, input, gain, delta, sample_count);
+}
+
+void ApplyGain(s32* output, const s32* input, s32 gain, s32 delta, s32 sample_count) {
+    GetMixKernels().apply_gain(output, input, gain, delta, sample_count);
+}
+
+void ApplyGainWithoutDelta(s32* output, const s32* input, s32 gain, s32 sample_count) {
+    GetMixKernels().apply_gain_without_delta(output, input, gain, sample_count);
+}
+
+s32 ApplyMixDepop(s32* output, s32 first_sample, s32 delta, s32 sample_count) {
+    // Each sample depends on the previous one, so this can't be vectorized. The decay reaches zero
+    // quickly though and stays there, which ends the loop early.
+    const bool positive = first_sample > 0;
+    auto final_sample = std::abs(first_sample);
+    for (s32 i = 0; i < sample_count && final_sample != 0; i++) {
+        final_sample = static_cast<s32>((static_cast<s64>(final_sample) * delta) >> 15);
+        if (positive) {
+            output[i] += final_sample;
+        } else {
+            output[i] -= final_sample;
+        }
+    }
+    if (positive) {
+        return final_sample;
+    } else {
+        return -final_sample;
+    }
+}
+
+} // namespace AudioCore
@@ -0,0 +1,28 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include "common/common_types.h"
+
+namespace AudioCore {
+
+/// Mixes the input scaled by a Q15 gain into the output.
+void ApplyMix(s32* output, const s32* input, s32 gain, s32 sample_count);
+
+/// Mixes the input into the output with a gain that changes by delta every sample.
+/// @returns The last sample mixed into the output.
+s32 ApplyMixRamp(s32* output, const s32* input, float gain, float delta, s32 sample_count);
+
+/// Writes the input scaled by a Q15 gain that changes by delta every sample to the output.
+void ApplyGain(s32* output, const s32* input, s32 gain, s32 delta, s32 sample_count);
+
+/// Writes the input scaled by a Q15 gain to the output.
+void ApplyGainWithoutDelta(s32* output, const s32* input, s32 gain, s32 sample_count);
+
+/// Mixes a sample decaying by a Q15 factor every sample into the output.
+/// @returns The sample left after the decay, to be carried over to the next frame.
+s32 ApplyMixDepop(s32* output, s32 first_sample, s32 delta, s32 sample_count);
+
+} // namespace AudioCore
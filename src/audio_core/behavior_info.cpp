@@ -12,7 +12,7 @@ namespace AudioCore {
 BehaviorInfo::BehaviorInfo() : process_revision(AudioCommon::CURRENT_PROCESS_REVISION) {}
 BehaviorInfo::~BehaviorInfo() = default;
 
-bool BehaviorInfo::UpdateOutput(std::vector<u8>& buffer, std::size_t offset) {
+bool BehaviorInfo::UpdateOutput(std::span<u8> buffer, std::size_t offset) {
     if (!AudioCommon::CanConsumeBuffer(buffer.size(), offset, sizeof(OutParams))) {
         LOG_ERROR(Audio, "Buffer is an invalid size!");
         return false;
@@ -6,6 +6,7 @@
 
 #include <array>
 
+#include <span>
 #include <vector>
 #include "common/common_funcs.h"
 #include "common/common_types.h"
@@ -38,7 +39,7 @@ public:
     explicit BehaviorInfo();
     ~BehaviorInfo();
 
-    bool UpdateOutput(std::vector<u8>& buffer, std::size_t offset);
+    bool UpdateOutput(std::span<u8> buffer, std::size_t offset);
 
     void ClearError();
     void UpdateFlags(u64_le dest_flags);
@@ -2,19 +2,26 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include <cmath>
 #include <numbers>
+#include <thread>
 #include "audio_core/algorithm/interpolate.h"
+#include "audio_core/algorithm/mix.h"
 #include "audio_core/command_generator.h"
 #include "audio_core/effect_context.h"
 #include "audio_core/mix_context.h"
 #include "audio_core/voice_context.h"
+#include "common/thread_worker.h"
 #include "core/memory.h"
 
 namespace AudioCore {
 namespace {
 constexpr std::size_t MIX_BUFFER_SIZE = 0x3f00;
 constexpr std::size_t SCALED_MIX_BUFFER_SIZE = MIX_BUFFER_SIZE << 15ULL;
+// Rendering fewer voices in parallel costs more in synchronization than it saves
+constexpr std::size_t MIN_PARALLEL_VOICES = 8;
+constexpr std::size_t MAX_VOICE_WORKERS = 3;
 using DelayLineTimes = std::array<f32, AudioCommon::I3DL2REVERB_DELAY_LINE_COUNT>;
 
 constexpr DelayLineTimes FDN_MIN_DELAY_LINE_TIMES{5.0f, 6.0f, 13.0f, 14.0f};
@@ -30,57 +37,6 @@ constexpr std::array<f32, AudioCommon::I3DL2REVERB_TAPS> EARLY_GAIN{
     0.24712f, 0.45945f, 0.45021f, 0.64196f, 0.54879f, 0.92925f, 0.38270f,
     0.72867f, 0.69794f, 0.5464f,  0.24563f, 0.45214f, 0.44042f};
 
-template <std::size_t N>
-void ApplyMix(s32* output, const s32* input, s32 gain, s32 sample_count) {
-    for (std::size_t i = 0; i < static_cast<std::size_t>(sample_count); i += N) {
-        for (std::size_t j = 0; j < N; j++) {
-            output[i + j] +=
-                static_cast<s32>((static_cast<s64>(input[i + j]) * gain + 0x4000) >> 15);
-        }
-    }
-}
-
-s32 ApplyMixRamp(s32* output, const s32* input, float gain, float delta, s32 sample_count) {
-    s32 x = 0;
-    for (s32 i = 0; i < sample_count; i++) {
-        x = static_cast<s32>(static_cast<float>(input[i]) * gain);
-        output[i] += x;
-        gain += delta;
-    }
-    return x;
-}
-
-void ApplyGain(s32* output, const s32* input, s32 gain, s32 delta, s32 sample_count) {
-    for (s32 i = 0; i < sample_count; i++) {
-        output[i] = static_cast<s32>((static_cast<s64>(input[i]) * gain + 0x4000) >> 15);
-        gain += delta;
-    }
-}
-
-void ApplyGainWithoutDelta(s32* output, const s32* input, s32 gain, s32 sample_count) {
-    for (s32 i = 0; i < sample_count; i++) {
-        output[i] = static_cast<s32>((static_cast<s64>(input[i]) * gain + 0x4000) >> 15);
-    }
-}
-
-s32 ApplyMixDepop(s32* output, s32 first_sample, s32 delta, s32 sample_count) {
-    const bool positive = first_sample > 0;
-    auto final_sample = std::abs(first_sample);
-    for (s32 i = 0; i < sample_count; i++) {
-        final_sample = static_cast<s32>((static_cast<s64>(final_sample) * delta) >> 15);
-        if (positive) {
-            output[i] += final_sample;
-        } else {
-            output[i] -= final_sample;
-        }
-    }
-    if (positive) {
-        return final_sample;
-    } else {
-        return -final_sample;
-    }
-}
-
 float Pow10(float x) {
     if (x >= 0.0f) {
         return 1.0f;
@@ -234,14 +190,24 @@ void ApplyReverbGeneric(I3dl2ReverbState& state,
 CommandGenerator::CommandGenerator(AudioCommon::AudioRendererParameter& worker_params_,
                                    VoiceContext& voice_context_, MixContext& mix_context_,
                                    SplitterContext& splitter_context_,
-                                   EffectContext& effect_context_, Core::Memory::Memory& memory_)
+                                   EffectContext& effect_context_, Core::Memory::Memory& memory_,
+                                   bool parallel_voices)
     : worker_params(worker_params_), voice_context(voice_context_), mix_context(mix_context_),
       splitter_context(splitter_context_), effect_context(effect_context_), memory(memory_),
       mix_buffer((worker_params.mix_buffer_count + AudioCommon::MAX_CHANNEL_COUNT) *
                  worker_params.sample_count),
       sample_buffer(MIX_BUFFER_SIZE),
       depop_buffer((worker_params.mix_buffer_count + AudioCommon::MAX_CHANNEL_COUNT) *
-                   worker_params.sample_count) {}
+                   worker_params.sample_count) {
+    if (!parallel_voices) {
+        return;
+    }
+    const std::size_t num_workers = std::min<std::size_t>(
+        MAX_VOICE_WORKERS, std::max(std::thread::hardware_concurrency(), 2U) - 1);
+    worker_sample_buffers.assign(num_workers, std::vector<s32>(MIX_BUFFER_SIZE));
+    voice_workers = std::make_unique<Common::ThreadWorker>(num_workers, "yuzu:AudioVoiceWorker");
+}
+
 CommandGenerator::~CommandGenerator() = default;
 
 void CommandGenerator::ClearMixBuffers() {
@@ -255,6 +221,7 @@ void CommandGenerator::GenerateVoiceCommands() {
         LOG_DEBUG(Audio, "(DSP_TRACE) GenerateVoiceCommands");
     }
     // Grab all our voices
+    queued_voices.clear();
     const auto voice_count = voice_context.GetVoiceCount();
     for (std::size_t i = 0; i < voice_count; i++) {
         auto& voice_info = voice_context.GetSortedInfo(i);
@@ -264,71 +231,60 @@ void CommandGenerator::GenerateVoiceCommands() {
         }
 
         // Queue our voice
-        GenerateVoiceCommand(voice_info);
+        queued_voices.push_back(&voice_info);
+    }
+
+    if (voice_workers && queued_voices.size() >= MIN_PARALLEL_VOICES) {
+        // Voices are independent until they are mixed, mixing them in order keeps the output
+        // identical to rendering them one at a time
+        RenderQueuedVoicesInParallel();
+        const std::size_t voice_stride =
+            AudioCommon::MAX_CHANNEL_COUNT * worker_params.sample_count;
+        for (std::size_t i = 0; i < queued_voices.size(); i++) {
+            MixVoice(*queued_voices[i], voice_buffer.data() + i * voice_stride);
+        }
+    } else {
+        for (auto* voice_info : queued_voices) {
+            GenerateVoiceCommand(*voice_info);
+        }
     }
     // Update our splitters
     splitter_context.UpdateInternalState();
 }
 
 void CommandGenerator::GenerateVoiceCommand(ServerVoiceInfo& voice_info) {
+    RenderVoice(voice_info, GetChannelMixBuffer(0), sample_buffer.data());
+    MixVoice(voice_info, GetChannelMixBuffer(0));
+}
+
+void CommandGenerator::RenderVoice(ServerVoiceInfo& voice_info, s32* output, s32* decode_buffer) {
     auto& in_params = voice_info.GetInParams();
     const auto channel_count = in_params.channel_count;
 
     for (s32 channel = 0; channel < channel_count; channel++) {
         const auto resource_id = in_params.voice_channel_resource_id[channel];
         auto& dsp_state = voice_context.GetDspSharedState(resource_id);
-        auto& channel_resource = voice_context.GetChannelResource(resource_id);
-
-        // Decode our samples for our channel
-        GenerateDataSourceCommand(voice_info, dsp_state, channel);
+        auto* channel_output = output + channel * worker_params.sample_count;
 
         if (in_params.should_depop) {
+            // The previous samples are faded out by the depop commands when mixing
             in_params.last_volume = 0.0f;
-        } else if (in_params.splitter_info_id != AudioCommon::NO_SPLITTER ||
-                   in_params.mix_id != AudioCommon::NO_MIX) {
+            continue;
+        }
+
+        // Decode our samples for our channel
+        GenerateDataSourceCommand(voice_info, dsp_state, channel_output, decode_buffer, channel);
+
+        if (in_params.splitter_info_id != AudioCommon::NO_SPLITTER ||
+            in_params.mix_id != AudioCommon::NO_MIX) {
             // Apply a biquad filter if needed
             GenerateBiquadFilterCommandForVoice(voice_info, dsp_state,
                                                 worker_params.mix_buffer_count, channel);
             // Base voice volume ramping
-            GenerateVolumeRampCommand(in_params.last_volume, in_params.volume, channel,
-                                      in_params.node_id);
+            GenerateVolumeRampCommand(in_params.last_volume, in_params.volume, channel_output,
+                                      channel, in_params.node_id);
             in_params.last_volume = in_params.volume;
 
-            if (in_params.mix_id != AudioCommon::NO_MIX) {
-                // If we're using a mix id
-                auto& mix_info = mix_context.GetInfo(in_params.mix_id);
-                const auto& dest_mix_params = mix_info.GetInParams();
-
-                // Voice Mixing
-                GenerateVoiceMixCommand(
-                    channel_resource.GetCurrentMixVolume(), channel_resource.GetLastMixVolume(),
-                    dsp_state, dest_mix_params.buffer_offset, dest_mix_params.buffer_count,
-                    worker_params.mix_buffer_count + channel, in_params.node_id);
-
-                // Update last mix volumes
-                channel_resource.UpdateLastMixVolumes();
-            } else if (in_params.splitter_info_id != AudioCommon::NO_SPLITTER) {
-                s32 base = channel;
-                while (auto* destination_data =
-                           GetDestinationData(in_params.splitter_info_id, base)) {
-                    base += channel_count;
-
-                    if (!destination_data->IsConfigured()) {
-                        continue;
-                    }
-                    if (destination_data->GetMixId() >= static_cast<int>(mix_context.GetCount())) {
-                        continue;
-                    }
-
-                    const auto& mix_info = mix_context.GetInfo(destination_data->GetMixId());
-                    const auto& dest_mix_params = mix_info.GetInParams();
-                    GenerateVoiceMixCommand(
-                        destination_data->CurrentMixVolumes(), destination_data->LastMixVolumes(),
-                        dsp_state, dest_mix_params.buffer_offset, dest_mix_params.buffer_count,
-                        worker_params.mix_buffer_count + channel, in_params.node_id);
-                    destination_data->MarkDirty();
-                }
-            }
             // Update biquad filter enabled states
             for (std::size_t i = 0; i < AudioCommon::MAX_BIQUAD_FILTERS; i++) {
                 in_params.was_biquad_filter_enabled[i] = in_params.biquad_filter[i].enabled;
@@ -337,6 +293,89 @@ void CommandGenerator::GenerateVoiceCommand(ServerVoiceInfo& voice_info) {
     }
 }
 
+void CommandGenerator::MixVoice(ServerVoiceInfo& voice_info, const s32* input) {
+    auto& in_params = voice_info.GetInParams();
+    const auto channel_count = in_params.channel_count;
+
+    for (s32 channel = 0; channel < channel_count; channel++) {
+        const auto resource_id = in_params.voice_channel_resource_id[channel];
+        auto& dsp_state = voice_context.GetDspSharedState(resource_id);
+        auto& channel_resource = voice_context.GetChannelResource(resource_id);
+        const auto* channel_input = input + channel * worker_params.sample_count;
+
+        if (in_params.should_depop) {
+            GenerateVoiceDepopCommand(voice_info, dsp_state);
+        } else if (in_params.mix_id != AudioCommon::NO_MIX) {
+            // If we're using a mix id
+            auto& mix_info = mix_context.GetInfo(in_params.mix_id);
+            const auto& dest_mix_params = mix_info.GetInParams();
+
+            // Voice Mixing
+            GenerateVoiceMixCommand(
+                channel_resource.GetCurrentMixVolume(), channel_resource.GetLastMixVolume(),
+                dsp_state, dest_mix_params.buffer_offset, dest_mix_params.buffer_count,
+                channel_input, worker_params.mix_buffer_count + channel, in_params.node_id);
+
+            // Update last mix volumes
+            channel_resource.UpdateLastMixVolumes();
+        } else if (in_params.splitter_info_id != AudioCommon::NO_SPLITTER) {
+            s32 base = channel;
+            while (auto* destination_data = GetDestinationData(in_params.splitter_info_id, base)) {
+                base += channel_count;
+
+                if (!destination_data->IsConfigured()) {
+                    continue;
+                }
+                if (destination_data->GetMixId() >= static_cast<int>(mix_context.GetCount())) {
+                    continue;
+                }
+
+                const auto& mix_info = mix_context.GetInfo(destination_data->GetMixId());
+                const auto& dest_mix_params = mix_info.GetInParams();
+                GenerateVoiceMixCommand(
+                    destination_data->CurrentMixVolumes(), destination_data->LastMixVolumes(),
+                    dsp_state, dest_mix_params.buffer_offset, dest_mix_params.buffer_count,
+                    channel_input, worker_params.mix_buffer_count + channel, in_params.node_id);
+                destination_data->MarkDirty();
+            }
+        }
+    }
+}
+
+void CommandGenerator::RenderQueuedVoicesInParallel() {
+    voice_buffer.resize(queued_voices.size() * AudioCommon::MAX_CHANNEL_COUNT *
+                        worker_params.sample_count);
+    next_queued_voice.store(0, std::memory_order_relaxed);
+    {
+        std::scoped_lock lock{workers_mutex};
+        pending_workers = worker_sample_buffers.size();
+    }
+    for (auto& worker_sample_buffer : worker_sample_buffers) {
+        voice_workers->QueueWork([this, decode_buffer = worker_sample_buffer.data()] {
+            RenderQueuedVoices(decode_buffer);
+            std::scoped_lock lock{workers_mutex};
+            --pending_workers;
+            workers_done.notify_one();
+        });
+    }
+    RenderQueuedVoices(sample_buffer.data());
+
+    std::unique_lock lock{workers_mutex};
+    workers_done.wait(lock, [this] { return pending_workers == 0; });
+}
+
+void CommandGenerator::RenderQueuedVoices(s32* decode_buffer) {
+    const std::size_t voice_stride = AudioCommon::MAX_CHANNEL_COUNT * worker_params.sample_count;
+    while (true) {
+        const std::size_t index = next_queued_voice.fetch_add(1, std::memory_order_relaxed);
+        if (index >= queued_voices.size()) {
+            return;
+        }
+        RenderVoice(*queued_voices[index], voice_buffer.data() + index * voice_stride,
+                    decode_buffer);
+    }
+}
+
 void CommandGenerator::GenerateSubMixCommands() {
     const auto mix_count = mix_context.GetCount();
     for (std::size_t i = 0; i < mix_count; i++) {
@@ -377,42 +416,41 @@ void CommandGenerator::PostCommand() {
 }
 
 void CommandGenerator::GenerateDataSourceCommand(ServerVoiceInfo& voice_info, VoiceState& dsp_state,
-                                                 s32 channel) {
+                                                 s32* output, s32* decode_buffer, s32 channel) {
     const auto& in_params = voice_info.GetInParams();
-    const auto depop = in_params.should_depop;
+    switch (in_params.sample_format) {
+    case SampleFormat::Pcm16:
+        DecodeFromWaveBuffers(voice_info, output, decode_buffer, dsp_state, channel,
+                              worker_params.sample_rate, worker_params.sample_count,
+                              in_params.node_id);
+        break;
+    case SampleFormat::Adpcm:
+        ASSERT(channel == 0 && in_params.channel_count == 1);
+        DecodeFromWaveBuffers(voice_info, output, decode_buffer, dsp_state, 0,
+                              worker_params.sample_rate, worker_params.sample_count,
+                              in_params.node_id);
+        break;
+    default:
+        UNREACHABLE_MSG("Unimplemented sample format={}", in_params.sample_format);
+    }
+}
 
-    if (depop) {
-        if (in_params.mix_id != AudioCommon::NO_MIX) {
-            auto& mix_info = mix_context.GetInfo(in_params.mix_id);
+void CommandGenerator::GenerateVoiceDepopCommand(ServerVoiceInfo& voice_info,
+                                                 VoiceState& dsp_state) {
+    const auto& in_params = voice_info.GetInParams();
+    if (in_params.mix_id != AudioCommon::NO_MIX) {
+        auto& mix_info = mix_context.GetInfo(in_params.mix_id);
+        const auto& mix_in = mix_info.GetInParams();
+        GenerateDepopPrepareCommand(dsp_state, mix_in.buffer_count, mix_in.buffer_offset);
+    } else if (in_params.splitter_info_id != AudioCommon::NO_SPLITTER) {
+        s32 index{};
+        while (const auto* destination = GetDestinationData(in_params.splitter_info_id, index++)) {
+            if (!destination->IsConfigured()) {
+                continue;
+            }
+            auto& mix_info = mix_context.GetInfo(destination->GetMixId());
             const auto& mix_in = mix_info.GetInParams();
             GenerateDepopPrepareCommand(dsp_state, mix_in.buffer_count, mix_in.buffer_offset);
-        } else if (in_params.splitter_info_id != AudioCommon::NO_SPLITTER) {
-            s32 index{};
-            while (const auto* destination =
-                       GetDestinationData(in_params.splitter_info_id, index++)) {
-                if (!destination->IsConfigured()) {
-                    continue;
-                }
-                auto& mix_info = mix_context.GetInfo(destination->GetMixId());
-                const auto& mix_in = mix_info.GetInParams();
-                GenerateDepopPrepareCommand(dsp_state, mix_in.buffer_count, mix_in.buffer_offset);
-            }
-        }
-    } else {
-        switch (in_params.sample_format) {
-        case SampleFormat::Pcm16:
-            DecodeFromWaveBuffers(voice_info, GetChannelMixBuffer(channel), dsp_state, channel,
-                                  worker_params.sample_rate, worker_params.sample_count,
-                                  in_params.node_id);
-            break;
-        case SampleFormat::Adpcm:
-            ASSERT(channel == 0 && in_params.channel_count == 1);
-            DecodeFromWaveBuffers(voice_info, GetChannelMixBuffer(0), dsp_state, 0,
-                                  worker_params.sample_rate, worker_params.sample_count,
-                                  in_params.node_id);
-            break;
-        default:
-            UNREACHABLE_MSG("Unimplemented sample format={}", in_params.sample_format);
         }
     }
 }
@@ -602,7 +640,7 @@ void CommandGenerator::GenerateBiquadFilterEffectCommand(s32 mix_buffer_offset,
         if (params.input[i] != params.output[i]) {
             const auto* input = GetMixBuffer(mix_buffer_offset + params.input[i]);
             auto* output = GetMixBuffer(mix_buffer_offset + params.output[i]);
-            ApplyMix<1>(output, input, 32768, worker_params.sample_count);
+            ApplyMix(output, input, 32768, worker_params.sample_count);
         }
     }
 }
@@ -852,7 +890,7 @@ void CommandGenerator::UpdateI3dl2Reverb(I3dl2ReverbParams& info, I3dl2ReverbSta
 }
 
 void CommandGenerator::GenerateVolumeRampCommand(float last_volume, float current_volume,
-                                                 s32 channel, s32 node_id) {
+                                                 s32* output, s32 channel, s32 node_id) {
     const auto last = static_cast<s32>(last_volume * 32768.0f);
     const auto current = static_cast<s32>(current_volume * 32768.0f);
     const auto delta = static_cast<s32>((static_cast<float>(current) - static_cast<float>(last)) /
@@ -866,14 +904,14 @@ void CommandGenerator::GenerateVolumeRampCommand(float last_volume, float curren
                   last_volume, current_volume);
     }
     // Apply generic gain on samples
-    ApplyGain(GetChannelMixBuffer(channel), GetChannelMixBuffer(channel), last, delta,
-              worker_params.sample_count);
+    ApplyGain(output, output, last, delta, worker_params.sample_count);
 }
 
 void CommandGenerator::GenerateVoiceMixCommand(const MixVolumeBuffer& mix_volumes,
                                                const MixVolumeBuffer& last_mix_volumes,
                                                VoiceState& dsp_state, s32 mix_buffer_offset,
-                                               s32 mix_buffer_count, s32 voice_index, s32 node_id) {
+                                               s32 mix_buffer_count, const s32* input,
+                                               s32 voice_index, s32 node_id) {
     // Loop all our mix buffers
     for (s32 i = 0; i < mix_buffer_count; i++) {
         if (last_mix_volumes[i] != 0.0f || mix_volumes[i] != 0.0f) {
@@ -889,8 +927,8 @@ void CommandGenerator::GenerateVoiceMixCommand(const MixVolumeBuffer& mix_volume
             }
 
             dsp_state.previous_samples[i] =
-                ApplyMixRamp(GetMixBuffer(mix_buffer_offset + i), GetMixBuffer(voice_index),
-                             last_mix_volumes[i], delta, worker_params.sample_count);
+                ApplyMixRamp(GetMixBuffer(mix_buffer_offset + i), input, last_mix_volumes[i],
+                             delta, worker_params.sample_count);
         } else {
             dsp_state.previous_samples[i] = 0;
         }
@@ -966,14 +1004,7 @@ void CommandGenerator::GenerateMixCommand(std::size_t output_offset, std::size_t
     const auto* input = GetMixBuffer(input_offset);
 
     const s32 gain = static_cast<s32>(volume * 32768.0f);
-    // Mix with loop unrolling
-    if (worker_params.sample_count % 4 == 0) {
-        ApplyMix<4>(output, input, gain, worker_params.sample_count);
-    } else if (worker_params.sample_count % 2 == 0) {
-        ApplyMix<2>(output, input, gain, worker_params.sample_count);
-    } else {
-        ApplyMix<1>(output, input, gain, worker_params.sample_count);
-    }
+    ApplyMix(output, input, gain, worker_params.sample_count);
 }
 
 void CommandGenerator::GenerateFinalMixCommand() {
@@ -1004,7 +1035,8 @@ void CommandGenerator::GenerateFinalMixCommand() {
 }
 
 s32 CommandGenerator::DecodePcm16(ServerVoiceInfo& voice_info, VoiceState& dsp_state,
-                                  s32 sample_count, s32 channel, std::size_t mix_offset) {
+                                  s32* decode_buffer, s32 sample_count, s32 channel,
+                                  std::size_t mix_offset) {
     const auto& in_params = voice_info.GetInParams();
     const auto& wave_buffer = in_params.wave_buffer[dsp_state.wave_buffer_index];
     if (wave_buffer.buffer_address == 0) {
@@ -1028,7 +1060,7 @@ s32 CommandGenerator::DecodePcm16(ServerVoiceInfo& voice_info, VoiceState& dsp_s
         std::vector<s16> buffer(samples_processed);
         memory.ReadBlock(buffer_pos, buffer.data(), buffer.size() * sizeof(s16));
         for (std::size_t i = 0; i < buffer.size(); i++) {
-            sample_buffer[mix_offset + i] = buffer[i];
+            decode_buffer[mix_offset + i] = buffer[i];
         }
     } else {
         const auto channel_count = in_params.channel_count;
@@ -1036,7 +1068,7 @@ s32 CommandGenerator::DecodePcm16(ServerVoiceInfo& voice_info, VoiceState& dsp_s
         memory.ReadBlock(buffer_pos, buffer.data(), buffer.size() * sizeof(s16));
 
         for (std::size_t i = 0; i < static_cast<std::size_t>(samples_processed); i++) {
-            sample_buffer[mix_offset + i] = buffer[i * channel_count + channel];
+            decode_buffer[mix_offset + i] = buffer[i * channel_count + channel];
         }
     }
 
@@ -1044,8 +1076,8 @@ s32 CommandGenerator::DecodePcm16(ServerVoiceInfo& voice_info, VoiceState& dsp_s
 }
 
 s32 CommandGenerator::DecodeAdpcm(ServerVoiceInfo& voice_info, VoiceState& dsp_state,
-                                  s32 sample_count, [[maybe_unused]] s32 channel,
-                                  std::size_t mix_offset) {
+                                  s32* decode_buffer, s32 sample_count,
+                                  [[maybe_unused]] s32 channel, std::size_t mix_offset) {
     const auto& in_params = voice_info.GetInParams();
     const auto& wave_buffer = in_params.wave_buffer[dsp_state.wave_buffer_index];
     if (wave_buffer.buffer_address == 0) {
@@ -1129,8 +1161,8 @@ s32 CommandGenerator::DecodeAdpcm(ServerVoiceInfo& voice_info, VoiceState& dsp_s
                     const s32 s1 = SIGNED_NIBBLES[buffer[buffer_offset++] & 0xf];
                     const s16 sample_1 = decode_sample(s0);
                     const s16 sample_2 = decode_sample(s1);
-                    sample_buffer[cur_mix_offset++] = sample_1;
-                    sample_buffer[cur_mix_offset++] = sample_2;
+                    decode_buffer[cur_mix_offset++] = sample_1;
+                    decode_buffer[cur_mix_offset++] = sample_2;
                 }
                 remaining_samples -= static_cast<int>(SAMPLES_PER_FRAME);
                 position_in_frame += SAMPLES_PER_FRAME;
@@ -1146,7 +1178,7 @@ s32 CommandGenerator::DecodeAdpcm(ServerVoiceInfo& voice_info, VoiceState& dsp_s
             current_nibble >>= 4;
         }
         const s16 sample = decode_sample(SIGNED_NIBBLES[current_nibble]);
-        sample_buffer[cur_mix_offset++] = sample;
+        decode_buffer[cur_mix_offset++] = sample;
         remaining_samples--;
     }
 
@@ -1182,9 +1214,9 @@ const s32* CommandGenerator::GetChannelMixBuffer(s32 channel) const {
 }
 
 void CommandGenerator::DecodeFromWaveBuffers(ServerVoiceInfo& voice_info, s32* output,
-                                             VoiceState& dsp_state, s32 channel,
-                                             s32 target_sample_rate, s32 sample_count,
-                                             s32 node_id) {
+                                             s32* decode_buffer, VoiceState& dsp_state,
+                                             s32 channel, s32 target_sample_rate,
+                                             s32 sample_count, s32 node_id) {
     const auto& in_params = voice_info.GetInParams();
     if (dumping_frame) {
         LOG_DEBUG(Audio,
@@ -1219,7 +1251,7 @@ void CommandGenerator::DecodeFromWaveBuffers(ServerVoiceInfo& voice_info, s32* o
         if (!in_params.behavior_flags.is_pitch_and_src_skipped) {
             // Append sample histtory for resampler
             for (std::size_t i = 0; i < AudioCommon::MAX_SAMPLE_HISTORY; i++) {
-                sample_buffer[temp_mix_offset + i] = dsp_state.sample_history[i];
+                decode_buffer[temp_mix_offset + i] = dsp_state.sample_history[i];
             }
             temp_mix_offset += 4;
         }
@@ -1241,12 +1273,14 @@ void CommandGenerator::DecodeFromWaveBuffers(ServerVoiceInfo& voice_info, s32* o
             s32 samples_decoded{0};
             switch (in_params.sample_format) {
             case SampleFormat::Pcm16:
-                samples_decoded = DecodePcm16(voice_info, dsp_state, samples_to_read - samples_read,
-                                              channel, temp_mix_offset);
+                samples_decoded =
+                    DecodePcm16(voice_info, dsp_state, decode_buffer,
+                                samples_to_read - samples_read, channel, temp_mix_offset);
                 break;
             case SampleFormat::Adpcm:
-                samples_decoded = DecodeAdpcm(voice_info, dsp_state, samples_to_read - samples_read,
-                                              channel, temp_mix_offset);
+                samples_decoded =
+                    DecodeAdpcm(voice_info, dsp_state, decode_buffer,
+                                samples_to_read - samples_read, channel, temp_mix_offset);
                 break;
             default:
                 UNREACHABLE_MSG("Unimplemented sample format={}", in_params.sample_format);
@@ -1288,16 +1322,15 @@ void CommandGenerator::DecodeFromWaveBuffers(ServerVoiceInfo& voice_info, s32* o
 
         if (in_params.behavior_flags.is_pitch_and_src_skipped.Value()) {
             // No need to resample
-            std::memcpy(output, sample_buffer.data(), samples_read * sizeof(s32));
+            std::memcpy(output, decode_buffer, samples_read * sizeof(s32));
         } else {
-            std::fill(sample_buffer.begin() + temp_mix_offset,
-                      sample_buffer.begin() + temp_mix_offset + (samples_to_read - samples_read),
-                      0);
-            AudioCore::Resample(output, sample_buffer.data(), resample_rate, dsp_state.fraction,
+            std::fill(decode_buffer + temp_mix_offset,
+                      decode_buffer + temp_mix_offset + (samples_to_read - samples_read), 0);
+            AudioCore::Resample(output, decode_buffer, resample_rate, dsp_state.fraction,
                                 samples_to_output);
             // Resample
             for (std::size_t i = 0; i < AudioCommon::MAX_SAMPLE_HISTORY; i++) {
-                dsp_state.sample_history[i] = sample_buffer[samples_to_read + i];
+                dsp_state.sample_history[i] = decode_buffer[samples_to_read + i];
             }
         }
         output += samples_to_output;
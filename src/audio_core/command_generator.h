@@ -5,10 +5,19 @@
 #pragma once
 
 #include <array>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
 #include "audio_core/common.h"
 #include "audio_core/voice_context.h"
 #include "common/common_types.h"
 
+namespace Common {
+class ThreadWorker;
+}
+
 namespace Core::Memory {
 class Memory;
 }
@@ -30,7 +39,7 @@ public:
     explicit CommandGenerator(AudioCommon::AudioRendererParameter& worker_params_,
                               VoiceContext& voice_context_, MixContext& mix_context_,
                               SplitterContext& splitter_context_, EffectContext& effect_context_,
-                              Core::Memory::Memory& memory_);
+                              Core::Memory::Memory& memory_, bool parallel_voices);
     ~CommandGenerator();
 
     void ClearMixBuffers();
@@ -50,15 +59,27 @@ public:
     [[nodiscard]] std::size_t GetTotalMixBufferCount() const;
 
 private:
-    void GenerateDataSourceCommand(ServerVoiceInfo& voice_info, VoiceState& dsp_state, s32 channel);
+    /// Decodes, filters and ramps the volume of every channel of a voice. Channels are written to
+    /// consecutive buffers of sample_count samples starting at output. Touches no state shared
+    /// with other voices, so voices can be rendered concurrently.
+    void RenderVoice(ServerVoiceInfo& voice_info, s32* output, s32* decode_buffer);
+    /// Mixes the channels rendered by RenderVoice into the mix buffers of its destinations.
+    void MixVoice(ServerVoiceInfo& voice_info, const s32* input);
+    /// Renders the queued voices on the worker threads and this one, then waits for all of them.
+    void RenderQueuedVoicesInParallel();
+    void RenderQueuedVoices(s32* decode_buffer);
+
+    void GenerateDataSourceCommand(ServerVoiceInfo& voice_info, VoiceState& dsp_state, s32* output,
+                                   s32* decode_buffer, s32 channel);
+    void GenerateVoiceDepopCommand(ServerVoiceInfo& voice_info, VoiceState& dsp_state);
     void GenerateBiquadFilterCommandForVoice(ServerVoiceInfo& voice_info, VoiceState& dsp_state,
                                              s32 mix_buffer_count, s32 channel);
-    void GenerateVolumeRampCommand(float last_volume, float current_volume, s32 channel,
-                                   s32 node_id);
+    void GenerateVolumeRampCommand(float last_volume, float current_volume, s32* output,
+                                   s32 channel, s32 node_id);
     void GenerateVoiceMixCommand(const MixVolumeBuffer& mix_volumes,
                                  const MixVolumeBuffer& last_mix_volumes, VoiceState& dsp_state,
-                                 s32 mix_buffer_offset, s32 mix_buffer_count, s32 voice_index,
-                                 s32 node_id);
+                                 s32 mix_buffer_offset, s32 mix_buffer_count, const s32* input,
+                                 s32 voice_index, s32 node_id);
     void GenerateSubMixCommand(ServerMixInfo& mix_info);
     void GenerateMixCommands(ServerMixInfo& mix_info);
     void GenerateMixCommand(std::size_t output_offset, std::size_t input_offset, float volume,
@@ -86,12 +107,13 @@ private:
                                std::vector<u8>& work_buffer);
     void UpdateI3dl2Reverb(I3dl2ReverbParams& info, I3dl2ReverbState& state, bool should_clear);
     // DSP Code
-    s32 DecodePcm16(ServerVoiceInfo& voice_info, VoiceState& dsp_state, s32 sample_count,
-                    s32 channel, std::size_t mix_offset);
-    s32 DecodeAdpcm(ServerVoiceInfo& voice_info, VoiceState& dsp_state, s32 sample_count,
-                    s32 channel, std::size_t mix_offset);
-    void DecodeFromWaveBuffers(ServerVoiceInfo& voice_info, s32* output, VoiceState& dsp_state,
-                               s32 channel, s32 target_sample_rate, s32 sample_count, s32 node_id);
+    s32 DecodePcm16(ServerVoiceInfo& voice_info, VoiceState& dsp_state, s32* decode_buffer,
+                    s32 sample_count, s32 channel, std::size_t mix_offset);
+    s32 DecodeAdpcm(ServerVoiceInfo& voice_info, VoiceState& dsp_state, s32* decode_buffer,
+                    s32 sample_count, s32 channel, std::size_t mix_offset);
+    void DecodeFromWaveBuffers(ServerVoiceInfo& voice_info, s32* output, s32* decode_buffer,
+                               VoiceState& dsp_state, s32 channel, s32 target_sample_rate,
+                               s32 sample_count, s32 node_id);
 
     AudioCommon::AudioRendererParameter& worker_params;
     VoiceContext& voice_context;
@@ -103,5 +125,17 @@ private:
     std::vector<s32> sample_buffer{};
     std::vector<s32> depop_buffer{};
     bool dumping_frame{false};
+
+    // Voices rendered this frame, in mixing order
+    std::vector<ServerVoiceInfo*> queued_voices;
+    // Rendered channels of every queued voice when they are rendered in parallel
+    std::vector<s32> voice_buffer;
+    // Decode buffers of each worker, the calling thread decodes into sample_buffer
+    std::vector<std::vector<s32>> worker_sample_buffers;
+    std::atomic<std::size_t> next_queued_voice{};
+    std::size_t pending_workers{};
+    std::mutex workers_mutex;
+    std::condition_variable workers_done;
+    std::unique_ptr<Common::ThreadWorker> voice_workers;
 };
 } // namespace AudioCore
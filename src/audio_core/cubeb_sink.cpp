@@ -5,6 +5,7 @@
 #include <algorithm>
 #include <atomic>
 #include <cstring>
+#include <span>
 #include "audio_core/cubeb_sink.h"
 #include "audio_core/stream.h"
 #include "audio_core/time_stretch.h"
@@ -21,10 +22,10 @@ namespace AudioCore {
 
 class CubebSinkStream final : public SinkStream {
 public:
-    CubebSinkStream(cubeb* ctx_, u32 sample_rate, u32 num_channels_, cubeb_devid output_device,
+    CubebSinkStream(cubeb* ctx_, u32 sample_rate_, u32 num_channels_, cubeb_devid output_device,
                     const std::string& name)
-        : ctx{ctx_}, num_channels{std::min(num_channels_, 6u)}, time_stretch{sample_rate,
-                                                                             num_channels} {
+        : ctx{ctx_}, num_channels{std::min(num_channels_, 6u)}, sample_rate{sample_rate_},
+          time_stretch{sample_rate, num_channels} {
 
         cubeb_stream_params params{};
         params.rate = sample_rate;
@@ -74,36 +75,20 @@ public:
         cubeb_stream_destroy(stream_backend);
     }
 
-    void EnqueueSamples(u32 source_num_channels, const std::vector<s16>& samples) override {
-        if (source_num_channels > num_channels) {
-            // Downsample 6 channels to 2
-            ASSERT_MSG(source_num_channels == 6, "Channel count must be 6");
-
-            std::vector<s16> buf;
-            buf.reserve(samples.size() * num_channels / source_num_channels);
-            for (std::size_t i = 0; i < samples.size(); i += source_num_channels) {
-                // Downmixing implementation taken from the ATSC standard
-                const s16 left{samples[i + 0]};
-                const s16 right{samples[i + 1]};
-                const s16 center{samples[i + 2]};
-                const s16 surround_left{samples[i + 4]};
-                const s16 surround_right{samples[i + 5]};
-                // Not used in the ATSC reference implementation
-                [[maybe_unused]] const s16 low_frequency_effects{samples[i + 3]};
-
-                constexpr s32 clev{707}; // center mixing level coefficient
-                constexpr s32 slev{707}; // surround mixing level coefficient
-
-                buf.push_back(static_cast<s16>(left + (clev * center / 1000) +
-                                               (slev * surround_left / 1000)));
-                buf.push_back(static_cast<s16>(right + (clev * center / 1000) +
-                                               (slev * surround_right / 1000)));
-            }
-            queue.Push(buf);
-            return;
+    void EnqueueSamples(u32 source_num_channels, const std::vector<s16>& samples,
+                        float volume_scale) override {
+        const std::size_t num_frames = samples.size() / source_num_channels;
+        const std::size_t free_frames = (queue.Capacity() - queue.Size()) / num_channels;
+        const std::size_t frames_to_push = std::min(num_frames, free_frames);
+        if (frames_to_push < num_frames) {
+            RecordOverrun();
         }
-
-        queue.Push(samples);
+        queue.PushWith(frames_to_push * num_channels,
+                       [&](std::span<s16> first, std::span<s16> second) {
+                           ConvertFrames(first, second, samples, source_num_channels,
+                                         num_channels, volume_scale);
+                       });
+        is_playing = true;
     }
 
     std::size_t SamplesInQueue(u32 channel_count) const override {
@@ -115,6 +100,7 @@ public:
 
     void Flush() override {
         should_flush = true;
+        is_playing = false;
     }
 
     u32 GetNumChannels() const {
@@ -127,10 +113,12 @@ private:
     cubeb* ctx{};
     cubeb_stream* stream_backend{};
     u32 num_channels{};
+    u32 sample_rate{};
 
     Common::RingBuffer<s16, 0x10000> queue;
-    std::array<s16, 2> last_frame{};
+    std::array<s16, 6> last_frame{};
     std::atomic<bool> should_flush{};
+    std::atomic<bool> is_playing{};
     TimeStretcher time_stretch;
 
     static long DataCallback(cubeb_stream* stream, void* user_data, const void* input_buffer,
@@ -207,6 +195,8 @@ long CubebSinkStream::DataCallback([[maybe_unused]] cubeb_stream* stream, void*
     const std::size_t samples_to_write = num_channels * num_frames;
     std::size_t samples_written;
 
+    impl->RecordQueueLatency(impl->queue.Size() / num_channels, impl->sample_rate);
+
     /*
     if (Settings::values.enable_audio_stretching.GetValue()) {
         const std::vector<s16> in{impl->queue.Pop()};
@@ -224,6 +214,9 @@ long CubebSinkStream::DataCallback([[maybe_unused]] cubeb_stream* stream, void*
         samples_written = impl->queue.Pop(buffer, samples_to_write);
     }*/
     samples_written = impl->queue.Pop(buffer, samples_to_write);
+    if (samples_written < samples_to_write && impl->is_playing) {
+        impl->RecordUnderrun();
+    }
 
     if (samples_written >= num_channels) {
         std::memcpy(&impl->last_frame[0], buffer + (samples_written - num_channels) * sizeof(s16),
@@ -14,7 +14,7 @@
 
 namespace AudioCore {
 
-InfoUpdater::InfoUpdater(const std::vector<u8>& in_params_, std::vector<u8>& out_params_,
+InfoUpdater::InfoUpdater(std::span<const u8> in_params_, std::span<u8> out_params_,
                          BehaviorInfo& behavior_info_)
     : in_params(in_params_), out_params(out_params_), behavior_info(behavior_info_) {
     ASSERT(
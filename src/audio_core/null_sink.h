@@ -20,7 +20,8 @@ public:
 
 private:
     struct NullSinkStreamImpl final : SinkStream {
-        void EnqueueSamples(u32 /*num_channels*/, const std::vector<s16>& /*samples*/) override {}
+        void EnqueueSamples(u32 /*num_channels*/, const std::vector<s16>& /*samples*/,
+                            float /*volume_scale*/) override {}
 
         std::size_t SamplesInQueue(u32 /*num_channels*/) const override {
             return 0;
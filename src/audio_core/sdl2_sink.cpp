@@ -5,11 +5,13 @@
 #include <algorithm>
 #include <atomic>
 #include <cstring>
+#include <span>
 #include "audio_core/sdl2_sink.h"
 #include "audio_core/stream.h"
 #include "audio_core/time_stretch.h"
 #include "common/assert.h"
 #include "common/logging/log.h"
+#include "common/ring_buffer.h"
 //#include "common/settings.h"
 
 // Ignore -Wimplicit-fallthrough due to https://github.com/libsdl-org/SDL/issues/4307
@@ -26,15 +28,17 @@ namespace AudioCore {
 
 class SDLSinkStream final : public SinkStream {
 public:
-    SDLSinkStream(u32 sample_rate, u32 num_channels_, const std::string& output_device)
-        : num_channels{std::min(num_channels_, 6u)}, time_stretch{sample_rate, num_channels} {
+    SDLSinkStream(u32 sample_rate_, u32 num_channels_, const std::string& output_device)
+        : num_channels{std::min(num_channels_, 6u)}, sample_rate{sample_rate_},
+          time_stretch{sample_rate, num_channels} {
 
         SDL_AudioSpec spec;
         spec.freq = sample_rate;
         spec.channels = static_cast<u8>(num_channels);
         spec.format = AUDIO_S16SYS;
         spec.samples = 4096;
-        spec.callback = nullptr;
+        spec.callback = &SDLSinkStream::DataCallback;
+        spec.userdata = this;
 
         SDL_AudioSpec obtained;
         if (output_device.empty()) {
@@ -59,53 +63,32 @@ public:
         SDL_CloseAudioDevice(dev);
     }
 
-    void EnqueueSamples(u32 source_num_channels, const std::vector<s16>& samples) override {
-        if (source_num_channels > num_channels) {
-            // Downsample 6 channels to 2
-            ASSERT_MSG(source_num_channels == 6, "Channel count must be 6");
-
-            std::vector<s16> buf;
-            buf.reserve(samples.size() * num_channels / source_num_channels);
-            for (std::size_t i = 0; i < samples.size(); i += source_num_channels) {
-                // Downmixing implementation taken from the ATSC standard
-                const s16 left{samples[i + 0]};
-                const s16 right{samples[i + 1]};
-                const s16 center{samples[i + 2]};
-                const s16 surround_left{samples[i + 4]};
-                const s16 surround_right{samples[i + 5]};
-                // Not used in the ATSC reference implementation
-                [[maybe_unused]] const s16 low_frequency_effects{samples[i + 3]};
-
-                constexpr s32 clev{707}; // center mixing level coefficient
-                constexpr s32 slev{707}; // surround mixing level coefficient
-
-                buf.push_back(static_cast<s16>(left + (clev * center / 1000) +
-                                               (slev * surround_left / 1000)));
-                buf.push_back(static_cast<s16>(right + (clev * center / 1000) +
-                                               (slev * surround_right / 1000)));
-            }
-            int ret = SDL_QueueAudio(dev, static_cast<const void*>(buf.data()),
-                                     static_cast<u32>(buf.size() * sizeof(s16)));
-            if (ret < 0)
-                LOG_WARNING(Audio_Sink, "Could not queue audio buffer: {}", SDL_GetError());
-            return;
+    void EnqueueSamples(u32 source_num_channels, const std::vector<s16>& samples,
+                        float volume_scale) override {
+        const std::size_t num_frames = samples.size() / source_num_channels;
+        const std::size_t free_frames = (queue.Capacity() - queue.Size()) / num_channels;
+        const std::size_t frames_to_push = std::min(num_frames, free_frames);
+        if (frames_to_push < num_frames) {
+            RecordOverrun();
         }
-
-        int ret = SDL_QueueAudio(dev, static_cast<const void*>(samples.data()),
-                                 static_cast<u32>(samples.size() * sizeof(s16)));
-        if (ret < 0)
-            LOG_WARNING(Audio_Sink, "Could not queue audio buffer: {}", SDL_GetError());
+        queue.PushWith(frames_to_push * num_channels,
+                       [&](std::span<s16> first, std::span<s16> second) {
+                           ConvertFrames(first, second, samples, source_num_channels,
+                                         num_channels, volume_scale);
+                       });
+        is_playing = true;
     }
 
     std::size_t SamplesInQueue(u32 channel_count) const override {
         if (dev == 0)
             return 0;
 
-        return SDL_GetQueuedAudioSize(dev) / (channel_count * sizeof(s16));
+        return queue.Size() / channel_count;
     }
 
     void Flush() override {
         should_flush = true;
+        is_playing = false;
     }
 
     u32 GetNumChannels() const {
@@ -113,12 +96,48 @@ public:
     }
 
 private:
+    static void DataCallback(void* user_data, Uint8* output_buffer, int length);
+
     SDL_AudioDeviceID dev = 0;
     u32 num_channels{};
+    u32 sample_rate{};
+    Common::RingBuffer<s16, 0x10000> queue;
+    std::array<s16, 6> last_frame{};
     std::atomic<bool> should_flush{};
+    std::atomic<bool> is_playing{};
     TimeStretcher time_stretch;
 };
 
+void SDLSinkStream::DataCallback(void* user_data, Uint8* output_buffer, int length) {
+    auto* impl = static_cast<SDLSinkStream*>(user_data);
+    if (!impl) {
+        return;
+    }
+
+    const std::size_t num_channels = impl->GetNumChannels();
+    const std::size_t samples_to_write = static_cast<std::size_t>(length) / sizeof(s16);
+
+    impl->RecordQueueLatency(impl->queue.Size() / num_channels, impl->sample_rate);
+
+    const std::size_t samples_written = impl->queue.Pop(output_buffer, samples_to_write);
+    if (samples_written < samples_to_write && impl->is_playing) {
+        impl->RecordUnderrun();
+    }
+
+    if (samples_written >= num_channels) {
+        std::memcpy(impl->last_frame.data(),
+                    output_buffer + (samples_written - num_channels) * sizeof(s16),
+                    num_channels * sizeof(s16));
+    }
+
+    // Fill the rest of the frames with last_frame
+    for (std::size_t i = samples_written; i + num_channels <= samples_to_write;
+         i += num_channels) {
+        std::memcpy(output_buffer + i * sizeof(s16), impl->last_frame.data(),
+                    num_channels * sizeof(s16));
+    }
+}
+
 SDLSink::SDLSink(std::string_view target_device_name) {
     if (!SDL_WasInit(SDL_INIT_AUDIO)) {
         if (SDL_InitSubSystem(SDL_INIT_AUDIO) < 0) {
@@ -0,0 +1,106 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+
+#include "audio_core/sink_stream.h"
+#include "common/assert.h"
+
+namespace AudioCore {
+namespace {
+std::atomic<u32> underrun_count{};
+std::atomic<u32> overrun_count{};
+std::atomic<u64> queue_latency_sum_us{};
+std::atomic<u64> queue_latency_samples{};
+std::atomic<double> last_stretch_ratio{1.0};
+
+s16 ScaleSample(s16 sample, float volume_scale) {
+    if (volume_scale == 1.0f) {
+        return sample;
+    }
+    return static_cast<s16>(sample * volume_scale);
+}
+} // Anonymous namespace
+
+SinkStatistics GetAndResetSinkStatistics() {
+    const u64 latency_sum_us = queue_latency_sum_us.exchange(0, std::memory_order_relaxed);
+    const u64 latency_samples = queue_latency_samples.exchange(0, std::memory_order_relaxed);
+    return {
+        .underruns = underrun_count.exchange(0, std::memory_order_relaxed),
+        .overruns = overrun_count.exchange(0, std::memory_order_relaxed),
+        .queue_latency = latency_samples == 0 ? 0.0
+                                              : static_cast<double>(latency_sum_us) /
+                                                    static_cast<double>(latency_samples) / 1e6,
+        .stretch_ratio = last_stretch_ratio.load(std::memory_order_relaxed),
+    };
+}
+
+void RecordStretchRatio(double ratio) {
+    last_stretch_ratio.store(ratio, std::memory_order_relaxed);
+}
+
+void SinkStream::ConvertFrames(std::span<s16> first, std::span<s16> second,
+                               std::span<const s16> samples, u32 source_num_channels,
+                               u32 num_channels, float volume_scale) {
+    std::size_t output_index = 0;
+    const auto write = [&](s16 sample) {
+        if (output_index < first.size()) {
+            first[output_index] = sample;
+        } else {
+            second[output_index - first.size()] = sample;
+        }
+        ++output_index;
+    };
+
+    const std::size_t num_frames = (first.size() + second.size()) / num_channels;
+    if (source_num_channels <= num_channels) {
+        ASSERT(source_num_channels == num_channels);
+        for (std::size_t i = 0; i < num_frames * num_channels; ++i) {
+            write(ScaleSample(samples[i], volume_scale));
+        }
+        return;
+    }
+
+    // Downsample 6 channels to 2
+    ASSERT_MSG(source_num_channels == 6 && num_channels == 2, "Channel count must be 6");
+    for (std::size_t frame = 0; frame < num_frames; ++frame) {
+        std::array<s16, 6> source;
+        for (std::size_t channel = 0; channel < source.size(); ++channel) {
+            source[channel] = ScaleSample(samples[frame * 6 + channel], volume_scale);
+        }
+
+        // Downmixing implementation taken from the ATSC standard
+        const s16 left{source[0]};
+        const s16 right{source[1]};
+        const s16 center{source[2]};
+        const s16 surround_left{source[4]};
+        const s16 surround_right{source[5]};
+        // Not used in the ATSC reference implementation
+        [[maybe_unused]] const s16 low_frequency_effects{source[3]};
+
+        constexpr s32 clev{707}; // center mixing level coefficient
+        constexpr s32 slev{707}; // surround mixing level coefficient
+
+        write(static_cast<s16>(left + (clev * center / 1000) + (slev * surround_left / 1000)));
+        write(static_cast<s16>(right + (clev * center / 1000) + (slev * surround_right / 1000)));
+    }
+}
+
+void SinkStream::RecordUnderrun() {
+    underrun_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+void SinkStream::RecordOverrun() {
+    overrun_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+void SinkStream::RecordQueueLatency(std::size_t queued_frames, u32 sample_rate) {
+    queue_latency_sum_us.fetch_add(static_cast<u64>(queued_frames) * 1'000'000 / sample_rate,
+                                   std::memory_order_relaxed);
+    queue_latency_samples.fetch_add(1, std::memory_order_relaxed);
+}
+
+} // namespace AudioCore
@@ -5,12 +5,31 @@
 #pragma once
 
 #include <memory>
+#include <span>
 #include <vector>
 
 #include "common/common_types.h"
 
 namespace AudioCore {
 
+/// Playback statistics gathered from every sink stream.
+struct SinkStatistics {
+    /// Number of times a sink ran out of samples while playing
+    u32 underruns{};
+    /// Number of times samples were dropped because a sink queue was full
+    u32 overruns{};
+    /// Average time samples waited in the sink queues, in seconds
+    double queue_latency{};
+    /// Tempo the time stretcher last played at, 1.0 when it is not in use
+    double stretch_ratio{1.0};
+};
+
+/// Returns the statistics gathered since the last call and starts gathering new ones.
+SinkStatistics GetAndResetSinkStatistics();
+
+/// Records the stretch ratio applied by a time stretcher.
+void RecordStretchRatio(double ratio);
+
 /**
  * Accepts samples in stereo signed PCM16 format to be output. Sinks *do not* handle resampling and
  * expect the correct sample rate. They are dumb outputs.
@@ -23,12 +42,34 @@ public:
      * Feed stereo samples to sink.
      * @param num_channels Number of channels used.
      * @param samples Samples in interleaved stereo PCM16 format.
+     * @param volume_scale Factor the samples are scaled by while they are queued.
      */
-    virtual void EnqueueSamples(u32 num_channels, const std::vector<s16>& samples) = 0;
+    virtual void EnqueueSamples(u32 num_channels, const std::vector<s16>& samples,
+                                float volume_scale) = 0;
 
     virtual std::size_t SamplesInQueue(u32 num_channels) const = 0;
 
     virtual void Flush() = 0;
+
+protected:
+    /**
+     * Scales source frames and downmixes them to the sink's channel count, writing them across
+     * the regions of a sink queue in a single pass.
+     * @param first First region of the queue to write, then second.
+     * @param samples Interleaved source frames, as many as fit in the regions.
+     */
+    static void ConvertFrames(std::span<s16> first, std::span<s16> second,
+                              std::span<const s16> samples, u32 source_num_channels,
+                              u32 num_channels, float volume_scale);
+
+    /// Records a sink having to pad its output because its queue ran dry.
+    static void RecordUnderrun();
+
+    /// Records a sink dropping samples because its queue was full.
+    static void RecordOverrun();
+
+    /// Records how long the samples queued in a sink will take to be played.
+    static void RecordQueueLatency(std::size_t queued_frames, u32 sample_rate);
 };
 
 using SinkStreamPtr = std::unique_ptr<SinkStream>;
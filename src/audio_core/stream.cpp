@@ -72,18 +72,16 @@ std::chrono::nanoseconds Stream::GetBufferReleaseNS(const Buffer& buffer) const
     return std::chrono::nanoseconds((static_cast<u64>(num_samples) * 1000000000ULL) / sample_rate);
 }
 
-static void VolumeAdjustSamples(std::vector<s16>& samples, float game_volume) {
+/// Returns the factor samples are scaled by for the current volume settings
+static float GetVolumeScale(float game_volume) {
     const float volume{std::clamp(Settings::Volume() - (1.0f - game_volume), 0.0f, 1.0f)};
 
     if (volume == 1.0f) {
-        return;
+        return 1.0f;
     }
 
     // Implementation of a volume slider with a dynamic range of 60 dB
-    const float volume_scale_factor = volume == 0 ? 0 : std::exp(6.90775f * volume) * 0.001f;
-    for (auto& sample : samples) {
-        sample = static_cast<s16>(sample * volume_scale_factor);
-    }
+    return volume == 0 ? 0 : std::exp(6.90775f * volume) * 0.001f;
 }
 
 void Stream::PlayNextBuffer(std::chrono::nanoseconds ns_late) {
@@ -107,9 +105,9 @@ void Stream::PlayNextBuffer(std::chrono::nanoseconds ns_late) {
     active_buffer = queued_buffers.front();
     queued_buffers.pop();
 
-    VolumeAdjustSamples(active_buffer->GetSamples(), game_volume);
-
-    sink_stream.EnqueueSamples(GetNumChannels(), active_buffer->GetSamples());
+    // The volume is applied while the sink copies the samples to its queue
+    sink_stream.EnqueueSamples(GetNumChannels(), active_buffer->GetSamples(),
+                               GetVolumeScale(game_volume));
 
     const auto buffer_release_ns = GetBufferReleaseNS(*active_buffer);
 
@@ -5,6 +5,7 @@
 #include <algorithm>
 #include <cmath>
 #include <cstddef>
+#include "audio_core/sink_stream.h"
 #include "audio_core/time_stretch.h"
 #include "common/logging/log.h"
 
@@ -57,6 +58,7 @@ std::size_t TimeStretcher::Process(const s16* in, std::size_t num_in, s16* out,
     // many silence samples. These do not need to be timestretched.
     m_stretch_ratio = std::max(m_stretch_ratio, 0.05);
     m_sound_touch.setTempo(m_stretch_ratio);
+    RecordStretchRatio(m_stretch_ratio);
 
     LOG_TRACE(Audio, "{:5}/{:5} ratio:{:0.6f} backlog:{:0.6f}", num_in, num_out, m_stretch_ratio,
               backlog_fullness);
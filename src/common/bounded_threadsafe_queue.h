@@ -0,0 +1,162 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <utility>
+
+#include "common/common_types.h"
+
+namespace Common {
+
+/// A bounded, preallocated queue with lock-free multiple writers and a single reader.
+/// Elements are stored inline in the queue slots, so pushing and popping never allocates.
+/// Writers block while the queue is full and the reader blocks while it's empty.
+template <typename T, std::size_t Capacity>
+class BoundedMPSCQueue {
+    static_assert(std::has_single_bit(Capacity), "Capacity must be a power of two");
+
+public:
+    BoundedMPSCQueue() {
+        for (std::size_t i = 0; i < Capacity; ++i) {
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    /// Pushes an element and returns its position in the queue.
+    /// Positions are unique and elements are popped in increasing position order.
+    template <typename Arg>
+    u64 Push(Arg&& t) {
+        const u64 position = write_index.fetch_add(1, std::memory_order_relaxed);
+        Slot& slot = slots[position % Capacity];
+
+        // Wait until the reader has released the slot from the previous lap
+        WaitSequence(slot, position);
+
+        slot.value = std::forward<Arg>(t);
+        slot.sequence.store(position + 1, std::memory_order_release);
+        slot.sequence.notify_all();
+        return position;
+    }
+
+    /// Blocks until there's an element to pop.
+    void Wait() {
+        WaitSequence(slots[read_index % Capacity], read_index + 1);
+    }
+
+    /// Blocks until there's an element and pops it.
+    T PopWait() {
+        Slot& slot = slots[read_index % Capacity];
+        WaitSequence(slot, read_index + 1);
+
+        T t = std::move(slot.value);
+        slot.sequence.store(read_index + Capacity, std::memory_order_release);
+        slot.sequence.notify_all();
+        ++read_index;
+        return t;
+    }
+
+    [[nodiscard]] bool Empty() const {
+        return slots[read_index % Capacity].sequence.load(std::memory_order_acquire) !=
+               read_index + 1;
+    }
+
+private:
+    struct Slot {
+        std::atomic<u64> sequence{};
+        T value{};
+    };
+
+    static void WaitSequence(Slot& slot, u64 expected) {
+        for (u64 sequence = slot.sequence.load(std::memory_order_acquire); sequence != expected;
+             sequence = slot.sequence.load(std::memory_order_acquire)) {
+            slot.sequence.wait(sequence, std::memory_order_acquire);
+        }
+    }
+
+    std::array<Slot, Capacity> slots;
+    alignas(64) std::atomic<u64> write_index{0};
+    alignas(64) u64 read_index{0};
+};
+
+/// A bounded, preallocated queue with lock-free multiple writers and multiple readers.
+/// Pushing and popping never block: they fail instead when the queue is full or empty.
+template <typename T, std::size_t Capacity>
+class BoundedMPMCQueue {
+    static_assert(std::has_single_bit(Capacity), "Capacity must be a power of two");
+
+public:
+    BoundedMPMCQueue() {
+        for (std::size_t i = 0; i < Capacity; ++i) {
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    /// Pushes an element. Returns false without pushing when the queue is full.
+    template <typename Arg>
+    [[nodiscard]] bool TryPush(Arg&& t) {
+        u64 position = write_index.load(std::memory_order_relaxed);
+        while (true) {
+            Slot& slot = slots[position % Capacity];
+            const u64 sequence = slot.sequence.load(std::memory_order_acquire);
+            if (sequence == position) {
+                if (write_index.compare_exchange_weak(position, position + 1,
+                                                      std::memory_order_relaxed)) {
+                    slot.value = std::forward<Arg>(t);
+                    slot.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (sequence < position) {
+                // The slot still holds the element from the previous lap
+                return false;
+            } else {
+                position = write_index.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /// Pops an element into t. Returns false without popping when the queue is empty.
+    [[nodiscard]] bool TryPop(T& t) {
+        u64 position = read_index.load(std::memory_order_relaxed);
+        while (true) {
+            Slot& slot = slots[position % Capacity];
+            const u64 sequence = slot.sequence.load(std::memory_order_acquire);
+            if (sequence == position + 1) {
+                if (read_index.compare_exchange_weak(position, position + 1,
+                                                     std::memory_order_relaxed)) {
+                    t = std::move(slot.value);
+                    slot.sequence.store(position + Capacity, std::memory_order_release);
+                    return true;
+                }
+            } else if (sequence < position + 1) {
+                return false;
+            } else {
+                position = read_index.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /// Returns true if the queue looked empty at the time of the call.
+    [[nodiscard]] bool Empty() const {
+        const u64 position = read_index.load(std::memory_order_relaxed);
+        return slots[position % Capacity].sequence.load(std::memory_order_acquire) !=
+               position + 1;
+    }
+
+private:
+    struct Slot {
+        std::atomic<u64> sequence{};
+        T value{};
+    };
+
+    std::array<Slot, Capacity> slots;
+    alignas(64) std::atomic<u64> write_index{0};
+    alignas(64) std::atomic<u64> read_index{0};
+};
+
+} // namespace Common
@@ -0,0 +1,73 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <filesystem>
+#include <span>
+
+#include "common/common_types.h"
+
+namespace Common::FS {
+
+/**
+ * Read-only view of an entire file mapped into the address space of the process.
+ * Pages are brought in by the host on demand, so reads from the view do not cost a system call.
+ * Empty files cannot be mapped.
+ */
+class MappedFile {
+public:
+    MappedFile();
+
+    /**
+     * Maps the file at path. Check IsOpen() to know whether the mapping succeeded.
+     *
+     * @param path Filesystem path
+     */
+    explicit MappedFile(const std::filesystem::path& path);
+
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    /**
+     * Maps the file at path, unmapping any previously mapped file.
+     *
+     * @param path Filesystem path
+     */
+    void Open(const std::filesystem::path& path);
+
+    /// Unmaps the file. Views previously returned by GetSpan() become invalid.
+    void Close();
+
+    /// Returns whether a file is currently mapped.
+    [[nodiscard]] bool IsOpen() const {
+        return data != nullptr;
+    }
+
+    /// Returns the size of the mapping, which is the size of the file when it was mapped.
+    [[nodiscard]] size_t GetSize() const {
+        return size;
+    }
+
+    /// Returns a view of the whole mapping, or an empty span if nothing is mapped.
+    [[nodiscard]] std::span<const u8> GetSpan() const {
+        return {data, size};
+    }
+
+private:
+    const u8* data = nullptr;
+    size_t size = 0;
+
+#ifdef _WIN32
+    void* file_handle = nullptr;
+    void* mapping_handle = nullptr;
+#endif
+};
+
+} // namespace Common::FS
@@ -7,8 +7,11 @@
 #include <chrono>
 #include <climits>
 #include <condition_variable>
+#include <cstring>
 #include <memory>
 #include <mutex>
+#include <optional>
+#include <span>
 #include <thread>
 #include <vector>
 
@@ -16,10 +19,12 @@
 #include <windows.h> // For OutputDebugStringW
 #endif
 
+#include "common/alignment.h"
 #include "common/assert.h"
 #include "common/fs/file.h"
 #include "common/fs/fs.h"
 #include "common/logging/backend.h"
+#include "common/logging/binary_log.h"
 #include "common/logging/log.h"
 #include "common/logging/text_formatter.h"
 #include "common/settings.h"
@@ -28,6 +33,149 @@
 
 namespace Common::Log {
 
+namespace {
+
+/// How often the backend thread collects the messages of the deferred rings. Errors and worse
+/// are queued instead and wake it up right away.
+constexpr std::chrono::milliseconds DEFERRED_POLL_INTERVAL{10};
+
+/// Header of a message in a DeferredRing, followed by its payload
+struct DeferredRecord {
+    /// Size of the record including its payload and padding, zero marks the end of the ring
+    u32 size;
+    u32 payload_size;
+    std::chrono::microseconds timestamp;
+    const char* filename;
+    const char* function;
+    const char* format;
+    unsigned int line_num;
+    Class log_class;
+    Level log_level;
+};
+
+/**
+ * Lock-free ring holding the messages a thread logged while deferred formatting is enabled.
+ * The logging thread is the only producer and the backend thread the only consumer.
+ * Messages that don't fit are formatted and spilled to a locked list instead, and the following
+ * ones are spilled too until the consumer catches up, so they are all drained in order.
+ */
+class DeferredRing {
+public:
+    static constexpr std::size_t CAPACITY = 1024 * 1024;
+
+    /// Reserves a record with room for payload_size bytes.
+    /// Returns nullptr if the ring is full or spilling, the message has to be spilled then.
+    u8* Reserve(const DeferredRecord& header, std::size_t payload_size) {
+        if (is_spilling.load(std::memory_order_acquire)) {
+            return nullptr;
+        }
+        const std::size_t size =
+            Common::AlignUp(sizeof(DeferredRecord) + payload_size, alignof(DeferredRecord));
+        if (size > CAPACITY / 2) {
+            return nullptr;
+        }
+        u64 position = write_position.load(std::memory_order_relaxed);
+        std::size_t offset = position % CAPACITY;
+        const std::size_t space_to_end = CAPACITY - offset;
+        const std::size_t needed = size > space_to_end ? space_to_end + size : size;
+        if (position + needed - read_position.load(std::memory_order_acquire) > CAPACITY) {
+            return nullptr;
+        }
+        if (size > space_to_end) {
+            // Records are never split, skip the rest of the ring
+            const u32 end_marker = 0;
+            std::memcpy(buffer.data() + offset, &end_marker, sizeof(end_marker));
+            position += space_to_end;
+            offset = 0;
+        }
+        DeferredRecord record = header;
+        record.size = static_cast<u32>(size);
+        record.payload_size = static_cast<u32>(payload_size);
+        std::memcpy(buffer.data() + offset, &record, sizeof(record));
+        reserved_position = position + size;
+        return buffer.data() + offset + sizeof(DeferredRecord);
+    }
+
+    /// Publishes the last reserved record to the consumer.
+    void Commit() {
+        write_position.store(reserved_position, std::memory_order_release);
+    }
+
+    /// Queues a formatted message behind the ones in the ring.
+    void Spill(Entry entry) {
+        std::lock_guard lock{spill_mutex};
+        spilled_entries.push_back(std::move(entry));
+        is_spilling.store(true, std::memory_order_release);
+    }
+
+    /// Calls on_record with every published record and its payload, then on_spilled with every
+    /// spilled message, in the order they were logged.
+    template <typename RecordFunc, typename SpilledFunc>
+    void Drain(RecordFunc&& on_record, SpilledFunc&& on_spilled) {
+        // Holding the lock keeps the producer from spilling until the ring is drained, and the
+        // ring can't be written to while messages are spilled
+        std::lock_guard lock{spill_mutex};
+
+        u64 position = read_position.load(std::memory_order_relaxed);
+        const u64 end = write_position.load(std::memory_order_acquire);
+        while (position != end) {
+            const std::size_t offset = position % CAPACITY;
+            u32 size;
+            std::memcpy(&size, buffer.data() + offset, sizeof(size));
+            if (size == 0) {
+                position += CAPACITY - offset;
+                continue;
+            }
+            DeferredRecord record;
+            std::memcpy(&record, buffer.data() + offset, sizeof(record));
+            on_record(record, std::span<const u8>{buffer.data() + offset + sizeof(DeferredRecord),
+                                                  record.payload_size});
+            position += size;
+        }
+        read_position.store(position, std::memory_order_release);
+
+        for (Entry& entry : spilled_entries) {
+            on_spilled(std::move(entry));
+        }
+        spilled_entries.clear();
+        is_spilling.store(false, std::memory_order_release);
+    }
+
+    /// Marks the ring as no longer written to, its thread has exited.
+    void Orphan() {
+        is_orphaned.store(true, std::memory_order_release);
+    }
+
+    bool IsOrphaned() const {
+        return is_orphaned.load(std::memory_order_acquire);
+    }
+
+private:
+    std::vector<u8> buffer = std::vector<u8>(CAPACITY);
+    std::atomic<u64> write_position{};
+    std::atomic<u64> read_position{};
+    u64 reserved_position{};
+
+    std::mutex spill_mutex;
+    std::vector<Entry> spilled_entries;
+    std::atomic_bool is_spilling{};
+
+    std::atomic_bool is_orphaned{};
+};
+
+/// Owns the ring of a logging thread, orphaning it when the thread exits.
+struct ThreadRingHolder {
+    ~ThreadRingHolder() {
+        if (ring) {
+            ring->Orphan();
+        }
+    }
+
+    std::shared_ptr<DeferredRing> ring;
+};
+
+} // Anonymous namespace
+
 /**
  * Static state as a singleton.
  */
@@ -46,8 +194,50 @@ public:
 
     void PushEntry(Class log_class, Level log_level, const char* filename, unsigned int line_num,
                    const char* function, std::string message) {
-        message_queue.Push(
-            CreateEntry(log_class, log_level, filename, line_num, function, std::move(message)));
+        // Errors are queued even with deferred formatting, so they are written without waiting
+        // for the next poll of the rings
+        if (!deferred_formatting.load(std::memory_order_relaxed) || IsUrgent(log_level)) {
+            message_queue.Push(CreateEntry(log_class, log_level, filename, line_num, function,
+                                           std::move(message)));
+            return;
+        }
+
+        // Keep the message in order with the deferred messages of this thread
+        DeferredRing& ring = GetThreadRing();
+        u8* const dest = ring.Reserve(
+            CreateRecord(log_class, log_level, filename, line_num, function, nullptr),
+            message.size());
+        if (dest == nullptr) {
+            ring.Spill(CreateEntry(log_class, log_level, filename, line_num, function,
+                                   std::move(message)));
+            return;
+        }
+        std::memcpy(dest, message.data(), message.size());
+        ring.Commit();
+    }
+
+    u8* BeginDeferredMessage(Class log_class, Level log_level, const char* filename,
+                             unsigned int line_num, const char* function, const char* format,
+                             std::size_t args_size) {
+        if (!deferred_formatting.load(std::memory_order_relaxed) || IsUrgent(log_level) ||
+            !filter.CheckMessage(log_class, log_level)) {
+            return nullptr;
+        }
+        return GetThreadRing().Reserve(
+            CreateRecord(log_class, log_level, filename, line_num, function, format), args_size);
+    }
+
+    void EndDeferredMessage() {
+        GetThreadRing().Commit();
+    }
+
+    void SetDeferredFormatting(bool enabled) {
+        deferred_formatting.store(enabled, std::memory_order_relaxed);
+
+        // Queued directly to wake the backend thread up, so it starts or stops polling the rings
+        message_queue.Push(CreateEntry(
+            Class::Log, Level::Info, TrimSourcePath(__FILE__), __LINE__, __func__,
+            fmt::format("Deferred formatting {}", enabled ? "enabled" : "disabled")));
     }
 
     void AddBackend(std::unique_ptr<Backend> backend) {
@@ -81,21 +271,39 @@ public:
     }
 
 private:
+    /// Message waiting to be written, either a deferred record or a formatted entry
+    struct PendingMessage {
+        std::chrono::microseconds timestamp;
+        /// Index of the formatted entry in pending_entries, or NO_ENTRY for deferred records
+        std::size_t entry_index;
+        /// Deferred record, with its payload stored in deferred_data
+        DeferredRecord record;
+        std::size_t data_offset;
+    };
+
+    static constexpr std::size_t NO_ENTRY = ~std::size_t{0};
+
     Impl() {
         backend_thread = std::thread([&] {
             Entry entry;
-            auto write_logs = [&](Entry& e) {
-                std::lock_guard lock{writing_mutex};
-                for (const auto& backend : backends) {
-                    backend->Write(e);
-                }
-            };
             while (true) {
-                entry = message_queue.PopWait();
-                if (entry.final_entry) {
+                // Deferred messages are not queued, poll their rings while they're enabled
+                bool has_entry = true;
+                if (deferred_formatting.load(std::memory_order_relaxed)) {
+                    has_entry = message_queue.PopWait(entry, DEFERRED_POLL_INTERVAL);
+                } else {
+                    entry = message_queue.PopWait();
+                }
+                if (has_entry && entry.final_entry) {
                     break;
                 }
-                write_logs(entry);
+                if (has_entry) {
+                    // Collect first, so that the messages the thread deferred before queuing this
+                    // one stay ahead of it when their timestamps are equal
+                    CollectDeferredMessages();
+                    AddPendingEntry(std::move(entry));
+                }
+                WriteLogs();
             }
 
             // Drain the logging queue. Only writes out up to MAX_LOGS_TO_WRITE to prevent a case
@@ -103,8 +311,9 @@ private:
             const int MAX_LOGS_TO_WRITE = filter.IsDebug() ? INT_MAX : 100;
             int logs_written = 0;
             while (logs_written++ < MAX_LOGS_TO_WRITE && message_queue.Pop(entry)) {
-                write_logs(entry);
+                AddPendingEntry(std::move(entry));
             }
+            WriteLogs();
         });
     }
 
@@ -115,14 +324,23 @@ private:
         backend_thread.join();
     }
 
-    Entry CreateEntry(Class log_class, Level log_level, const char* filename, unsigned int line_nr,
-                      const char* function, std::string message) const {
+    /// Returns true if messages of the given level are written as soon as they are logged.
+    static bool IsUrgent(Level log_level) {
+        return log_level >= Level::Error;
+    }
+
+    std::chrono::microseconds GetTimestamp() const {
         using std::chrono::duration_cast;
         using std::chrono::microseconds;
         using std::chrono::steady_clock;
 
+        return duration_cast<microseconds>(steady_clock::now() - time_origin);
+    }
+
+    Entry CreateEntry(Class log_class, Level log_level, const char* filename, unsigned int line_nr,
+                      const char* function, std::string message) const {
         return {
-            .timestamp = duration_cast<microseconds>(steady_clock::now() - time_origin),
+            .timestamp = GetTimestamp(),
             .log_class = log_class,
             .log_level = log_level,
             .filename = filename,
@@ -133,12 +351,128 @@ private:
         };
     }
 
+    DeferredRecord CreateRecord(Class log_class, Level log_level, const char* filename,
+                                unsigned int line_num, const char* function,
+                                const char* format) const {
+        return {
+            .size = 0,
+            .payload_size = 0,
+            .timestamp = GetTimestamp(),
+            .filename = filename,
+            .function = function,
+            .format = format,
+            .line_num = line_num,
+            .log_class = log_class,
+            .log_level = log_level,
+        };
+    }
+
+    DeferredRing& GetThreadRing() {
+        thread_local ThreadRingHolder holder;
+        if (!holder.ring) {
+            holder.ring = std::make_shared<DeferredRing>();
+            std::lock_guard lock{rings_mutex};
+            rings.push_back(holder.ring);
+        }
+        return *holder.ring;
+    }
+
+    void AddPendingEntry(Entry&& entry) {
+        pending_messages.push_back({
+            .timestamp = entry.timestamp,
+            .entry_index = pending_entries.size(),
+            .record = {},
+            .data_offset = 0,
+        });
+        pending_entries.push_back(std::move(entry));
+    }
+
+    /// Copies the messages out of the deferred rings into the pending messages.
+    void CollectDeferredMessages() {
+        const auto on_record = [this](const DeferredRecord& record, std::span<const u8> payload) {
+            pending_messages.push_back({
+                .timestamp = record.timestamp,
+                .entry_index = NO_ENTRY,
+                .record = record,
+                .data_offset = deferred_data.size(),
+            });
+            deferred_data.insert(deferred_data.end(), payload.begin(), payload.end());
+        };
+        const auto on_spilled = [this](Entry&& entry) { AddPendingEntry(std::move(entry)); };
+
+        std::lock_guard lock{rings_mutex};
+        std::erase_if(rings, [&](const std::shared_ptr<DeferredRing>& ring) {
+            // Check before draining, the thread may log until it exits
+            const bool is_orphaned = ring->IsOrphaned();
+            ring->Drain(on_record, on_spilled);
+            return is_orphaned;
+        });
+    }
+
+    void WriteDeferred(const PendingMessage& message) {
+        const DeferredRecord& record = message.record;
+        const DeferredEntry entry{
+            .timestamp = record.timestamp,
+            .log_class = record.log_class,
+            .log_level = record.log_level,
+            .filename = record.filename,
+            .line_num = record.line_num,
+            .function = record.function,
+            .format = record.format,
+            .data = std::span<const u8>{deferred_data}.subspan(message.data_offset,
+                                                               record.payload_size),
+        };
+        // Format at most once, and only for the backends that can't take the message as is
+        std::optional<Entry> formatted;
+        for (const auto& backend : backends) {
+            if (backend->AcceptsDeferred()) {
+                backend->WriteDeferred(entry);
+                continue;
+            }
+            if (!formatted) {
+                formatted = entry.ToEntry();
+            }
+            backend->Write(*formatted);
+        }
+    }
+
+    /// Writes the pending messages along with the ones in the deferred rings, in the order they
+    /// were logged. The messages of a thread are collected in order, sorting keeps them so.
+    void WriteLogs() {
+        CollectDeferredMessages();
+        std::stable_sort(pending_messages.begin(), pending_messages.end(),
+                         [](const PendingMessage& lhs, const PendingMessage& rhs) {
+                             return lhs.timestamp < rhs.timestamp;
+                         });
+
+        std::lock_guard lock{writing_mutex};
+        for (const PendingMessage& message : pending_messages) {
+            if (message.entry_index == NO_ENTRY) {
+                WriteDeferred(message);
+                continue;
+            }
+            for (const auto& backend : backends) {
+                backend->Write(pending_entries[message.entry_index]);
+            }
+        }
+        pending_messages.clear();
+        pending_entries.clear();
+        deferred_data.clear();
+    }
+
     std::mutex writing_mutex;
     std::thread backend_thread;
     std::vector<std::unique_ptr<Backend>> backends;
     MPSCQueue<Entry> message_queue;
     Filter filter;
     std::chrono::steady_clock::time_point time_origin{std::chrono::steady_clock::now()};
+
+    std::atomic_bool deferred_formatting{};
+    std::mutex rings_mutex;
+    std::vector<std::shared_ptr<DeferredRing>> rings;
+    std::vector<PendingMessage> pending_messages;
+    std::vector<Entry> pending_entries;
+    std::vector<u8> deferred_data;
 };
 
 ConsoleBackend::~ConsoleBackend() = default;
@@ -190,6 +524,54 @@ void FileBackend::Write(const Entry& entry) {
     }
 }
 
+BinaryFileBackend::BinaryFileBackend(const std::filesystem::path& filename) {
+    auto old_filename = filename;
+    old_filename += ".old";
+
+    void(FS::RemoveFile(old_filename));
+    void(FS::RenameFile(filename, old_filename));
+
+    file = std::make_unique<FS::IOFile>(filename, FS::FileAccessMode::Write,
+                                        FS::FileType::BinaryFile);
+    writer = std::make_unique<BinaryLogWriter>();
+}
+
+BinaryFileBackend::~BinaryFileBackend() {
+    Flush();
+}
+
+void BinaryFileBackend::Write(const Entry& entry) {
+    writer->Write(entry);
+    FlushIfNeeded(entry.log_level);
+}
+
+void BinaryFileBackend::WriteDeferred(const DeferredEntry& entry) {
+    writer->Write(entry);
+    FlushIfNeeded(entry.log_level);
+}
+
+void BinaryFileBackend::FlushIfNeeded(Level log_level) {
+    constexpr std::size_t FLUSH_THRESHOLD = 64 * 1024;
+    if (writer->GetData().size() >= FLUSH_THRESHOLD || log_level >= Level::Error) {
+        Flush();
+    }
+}
+
+void BinaryFileBackend::Flush() {
+    // Same limits as the text log, the binary log is several times smaller for the same messages
+    constexpr std::size_t MAX_BYTES_WRITTEN = 100 * 1024 * 1024;
+    constexpr std::size_t MAX_BYTES_WRITTEN_EXTENDED = 1024 * 1024 * 1024;
+
+    const auto data = writer->GetData();
+    const std::size_t max_bytes =
+        Settings::values.extended_logging ? MAX_BYTES_WRITTEN_EXTENDED : MAX_BYTES_WRITTEN;
+    if (file->IsOpen() && bytes_written <= max_bytes) {
+        bytes_written += file->WriteSpan(data);
+        void(file->Flush());
+    }
+    writer->ClearData();
+}
+
 DebuggerBackend::~DebuggerBackend() = default;
 
 void DebuggerBackend::Write(const Entry& entry) {
@@ -214,6 +596,10 @@ Backend* GetBackend(std::string_view backend_name) {
     return Impl::Instance().GetBackend(backend_name);
 }
 
+void SetDeferredFormatting(bool enabled) {
+    Impl::Instance().SetDeferredFormatting(enabled);
+}
+
 void FmtLogMessageImpl(Class log_class, Level log_level, const char* filename,
                        unsigned int line_num, const char* function, const char* format,
                        const fmt::format_args& args) {
@@ -225,4 +611,15 @@ void FmtLogMessageImpl(Class log_class, Level log_level, const char* filename,
     instance.PushEntry(log_class, log_level, filename, line_num, function,
                        fmt::vformat(format, args));
 }
+
+u8* BeginDeferredMessage(Class log_class, Level log_level, const char* filename,
+                         unsigned int line_num, const char* function, const char* format,
+                         std::size_t args_size) {
+    return Impl::Instance().BeginDeferredMessage(log_class, log_level, filename, line_num,
+                                                 function, format, args_size);
+}
+
+void EndDeferredMessage() {
+    Impl::Instance().EndDeferredMessage();
+}
 } // namespace Common::Log
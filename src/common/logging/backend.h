@@ -17,6 +17,7 @@ class IOFile;
 
 namespace Common::Log {
 
+class BinaryLogWriter;
 class Filter;
 
 /**
@@ -33,6 +34,12 @@ public:
     virtual const char* GetName() const = 0;
     virtual void Write(const Entry& entry) = 0;
 
+    /// Whether the backend takes deferred messages as is, instead of formatted through Write.
+    virtual bool AcceptsDeferred() const {
+        return false;
+    }
+    virtual void WriteDeferred([[maybe_unused]] const DeferredEntry& entry) {}
+
 private:
     Filter filter;
 };
@@ -93,6 +100,39 @@ private:
     std::size_t bytes_written = 0;
 };
 
+/**
+ * Backend that writes the compact binary log format to a file passed into the constructor.
+ * Deferred messages are stored without formatting them, yuzu_log_decoder formats the log offline.
+ */
+class BinaryFileBackend : public Backend {
+public:
+    explicit BinaryFileBackend(const std::filesystem::path& filename);
+    ~BinaryFileBackend() override;
+
+    static const char* Name() {
+        return "binary_file";
+    }
+
+    const char* GetName() const override {
+        return Name();
+    }
+
+    void Write(const Entry& entry) override;
+
+    bool AcceptsDeferred() const override {
+        return true;
+    }
+    void WriteDeferred(const DeferredEntry& entry) override;
+
+private:
+    void FlushIfNeeded(Level log_level);
+    void Flush();
+
+    std::unique_ptr<FS::IOFile> file;
+    std::unique_ptr<BinaryLogWriter> writer;
+    std::size_t bytes_written = 0;
+};
+
 /**
  * Backend that writes to Visual Studio's output window
  */
@@ -121,4 +161,11 @@ Backend* GetBackend(std::string_view backend_name);
  * never get the message
  */
 void SetGlobalFilter(const Filter& filter);
+
+/**
+ * Enables or disables deferred formatting. While it's enabled, messages whose arguments are all
+ * trivially copyable are captured into a per-thread ring and formatted on the logging thread, or
+ * not at all when only binary backends are active.
+ */
+void SetDeferredFormatting(bool enabled);
 } // namespace Common::Log
\ No newline at end of file
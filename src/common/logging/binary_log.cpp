@@ -0,0 +1,192 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <array>
+#include <cstring>
+#include <deque>
+
+#include "common/logging/binary_log.h"
+
+namespace Common::Log {
+
+namespace {
+
+constexpr std::array<u8, 4> BINARY_LOG_MAGIC{'Y', 'Z', 'L', 'G'};
+constexpr u32 BINARY_LOG_VERSION = 1;
+
+/// Kinds of the records a binary log is made of
+enum class RecordKind : u8 {
+    String,  ///< Defines the string with the next id
+    Message, ///< Message with a format string id and encoded arguments
+    Text,    ///< Message formatted when it was logged
+};
+
+/// Reads values from a binary log, remembering whether it ran past the end of the data.
+class Reader {
+public:
+    explicit Reader(std::span<const u8> data_) : data{data_} {}
+
+    template <typename T>
+    T Get() {
+        T value{};
+        if (sizeof(T) > data.size() - offset) {
+            offset = data.size();
+            is_truncated = true;
+            return value;
+        }
+        std::memcpy(&value, data.data() + offset, sizeof(T));
+        offset += sizeof(T);
+        return value;
+    }
+
+    std::span<const u8> GetBytes(std::size_t size) {
+        if (size > data.size() - offset) {
+            offset = data.size();
+            is_truncated = true;
+            return {};
+        }
+        const std::span<const u8> bytes = data.subspan(offset, size);
+        offset += size;
+        return bytes;
+    }
+
+    bool IsEnd() const {
+        return offset == data.size();
+    }
+
+    bool IsTruncated() const {
+        return is_truncated;
+    }
+
+private:
+    std::span<const u8> data;
+    std::size_t offset = 0;
+    bool is_truncated = false;
+};
+
+} // Anonymous namespace
+
+BinaryLogWriter::BinaryLogWriter() {
+    buffer.insert(buffer.end(), BINARY_LOG_MAGIC.begin(), BINARY_LOG_MAGIC.end());
+    Put(BINARY_LOG_VERSION);
+}
+
+BinaryLogWriter::~BinaryLogWriter() = default;
+
+void BinaryLogWriter::Write(const DeferredEntry& entry) {
+    const u32 filename_id = InternLiteral(entry.filename);
+    const u32 function_id = InternLiteral(entry.function);
+    if (entry.format == nullptr) {
+        WriteHeader(static_cast<u8>(RecordKind::Text), entry.timestamp, entry.log_class,
+                    entry.log_level, entry.line_num, filename_id, function_id);
+    } else {
+        const u32 format_id = InternLiteral(entry.format);
+        WriteHeader(static_cast<u8>(RecordKind::Message), entry.timestamp, entry.log_class,
+                    entry.log_level, entry.line_num, filename_id, function_id);
+        Put(format_id);
+    }
+    Put(static_cast<u32>(entry.data.size()));
+    buffer.insert(buffer.end(), entry.data.begin(), entry.data.end());
+}
+
+void BinaryLogWriter::Write(const Entry& entry) {
+    const u32 filename_id = InternLiteral(entry.filename);
+    const u32 function_id = InternString(entry.function);
+    WriteHeader(static_cast<u8>(RecordKind::Text), entry.timestamp, entry.log_class,
+                entry.log_level, entry.line_num, filename_id, function_id);
+    Put(static_cast<u32>(entry.message.size()));
+    buffer.insert(buffer.end(), entry.message.begin(), entry.message.end());
+}
+
+u32 BinaryLogWriter::InternLiteral(const char* string) {
+    if (string == nullptr) {
+        string = "";
+    }
+    if (const auto it = literal_ids.find(string); it != literal_ids.end()) {
+        return it->second;
+    }
+    const u32 id = InternString(string);
+    literal_ids.emplace(string, id);
+    return id;
+}
+
+u32 BinaryLogWriter::InternString(std::string_view string) {
+    const auto [it, is_new] =
+        string_ids.try_emplace(std::string{string}, static_cast<u32>(string_ids.size()));
+    if (is_new) {
+        Put(static_cast<u8>(RecordKind::String));
+        Put(static_cast<u32>(string.size()));
+        buffer.insert(buffer.end(), string.begin(), string.end());
+    }
+    return it->second;
+}
+
+void BinaryLogWriter::WriteHeader(u8 kind, std::chrono::microseconds timestamp, Class log_class,
+                                  Level log_level, unsigned int line_num, u32 filename_id,
+                                  u32 function_id) {
+    Put(kind);
+    Put(static_cast<s64>(timestamp.count()));
+    Put(static_cast<u8>(log_class));
+    Put(static_cast<u8>(log_level));
+    Put(static_cast<u32>(line_num));
+    Put(filename_id);
+    Put(function_id);
+}
+
+bool DecodeBinaryLog(std::span<const u8> data, const std::function<void(const Entry&)>& callback) {
+    Reader reader{data};
+    const auto magic = reader.Get<std::array<u8, 4>>();
+    if (magic != BINARY_LOG_MAGIC || reader.Get<u32>() != BINARY_LOG_VERSION) {
+        return false;
+    }
+
+    // Deque elements are never relocated, so entries can point to the strings
+    std::deque<std::string> strings;
+    const auto get_string = [&strings](u32 id) -> const std::string* {
+        return id < strings.size() ? &strings[id] : nullptr;
+    };
+    while (!reader.IsEnd()) {
+        const auto kind = static_cast<RecordKind>(reader.Get<u8>());
+        if (kind == RecordKind::String) {
+            const auto bytes = reader.GetBytes(reader.Get<u32>());
+            strings.emplace_back(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+            continue;
+        }
+        if (kind != RecordKind::Message && kind != RecordKind::Text) {
+            return false;
+        }
+        const auto timestamp = std::chrono::microseconds{reader.Get<s64>()};
+        const auto log_class = static_cast<Class>(reader.Get<u8>());
+        const auto log_level = static_cast<Level>(reader.Get<u8>());
+        const u32 line_num = reader.Get<u32>();
+        const std::string* const filename = get_string(reader.Get<u32>());
+        const std::string* const function = get_string(reader.Get<u32>());
+        const std::string* format = nullptr;
+        if (kind == RecordKind::Message) {
+            format = get_string(reader.Get<u32>());
+            if (format == nullptr) {
+                return false;
+            }
+        }
+        const auto bytes = reader.GetBytes(reader.Get<u32>());
+        if (reader.IsTruncated() || filename == nullptr || function == nullptr ||
+            log_class >= Class::Count || log_level >= Level::Count) {
+            return false;
+        }
+        const DeferredEntry entry{
+            .timestamp = timestamp,
+            .log_class = log_class,
+            .log_level = log_level,
+            .filename = filename->c_str(),
+            .line_num = line_num,
+            .function = function->c_str(),
+            .format = format != nullptr ? format->c_str() : nullptr,
+            .data = bytes,
+        };
+        callback(entry.ToEntry());
+    }
+    return true;
+}
+
+} // namespace Common::Log
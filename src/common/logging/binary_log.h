@@ -0,0 +1,73 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <functional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "common/common_types.h"
+#include "common/logging/deferred.h"
+#include "common/logging/types.h"
+
+namespace Common::Log {
+
+/**
+ * Encodes log messages into the compact binary log format.
+ * Strings are written once and referenced by id afterwards, and deferred messages keep their
+ * arguments encoded, so the log can be formatted offline by DecodeBinaryLog.
+ */
+class BinaryLogWriter {
+public:
+    BinaryLogWriter();
+    ~BinaryLogWriter();
+
+    /// Writes a deferred message, its strings must have static storage like the ones captured
+    /// by the logging macros.
+    void Write(const DeferredEntry& entry);
+
+    /// Writes a formatted message.
+    void Write(const Entry& entry);
+
+    /// Returns the bytes encoded since the last call to ClearData.
+    std::span<const u8> GetData() const {
+        return buffer;
+    }
+
+    void ClearData() {
+        buffer.clear();
+    }
+
+private:
+    /// Returns the id of a string with static storage, keyed by address first to skip hashing.
+    u32 InternLiteral(const char* string);
+
+    /// Returns the id of a string, writing its definition the first time it's seen.
+    u32 InternString(std::string_view string);
+
+    void WriteHeader(u8 kind, std::chrono::microseconds timestamp, Class log_class,
+                     Level log_level, unsigned int line_num, u32 filename_id, u32 function_id);
+
+    template <typename T>
+    void Put(const T& value) {
+        const auto* const bytes = reinterpret_cast<const u8*>(&value);
+        buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+    }
+
+    std::vector<u8> buffer;
+    std::unordered_map<const char*, u32> literal_ids;
+    std::unordered_map<std::string, u32> string_ids;
+};
+
+/**
+ * Decodes a binary log written by BinaryLogWriter, calling callback with every entry in order.
+ * Returns false if the data is not a binary log or is truncated.
+ */
+bool DecodeBinaryLog(std::span<const u8> data, const std::function<void(const Entry&)>& callback);
+
+} // namespace Common::Log
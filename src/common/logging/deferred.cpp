@@ -0,0 +1,93 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <cstring>
+
+#include <fmt/args.h>
+#include <fmt/format.h>
+
+#include "common/logging/deferred.h"
+
+namespace Common::Log {
+
+namespace {
+
+template <typename T>
+T ReadValue(const u8* data) {
+    T value;
+    std::memcpy(&value, data, sizeof(T));
+    return value;
+}
+
+} // Anonymous namespace
+
+std::string FormatDeferredArgs(const char* format, std::span<const u8> args) {
+    fmt::dynamic_format_arg_store<fmt::format_context> store;
+    std::size_t offset = 0;
+    while (offset < args.size()) {
+        const auto type = static_cast<DeferredArgType>(args[offset++]);
+        const std::size_t size = Detail::GetDeferredArgValueSize(type);
+        if (size == 0 || size > args.size() - offset) {
+            return fmt::format("<malformed log arguments for \"{}\">", format);
+        }
+        const u8* const value = args.data() + offset;
+        offset += size;
+
+        switch (type) {
+        case DeferredArgType::Bool:
+            store.push_back(*value != 0);
+            break;
+        case DeferredArgType::Char:
+            store.push_back(ReadValue<char>(value));
+            break;
+        case DeferredArgType::S32:
+            store.push_back(ReadValue<s32>(value));
+            break;
+        case DeferredArgType::U32:
+            store.push_back(ReadValue<u32>(value));
+            break;
+        case DeferredArgType::S64:
+            store.push_back(ReadValue<s64>(value));
+            break;
+        case DeferredArgType::U64:
+            store.push_back(ReadValue<u64>(value));
+            break;
+        case DeferredArgType::Float:
+            store.push_back(ReadValue<float>(value));
+            break;
+        case DeferredArgType::Double:
+            store.push_back(ReadValue<double>(value));
+            break;
+        case DeferredArgType::Pointer:
+            store.push_back(reinterpret_cast<const void*>(ReadValue<uintptr_t>(value)));
+            break;
+        }
+    }
+    try {
+        return fmt::vformat(format, store);
+    } catch (const fmt::format_error& error) {
+        return fmt::format("<{} in \"{}\">", error.what(), format);
+    }
+}
+
+Entry DeferredEntry::ToEntry() const {
+    std::string message;
+    if (format != nullptr) {
+        message = FormatDeferredArgs(format, data);
+    } else {
+        message.assign(reinterpret_cast<const char*>(data.data()), data.size());
+    }
+    return {
+        .timestamp = timestamp,
+        .log_class = log_class,
+        .log_level = log_level,
+        .filename = filename,
+        .line_num = line_num,
+        .function = function,
+        .message = std::move(message),
+        .final_entry = false,
+    };
+}
+
+} // namespace Common::Log
@@ -0,0 +1,141 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <chrono>
+#include <cstring>
+#include <span>
+#include <string>
+#include <type_traits>
+
+#include "common/common_types.h"
+#include "common/logging/types.h"
+
+namespace Common::Log {
+
+/// Type tags of the arguments captured by log messages whose formatting is deferred.
+enum class DeferredArgType : u8 {
+    Bool,
+    Char,
+    S32,
+    U32,
+    S64,
+    U64,
+    Float,
+    Double,
+    Pointer,
+};
+
+/// Arguments that can be captured by value and formatted later on another thread.
+/// Strings and user types are excluded, their contents may not outlive the log call.
+template <typename T>
+constexpr bool IsDeferrableArg =
+    (std::is_arithmetic_v<T> && !std::is_same_v<T, long double>) ||
+    std::is_same_v<T, void*> || std::is_same_v<T, const void*>;
+
+namespace Detail {
+
+template <typename T>
+constexpr DeferredArgType GetDeferredArgType() {
+    if constexpr (std::is_same_v<T, bool>) {
+        return DeferredArgType::Bool;
+    } else if constexpr (std::is_same_v<T, char>) {
+        return DeferredArgType::Char;
+    } else if constexpr (std::is_floating_point_v<T>) {
+        return sizeof(T) == sizeof(float) ? DeferredArgType::Float : DeferredArgType::Double;
+    } else if constexpr (std::is_pointer_v<T>) {
+        return DeferredArgType::Pointer;
+    } else if constexpr (std::is_signed_v<T>) {
+        return sizeof(T) <= sizeof(s32) ? DeferredArgType::S32 : DeferredArgType::S64;
+    } else {
+        return sizeof(T) <= sizeof(u32) ? DeferredArgType::U32 : DeferredArgType::U64;
+    }
+}
+
+/// Returns the size of the value stored after the type tag of an argument.
+constexpr std::size_t GetDeferredArgValueSize(DeferredArgType type) {
+    switch (type) {
+    case DeferredArgType::Bool:
+    case DeferredArgType::Char:
+        return 1;
+    case DeferredArgType::S32:
+    case DeferredArgType::U32:
+    case DeferredArgType::Float:
+        return 4;
+    case DeferredArgType::S64:
+    case DeferredArgType::U64:
+    case DeferredArgType::Double:
+    case DeferredArgType::Pointer:
+        return 8;
+    }
+    return 0;
+}
+
+template <typename T>
+u8* EncodeDeferredArg(u8* dest, const T& value) {
+    static constexpr DeferredArgType type = GetDeferredArgType<T>();
+    *dest++ = static_cast<u8>(type);
+    if constexpr (type == DeferredArgType::Bool) {
+        *dest = value ? 1 : 0;
+    } else if constexpr (type == DeferredArgType::Char) {
+        std::memcpy(dest, &value, 1);
+    } else if constexpr (type == DeferredArgType::Float) {
+        const float converted = value;
+        std::memcpy(dest, &converted, sizeof(converted));
+    } else if constexpr (type == DeferredArgType::Double) {
+        const double converted = value;
+        std::memcpy(dest, &converted, sizeof(converted));
+    } else if constexpr (type == DeferredArgType::Pointer) {
+        const u64 converted = reinterpret_cast<uintptr_t>(value);
+        std::memcpy(dest, &converted, sizeof(converted));
+    } else if constexpr (type == DeferredArgType::S32 || type == DeferredArgType::U32) {
+        using Converted = std::conditional_t<std::is_signed_v<T>, s32, u32>;
+        const auto converted = static_cast<Converted>(value);
+        std::memcpy(dest, &converted, sizeof(converted));
+    } else {
+        using Converted = std::conditional_t<std::is_signed_v<T>, s64, u64>;
+        const auto converted = static_cast<Converted>(value);
+        std::memcpy(dest, &converted, sizeof(converted));
+    }
+    return dest + GetDeferredArgValueSize(type);
+}
+
+} // namespace Detail
+
+/// Size of the encoded arguments of a deferred log message.
+template <typename... Args>
+constexpr std::size_t DeferredArgsSize =
+    ((1 + Detail::GetDeferredArgValueSize(Detail::GetDeferredArgType<Args>())) + ... + 0);
+
+/// Encodes the arguments of a deferred log message, dest must hold DeferredArgsSize bytes.
+template <typename... Args>
+void EncodeDeferredArgs([[maybe_unused]] u8* dest, const Args&... args) {
+    ((dest = Detail::EncodeDeferredArg(dest, args)), ...);
+}
+
+/// Formats a message from its format string and encoded arguments.
+std::string FormatDeferredArgs(const char* format, std::span<const u8> args);
+
+/**
+ * A log message captured without formatting it. The strings are owned by the code that logged
+ * the message and the data by the logger, so the entry is only valid while it's being written.
+ */
+struct DeferredEntry {
+    std::chrono::microseconds timestamp;
+    Class log_class{};
+    Level log_level{};
+    const char* filename = nullptr;
+    unsigned int line_num = 0;
+    const char* function = nullptr;
+    /// Format string of the message, nullptr when the message was formatted on capture
+    const char* format = nullptr;
+    /// Encoded arguments, or the text of the message when format is nullptr
+    std::span<const u8> data;
+
+    /// Formats the message into a regular log entry.
+    Entry ToEntry() const;
+};
+
+} // namespace Common::Log
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <fmt/format.h>
+#include "common/logging/deferred.h"
 #include "common/logging/types.h"
 
 namespace Common::Log {
@@ -23,9 +24,32 @@ void FmtLogMessageImpl(Class log_class, Level log_level, const char* filename,
                        unsigned int line_num, const char* function, const char* format,
                        const fmt::format_args& args);
 
+/**
+ * Reserves space in the logging thread's ring for the encoded arguments of a message whose
+ * formatting is deferred. Returns nullptr if the message is filtered out, deferred formatting is
+ * disabled, the message is an error or worse, or the ring has no room. The caller then formats the
+ * message right away: errors wake the logging thread up, and messages that don't fit the ring are
+ * spilled behind it, so they are still written in order.
+ */
+u8* BeginDeferredMessage(Class log_class, Level log_level, const char* filename,
+                         unsigned int line_num, const char* function, const char* format,
+                         std::size_t args_size);
+
+/// Publishes the message reserved by the last successful call to BeginDeferredMessage.
+void EndDeferredMessage();
+
 template <typename... Args>
 void FmtLogMessage(Class log_class, Level log_level, const char* filename, unsigned int line_num,
                    const char* function, const char* format, const Args&... args) {
+    if constexpr ((IsDeferrableArg<Args> && ...)) {
+        u8* const dest = BeginDeferredMessage(log_class, log_level, filename, line_num, function,
+                                              format, DeferredArgsSize<Args...>);
+        if (dest != nullptr) {
+            EncodeDeferredArgs(dest, args...);
+            EndDeferredMessage();
+            return;
+        }
+    }
     FmtLogMessageImpl(log_class, log_level, filename, line_num, function, format,
                       fmt::make_format_args(args...));
 }
@@ -2,7 +2,10 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#pragma once
+
 #include <chrono>
+#include <string>
 
 #include "common/common_types.h"
 
@@ -5,3 +5,21 @@
 // Includes the MicroProfile implementation in this file for compilation
 #define MICROPROFILE_IMPL 1
 #include "common/microprofile.h"
+
+namespace Common {
+
+MicroProfileTimerName GetMicroProfileTimerName(MicroProfileToken token) {
+    const MicroProfile& state = *MicroProfileGet();
+    const MicroProfileTimerInfo& info = state.TimerInfo[MicroProfileGetTimerIndex(token)];
+    return {
+        .group = state.GroupInfo[info.nGroupIndex].pName,
+        .name = info.pName,
+    };
+}
+
+const char* GetMicroProfileThreadName() {
+    const MicroProfileThreadLog* const log = MicroProfileGetThreadLog();
+    return log != nullptr ? log->ThreadName : nullptr;
+}
+
+} // namespace Common
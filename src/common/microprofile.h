@@ -24,6 +24,53 @@ typedef void* HANDLE;
 
 #define MP_RGB(r, g, b) ((r) << 16 | (g) << 8 | (b) << 0)
 
+#if MICROPROFILE_ENABLED
+#include "common/trace_recorder.h"
+
+namespace Common {
+
+struct MicroProfileTimerName {
+    const char* group;
+    const char* name;
+};
+
+/// Returns the group and name a MicroProfile timer was defined with.
+MicroProfileTimerName GetMicroProfileTimerName(MicroProfileToken token);
+
+/// Returns the name the calling thread was registered with, or nullptr if it wasn't.
+const char* GetMicroProfileThreadName();
+
+/// MicroProfile scope that is also recorded by the trace recorder while it's running.
+class MicroProfileTraceScope {
+public:
+    explicit MicroProfileTraceScope(MicroProfileToken token_)
+        : token{token_}, tick{MicroProfileEnter(token)}, is_traced{Trace::IsRecording()},
+          start_ns{is_traced ? Trace::Now() : 0} {}
+
+    ~MicroProfileTraceScope() {
+        MicroProfileLeave(token, tick);
+        if (is_traced) {
+            Trace::RecordMicroProfileScope(token, start_ns, Trace::Now());
+        }
+    }
+
+    MicroProfileTraceScope(const MicroProfileTraceScope&) = delete;
+    MicroProfileTraceScope& operator=(const MicroProfileTraceScope&) = delete;
+
+private:
+    MicroProfileToken token;
+    u64 tick;
+    bool is_traced;
+    u64 start_ns;
+};
+
+} // namespace Common
+
+#undef MICROPROFILE_SCOPE
+#define MICROPROFILE_SCOPE(var)                                                                    \
+    Common::MicroProfileTraceScope MICROPROFILE_TOKEN_PASTE(foo, __LINE__)(g_mp_##var)
+#endif
+
 // On OS X, some Mach header included by MicroProfile defines these as macros, conflicting with
 // identifiers we use.
 #ifdef PAGE_SIZE
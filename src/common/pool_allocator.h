@@ -0,0 +1,168 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <new>
+
+#include "common/spin_lock.h"
+
+namespace Common {
+
+namespace detail {
+/// Number of blocks all pools took from the heap
+inline std::atomic<std::size_t> block_pool_heap_blocks{};
+} // namespace detail
+
+/// Returns the number of blocks all block pools took from the heap since the process started.
+[[nodiscard]] inline std::size_t GetBlockPoolHeapBlocks() {
+    return detail::block_pool_heap_blocks.load(std::memory_order_relaxed);
+}
+
+/**
+ * Fixed size block allocator for objects that are created and destroyed at a high rate.
+ *
+ * Every thread keeps its own free list, so allocating and freeing are a couple of pointer writes.
+ * Objects are often created on one thread and destroyed on another (e.g. requests handed to a
+ * service thread), so threads that free more blocks than they allocate hand batches of them over
+ * to a shared free list, where the allocating threads pick them up. Blocks are only taken from the
+ * heap when every free list is empty and they are never given back, so once the pool has grown to
+ * the peak number of live objects allocating from it doesn't touch the heap.
+ */
+template <std::size_t BlockSize, std::size_t Alignment>
+class BlockPool {
+public:
+    [[nodiscard]] static void* Allocate() {
+        ThreadCache& cache = GetThreadCache();
+        if (cache.head == nullptr) {
+            GetSharedList().TakeBatch(cache);
+        }
+        if (cache.head == nullptr) {
+            detail::block_pool_heap_blocks.fetch_add(1, std::memory_order_relaxed);
+            return ::operator new(BLOCK_SIZE, std::align_val_t{ALIGNMENT});
+        }
+        FreeBlock* const block = cache.head;
+        cache.head = block->next;
+        --cache.count;
+        return block;
+    }
+
+    static void Free(void* pointer) {
+        ThreadCache& cache = GetThreadCache();
+        cache.Push(static_cast<FreeBlock*>(pointer));
+        if (cache.count >= MAX_CACHED_BLOCKS) {
+            GetSharedList().GiveBatch(cache, BATCH_SIZE);
+        }
+    }
+
+private:
+    static constexpr std::size_t BATCH_SIZE = 32;
+    static constexpr std::size_t MAX_CACHED_BLOCKS = BATCH_SIZE * 2;
+
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    static constexpr std::size_t ALIGNMENT =
+        Alignment > alignof(FreeBlock) ? Alignment : alignof(FreeBlock);
+    static constexpr std::size_t BLOCK_SIZE =
+        ((BlockSize > sizeof(FreeBlock) ? BlockSize : sizeof(FreeBlock)) + ALIGNMENT - 1) &
+        ~(ALIGNMENT - 1);
+
+    struct ThreadCache;
+
+    struct SharedList {
+        /// Moves up to a batch of blocks to the given thread cache.
+        void TakeBatch(ThreadCache& cache) {
+            std::scoped_lock lock{mutex};
+            for (std::size_t i = 0; i < BATCH_SIZE && head != nullptr; ++i) {
+                FreeBlock* const block = head;
+                head = block->next;
+                cache.Push(block);
+            }
+        }
+
+        /// Moves the given number of blocks out of a thread cache.
+        void GiveBatch(ThreadCache& cache, std::size_t num_blocks) {
+            std::scoped_lock lock{mutex};
+            for (std::size_t i = 0; i < num_blocks && cache.head != nullptr; ++i) {
+                FreeBlock* const block = cache.head;
+                cache.head = block->next;
+                --cache.count;
+                block->next = head;
+                head = block;
+            }
+        }
+
+        SpinLock mutex;
+        FreeBlock* head = nullptr;
+    };
+
+    struct ThreadCache {
+        ~ThreadCache() {
+            // Keep the blocks of exiting threads for the threads that are still running
+            GetSharedList().GiveBatch(*this, count);
+        }
+
+        void Push(FreeBlock* block) {
+            block->next = head;
+            head = block;
+            ++count;
+        }
+
+        FreeBlock* head = nullptr;
+        std::size_t count = 0;
+    };
+
+    static SharedList& GetSharedList() {
+        // Never destroyed, thread caches may still return their blocks while exiting
+        static SharedList* const shared_list = new SharedList;
+        return *shared_list;
+    }
+
+    static ThreadCache& GetThreadCache() {
+        thread_local ThreadCache cache;
+        return cache;
+    }
+};
+
+/// Allocator handing out single objects from a BlockPool, e.g. for std::allocate_shared.
+template <typename T>
+class PoolAllocator {
+public:
+    using value_type = T;
+
+    PoolAllocator() noexcept = default;
+
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U>&) noexcept {}
+
+    [[nodiscard]] T* allocate(std::size_t n) {
+        if (n != 1) {
+            return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{alignof(T)}));
+        }
+        return static_cast<T*>(Pool::Allocate());
+    }
+
+    void deallocate(T* pointer, std::size_t n) noexcept {
+        if (n != 1) {
+            ::operator delete(pointer, std::align_val_t{alignof(T)});
+            return;
+        }
+        Pool::Free(pointer);
+    }
+
+    template <typename U>
+    friend bool operator==(const PoolAllocator&, const PoolAllocator<U>&) noexcept {
+        return true;
+    }
+
+private:
+    using Pool = BlockPool<sizeof(T), alignof(T)>;
+};
+
+} // namespace Common
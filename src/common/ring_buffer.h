@@ -10,6 +10,7 @@
 #include <cstddef>
 #include <cstring>
 #include <new>
+#include <span>
 #include <type_traits>
 #include <vector>
 #include "common/common_types.h"
@@ -37,6 +38,19 @@ public:
     /// @param slot_count  Number of slots to push
     /// @returns The number of slots actually pushed
     std::size_t Push(const void* new_slots, std::size_t slot_count) {
+        const char* in = static_cast<const char*>(new_slots);
+        return PushWith(slot_count, [in](std::span<T> first, std::span<T> second) {
+            std::memcpy(first.data(), in, first.size_bytes());
+            std::memcpy(second.data(), in + first.size_bytes(), second.size_bytes());
+        });
+    }
+
+    /// Pushes slots written in place, letting producers convert their data while copying it
+    /// @param slot_count  Number of slots to push
+    /// @param write       Called once with the two contiguous regions to fill, in order
+    /// @returns The number of slots actually pushed
+    template <typename Func>
+    std::size_t PushWith(std::size_t slot_count, Func&& write) {
         const std::size_t write_index = m_write_index.load();
         const std::size_t slots_free = capacity + m_read_index.load() - write_index;
         const std::size_t push_count = std::min(slot_count, slots_free);
@@ -45,10 +59,8 @@ public:
         const std::size_t first_copy = std::min(capacity - pos, push_count);
         const std::size_t second_copy = push_count - first_copy;
 
-        const char* in = static_cast<const char*>(new_slots);
-        std::memcpy(m_data.data() + pos, in, first_copy * slot_size);
-        in += first_copy * slot_size;
-        std::memcpy(m_data.data(), in, second_copy * slot_size);
+        write(std::span<T>(m_data.data() + pos, first_copy),
+              std::span<T>(m_data.data(), second_copy));
 
         m_write_index.store(write_index + push_count);
 
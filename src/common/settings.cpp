@@ -63,6 +63,7 @@ void LogSettings() {
     log_setting("Audio_OutputEngine", values.sink_id);
     log_setting("Audio_EnableAudioStretching", values.enable_audio_stretching.GetValue());
     log_setting("Audio_OutputDevice", values.audio_device_id);
+    log_setting("Audio_EnableParallelVoiceDecoding", values.enable_parallel_voice_decoding);
     log_setting("DataStorage_UseVirtualSd", values.use_virtual_sd);
     log_path("DataStorage_CacheDir", Common::FS::GetYuzuPath(Common::FS::YuzuPath::CacheDir));
     log_path("DataStorage_ConfigDir", Common::FS::GetYuzuPath(Common::FS::YuzuPath::ConfigDir));
@@ -20,6 +20,7 @@ namespace Settings {
 enum class RendererBackend : u32 {
     OpenGL = 0,
     Vulkan = 1,
+    Null = 2,
 };
 
 enum class GPUAccuracy : u32 {
@@ -110,6 +111,7 @@ struct Values {
     bool audio_muted;
     Setting<bool> enable_audio_stretching;
     Setting<float> volume;
+    bool enable_parallel_voice_decoding;
 
     // Core
     Setting<bool> use_multi_core;
@@ -219,6 +221,7 @@ struct Values {
     bool use_gdbstub;
     u16 gdbstub_port;
     std::string program_args;
+    std::string gpu_trace_path;
     bool dump_exefs;
     bool dump_nso;
     bool enable_fs_access_log;
@@ -226,6 +229,7 @@ struct Values {
     bool quest_flag;
     bool disable_macro_jit;
     bool extended_logging;
+    bool binary_logging;
     bool use_debug_asserts;
     bool use_auto_stub;
 
@@ -71,6 +71,7 @@ void AppendCPUInfo(FieldCollection& fc) {
     fc.AddField(FieldType::UserSystem, "CPU_Extension_x64_SSSE3", Common::GetCPUCaps().ssse3);
     fc.AddField(FieldType::UserSystem, "CPU_Extension_x64_SSE41", Common::GetCPUCaps().sse4_1);
     fc.AddField(FieldType::UserSystem, "CPU_Extension_x64_SSE42", Common::GetCPUCaps().sse4_2);
+    fc.AddField(FieldType::UserSystem, "CPU_Extension_x64_VAES", Common::GetCPUCaps().vaes);
 #else
     fc.AddField(FieldType::UserSystem, "CPU_Model", "Other");
 #endif
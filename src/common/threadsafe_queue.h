@@ -8,6 +8,7 @@
 // single reader, single writer queue
 
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <cstddef>
 #include <mutex>
@@ -97,6 +98,18 @@ public:
         return t;
     }
 
+    /// Waits up to timeout for an element, returns false if none was pushed in time.
+    template <typename Rep, typename Period>
+    bool PopWait(T& t, const std::chrono::duration<Rep, Period>& timeout) {
+        if (Empty()) {
+            std::unique_lock lock{cv_mutex};
+            if (!cv.wait_for(lock, timeout, [this]() { return !Empty(); })) {
+                return false;
+            }
+        }
+        return Pop(t);
+    }
+
     // not thread-safe
     void Clear() {
         size.store(0);
@@ -168,6 +181,11 @@ public:
         return spsc_queue.PopWait();
     }
 
+    template <typename Rep, typename Period>
+    bool PopWait(T& t, const std::chrono::duration<Rep, Period>& timeout) {
+        return spsc_queue.PopWait(t, timeout);
+    }
+
     // not thread-safe
     void Clear() {
         spsc_queue.Clear();
@@ -0,0 +1,404 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <chrono>
+#include <condition_variable>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "common/fs/file.h"
+#include "common/logging/log.h"
+#include "common/microprofile.h"
+#include "common/thread.h"
+#include "common/trace_recorder.h"
+
+namespace Common::Trace {
+
+namespace Detail {
+std::atomic_bool is_recording{};
+}
+
+namespace {
+
+/// Events each thread can hold before new ones are dropped
+constexpr std::size_t RING_CAPACITY = 1 << 15;
+
+/// How often the pending events are streamed to the file
+constexpr std::chrono::milliseconds WRITE_INTERVAL{100};
+
+enum class EventType : u8 {
+    Scope,
+    MicroProfileScope,
+    Instant,
+};
+
+struct Event {
+    EventType type;
+    u64 timestamp;
+    /// End time of scopes, argument of instants
+    u64 value;
+    u64 token;
+    const char* category;
+    const char* name;
+    const char* arg_name;
+};
+
+/// Ring of the events recorded by a thread, it's the only producer and the writer the only consumer
+class EventRing {
+public:
+    explicit EventRing(u32 thread_id_, std::string thread_name_)
+        : thread_id{thread_id_}, thread_name{std::move(thread_name_)} {}
+
+    void Push(const Event& event) {
+        const u64 position = write_position.load(std::memory_order_relaxed);
+        if (position - read_position.load(std::memory_order_acquire) == RING_CAPACITY) {
+            dropped_events.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        events[position % RING_CAPACITY] = event;
+        write_position.store(position + 1, std::memory_order_release);
+    }
+
+    template <typename Func>
+    void Drain(Func&& func) {
+        u64 position = read_position.load(std::memory_order_relaxed);
+        const u64 end = write_position.load(std::memory_order_acquire);
+        for (; position != end; ++position) {
+            func(events[position % RING_CAPACITY]);
+        }
+        read_position.store(position, std::memory_order_release);
+    }
+
+    /// Returns and resets the number of events dropped because the ring was full.
+    u64 TakeDroppedEvents() {
+        return dropped_events.exchange(0, std::memory_order_relaxed);
+    }
+
+    void Orphan() {
+        is_orphaned.store(true, std::memory_order_release);
+    }
+
+    bool IsOrphaned() const {
+        return is_orphaned.load(std::memory_order_acquire);
+    }
+
+    u32 GetThreadId() const {
+        return thread_id;
+    }
+
+    const std::string& GetThreadName() const {
+        return thread_name;
+    }
+
+    /// Whether the thread name was written to the current trace, only used by the writer
+    bool is_described = false;
+
+private:
+    const u32 thread_id;
+    const std::string thread_name;
+    std::vector<Event> events = std::vector<Event>(RING_CAPACITY);
+    std::atomic<u64> write_position{};
+    std::atomic<u64> read_position{};
+    std::atomic<u64> dropped_events{};
+    std::atomic_bool is_orphaned{};
+};
+
+/// Owns the ring of a recording thread, orphaning it when the thread exits.
+struct ThreadRingHolder {
+    ~ThreadRingHolder() {
+        if (ring) {
+            ring->Orphan();
+        }
+    }
+
+    std::shared_ptr<EventRing> ring;
+};
+
+/// Appends a JSON string literal, escaping the characters that need it.
+void AppendString(std::string& out, std::string_view string) {
+    out += '"';
+    for (const char c : string) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            fmt::format_to(std::back_inserter(out), "\\u{:04x}", static_cast<int>(c));
+        } else {
+            out += c;
+        }
+    }
+    out += '"';
+}
+
+class Recorder {
+public:
+    static Recorder& Instance() {
+        static Recorder recorder;
+        return recorder;
+    }
+
+    ~Recorder() {
+        Stop();
+    }
+
+    bool Start(const std::filesystem::path& path) {
+        std::lock_guard lock{control_mutex};
+        if (file) {
+            LOG_ERROR(Common, "A trace is already being recorded");
+            return false;
+        }
+        file = std::make_unique<FS::IOFile>(path, FS::FileAccessMode::Write,
+                                            FS::FileType::TextFile);
+        if (!file->IsOpen()) {
+            LOG_ERROR(Common, "Failed to create trace file");
+            file.reset();
+            return false;
+        }
+        {
+            std::lock_guard rings_lock{rings_mutex};
+            for (const auto& ring : rings) {
+                // Throw away the events recorded after the previous trace was stopped
+                ring->Drain([](const Event&) {});
+                ring->TakeDroppedEvents();
+                ring->is_described = false;
+            }
+        }
+        buffer = "[\n";
+        is_first_event = true;
+        total_events = 0;
+        total_dropped_events = 0;
+        stop_requested = false;
+        writer_thread = std::thread([this] { WriterLoop(); });
+        Detail::is_recording.store(true, std::memory_order_relaxed);
+        return true;
+    }
+
+    void Stop() {
+        std::lock_guard lock{control_mutex};
+        if (!file) {
+            return;
+        }
+        Detail::is_recording.store(false, std::memory_order_relaxed);
+        {
+            std::lock_guard stop_lock{stop_mutex};
+            stop_requested = true;
+        }
+        stop_cv.notify_one();
+        writer_thread.join();
+
+        WritePendingEvents();
+        buffer += "\n]\n";
+        FlushBuffer();
+        file.reset();
+
+        LOG_INFO(Common, "Recorded {} trace events, dropped {} because the buffers were full",
+                 total_events, total_dropped_events);
+    }
+
+    const char* InternName(std::string_view name) {
+        std::lock_guard lock{names_mutex};
+        return names.emplace(name).first->c_str();
+    }
+
+    void Push(const Event& event) {
+        if (IsRecording()) {
+            GetThreadRing().Push(event);
+        }
+    }
+
+private:
+    Recorder() = default;
+
+    EventRing& GetThreadRing() {
+        thread_local ThreadRingHolder holder;
+        if (!holder.ring) {
+            std::string thread_name;
+#if MICROPROFILE_ENABLED
+            if (const char* const name = GetMicroProfileThreadName()) {
+                thread_name = name;
+            }
+#endif
+            std::lock_guard lock{rings_mutex};
+            const u32 thread_id = next_thread_id++;
+            if (thread_name.empty()) {
+                thread_name = fmt::format("Thread {}", thread_id);
+            }
+            holder.ring = std::make_shared<EventRing>(thread_id, std::move(thread_name));
+            rings.push_back(holder.ring);
+        }
+        return *holder.ring;
+    }
+
+    void WriterLoop() {
+        SetCurrentThreadName("yuzu:TraceRecorder");
+        std::unique_lock lock{stop_mutex};
+        while (!stop_cv.wait_for(lock, WRITE_INTERVAL, [this] { return stop_requested; })) {
+            WritePendingEvents();
+        }
+    }
+
+    void WritePendingEvents() {
+        {
+            std::lock_guard lock{rings_mutex};
+            std::erase_if(rings, [this](const std::shared_ptr<EventRing>& ring) {
+                // Check before draining, the thread may record events until it exits
+                const bool is_orphaned = ring->IsOrphaned();
+                WriteRing(*ring);
+                return is_orphaned;
+            });
+        }
+        FlushBuffer();
+    }
+
+    void WriteRing(EventRing& ring) {
+        const u32 tid = ring.GetThreadId();
+        ring.Drain([this, tid](const Event& event) { WriteEvent(event, tid); });
+        total_dropped_events += ring.TakeDroppedEvents();
+
+        if (!ring.is_described) {
+            ring.is_described = true;
+            BeginEvent();
+            buffer += R"({"name":"thread_name","ph":"M","pid":1,"tid":)";
+            fmt::format_to(std::back_inserter(buffer), "{}", tid);
+            buffer += R"(,"args":{"name":)";
+            AppendString(buffer, ring.GetThreadName());
+            buffer += "}}";
+        }
+    }
+
+    void WriteEvent(const Event& event, u32 tid) {
+        const char* category = event.category;
+        const char* name = event.name;
+#if MICROPROFILE_ENABLED
+        if (event.type == EventType::MicroProfileScope) {
+            const MicroProfileTimerName timer_name = GetMicroProfileTimerName(event.token);
+            category = timer_name.group;
+            name = timer_name.name;
+        }
+#endif
+        ++total_events;
+        BeginEvent();
+        buffer += R"({"name":)";
+        AppendString(buffer, name);
+        buffer += R"(,"cat":)";
+        AppendString(buffer, category);
+
+        const double timestamp_us = static_cast<double>(event.timestamp) / 1000.0;
+        if (event.type == EventType::Instant) {
+            fmt::format_to(std::back_inserter(buffer),
+                           R"(,"ph":"i","s":"t","ts":{:.3f},"pid":1,"tid":{})", timestamp_us,
+                           tid);
+            if (event.arg_name != nullptr) {
+                buffer += R"(,"args":{)";
+                AppendString(buffer, event.arg_name);
+                fmt::format_to(std::back_inserter(buffer), ":{}}}", event.value);
+            }
+        } else {
+            const double duration_us = static_cast<double>(event.value - event.timestamp) / 1000.0;
+            fmt::format_to(std::back_inserter(buffer),
+                           R"(,"ph":"X","ts":{:.3f},"dur":{:.3f},"pid":1,"tid":{})", timestamp_us,
+                           duration_us, tid);
+        }
+        buffer += '}';
+    }
+
+    void BeginEvent() {
+        if (!is_first_event) {
+            buffer += ",\n";
+        }
+        is_first_event = false;
+    }
+
+    void FlushBuffer() {
+        void(file->WriteString(buffer));
+        buffer.clear();
+    }
+
+    std::mutex control_mutex;
+    std::unique_ptr<FS::IOFile> file;
+    std::thread writer_thread;
+
+    std::mutex stop_mutex;
+    std::condition_variable stop_cv;
+    bool stop_requested = false;
+
+    std::mutex rings_mutex;
+    std::vector<std::shared_ptr<EventRing>> rings;
+    u32 next_thread_id = 1;
+
+    std::mutex names_mutex;
+    std::unordered_set<std::string> names;
+
+    /// Only used by the writer thread while recording
+    std::string buffer;
+    bool is_first_event = true;
+    u64 total_events = 0;
+    u64 total_dropped_events = 0;
+};
+
+} // Anonymous namespace
+
+u64 Now() {
+    static const auto time_origin = std::chrono::steady_clock::now();
+    return static_cast<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                std::chrono::steady_clock::now() - time_origin)
+                                .count());
+}
+
+bool Start(const std::filesystem::path& path) {
+    return Recorder::Instance().Start(path);
+}
+
+void Stop() {
+    Recorder::Instance().Stop();
+}
+
+const char* InternName(std::string_view name) {
+    return Recorder::Instance().InternName(name);
+}
+
+void RecordScope(const char* category, const char* name, u64 start_ns, u64 end_ns) {
+    Recorder::Instance().Push({
+        .type = EventType::Scope,
+        .timestamp = start_ns,
+        .value = end_ns,
+        .token = 0,
+        .category = category,
+        .name = name,
+        .arg_name = nullptr,
+    });
+}
+
+void RecordMicroProfileScope(u64 token, u64 start_ns, u64 end_ns) {
+    Recorder::Instance().Push({
+        .type = EventType::MicroProfileScope,
+        .timestamp = start_ns,
+        .value = end_ns,
+        .token = token,
+        .category = nullptr,
+        .name = nullptr,
+        .arg_name = nullptr,
+    });
+}
+
+void RecordInstant(const char* category, const char* name, const char* arg_name, u64 arg) {
+    Recorder::Instance().Push({
+        .type = EventType::Instant,
+        .timestamp = Now(),
+        .value = arg,
+        .token = 0,
+        .category = category,
+        .name = name,
+        .arg_name = arg_name,
+    });
+}
+
+} // namespace Common::Trace
@@ -0,0 +1,53 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <atomic>
+#include <filesystem>
+#include <string_view>
+
+#include "common/common_types.h"
+
+/**
+ * Records timeline events into a Chrome trace event JSON file, which can be loaded in Perfetto or
+ * chrome://tracing. Every thread records into its own bounded ring, events are dropped instead of
+ * blocking when a ring is full. A background thread streams the rings to the file, so recording
+ * can stay on for long sessions.
+ */
+namespace Common::Trace {
+
+namespace Detail {
+extern std::atomic_bool is_recording;
+}
+
+/// Returns whether a trace is being recorded, cheap enough to be checked on hot paths.
+inline bool IsRecording() {
+    return Detail::is_recording.load(std::memory_order_relaxed);
+}
+
+/// Returns the current time in nanoseconds, as used by the recorded events.
+u64 Now();
+
+/// Starts recording to the given file. Returns false if it can't be created.
+bool Start(const std::filesystem::path& path);
+
+/// Stops recording, writing out the pending events and closing the file.
+void Stop();
+
+/// Returns a copy of the string with static storage, for names that don't have one. It takes a
+/// lock, so names are meant to be interned once up front rather than for every event.
+const char* InternName(std::string_view name);
+
+/// Records a span of time. The strings must have static storage.
+void RecordScope(const char* category, const char* name, u64 start_ns, u64 end_ns);
+
+/// Records a MicroProfile scope, its group and name are looked up when writing the trace.
+void RecordMicroProfileScope(u64 token, u64 start_ns, u64 end_ns);
+
+/// Records a point in time with an optional value. The strings must have static storage.
+void RecordInstant(const char* category, const char* name, const char* arg_name = nullptr,
+                   u64 arg = 0);
+
+} // namespace Common::Trace
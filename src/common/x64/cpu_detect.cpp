@@ -134,6 +134,9 @@ static CPUCaps Detect() {
                 (cpu_id[1] >> 17) & 1 && (cpu_id[1] >> 30) & 1) {
                 caps.avx512 = caps.avx2;
             }
+            // 256-bit VAES needs the AVX state to be enabled as well
+            if ((cpu_id[2] >> 9) & 1)
+                caps.vaes = caps.avx2 && caps.aes;
         }
     }
 
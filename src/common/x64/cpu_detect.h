@@ -33,6 +33,7 @@ struct CPUCaps {
     bool fma;
     bool fma4;
     bool aes;
+    bool vaes;
     bool invariant_tsc;
     u32 base_frequency;
     u32 max_frequency;
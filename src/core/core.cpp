@@ -25,6 +25,7 @@
 #include "core/file_sys/romfs_factory.h"
 #include "core/file_sys/savedata_factory.h"
 #include "core/file_sys/sdmc_factory.h"
+#include "core/file_sys/vfs_cached.h"
 #include "core/file_sys/vfs_concat.h"
 #include "core/file_sys/vfs_real.h"
 #include "core/hardware_interrupt_manager.h"
@@ -298,6 +299,13 @@ struct System::Impl {
                                         perf_stats->GetMeanFrametime());
         }
 
+        auto& block_cache = FileSys::BlockCache::Shared();
+        const auto cache_stats = block_cache.GetStats();
+        LOG_INFO(Core, "VFS block cache: {} hits, {} misses ({:.1f}% hit rate), {} read ahead",
+                 cache_stats.hits, cache_stats.misses, cache_stats.HitRate() * 100.0,
+                 cache_stats.read_ahead_blocks);
+        block_cache.ResetStats();
+
         is_powered_on = false;
         exit_lock = false;
 
@@ -463,6 +471,21 @@ System::ResultStatus System::Load(Frontend::EmuWindow& emu_window, const std::st
     return impl->Load(*this, emu_window, filepath, program_index);
 }
 
+void System::BootHeadlessGPU(std::unique_ptr<Tegra::GPU> gpu) {
+    impl->device_memory = std::make_unique<Core::DeviceMemory>();
+    impl->gpu_core = std::move(gpu);
+    impl->is_powered_on = true;
+}
+
+void System::ShutdownHeadlessGPU() {
+    impl->is_powered_on = false;
+    if (impl->gpu_core) {
+        impl->gpu_core->ShutDown();
+    }
+    impl->gpu_core.reset();
+    impl->device_memory.reset();
+}
+
 bool System::IsPoweredOn() const {
     return impl->is_powered_on.load(std::memory_order::relaxed);
 }
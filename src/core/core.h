@@ -177,6 +177,17 @@ public:
     [[nodiscard]] ResultStatus Load(Frontend::EmuWindow& emu_window, const std::string& filepath,
                                     std::size_t program_index = 0);
 
+    /**
+     * Powers on the system with only the given GPU and the device memory, nothing else is
+     * initialized and no application is loaded. Used by tools that replay recorded GPU command
+     * lists, they back guest memory with their own page table.
+     * @param gpu GPU driven by the caller, its renderer must already be bound.
+     */
+    void BootHeadlessGPU(std::unique_ptr<Tegra::GPU> gpu);
+
+    /// Powers off a system booted with BootHeadlessGPU and destroys its GPU and device memory.
+    void ShutdownHeadlessGPU();
+
     /**
      * Indicates if the emulated system is powered on (all subsystems initialized and able to run an
      * application).
@@ -2,12 +2,11 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
-#include <algorithm>
 #include <mutex>
 #include <string>
-#include <tuple>
 
 #include "common/microprofile.h"
+#include "common/trace_recorder.h"
 #include "core/core_timing.h"
 #include "core/core_timing_util.h"
 #include "core/hardware_properties.h"
@@ -20,23 +19,6 @@ std::shared_ptr<EventType> CreateEvent(std::string name, TimedCallback&& callbac
     return std::make_shared<EventType>(std::move(callback), std::move(name));
 }
 
-struct CoreTiming::Event {
-    u64 time;
-    u64 fifo_order;
-    std::uintptr_t user_data;
-    std::weak_ptr<EventType> type;
-
-    // Sort by time, unless the times are the same, in which case sort by
-    // the order added to the queue
-    friend bool operator>(const Event& left, const Event& right) {
-        return std::tie(left.time, left.fifo_order) > std::tie(right.time, right.fifo_order);
-    }
-
-    friend bool operator<(const Event& left, const Event& right) {
-        return std::tie(left.time, left.fifo_order) < std::tie(right.time, right.fifo_order);
-    }
-};
-
 CoreTiming::CoreTiming()
     : clock{Common::CreateBestMatchingClock(Hardware::BASE_CLOCK_RATE, Hardware::CNTFREQ)} {}
 
@@ -102,7 +84,7 @@ bool CoreTiming::IsRunning() const {
 }
 
 bool CoreTiming::HasPendingEvents() const {
-    return !(wait_set && event_queue.empty());
+    return !(wait_set && event_queue.Empty());
 }
 
 void CoreTiming::ScheduleEvent(std::chrono::nanoseconds ns_into_future,
@@ -111,10 +93,7 @@ void CoreTiming::ScheduleEvent(std::chrono::nanoseconds ns_into_future,
     {
         std::scoped_lock scope{basic_lock};
         const u64 timeout = static_cast<u64>((GetGlobalTimeNs() + ns_into_future).count());
-
-        event_queue.emplace_back(Event{timeout, event_fifo_id++, user_data, event_type});
-
-        std::push_heap(event_queue.begin(), event_queue.end(), std::greater<>());
+        event_queue.Schedule(timeout, event_fifo_id++, event_type, user_data);
     }
     event.Set();
 }
@@ -122,15 +101,7 @@ void CoreTiming::ScheduleEvent(std::chrono::nanoseconds ns_into_future,
 void CoreTiming::UnscheduleEvent(const std::shared_ptr<EventType>& event_type,
                                  std::uintptr_t user_data) {
     std::scoped_lock scope{basic_lock};
-    const auto itr = std::remove_if(event_queue.begin(), event_queue.end(), [&](const Event& e) {
-        return e.type.lock().get() == event_type.get() && e.user_data == user_data;
-    });
-
-    // Removing random items breaks the invariant so we have to re-establish it.
-    if (itr != event_queue.end()) {
-        event_queue.erase(itr, event_queue.end());
-        std::make_heap(event_queue.begin(), event_queue.end(), std::greater<>());
-    }
+    event_queue.Unschedule(event_type.get(), user_data);
 }
 
 void CoreTiming::AddTicks(u64 ticks_to_add) {
@@ -139,9 +110,13 @@ void CoreTiming::AddTicks(u64 ticks_to_add) {
 }
 
 void CoreTiming::Idle() {
-    if (!event_queue.empty()) {
-        const u64 next_event_time = event_queue.front().time;
-        const u64 next_ticks = nsToCycles(std::chrono::nanoseconds(next_event_time)) + 10U;
+    std::optional<u64> next_event_time;
+    {
+        std::scoped_lock lock{basic_lock};
+        next_event_time = event_queue.NextTime();
+    }
+    if (next_event_time) {
+        const u64 next_ticks = nsToCycles(std::chrono::nanoseconds(*next_event_time)) + 10U;
         if (next_ticks > ticks) {
             ticks = next_ticks;
         }
@@ -169,44 +144,38 @@ u64 CoreTiming::GetClockTicks() const {
 }
 
 void CoreTiming::ClearPendingEvents() {
-    event_queue.clear();
+    event_queue.Clear();
 }
 
 void CoreTiming::RemoveEvent(const std::shared_ptr<EventType>& event_type) {
     std::scoped_lock lock{basic_lock};
-
-    const auto itr = std::remove_if(event_queue.begin(), event_queue.end(), [&](const Event& e) {
-        return e.type.lock().get() == event_type.get();
-    });
-
-    // Removing random items breaks the invariant so we have to re-establish it.
-    if (itr != event_queue.end()) {
-        event_queue.erase(itr, event_queue.end());
-        std::make_heap(event_queue.begin(), event_queue.end(), std::greater<>());
-    }
+    event_queue.Remove(event_type.get());
 }
 
 std::optional<s64> CoreTiming::Advance() {
     std::scoped_lock lock{advance_lock, basic_lock};
     global_timer = GetGlobalTimeNs().count();
 
-    while (!event_queue.empty() && event_queue.front().time <= global_timer) {
-        Event evt = std::move(event_queue.front());
-        std::pop_heap(event_queue.begin(), event_queue.end(), std::greater<>());
-        event_queue.pop_back();
+    while (auto evt = event_queue.PopDue(global_timer)) {
         basic_lock.unlock();
 
-        if (const auto event_type{evt.type.lock()}) {
-            event_type->callback(
-                evt.user_data, std::chrono::nanoseconds{static_cast<s64>(global_timer - evt.time)});
+        if (const auto event_type{evt->type.lock()}) {
+            const bool is_traced = Common::Trace::IsRecording();
+            const u64 trace_start = is_traced ? Common::Trace::Now() : 0;
+            event_type->callback(evt->user_data, std::chrono::nanoseconds{
+                                                     static_cast<s64>(global_timer - evt->time)});
+            if (is_traced) {
+                Common::Trace::RecordScope("core_timing", event_type->trace_name, trace_start,
+                                           Common::Trace::Now());
+            }
         }
 
         basic_lock.lock();
         global_timer = GetGlobalTimeNs().count();
     }
 
-    if (!event_queue.empty()) {
-        const s64 next_time = event_queue.front().time - global_timer;
+    if (const auto next_event_time = event_queue.NextTime()) {
+        const s64 next_time = *next_event_time - global_timer;
         return next_time;
     } else {
         return std::nullopt;
@@ -17,7 +17,9 @@
 #include "common/common_types.h"
 #include "common/spin_lock.h"
 #include "common/thread.h"
+#include "common/trace_recorder.h"
 #include "common/wall_clock.h"
+#include "core/core_timing_wheel.h"
 
 namespace Core::Timing {
 
@@ -28,12 +30,15 @@ using TimedCallback =
 /// Contains the characteristics of a particular event.
 struct EventType {
     explicit EventType(TimedCallback&& callback_, std::string&& name_)
-        : callback{std::move(callback_)}, name{std::move(name_)} {}
+        : callback{std::move(callback_)}, name{std::move(name_)},
+          trace_name{Common::Trace::InternName(name)} {}
 
     /// The event's callback function.
     TimedCallback callback;
     /// A pointer to the name of the event.
     const std::string name;
+    /// Copy of the name that outlives the event, for the traces that record its callbacks.
+    const char* const trace_name;
 };
 
 /**
@@ -128,8 +133,6 @@ public:
     std::optional<s64> Advance();
 
 private:
-    struct Event;
-
     /// Clear all pending events. This should ONLY be done on exit.
     void ClearPendingEvents();
 
@@ -140,11 +143,9 @@ private:
 
     u64 global_timer = 0;
 
-    // The queue is a min-heap using std::make_heap/push_heap/pop_heap.
-    // We don't use std::priority_queue because we need to be able to serialize, unserialize and
-    // erase arbitrary events (RemoveEvent()) regardless of the queue order. These aren't
-    // accomodated by the standard adaptor class.
-    std::vector<Event> event_queue;
+    // Events are kept in a timing wheel, scheduling and unscheduling them is constant time even
+    // with many pending events, which timer heavy titles and the kernel's timeouts create.
+    TimingWheel event_queue;
     u64 event_fifo_id = 0;
 
     std::shared_ptr<EventType> ev_lost;
@@ -0,0 +1,272 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <bit>
+#include <functional>
+#include <tuple>
+
+#include "common/assert.h"
+#include "core/core_timing_wheel.h"
+
+namespace Core::Timing {
+
+std::size_t TimingWheel::KeyHash::operator()(const Key& key) const noexcept {
+    const std::size_t type_hash = std::hash<const EventType*>{}(key.type);
+    const std::size_t data_hash = std::hash<std::uintptr_t>{}(key.user_data);
+    return type_hash ^ (data_hash + 0x9e3779b9 + (type_hash << 6) + (type_hash >> 2));
+}
+
+TimingWheel::TimingWheel() {
+    for (Level& level : levels) {
+        level.heads.fill(INVALID_NODE);
+    }
+}
+
+TimingWheel::~TimingWheel() = default;
+
+void TimingWheel::Schedule(u64 time, u64 fifo_order, const std::shared_ptr<EventType>& event_type,
+                           std::uintptr_t user_data) {
+    const u32 index = AllocateNode();
+    Node& node = nodes[index];
+    node.event = Event{time, fifo_order, user_data, event_type};
+    node.type_key = event_type.get();
+    LinkKey(index);
+    Insert(index);
+    ++size;
+}
+
+void TimingWheel::Unschedule(const EventType* event_type, std::uintptr_t user_data) {
+    const auto it = key_heads.find(Key{event_type, user_data});
+    if (it == key_heads.end()) {
+        return;
+    }
+    u32 index = it->second;
+    key_heads.erase(it);
+    while (index != INVALID_NODE) {
+        const u32 next = nodes[index].key_next;
+        nodes[index].key_prev = INVALID_NODE;
+        nodes[index].key_next = INVALID_NODE;
+        Cancel(index);
+        index = next;
+    }
+}
+
+void TimingWheel::Remove(const EventType* event_type) {
+    // Only used when tearing down event types, a full scan is fine here
+    for (u32 index = 0; index < static_cast<u32>(nodes.size()); ++index) {
+        const Node& node = nodes[index];
+        if (node.type_key != event_type) {
+            continue;
+        }
+        if (node.state == NodeState::Wheel || node.state == NodeState::Ready) {
+            UnlinkKey(index);
+            Cancel(index);
+        }
+    }
+}
+
+void TimingWheel::Clear() {
+    nodes.clear();
+    free_list = INVALID_NODE;
+    for (Level& level : levels) {
+        level.occupied_slots = 0;
+        level.heads.fill(INVALID_NODE);
+    }
+    ready_heap.clear();
+    key_heads.clear();
+    cursor_tick = 0;
+    size = 0;
+}
+
+std::optional<u64> TimingWheel::NextTime() {
+    if (!Refill()) {
+        return std::nullopt;
+    }
+    return nodes[ready_heap.front()].event.time;
+}
+
+std::optional<TimingWheel::Event> TimingWheel::PopDue(u64 now) {
+    if (!Refill()) {
+        return std::nullopt;
+    }
+    const u32 index = ready_heap.front();
+    if (nodes[index].event.time > now) {
+        return std::nullopt;
+    }
+    PopReady();
+    UnlinkKey(index);
+    Event event = std::move(nodes[index].event);
+    FreeNode(index);
+    --size;
+    return event;
+}
+
+u32 TimingWheel::AllocateNode() {
+    if (free_list == INVALID_NODE) {
+        nodes.emplace_back();
+        return static_cast<u32>(nodes.size() - 1);
+    }
+    const u32 index = free_list;
+    free_list = nodes[index].next;
+    return index;
+}
+
+void TimingWheel::FreeNode(u32 index) {
+    Node& node = nodes[index];
+    node.event.type.reset();
+    node.type_key = nullptr;
+    node.state = NodeState::Free;
+    node.next = free_list;
+    free_list = index;
+}
+
+void TimingWheel::Insert(u32 index) {
+    const u64 tick = nodes[index].event.time >> TICK_SHIFT;
+    if (tick <= cursor_tick) {
+        PushReady(index);
+        return;
+    }
+    const u32 highest_bit = static_cast<u32>(std::bit_width(tick ^ cursor_tick)) - 1;
+    const u32 level = highest_bit / LEVEL_BITS;
+    const u32 slot = static_cast<u32>(tick >> (level * LEVEL_BITS)) & (NUM_SLOTS - 1);
+    LinkSlot(index, level, slot);
+}
+
+void TimingWheel::LinkSlot(u32 index, u32 level, u32 slot) {
+    Node& node = nodes[index];
+    u32& head = levels[level].heads[slot];
+    node.state = NodeState::Wheel;
+    node.level = static_cast<u8>(level);
+    node.slot = static_cast<u8>(slot);
+    node.prev = INVALID_NODE;
+    node.next = head;
+    if (head != INVALID_NODE) {
+        nodes[head].prev = index;
+    }
+    head = index;
+    levels[level].occupied_slots |= u64{1} << slot;
+}
+
+void TimingWheel::UnlinkSlot(u32 index) {
+    const Node& node = nodes[index];
+    Level& level = levels[node.level];
+    if (node.prev != INVALID_NODE) {
+        nodes[node.prev].next = node.next;
+    } else {
+        level.heads[node.slot] = node.next;
+        if (node.next == INVALID_NODE) {
+            level.occupied_slots &= ~(u64{1} << node.slot);
+        }
+    }
+    if (node.next != INVALID_NODE) {
+        nodes[node.next].prev = node.prev;
+    }
+}
+
+void TimingWheel::LinkKey(u32 index) {
+    Node& node = nodes[index];
+    const auto it =
+        key_heads.try_emplace(Key{node.type_key, node.event.user_data}, INVALID_NODE).first;
+    node.key_prev = INVALID_NODE;
+    node.key_next = it->second;
+    if (it->second != INVALID_NODE) {
+        nodes[it->second].key_prev = index;
+    }
+    it->second = index;
+}
+
+void TimingWheel::UnlinkKey(u32 index) {
+    const Node& node = nodes[index];
+    if (node.key_next != INVALID_NODE) {
+        nodes[node.key_next].key_prev = node.key_prev;
+    }
+    if (node.key_prev != INVALID_NODE) {
+        nodes[node.key_prev].key_next = node.key_next;
+        return;
+    }
+    const auto it = key_heads.find(Key{node.type_key, node.event.user_data});
+    ASSERT(it != key_heads.end() && it->second == index);
+    if (node.key_next != INVALID_NODE) {
+        it->second = node.key_next;
+    } else {
+        key_heads.erase(it);
+    }
+}
+
+void TimingWheel::Cancel(u32 index) {
+    Node& node = nodes[index];
+    if (node.state == NodeState::Wheel) {
+        UnlinkSlot(index);
+        FreeNode(index);
+    } else {
+        // Dropped when it reaches the top of the heap instead of fixing up the heap here
+        node.state = NodeState::Cancelled;
+        node.event.type.reset();
+    }
+    --size;
+}
+
+bool TimingWheel::IsLater(u32 lhs, u32 rhs) const {
+    const Event& left = nodes[lhs].event;
+    const Event& right = nodes[rhs].event;
+    return std::tie(left.time, left.fifo_order) > std::tie(right.time, right.fifo_order);
+}
+
+void TimingWheel::PushReady(u32 index) {
+    nodes[index].state = NodeState::Ready;
+    ready_heap.push_back(index);
+    std::push_heap(ready_heap.begin(), ready_heap.end(),
+                   [this](u32 lhs, u32 rhs) { return IsLater(lhs, rhs); });
+}
+
+void TimingWheel::PopReady() {
+    std::pop_heap(ready_heap.begin(), ready_heap.end(),
+                  [this](u32 lhs, u32 rhs) { return IsLater(lhs, rhs); });
+    ready_heap.pop_back();
+}
+
+bool TimingWheel::Refill() {
+    while (true) {
+        while (!ready_heap.empty() && nodes[ready_heap.front()].state == NodeState::Cancelled) {
+            const u32 index = ready_heap.front();
+            PopReady();
+            FreeNode(index);
+        }
+        if (!ready_heap.empty()) {
+            return true;
+        }
+        if (!Cascade()) {
+            return false;
+        }
+    }
+}
+
+bool TimingWheel::Cascade() {
+    for (u32 level = 0; level < NUM_LEVELS; ++level) {
+        Level& wheel_level = levels[level];
+        if (wheel_level.occupied_slots == 0) {
+            continue;
+        }
+        // Events only differ from the cursor from this level up, and slots can only be after the
+        // cursor's, so the lowest occupied slot holds the earliest events
+        const u32 slot = static_cast<u32>(std::countr_zero(wheel_level.occupied_slots));
+        const u32 shift = level * LEVEL_BITS;
+        const u64 upper_mask = ~((u64{1} << (shift + LEVEL_BITS)) - 1);
+        cursor_tick = (cursor_tick & upper_mask) | (u64{slot} << shift);
+
+        u32 index = wheel_level.heads[slot];
+        wheel_level.heads[slot] = INVALID_NODE;
+        wheel_level.occupied_slots &= ~(u64{1} << slot);
+        while (index != INVALID_NODE) {
+            const u32 next = nodes[index].next;
+            Insert(index);
+            index = next;
+        }
+        return true;
+    }
+    return false;
+}
+
+} // namespace Core::Timing
@@ -0,0 +1,150 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "common/common_types.h"
+
+namespace Core::Timing {
+
+struct EventType;
+
+/**
+ * Hierarchical timing wheel holding the pending core timing events.
+ *
+ * Times are bucketed into ticks of 2^TICK_SHIFT nanoseconds, and every level of the wheel has 64
+ * slots covering 64 times the ticks of the level below. An event is filed in the level of the
+ * highest tick digit where it differs from the wheel's cursor, so scheduling and unscheduling
+ * are O(1) and every event is only moved down a level a bounded number of times. Events of the
+ * cursor's tick are kept in a small heap to run them in (time, fifo order), which also expires
+ * all the events of a tick in one batch.
+ */
+class TimingWheel {
+public:
+    struct Event {
+        u64 time;
+        u64 fifo_order;
+        std::uintptr_t user_data;
+        std::weak_ptr<EventType> type;
+    };
+
+    TimingWheel();
+    ~TimingWheel();
+
+    TimingWheel(const TimingWheel&) = delete;
+    TimingWheel& operator=(const TimingWheel&) = delete;
+
+    /// Adds an event that will be due at the given time.
+    void Schedule(u64 time, u64 fifo_order, const std::shared_ptr<EventType>& event_type,
+                  std::uintptr_t user_data);
+
+    /// Removes all the events of the given type with the given user data.
+    void Unschedule(const EventType* event_type, std::uintptr_t user_data);
+
+    /// Removes all the events of the given type.
+    void Remove(const EventType* event_type);
+
+    /// Removes all the events.
+    void Clear();
+
+    /// Returns the time of the earliest event, if there is any.
+    [[nodiscard]] std::optional<u64> NextTime();
+
+    /// Removes and returns the earliest event if it is due at the given time.
+    [[nodiscard]] std::optional<Event> PopDue(u64 now);
+
+    [[nodiscard]] std::size_t Size() const {
+        return size;
+    }
+
+    [[nodiscard]] bool Empty() const {
+        return size == 0;
+    }
+
+private:
+    static constexpr u32 TICK_SHIFT = 10;
+    static constexpr u32 LEVEL_BITS = 6;
+    static constexpr u32 NUM_SLOTS = 1U << LEVEL_BITS;
+    static constexpr u32 NUM_LEVELS = (64 - TICK_SHIFT + LEVEL_BITS - 1) / LEVEL_BITS;
+    static constexpr u32 INVALID_NODE = ~0U;
+
+    enum class NodeState : u8 {
+        Free,
+        Wheel,
+        Ready,
+        Cancelled,
+    };
+
+    struct Node {
+        Event event;
+        const EventType* type_key;
+        u32 prev;
+        u32 next;
+        u32 key_prev;
+        u32 key_next;
+        u8 level;
+        u8 slot;
+        NodeState state;
+    };
+
+    struct Key {
+        const EventType* type;
+        std::uintptr_t user_data;
+
+        friend bool operator==(const Key&, const Key&) = default;
+    };
+
+    struct KeyHash {
+        std::size_t operator()(const Key& key) const noexcept;
+    };
+
+    struct Level {
+        u64 occupied_slots;
+        std::array<u32, NUM_SLOTS> heads;
+    };
+
+    u32 AllocateNode();
+    void FreeNode(u32 index);
+
+    /// Files a node in the wheel, or in the ready heap when its tick is not after the cursor.
+    void Insert(u32 index);
+    void LinkSlot(u32 index, u32 level, u32 slot);
+    void UnlinkSlot(u32 index);
+    void LinkKey(u32 index);
+    void UnlinkKey(u32 index);
+    void Cancel(u32 index);
+
+    /// Orders the ready heap by time, then by the order the events were scheduled in.
+    bool IsLater(u32 lhs, u32 rhs) const;
+    void PushReady(u32 index);
+    void PopReady();
+
+    /// Drops cancelled events from the top of the ready heap and moves the cursor forward until
+    /// the ready heap holds the earliest events. Returns false if there are no events.
+    bool Refill();
+
+    /// Moves the cursor to the start of the earliest occupied slot and redistributes its events.
+    bool Cascade();
+
+    std::vector<Node> nodes;
+    u32 free_list = INVALID_NODE;
+
+    std::array<Level, NUM_LEVELS> levels{};
+    std::vector<u32> ready_heap;
+    std::unordered_map<Key, u32, KeyHash> key_heads;
+
+    /// All the events in the wheel are in ticks after the cursor
+    u64 cursor_tick = 0;
+    std::size_t size = 0;
+};
+
+} // namespace Core::Timing
@@ -0,0 +1,418 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <cstring>
+
+#include "common/assert.h"
+#include "common/swap.h"
+#include "core/crypto/aes_ni.h"
+
+#ifdef ARCHITECTURE_x86_64
+#include <immintrin.h>
+#include "common/x64/cpu_detect.h"
+
+#ifdef _MSC_VER
+#define TARGET_ISA(isa)
+#else
+#define TARGET_ISA(isa) __attribute__((target(isa)))
+#endif
+#endif
+
+namespace Core::Crypto {
+namespace {
+using Block = AESNIEngine::Block;
+using RoundKeys = std::array<Block, 11>;
+
+constexpr std::size_t BLOCK_SIZE = 16;
+constexpr std::size_t NUM_ROUNDS = 10;
+
+/// Number of blocks transcoded together, enough to cover the latency of an AES round
+constexpr std::size_t PIPELINE_BLOCKS = 8;
+constexpr std::size_t PIPELINE_SIZE = PIPELINE_BLOCKS * BLOCK_SIZE;
+
+/// 128-bit big endian CTR counter
+struct Counter {
+    explicit Counter(const Block& block) {
+        std::memcpy(&high, block.data(), sizeof(high));
+        std::memcpy(&low, block.data() + sizeof(high), sizeof(low));
+        high = Common::swap64(high);
+        low = Common::swap64(low);
+    }
+
+    void Store(Block& block) const {
+        const u64 high_be = Common::swap64(high);
+        const u64 low_be = Common::swap64(low);
+        std::memcpy(block.data(), &high_be, sizeof(high_be));
+        std::memcpy(block.data() + sizeof(high_be), &low_be, sizeof(low_be));
+    }
+
+    void Increment() {
+        if (++low == 0) {
+            ++high;
+        }
+    }
+
+    u64 high;
+    u64 low;
+};
+
+/// XTS tweak, a little endian element of GF(2^128)
+struct Tweak {
+    explicit Tweak(const Block& block) {
+        std::memcpy(&low, block.data(), sizeof(low));
+        std::memcpy(&high, block.data() + sizeof(low), sizeof(high));
+    }
+
+    /// Multiplies the tweak by the primitive element x
+    void Advance() {
+        const u64 carry = high >> 63;
+        high = (high << 1) | (low >> 63);
+        low = (low << 1) ^ (0x87 & (0 - carry));
+    }
+
+    u64 low;
+    u64 high;
+};
+
+#ifdef ARCHITECTURE_x86_64
+template <int rcon>
+TARGET_ISA("aes")
+__m128i ExpandRoundKey(__m128i key) {
+    const __m128i assist = _mm_shuffle_epi32(_mm_aeskeygenassist_si128(key, rcon), 0xFF);
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    return _mm_xor_si128(key, assist);
+}
+
+TARGET_ISA("aes")
+void ExpandKey(const u8* key, RoundKeys& encrypt_keys, RoundKeys& decrypt_keys) {
+    std::array<__m128i, NUM_ROUNDS + 1> keys;
+    keys[0] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(key));
+    keys[1] = ExpandRoundKey<0x01>(keys[0]);
+    keys[2] = ExpandRoundKey<0x02>(keys[1]);
+    keys[3] = ExpandRoundKey<0x04>(keys[2]);
+    keys[4] = ExpandRoundKey<0x08>(keys[3]);
+    keys[5] = ExpandRoundKey<0x10>(keys[4]);
+    keys[6] = ExpandRoundKey<0x20>(keys[5]);
+    keys[7] = ExpandRoundKey<0x40>(keys[6]);
+    keys[8] = ExpandRoundKey<0x80>(keys[7]);
+    keys[9] = ExpandRoundKey<0x1B>(keys[8]);
+    keys[10] = ExpandRoundKey<0x36>(keys[9]);
+
+    // The equivalent inverse cipher runs the rounds backwards with InvMixColumns applied to the
+    // inner round keys
+    for (std::size_t round = 0; round <= NUM_ROUNDS; ++round) {
+        __m128i decrypt_key = keys[NUM_ROUNDS - round];
+        if (round != 0 && round != NUM_ROUNDS) {
+            decrypt_key = _mm_aesimc_si128(decrypt_key);
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(encrypt_keys[round].data()), keys[round]);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(decrypt_keys[round].data()), decrypt_key);
+    }
+}
+
+TARGET_ISA("aes")
+std::array<__m128i, NUM_ROUNDS + 1> LoadRoundKeys(const RoundKeys& round_keys) {
+    std::array<__m128i, NUM_ROUNDS + 1> keys;
+    for (std::size_t round = 0; round <= NUM_ROUNDS; ++round) {
+        keys[round] = _mm_load_si128(reinterpret_cast<const __m128i*>(round_keys[round].data()));
+    }
+    return keys;
+}
+
+TARGET_ISA("avx2,vaes,aes")
+std::array<__m256i, NUM_ROUNDS + 1> LoadRoundKeysVAES(const RoundKeys& round_keys) {
+    std::array<__m256i, NUM_ROUNDS + 1> keys;
+    for (std::size_t round = 0; round <= NUM_ROUNDS; ++round) {
+        keys[round] = _mm256_broadcastsi128_si256(
+            _mm_load_si128(reinterpret_cast<const __m128i*>(round_keys[round].data())));
+    }
+    return keys;
+}
+
+/// Runs the cipher on N independent blocks, interleaving the rounds of all blocks
+template <Op op, std::size_t N>
+TARGET_ISA("aes")
+void CipherBlocks(__m128i (&blocks)[N], const std::array<__m128i, NUM_ROUNDS + 1>& keys) {
+    for (std::size_t i = 0; i < N; ++i) {
+        blocks[i] = _mm_xor_si128(blocks[i], keys[0]);
+    }
+    for (std::size_t round = 1; round < NUM_ROUNDS; ++round) {
+        for (std::size_t i = 0; i < N; ++i) {
+            if constexpr (op == Op::Encrypt) {
+                blocks[i] = _mm_aesenc_si128(blocks[i], keys[round]);
+            } else {
+                blocks[i] = _mm_aesdec_si128(blocks[i], keys[round]);
+            }
+        }
+    }
+    for (std::size_t i = 0; i < N; ++i) {
+        if constexpr (op == Op::Encrypt) {
+            blocks[i] = _mm_aesenclast_si128(blocks[i], keys[NUM_ROUNDS]);
+        } else {
+            blocks[i] = _mm_aesdeclast_si128(blocks[i], keys[NUM_ROUNDS]);
+        }
+    }
+}
+
+/// Runs the cipher on N pairs of independent blocks, interleaving the rounds of all blocks
+template <Op op, std::size_t N>
+TARGET_ISA("avx2,vaes,aes")
+void CipherBlocksVAES(__m256i (&blocks)[N], const std::array<__m256i, NUM_ROUNDS + 1>& keys) {
+    for (std::size_t i = 0; i < N; ++i) {
+        blocks[i] = _mm256_xor_si256(blocks[i], keys[0]);
+    }
+    for (std::size_t round = 1; round < NUM_ROUNDS; ++round) {
+        for (std::size_t i = 0; i < N; ++i) {
+            if constexpr (op == Op::Encrypt) {
+                blocks[i] = _mm256_aesenc_epi128(blocks[i], keys[round]);
+            } else {
+                blocks[i] = _mm256_aesdec_epi128(blocks[i], keys[round]);
+            }
+        }
+    }
+    for (std::size_t i = 0; i < N; ++i) {
+        if constexpr (op == Op::Encrypt) {
+            blocks[i] = _mm256_aesenclast_epi128(blocks[i], keys[NUM_ROUNDS]);
+        } else {
+            blocks[i] = _mm256_aesdeclast_epi128(blocks[i], keys[NUM_ROUNDS]);
+        }
+    }
+}
+
+TARGET_ISA("aes")
+__m128i LoadBlock(const u8* src) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+}
+
+TARGET_ISA("aes")
+void StoreBlock(u8* dest, __m128i block) {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dest), block);
+}
+
+TARGET_ISA("aes")
+__m128i NextCounter(Counter& counter) {
+    const __m128i block = _mm_set_epi64x(static_cast<s64>(Common::swap64(counter.low)),
+                                         static_cast<s64>(Common::swap64(counter.high)));
+    counter.Increment();
+    return block;
+}
+
+TARGET_ISA("aes")
+__m128i NextTweak(Tweak& tweak) {
+    const __m128i block =
+        _mm_set_epi64x(static_cast<s64>(tweak.high), static_cast<s64>(tweak.low));
+    tweak.Advance();
+    return block;
+}
+
+template <Op op>
+TARGET_ISA("aes")
+void TranscodeECBNI(const RoundKeys& round_keys, const u8* src, std::size_t size, u8* dest) {
+    const auto keys = LoadRoundKeys(round_keys);
+    std::size_t offset = 0;
+    for (; offset + PIPELINE_SIZE <= size; offset += PIPELINE_SIZE) {
+        __m128i blocks[PIPELINE_BLOCKS];
+        for (std::size_t i = 0; i < PIPELINE_BLOCKS; ++i) {
+            blocks[i] = LoadBlock(src + offset + i * BLOCK_SIZE);
+        }
+        CipherBlocks<op>(blocks, keys);
+        for (std::size_t i = 0; i < PIPELINE_BLOCKS; ++i) {
+            StoreBlock(dest + offset + i * BLOCK_SIZE, blocks[i]);
+        }
+    }
+    for (; offset < size; offset += BLOCK_SIZE) {
+        __m128i blocks[1]{LoadBlock(src + offset)};
+        CipherBlocks<op>(blocks, keys);
+        StoreBlock(dest + offset, blocks[0]);
+    }
+}
+
+TARGET_ISA("aes")
+void TranscodeCTRNI(const RoundKeys& round_keys, const u8* src, std::size_t size, u8* dest,
+                    Counter& counter) {
+    const auto keys = LoadRoundKeys(round_keys);
+    std::size_t offset = 0;
+    for (; offset + PIPELINE_SIZE <= size; offset += PIPELINE_SIZE) {
+        __m128i blocks[PIPELINE_BLOCKS];
+        for (std::size_t i = 0; i < PIPELINE_BLOCKS; ++i) {
+            blocks[i] = NextCounter(counter);
+        }
+        CipherBlocks<Op::Encrypt>(blocks, keys);
+        for (std::size_t i = 0; i < PIPELINE_BLOCKS; ++i) {
+            const std::size_t block_offset = offset + i * BLOCK_SIZE;
+            StoreBlock(dest + block_offset,
+                       _mm_xor_si128(LoadBlock(src + block_offset), blocks[i]));
+        }
+    }
+    for (; offset + BLOCK_SIZE <= size; offset += BLOCK_SIZE) {
+        __m128i blocks[1]{NextCounter(counter)};
+        CipherBlocks<Op::Encrypt>(blocks, keys);
+        StoreBlock(dest + offset, _mm_xor_si128(LoadBlock(src + offset), blocks[0]));
+    }
+    if (offset < size) {
+        __m128i blocks[1]{NextCounter(counter)};
+        CipherBlocks<Op::Encrypt>(blocks, keys);
+        Block keystream;
+        StoreBlock(keystream.data(), blocks[0]);
+        for (std::size_t i = 0; offset + i < size; ++i) {
+            dest[offset + i] = src[offset + i] ^ keystream[i];
+        }
+    }
+}
+
+TARGET_ISA("avx2,vaes,aes")
+void TranscodeCTRVAES(const RoundKeys& round_keys, const u8* src, std::size_t size, u8* dest,
+                      Counter& counter) {
+    const auto keys = LoadRoundKeysVAES(round_keys);
+    std::size_t offset = 0;
+    for (; offset + PIPELINE_SIZE <= size; offset += PIPELINE_SIZE) {
+        __m256i blocks[PIPELINE_BLOCKS / 2];
+        for (std::size_t i = 0; i < PIPELINE_BLOCKS / 2; ++i) {
+            const __m128i first = NextCounter(counter);
+            const __m128i second = NextCounter(counter);
+            blocks[i] = _mm256_set_m128i(second, first);
+        }
+        CipherBlocksVAES<Op::Encrypt>(blocks, keys);
+        for (std::size_t i = 0; i < PIPELINE_BLOCKS / 2; ++i) {
+            u8* const block_dest = dest + offset + i * BLOCK_SIZE * 2;
+            const u8* const block_src = src + offset + i * BLOCK_SIZE * 2;
+            const __m256i input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block_src));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(block_dest),
+                                _mm256_xor_si256(input, blocks[i]));
+        }
+    }
+    TranscodeCTRNI(round_keys, src + offset, size - offset, dest + offset, counter);
+}
+
+template <Op op>
+TARGET_ISA("aes")
+void TranscodeXTSNI(const RoundKeys& round_keys, const u8* src, std::size_t size, u8* dest,
+                    Tweak& tweak) {
+    const auto keys = LoadRoundKeys(round_keys);
+    std::size_t offset = 0;
+    for (; offset + PIPELINE_SIZE <= size; offset += PIPELINE_SIZE) {
+        __m128i tweaks[PIPELINE_BLOCKS];
+        __m128i blocks[PIPELINE_BLOCKS];
+        for (std::size_t i = 0; i < PIPELINE_BLOCKS; ++i) {
+            tweaks[i] = NextTweak(tweak);
+            blocks[i] = _mm_xor_si128(LoadBlock(src + offset + i * BLOCK_SIZE), tweaks[i]);
+        }
+        CipherBlocks<op>(blocks, keys);
+        for (std::size_t i = 0; i < PIPELINE_BLOCKS; ++i) {
+            StoreBlock(dest + offset + i * BLOCK_SIZE, _mm_xor_si128(blocks[i], tweaks[i]));
+        }
+    }
+    for (; offset < size; offset += BLOCK_SIZE) {
+        const __m128i block_tweak = NextTweak(tweak);
+        __m128i blocks[1]{_mm_xor_si128(LoadBlock(src + offset), block_tweak)};
+        CipherBlocks<op>(blocks, keys);
+        StoreBlock(dest + offset, _mm_xor_si128(blocks[0], block_tweak));
+    }
+}
+
+template <Op op>
+TARGET_ISA("avx2,vaes,aes")
+void TranscodeXTSVAES(const RoundKeys& round_keys, const u8* src, std::size_t size, u8* dest,
+                      Tweak& tweak) {
+    const auto keys = LoadRoundKeysVAES(round_keys);
+    std::size_t offset = 0;
+    for (; offset + PIPELINE_SIZE <= size; offset += PIPELINE_SIZE) {
+        __m256i tweaks[PIPELINE_BLOCKS / 2];
+        __m256i blocks[PIPELINE_BLOCKS / 2];
+        for (std::size_t i = 0; i < PIPELINE_BLOCKS / 2; ++i) {
+            const __m128i first = NextTweak(tweak);
+            const __m128i second = NextTweak(tweak);
+            tweaks[i] = _mm256_set_m128i(second, first);
+            const u8* const block_src = src + offset + i * BLOCK_SIZE * 2;
+            const __m256i input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block_src));
+            blocks[i] = _mm256_xor_si256(input, tweaks[i]);
+        }
+        CipherBlocksVAES<op>(blocks, keys);
+        for (std::size_t i = 0; i < PIPELINE_BLOCKS / 2; ++i) {
+            u8* const block_dest = dest + offset + i * BLOCK_SIZE * 2;
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(block_dest),
+                                _mm256_xor_si256(blocks[i], tweaks[i]));
+        }
+    }
+    TranscodeXTSNI<op>(round_keys, src + offset, size - offset, dest + offset, tweak);
+}
+#endif
+} // Anonymous namespace
+
+#ifdef ARCHITECTURE_x86_64
+
+bool AESNIEngine::IsSupported() {
+    return Common::GetCPUCaps().aes;
+}
+
+AESNIEngine::AESNIEngine(const std::array<u8, 16>& key) : use_vaes{Common::GetCPUCaps().vaes} {
+    ExpandKey(key.data(), encrypt_keys, decrypt_keys);
+}
+
+void AESNIEngine::TranscodeECB(const u8* src, std::size_t size, u8* dest, Op op) const {
+    ASSERT_MSG(size % BLOCK_SIZE == 0, "ECB size must be a multiple of the block size");
+    if (op == Op::Encrypt) {
+        TranscodeECBNI<Op::Encrypt>(encrypt_keys, src, size, dest);
+    } else {
+        TranscodeECBNI<Op::Decrypt>(decrypt_keys, src, size, dest);
+    }
+}
+
+void AESNIEngine::TranscodeCTR(const u8* src, std::size_t size, u8* dest, Block& counter) const {
+    Counter value{counter};
+    if (use_vaes) {
+        TranscodeCTRVAES(encrypt_keys, src, size, dest, value);
+    } else {
+        TranscodeCTRNI(encrypt_keys, src, size, dest, value);
+    }
+    value.Store(counter);
+}
+
+void AESNIEngine::TranscodeXTS(const u8* src, std::size_t size, u8* dest, const Block& tweak,
+                               Op op) const {
+    ASSERT_MSG(size % BLOCK_SIZE == 0, "XTS size must be a multiple of the block size");
+    Tweak value{tweak};
+    if (op == Op::Encrypt) {
+        if (use_vaes) {
+            TranscodeXTSVAES<Op::Encrypt>(encrypt_keys, src, size, dest, value);
+        } else {
+            TranscodeXTSNI<Op::Encrypt>(encrypt_keys, src, size, dest, value);
+        }
+    } else {
+        if (use_vaes) {
+            TranscodeXTSVAES<Op::Decrypt>(decrypt_keys, src, size, dest, value);
+        } else {
+            TranscodeXTSNI<Op::Decrypt>(decrypt_keys, src, size, dest, value);
+        }
+    }
+}
+
+#else
+
+bool AESNIEngine::IsSupported() {
+    return false;
+}
+
+AESNIEngine::AESNIEngine(const std::array<u8, 16>& key) {
+    UNREACHABLE_MSG("AES-NI is not available on this architecture");
+}
+
+void AESNIEngine::TranscodeECB(const u8* src, std::size_t size, u8* dest, Op op) const {
+    UNREACHABLE();
+}
+
+void AESNIEngine::TranscodeCTR(const u8* src, std::size_t size, u8* dest, Block& counter) const {
+    UNREACHABLE();
+}
+
+void AESNIEngine::TranscodeXTS(const u8* src, std::size_t size, u8* dest, const Block& tweak,
+                               Op op) const {
+    UNREACHABLE();
+}
+
+#endif
+
+} // namespace Core::Crypto
@@ -0,0 +1,52 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include "common/common_types.h"
+#include "core/crypto/aes_util.h"
+
+namespace Core::Crypto {
+
+/**
+ * AES-128 running on the AES-NI instructions of x86-64 hosts.
+ * Independent blocks are transcoded several at a time to hide the latency of the AES rounds, two
+ * blocks per instruction when the host supports 256-bit VAES.
+ */
+class AESNIEngine {
+public:
+    using Block = std::array<u8, 16>;
+
+    /// Returns whether the host CPU can run the engine.
+    [[nodiscard]] static bool IsSupported();
+
+    explicit AESNIEngine(const std::array<u8, 16>& key);
+
+    /// Transcodes size bytes in ECB mode, size must be a multiple of the block size.
+    void TranscodeECB(const u8* src, std::size_t size, u8* dest, Op op) const;
+
+    /**
+     * XORs size bytes with the CTR keystream starting at counter, a 128-bit big endian value.
+     * The counter is advanced past every block used, including a trailing partial one.
+     */
+    void TranscodeCTR(const u8* src, std::size_t size, u8* dest, Block& counter) const;
+
+    /**
+     * Transcodes one XTS data unit of size bytes using this engine as the data key.
+     * The tweak must already be encrypted with the tweak key and size must be a multiple of the
+     * block size, as ciphertext stealing is not supported.
+     */
+    void TranscodeXTS(const u8* src, std::size_t size, u8* dest, const Block& tweak,
+                      Op op) const;
+
+private:
+    alignas(16) std::array<Block, 11> encrypt_keys{};
+    alignas(16) std::array<Block, 11> decrypt_keys{};
+    bool use_vaes{};
+};
+
+} // namespace Core::Crypto
@@ -2,10 +2,14 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include <array>
+#include <cstring>
+#include <optional>
 #include <mbedtls/cipher.h>
 #include "common/assert.h"
 #include "common/logging/log.h"
+#include "core/crypto/aes_ni.h"
 #include "core/crypto/aes_util.h"
 #include "core/crypto/key_manager.h"
 
@@ -37,11 +41,36 @@ static_assert(static_cast<std::size_t>(Mode::XTS) ==
 struct CipherContext {
     mbedtls_cipher_context_t encryption_context;
     mbedtls_cipher_context_t decryption_context;
+
+    // Hardware engines used instead of mbedtls when the host supports them. XTS keys are made of
+    // the data key followed by the tweak key.
+    std::optional<AESNIEngine> engine;
+    std::optional<AESNIEngine> tweak_engine;
+    Mode mode;
+    AESNIEngine::Block iv{};
 };
 
 template <typename Key, std::size_t KeySize>
-Crypto::AESCipher<Key, KeySize>::AESCipher(Key key, Mode mode)
+Crypto::AESCipher<Key, KeySize>::AESCipher(Key key, Mode mode, bool allow_hardware)
     : ctx(std::make_unique<CipherContext>()) {
+    ctx->mode = mode;
+    if (allow_hardware && AESNIEngine::IsSupported()) {
+        // The engine implements AES-128, which covers CTR and ECB with 128-bit keys and XTS
+        if constexpr (KeySize == 0x20) {
+            if (mode == Mode::XTS) {
+                AESNIEngine::Block half_key;
+                std::memcpy(half_key.data(), key.data(), half_key.size());
+                ctx->engine.emplace(half_key);
+                std::memcpy(half_key.data(), key.data() + half_key.size(), half_key.size());
+                ctx->tweak_engine.emplace(half_key);
+            }
+        } else {
+            if (mode != Mode::XTS) {
+                ctx->engine.emplace(key);
+            }
+        }
+    }
+
     mbedtls_cipher_init(&ctx->encryption_context);
     mbedtls_cipher_init(&ctx->decryption_context);
 
@@ -68,6 +97,10 @@ AESCipher<Key, KeySize>::~AESCipher() {
 
 template <typename Key, std::size_t KeySize>
 void AESCipher<Key, KeySize>::Transcode(const u8* src, std::size_t size, u8* dest, Op op) const {
+    if (ctx->engine && TranscodeHardware(src, size, dest, op)) {
+        return;
+    }
+
     auto* const context = op == Op::Encrypt ? &ctx->encryption_context : &ctx->decryption_context;
 
     mbedtls_cipher_reset(context);
@@ -107,6 +140,36 @@ void AESCipher<Key, KeySize>::Transcode(const u8* src, std::size_t size, u8* des
     }
 }
 
+template <typename Key, std::size_t KeySize>
+bool AESCipher<Key, KeySize>::TranscodeHardware(const u8* src, std::size_t size, u8* dest,
+                                                Op op) const {
+    static constexpr std::size_t block_size = 0x10;
+
+    switch (ctx->mode) {
+    case Mode::CTR:
+        ctx->engine->TranscodeCTR(src, size, dest, ctx->iv);
+        return true;
+    case Mode::ECB:
+        // Partial blocks are padded by the caller
+        if (size % block_size != 0) {
+            return false;
+        }
+        ctx->engine->TranscodeECB(src, size, dest, op);
+        return true;
+    case Mode::XTS: {
+        // Ciphertext stealing is left to mbedtls
+        if (size % block_size != 0) {
+            return false;
+        }
+        AESNIEngine::Block tweak;
+        ctx->tweak_engine->TranscodeECB(ctx->iv.data(), tweak.size(), tweak.data(), Op::Encrypt);
+        ctx->engine->TranscodeXTS(src, size, dest, tweak, op);
+        return true;
+    }
+    }
+    return false;
+}
+
 template <typename Key, std::size_t KeySize>
 void AESCipher<Key, KeySize>::XTSTranscode(const u8* src, std::size_t size, u8* dest,
                                            std::size_t sector_id, std::size_t sector_size, Op op) {
@@ -120,6 +183,8 @@ void AESCipher<Key, KeySize>::XTSTranscode(const u8* src, std::size_t size, u8*
 
 template <typename Key, std::size_t KeySize>
 void AESCipher<Key, KeySize>::SetIV(std::span<const u8> data) {
+    ctx->iv = {};
+    std::memcpy(ctx->iv.data(), data.data(), std::min(data.size(), ctx->iv.size()));
     ASSERT_MSG((mbedtls_cipher_set_iv(&ctx->encryption_context, data.data(), data.size()) ||
                 mbedtls_cipher_set_iv(&ctx->decryption_context, data.data(), data.size())) == 0,
                "Failed to set IV on mbedtls ciphers.");
@@ -31,7 +31,9 @@ class AESCipher {
     static_assert(KeySize == 0x10 || KeySize == 0x20, "KeySize must be 128 or 256.");
 
 public:
-    AESCipher(Key key, Mode mode);
+    /// Creates a cipher, using the AES instructions of the host CPU when allow_hardware is set and
+    /// they are available.
+    AESCipher(Key key, Mode mode, bool allow_hardware = true);
     ~AESCipher();
 
     void SetIV(std::span<const u8> data);
@@ -58,6 +60,9 @@ public:
                       std::size_t sector_size, Op op);
 
 private:
+    /// Transcodes through the hardware engine, returns false when the request must go to mbedtls.
+    bool TranscodeHardware(const u8* src, std::size_t size, u8* dest, Op op) const;
+
     std::unique_ptr<CipherContext> ctx;
 };
 } // namespace Core::Crypto
@@ -21,10 +21,11 @@ std::size_t XTSEncryptionLayer::Read(u8* data, std::size_t length, std::size_t o
     const auto sector_offset = offset & 0x3FFF;
     if (sector_offset == 0) {
         if (length % XTS_SECTOR_SIZE == 0) {
-            std::vector<u8> raw = base->ReadBytes(length, offset);
-            cipher.XTSTranscode(raw.data(), raw.size(), data, offset / XTS_SECTOR_SIZE,
-                                XTS_SECTOR_SIZE, Op::Decrypt);
-            return raw.size();
+            // Decrypt in place in the caller's buffer
+            const std::size_t read = base->Read(data, length, offset);
+            cipher.XTSTranscode(data, read, data, offset / XTS_SECTOR_SIZE, XTS_SECTOR_SIZE,
+                                Op::Decrypt);
+            return read;
         }
         if (length > XTS_SECTOR_SIZE) {
             const auto rem = length % XTS_SECTOR_SIZE;
@@ -15,6 +15,7 @@
 #include "core/file_sys/content_archive.h"
 #include "core/file_sys/nca_patch.h"
 #include "core/file_sys/partition_filesystem.h"
+#include "core/file_sys/vfs_cached.h"
 #include "core/file_sys/vfs_offset.h"
 #include "core/loader/loader.h"
 
@@ -355,7 +356,8 @@ bool NCA::ReadRomFSSection(const NCASectionHeader& section, const NCASectionTabl
 
         // BKTR applies to entire IVFC, so make an offset version to level 6
         files.push_back(std::make_shared<OffsetVfsFile>(
-            bktr, romfs_size, section.romfs.ivfc.levels[IVFC_MAX_LEVEL - 1].offset));
+            std::make_shared<CachedVfsFile>(std::move(bktr)), romfs_size,
+            section.romfs.ivfc.levels[IVFC_MAX_LEVEL - 1].offset));
     } else {
         files.push_back(std::move(dec));
     }
@@ -505,7 +507,8 @@ VirtualFile NCA::Decrypt(const NCASectionHeader& s_header, VirtualFile in, u64 s
                 iv[i] = s_header.raw.section_ctr[8 - i - 1];
             }
             out->SetIV(iv);
-            return std::static_pointer_cast<VfsFile>(out);
+            // Cache decrypted blocks so hot data is only decrypted once
+            return std::make_shared<CachedVfsFile>(std::move(out));
         }
     case NCASectionCryptoType::XTS:
         // TODO(DarkLordZach): Find a test case for XTS-encrypted NCAs
@@ -6,6 +6,8 @@
 #include <array>
 #include <cstddef>
 #include <cstring>
+#include <iterator>
+#include <limits>
 
 #include "common/assert.h"
 #include "core/crypto/aes_util.h"
@@ -13,46 +15,13 @@
 
 namespace FileSys {
 namespace {
-template <bool Subsection, typename BlockType, typename BucketType>
-std::pair<std::size_t, std::size_t> SearchBucketEntry(u64 offset, const BlockType& block,
-                                                      const BucketType& buckets) {
-    if constexpr (Subsection) {
-        const auto& last_bucket = buckets[block.number_buckets - 1];
-        if (offset >= last_bucket.entries[last_bucket.number_entries].address_patch) {
-            return {block.number_buckets - 1, last_bucket.number_entries};
-        }
-    } else {
-        ASSERT_MSG(offset <= block.size, "Offset is out of bounds in BKTR relocation block.");
-    }
-
-    std::size_t bucket_id = std::count_if(
-        block.base_offsets.begin() + 1, block.base_offsets.begin() + block.number_buckets,
-        [&offset](u64 base_offset) { return base_offset <= offset; });
-
-    const auto& bucket = buckets[bucket_id];
-
-    if (bucket.number_entries == 1) {
-        return {bucket_id, 0};
-    }
-
-    std::size_t low = 0;
-    std::size_t mid = 0;
-    std::size_t high = bucket.number_entries - 1;
-    while (low <= high) {
-        mid = (low + high) / 2;
-        if (bucket.entries[mid].address_patch > offset) {
-            high = mid - 1;
-        } else {
-            if (mid == bucket.number_entries - 1 ||
-                bucket.entries[mid + 1].address_patch > offset) {
-                return {bucket_id, mid};
-            }
-
-            low = mid + 1;
-        }
-    }
-    UNREACHABLE_MSG("Offset could not be found in BKTR block.");
-    return {0, 0};
+/// Returns the last range starting at or before the offset, or the end if there is none.
+template <typename Range>
+auto FindRange(const std::vector<Range>& ranges, u64 offset) {
+    const auto it = std::upper_bound(
+        ranges.begin(), ranges.end(), offset,
+        [](u64 value, const Range& range) { return value < range.address_patch; });
+    return it == ranges.begin() ? ranges.end() : std::prev(it);
 }
 } // Anonymous namespace
 
@@ -61,126 +30,176 @@ BKTR::BKTR(VirtualFile base_romfs_, VirtualFile bktr_romfs_, RelocationBlock rel
            std::vector<SubsectionBucket> subsection_buckets_, bool is_encrypted_,
            Core::Crypto::Key128 key_, u64 base_offset_, u64 ivfc_offset_,
            std::array<u8, 8> section_ctr_)
-    : relocation(relocation_), relocation_buckets(std::move(relocation_buckets_)),
-      subsection(subsection_), subsection_buckets(std::move(subsection_buckets_)),
-      base_romfs(std::move(base_romfs_)), bktr_romfs(std::move(bktr_romfs_)),
-      encrypted(is_encrypted_), key(key_), base_offset(base_offset_), ivfc_offset(ivfc_offset_),
-      section_ctr(section_ctr_) {
-    for (std::size_t i = 0; i < relocation.number_buckets - 1; ++i) {
-        relocation_buckets[i].entries.push_back({relocation.base_offsets[i + 1], 0, 0});
-    }
-
-    for (std::size_t i = 0; i < subsection.number_buckets - 1; ++i) {
-        subsection_buckets[i].entries.push_back({subsection_buckets[i + 1].entries[0].address_patch,
-                                                 {0},
-                                                 subsection_buckets[i + 1].entries[0].ctr});
-    }
-
-    relocation_buckets.back().entries.push_back({relocation.size, 0, 0});
+    : size(relocation_.size), base_romfs(std::move(base_romfs_)),
+      bktr_romfs(std::move(bktr_romfs_)), encrypted(is_encrypted_), key(key_),
+      base_offset(base_offset_), ivfc_offset(ivfc_offset_), section_ctr(section_ctr_) {
+    BuildRelocationIndex(relocation_, relocation_buckets_);
+    BuildSubsectionIndex(subsection_, subsection_buckets_);
 }
 
 BKTR::~BKTR() = default;
 
-std::size_t BKTR::Read(u8* data, std::size_t length, std::size_t offset) const {
-    // Read out of bounds.
-    if (offset >= relocation.size) {
-        return 0;
+void BKTR::BuildRelocationIndex(const RelocationBlock& relocation,
+                                const std::vector<RelocationBucket>& relocation_buckets) {
+    const std::size_t num_buckets =
+        std::min<std::size_t>(relocation.number_buckets, relocation_buckets.size());
+    for (std::size_t i = 0; i < num_buckets; ++i) {
+        const auto& bucket = relocation_buckets[i];
+        for (std::size_t j = 0; j < bucket.number_entries; ++j) {
+            const RelocationEntry& entry = bucket.entries[j];
+            if (entry.address_patch >= size) {
+                break;
+            }
+            if (!relocation_ranges.empty()) {
+                const RelocationRange& last = relocation_ranges.back();
+                ASSERT_MSG(entry.address_patch >= last.address_patch,
+                           "BKTR relocation entries are not sorted.");
+                const bool is_continuation =
+                    last.from_patch == (entry.from_patch != 0) &&
+                    last.address_source + (entry.address_patch - last.address_patch) ==
+                        entry.address_source;
+                if (is_continuation) {
+                    continue;
+                }
+            }
+            relocation_ranges.push_back({entry.address_patch, entry.address_source,
+                                         entry.from_patch != 0});
+        }
     }
+    relocation_ranges.push_back({size, 0, false});
+}
 
-    const auto relocation_entry = GetRelocationEntry(offset);
-    const auto section_offset =
-        offset - relocation_entry.address_patch + relocation_entry.address_source;
-    const auto bktr_read = relocation_entry.from_patch;
-
-    const auto next_relocation = GetNextRelocationEntry(offset);
-
-    if (offset + length > next_relocation.address_patch) {
-        const u64 partition = next_relocation.address_patch - offset;
-        return Read(data, partition, offset) +
-               Read(data + partition, length - partition, offset + partition);
+void BKTR::BuildSubsectionIndex(const SubsectionBlock& subsection,
+                                const std::vector<SubsectionBucket>& subsection_buckets) {
+    const std::size_t num_buckets =
+        std::min<std::size_t>(subsection.number_buckets, subsection_buckets.size());
+    for (std::size_t i = 0; i < num_buckets; ++i) {
+        const auto& bucket = subsection_buckets[i];
+        for (std::size_t j = 0; j < bucket.number_entries; ++j) {
+            const SubsectionEntry& entry = bucket.entries[j];
+            if (!subsection_ranges.empty()) {
+                ASSERT_MSG(entry.address_patch >= subsection_ranges.back().address_patch,
+                           "BKTR subsection entries are not sorted.");
+                // The IV only depends on the counter and the offset
+                if (subsection_ranges.back().ctr == entry.ctr) {
+                    continue;
+                }
+            }
+            subsection_ranges.push_back({entry.address_patch, entry.ctr});
+        }
     }
+}
 
-    if (!bktr_read) {
-        ASSERT_MSG(section_offset >= ivfc_offset, "Offset calculation negative.");
-        return base_romfs->Read(data, length, section_offset - ivfc_offset);
+std::size_t BKTR::Read(u8* data, std::size_t length, std::size_t offset) const {
+    // Read out of bounds.
+    if (offset >= size) {
+        return 0;
     }
+    length = static_cast<std::size_t>(std::min<u64>(length, size - offset));
 
-    if (!encrypted) {
-        return bktr_romfs->Read(data, length, section_offset);
+    auto range = FindRange(relocation_ranges, offset);
+    if (range == relocation_ranges.end()) {
+        return 0;
     }
 
-    const auto subsection_entry = GetSubsectionEntry(section_offset);
-    Core::Crypto::AESCipher<Core::Crypto::Key128> cipher(key, Core::Crypto::Mode::CTR);
+    // Every range is a single read of the backing file, the sentinel stops the loop at the end
+    std::size_t total_read = 0;
+    while (length > 0) {
+        const auto next_range = std::next(range);
+        const std::size_t chunk =
+            static_cast<std::size_t>(std::min<u64>(length, next_range->address_patch - offset));
+        const u64 section_offset = offset - range->address_patch + range->address_source;
+
+        std::size_t read;
+        if (!range->from_patch) {
+            ASSERT_MSG(section_offset >= ivfc_offset, "Offset calculation negative.");
+            read = base_romfs->Read(data, chunk, section_offset - ivfc_offset);
+        } else if (!encrypted) {
+            read = bktr_romfs->Read(data, chunk, section_offset);
+        } else {
+            read = ReadEncrypted(data, chunk, section_offset);
+        }
 
-    // Calculate AES IV
-    std::array<u8, 16> iv{};
-    auto subsection_ctr = subsection_entry.ctr;
-    auto offset_iv = section_offset + base_offset;
-    for (std::size_t i = 0; i < section_ctr.size(); ++i) {
-        iv[i] = section_ctr[0x8 - i - 1];
-    }
-    offset_iv >>= 4;
-    for (std::size_t i = 0; i < sizeof(u64); ++i) {
-        iv[0xF - i] = static_cast<u8>(offset_iv & 0xFF);
-        offset_iv >>= 8;
-    }
-    for (std::size_t i = 0; i < sizeof(u32); ++i) {
-        iv[0x7 - i] = static_cast<u8>(subsection_ctr & 0xFF);
-        subsection_ctr >>= 8;
+        total_read += read;
+        if (read != chunk) {
+            break;
+        }
+        data += chunk;
+        length -= chunk;
+        offset += chunk;
+        range = next_range;
     }
-    cipher.SetIV(iv);
-
-    const auto next_subsection = GetNextSubsectionEntry(section_offset);
+    return total_read;
+}
 
-    if (section_offset + length > next_subsection.address_patch) {
-        const u64 partition = next_subsection.address_patch - section_offset;
-        return Read(data, partition, offset) +
-               Read(data + partition, length - partition, offset + partition);
+std::size_t BKTR::ReadEncrypted(u8* data, std::size_t length, u64 section_offset) const {
+    auto range = FindRange(subsection_ranges, section_offset);
+    if (range == subsection_ranges.end()) {
+        range = subsection_ranges.begin();
     }
+    ASSERT_MSG(range != subsection_ranges.end(), "BKTR has no subsection entries.");
 
-    const auto block_offset = section_offset & 0xF;
-    if (block_offset != 0) {
-        auto block = bktr_romfs->ReadBytes(0x10, section_offset & ~0xF);
-        cipher.Transcode(block.data(), block.size(), block.data(), Core::Crypto::Op::Decrypt);
-        if (length + block_offset < 0x10) {
-            std::memcpy(data, block.data() + block_offset, std::min(length, block.size()));
-            return std::min(length, block.size());
+    Core::Crypto::AESCipher<Core::Crypto::Key128> cipher(key, Core::Crypto::Mode::CTR);
+    std::size_t total_read = 0;
+    while (length > 0) {
+        const auto next_range = std::next(range);
+        const u64 range_end = next_range != subsection_ranges.end()
+                                  ? next_range->address_patch
+                                  : std::numeric_limits<u64>::max();
+        const std::size_t chunk =
+            static_cast<std::size_t>(std::min<u64>(length, range_end - section_offset));
+
+        // Calculate AES IV
+        std::array<u8, 16> iv{};
+        auto subsection_ctr = range->ctr;
+        auto offset_iv = section_offset + base_offset;
+        for (std::size_t i = 0; i < section_ctr.size(); ++i) {
+            iv[i] = section_ctr[0x8 - i - 1];
+        }
+        offset_iv >>= 4;
+        for (std::size_t i = 0; i < sizeof(u64); ++i) {
+            iv[0xF - i] = static_cast<u8>(offset_iv & 0xFF);
+            offset_iv >>= 8;
+        }
+        for (std::size_t i = 0; i < sizeof(u32); ++i) {
+            iv[0x7 - i] = static_cast<u8>(subsection_ctr & 0xFF);
+            subsection_ctr >>= 8;
+        }
+        cipher.SetIV(iv);
+
+        std::size_t read;
+        bool is_short_read;
+        const auto block_offset = section_offset & 0xF;
+        if (block_offset != 0) {
+            // Decrypt the whole block the read starts in, then continue block aligned
+            std::array<u8, 0x10> block{};
+            const std::size_t block_read =
+                bktr_romfs->Read(block.data(), block.size(), section_offset & ~0xF);
+            if (block_read <= block_offset) {
+                break;
+            }
+            cipher.Transcode(block.data(), block.size(), block.data(), Core::Crypto::Op::Decrypt);
+            read = std::min<std::size_t>(chunk, block_read - block_offset);
+            std::memcpy(data, block.data() + block_offset, read);
+            is_short_read = block_read != block.size();
+        } else {
+            read = bktr_romfs->Read(data, chunk, section_offset);
+            cipher.Transcode(data, read, data, Core::Crypto::Op::Decrypt);
+            is_short_read = read != chunk;
         }
 
-        const auto read = 0x10 - block_offset;
-        std::memcpy(data, block.data() + block_offset, read);
-        return read + Read(data + read, length - read, offset + read);
+        total_read += read;
+        if (is_short_read) {
+            break;
+        }
+        data += read;
+        length -= read;
+        section_offset += read;
+        if (read == chunk) {
+            range = next_range;
+        }
     }
-
-    const auto raw_read = bktr_romfs->Read(data, length, section_offset);
-    cipher.Transcode(data, raw_read, data, Core::Crypto::Op::Decrypt);
-    return raw_read;
-}
-
-RelocationEntry BKTR::GetRelocationEntry(u64 offset) const {
-    const auto res = SearchBucketEntry<false>(offset, relocation, relocation_buckets);
-    return relocation_buckets[res.first].entries[res.second];
-}
-
-RelocationEntry BKTR::GetNextRelocationEntry(u64 offset) const {
-    const auto res = SearchBucketEntry<false>(offset, relocation, relocation_buckets);
-    const auto bucket = relocation_buckets[res.first];
-    if (res.second + 1 < bucket.entries.size())
-        return bucket.entries[res.second + 1];
-    return relocation_buckets[res.first + 1].entries[0];
-}
-
-SubsectionEntry BKTR::GetSubsectionEntry(u64 offset) const {
-    const auto res = SearchBucketEntry<true>(offset, subsection, subsection_buckets);
-    return subsection_buckets[res.first].entries[res.second];
-}
-
-SubsectionEntry BKTR::GetNextSubsectionEntry(u64 offset) const {
-    const auto res = SearchBucketEntry<true>(offset, subsection, subsection_buckets);
-    const auto bucket = subsection_buckets[res.first];
-    if (res.second + 1 < bucket.entries.size())
-        return bucket.entries[res.second + 1];
-    return subsection_buckets[res.first + 1].entries[0];
+    return total_read;
 }
 
 std::string BKTR::GetName() const {
@@ -188,7 +207,7 @@ std::string BKTR::GetName() const {
 }
 
 std::size_t BKTR::GetSize() const {
-    return relocation.size;
+    return size;
 }
 
 bool BKTR::Resize(std::size_t new_size) {
@@ -12,6 +12,7 @@
 #include "common/common_types.h"
 #include "common/swap.h"
 #include "core/crypto/key_manager.h"
+#include "core/file_sys/vfs.h"
 
 namespace FileSys {
 
@@ -117,16 +118,33 @@ public:
     bool Rename(std::string_view name) override;
 
 private:
-    RelocationEntry GetRelocationEntry(u64 offset) const;
-    RelocationEntry GetNextRelocationEntry(u64 offset) const;
-
-    SubsectionEntry GetSubsectionEntry(u64 offset) const;
-    SubsectionEntry GetNextSubsectionEntry(u64 offset) const;
-
-    RelocationBlock relocation;
-    std::vector<RelocationBucket> relocation_buckets;
-    SubsectionBlock subsection;
-    std::vector<SubsectionBucket> subsection_buckets;
+    /// Run of the patched file read from a single contiguous range of one of the romfs files.
+    struct RelocationRange {
+        u64 address_patch;
+        u64 address_source;
+        bool from_patch;
+    };
+
+    /// Range of the patch romfs encrypted with the same counter.
+    struct SubsectionRange {
+        u64 address_patch;
+        u32 ctr;
+    };
+
+    /// Flattens the buckets into sorted ranges, merging the ones that continue each other.
+    void BuildRelocationIndex(const RelocationBlock& relocation,
+                              const std::vector<RelocationBucket>& relocation_buckets);
+    void BuildSubsectionIndex(const SubsectionBlock& subsection,
+                              const std::vector<SubsectionBucket>& subsection_buckets);
+
+    std::size_t ReadEncrypted(u8* data, std::size_t length, u64 section_offset) const;
+
+    u64 size;
+
+    // Sorted by address_patch, each range ends where the next one starts. The last range is a
+    // sentinel starting at the end of the file.
+    std::vector<RelocationRange> relocation_ranges;
+    std::vector<SubsectionRange> subsection_ranges;
 
     // Should be the raw base romfs, decrypted.
     VirtualFile base_romfs;
@@ -185,6 +185,10 @@ std::vector<u8> VfsFile::ReadAllBytes() const {
     return ReadBytes(GetSize());
 }
 
+std::optional<std::span<const u8>> VfsFile::GetSpan(std::size_t size, std::size_t offset) const {
+    return std::nullopt;
+}
+
 bool VfsFile::WriteByte(u8 data, std::size_t offset) {
     return Write(&data, 1, offset) == 1;
 }
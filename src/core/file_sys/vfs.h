@@ -8,6 +8,7 @@
 #include <map>
 #include <memory>
 #include <optional>
+#include <span>
 #include <string>
 #include <string_view>
 #include <type_traits>
@@ -112,6 +113,12 @@ public:
     // Reads all the bytes from the file into a vector. Equivalent to 'file->Read(file->GetSize(),
     // 0)'
     virtual std::vector<u8> ReadAllBytes() const;
+    // Returns a view of up to size bytes starting at offset that points straight into the memory
+    // backing the file, avoiding a copy. Returns std::nullopt if the file is not memory backed or
+    // the range is not contiguous, in which case Read must be used instead. The view is only valid
+    // while the file is alive.
+    virtual std::optional<std::span<const u8>> GetSpan(std::size_t size,
+                                                       std::size_t offset = 0) const;
 
     // Reads an array of type T, size number_elements starting at offset.
     // Returns the number of bytes (sizeof(T)*number_elements) read successfully.
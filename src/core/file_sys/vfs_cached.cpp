@@ -0,0 +1,227 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <cstring>
+
+#include "common/div_ceil.h"
+#include "core/file_sys/vfs_cached.h"
+
+namespace FileSys {
+
+namespace {
+
+/// Capacity of the cache shared by all files
+constexpr std::size_t SHARED_CACHE_SIZE = 64ULL * 1024 * 1024;
+
+/// Largest number of blocks fetched ahead of a sequential reader
+constexpr u64 MAX_READ_AHEAD_BLOCKS = 16;
+
+/// Reads at least this large go straight to the base file, so bulk loads don't flush the cache
+constexpr std::size_t MAX_CACHED_READ_SIZE = 1024 * 1024;
+
+} // Anonymous namespace
+
+BlockCache::BlockCache(std::size_t capacity_) : capacity{capacity_} {}
+
+BlockCache::~BlockCache() = default;
+
+BlockCache& BlockCache::Shared() {
+    static BlockCache cache{SHARED_CACHE_SIZE};
+    return cache;
+}
+
+u64 BlockCache::RegisterFile() {
+    return next_file_id.fetch_add(1, std::memory_order_relaxed);
+}
+
+void BlockCache::UnregisterFile(u64 file_id) {
+    std::scoped_lock lock{mutex};
+    for (auto it = blocks.begin(); it != blocks.end();) {
+        if (it->key.first != file_id) {
+            ++it;
+            continue;
+        }
+        used_bytes -= it->data.size();
+        block_map.erase(it->key);
+        it = blocks.erase(it);
+    }
+}
+
+bool BlockCache::Read(u64 file_id, u64 block_index, std::size_t offset, std::size_t size,
+                      u8* dest) {
+    std::scoped_lock lock{mutex};
+    const auto it = block_map.find({file_id, block_index});
+    if (it == block_map.end() || offset + size > it->second->data.size()) {
+        misses.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    hits.fetch_add(1, std::memory_order_relaxed);
+    blocks.splice(blocks.begin(), blocks, it->second);
+    std::memcpy(dest, it->second->data.data() + offset, size);
+    return true;
+}
+
+void BlockCache::Insert(u64 file_id, u64 block_index, std::span<const u8> data) {
+    const Key key{file_id, block_index};
+    std::scoped_lock lock{mutex};
+    if (const auto it = block_map.find(key); it != block_map.end()) {
+        used_bytes -= it->second->data.size();
+        blocks.erase(it->second);
+        block_map.erase(it);
+    }
+    EvictFor(data.size());
+
+    blocks.push_front(Block{key, std::vector<u8>(data.begin(), data.end())});
+    block_map.emplace(key, blocks.begin());
+    used_bytes += data.size();
+}
+
+void BlockCache::AddReadAhead(u64 num_blocks) {
+    read_ahead_blocks.fetch_add(num_blocks, std::memory_order_relaxed);
+}
+
+BlockCacheStats BlockCache::GetStats() const {
+    std::scoped_lock lock{mutex};
+    return {
+        .hits = hits.load(std::memory_order_relaxed),
+        .misses = misses.load(std::memory_order_relaxed),
+        .read_ahead_blocks = read_ahead_blocks.load(std::memory_order_relaxed),
+        .used_bytes = used_bytes,
+    };
+}
+
+void BlockCache::ResetStats() {
+    hits = 0;
+    misses = 0;
+    read_ahead_blocks = 0;
+}
+
+void BlockCache::EvictFor(std::size_t size) {
+    while (!blocks.empty() && used_bytes + size > capacity) {
+        const Block& victim = blocks.back();
+        used_bytes -= victim.data.size();
+        block_map.erase(victim.key);
+        blocks.pop_back();
+    }
+}
+
+CachedVfsFile::CachedVfsFile(VirtualFile base_, BlockCache& cache_)
+    : base{std::move(base_)}, cache{cache_}, file_id{cache.RegisterFile()},
+      size{base->GetSize()} {}
+
+CachedVfsFile::~CachedVfsFile() {
+    cache.UnregisterFile(file_id);
+}
+
+std::string CachedVfsFile::GetName() const {
+    return base->GetName();
+}
+
+std::size_t CachedVfsFile::GetSize() const {
+    return size;
+}
+
+bool CachedVfsFile::Resize(std::size_t new_size) {
+    return false;
+}
+
+VirtualDir CachedVfsFile::GetContainingDirectory() const {
+    return base->GetContainingDirectory();
+}
+
+bool CachedVfsFile::IsWritable() const {
+    return false;
+}
+
+bool CachedVfsFile::IsReadable() const {
+    return true;
+}
+
+std::size_t CachedVfsFile::Read(u8* data, std::size_t length, std::size_t offset) const {
+    if (offset >= size) {
+        return 0;
+    }
+    length = std::min(length, size - offset);
+    if (length == 0) {
+        return 0;
+    }
+
+    const u64 read_ahead = UpdateReadAhead(length, offset);
+    if (length >= MAX_CACHED_READ_SIZE) {
+        return base->Read(data, length, offset);
+    }
+
+    std::size_t done = 0;
+    while (done < length) {
+        const std::size_t position = offset + done;
+        const u64 block_index = position / BlockCache::BLOCK_SIZE;
+        const std::size_t block_offset = position % BlockCache::BLOCK_SIZE;
+        const std::size_t chunk = std::min(BlockCache::BLOCK_SIZE - block_offset, length - done);
+        if (cache.Read(file_id, block_index, block_offset, chunk, data + done)) {
+            done += chunk;
+            continue;
+        }
+        const std::size_t filled = Fill(data + done, length - done, position, read_ahead);
+        if (filled == 0) {
+            break;
+        }
+        done += filled;
+    }
+    return done;
+}
+
+std::size_t CachedVfsFile::Write(const u8* data, std::size_t length, std::size_t offset) {
+    return 0;
+}
+
+bool CachedVfsFile::Rename(std::string_view name) {
+    return false;
+}
+
+u64 CachedVfsFile::UpdateReadAhead(std::size_t length, std::size_t offset) const {
+    const u64 expected_offset = next_sequential_offset.exchange(offset + length);
+    u64 window = 0;
+    if (offset == expected_offset) {
+        window = std::clamp<u64>(read_ahead_window.load() * 2, 1, MAX_READ_AHEAD_BLOCKS);
+    }
+    read_ahead_window.store(window);
+    return window;
+}
+
+std::size_t CachedVfsFile::Fill(u8* data, std::size_t length, std::size_t offset,
+                                u64 read_ahead) const {
+    static constexpr std::size_t block_size = BlockCache::BLOCK_SIZE;
+
+    const u64 first_block = offset / block_size;
+    const u64 last_block = (offset + length - 1) / block_size;
+    const u64 num_file_blocks = Common::DivCeil(size, block_size);
+    const u64 end_block = std::min(last_block + 1 + read_ahead, num_file_blocks);
+
+    // Fetch the requested blocks and the ones ahead with a single read of the base file
+    const std::size_t fetch_offset = first_block * block_size;
+    const std::size_t fetch_size =
+        std::min<std::size_t>((end_block - first_block) * block_size, size - fetch_offset);
+    std::vector<u8> buffer(fetch_size);
+    const std::size_t read = base->Read(buffer.data(), fetch_size, fetch_offset);
+
+    for (std::size_t block_start = 0; block_start < read; block_start += block_size) {
+        const std::size_t block_length = std::min(block_size, read - block_start);
+        cache.Insert(file_id, first_block + block_start / block_size,
+                     std::span{buffer.data() + block_start, block_length});
+    }
+    if (end_block > last_block + 1) {
+        cache.AddReadAhead(end_block - last_block - 1);
+    }
+
+    const std::size_t start = offset - fetch_offset;
+    if (read <= start) {
+        return 0;
+    }
+    const std::size_t copied = std::min(length, read - start);
+    std::memcpy(data, buffer.data() + start, copied);
+    return copied;
+}
+
+} // namespace FileSys
@@ -0,0 +1,139 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <span>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "common/common_types.h"
+#include "common/hash.h"
+#include "core/file_sys/vfs.h"
+
+namespace FileSys {
+
+/// Counters describing how well a BlockCache performs.
+struct BlockCacheStats {
+    u64 hits;
+    u64 misses;
+    u64 read_ahead_blocks;
+    std::size_t used_bytes;
+
+    /// Returns the fraction of block lookups served from the cache.
+    double HitRate() const {
+        const u64 lookups = hits + misses;
+        return lookups == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(lookups);
+    }
+};
+
+/**
+ * Size-bounded LRU cache of fixed-size file blocks.
+ * Blocks are keyed by the id of the file they belong to and their aligned index in that file.
+ * The cache is thread-safe and shared by every CachedVfsFile.
+ */
+class BlockCache {
+public:
+    static constexpr std::size_t BLOCK_SIZE = 0x4000;
+
+    explicit BlockCache(std::size_t capacity_);
+    ~BlockCache();
+
+    BlockCache(const BlockCache&) = delete;
+    BlockCache& operator=(const BlockCache&) = delete;
+
+    /// Returns the cache shared by all cached files.
+    static BlockCache& Shared();
+
+    /// Returns a new id to key the blocks of a file with.
+    u64 RegisterFile();
+
+    /// Drops every block of the file with the given id.
+    void UnregisterFile(u64 file_id);
+
+    /**
+     * Copies size bytes starting at offset inside a cached block into dest.
+     * Returns false, copying nothing, when the block is not cached.
+     */
+    bool Read(u64 file_id, u64 block_index, std::size_t offset, std::size_t size, u8* dest);
+
+    /// Inserts a block, evicting the least recently used blocks to stay within capacity.
+    void Insert(u64 file_id, u64 block_index, std::span<const u8> data);
+
+    /// Counts blocks fetched ahead of a sequential reader.
+    void AddReadAhead(u64 num_blocks);
+
+    /// Returns the counters accumulated since the last reset.
+    BlockCacheStats GetStats() const;
+
+    /// Clears the counters.
+    void ResetStats();
+
+private:
+    using Key = std::pair<u64, u64>;
+
+    struct Block {
+        Key key;
+        std::vector<u8> data;
+    };
+
+    /// Evicts blocks until size additional bytes fit. Requires the lock to be held.
+    void EvictFor(std::size_t size);
+
+    const std::size_t capacity;
+    std::atomic<u64> next_file_id{1};
+
+    mutable std::mutex mutex;
+    std::size_t used_bytes = 0;
+    // Most recently used blocks are at the front
+    std::list<Block> blocks;
+    std::unordered_map<Key, std::list<Block>::iterator, Common::PairHash> block_map;
+
+    std::atomic<u64> hits{};
+    std::atomic<u64> misses{};
+    std::atomic<u64> read_ahead_blocks{};
+};
+
+/**
+ * Read-only VfsFile that serves reads of the wrapped file through the shared BlockCache.
+ * Used on top of the decryption layers so hot data is decrypted only once. Sequential readers
+ * get increasingly larger read-ahead so streaming does not miss on every block.
+ */
+class CachedVfsFile : public VfsFile {
+public:
+    explicit CachedVfsFile(VirtualFile base_, BlockCache& cache_ = BlockCache::Shared());
+    ~CachedVfsFile() override;
+
+    std::string GetName() const override;
+    std::size_t GetSize() const override;
+    bool Resize(std::size_t new_size) override;
+    VirtualDir GetContainingDirectory() const override;
+    bool IsWritable() const override;
+    bool IsReadable() const override;
+    std::size_t Read(u8* data, std::size_t length, std::size_t offset) const override;
+    std::size_t Write(const u8* data, std::size_t length, std::size_t offset) override;
+    bool Rename(std::string_view name) override;
+
+private:
+    /// Returns the number of blocks to fetch ahead of a read and updates the sequential state.
+    u64 UpdateReadAhead(std::size_t length, std::size_t offset) const;
+
+    /// Reads blocks from the base file into the cache and copies the requested range into data.
+    /// Returns the number of bytes copied.
+    std::size_t Fill(u8* data, std::size_t length, std::size_t offset, u64 read_ahead) const;
+
+    VirtualFile base;
+    BlockCache& cache;
+    u64 file_id;
+    std::size_t size;
+
+    mutable std::atomic<u64> next_sequential_offset{};
+    mutable std::atomic<u64> read_ahead_window{};
+};
+
+} // namespace FileSys
@@ -3,6 +3,7 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <iterator>
 #include <utility>
 
 #include "common/assert.h"
@@ -25,16 +26,23 @@ static bool VerifyConcatenationMapContinuity(const std::multimap<u64, VirtualFil
 
 ConcatenatedVfsFile::ConcatenatedVfsFile(std::vector<VirtualFile> files_, std::string name_)
     : name(std::move(name_)) {
-    std::size_t next_offset = 0;
-    for (const auto& file : files_) {
-        files.emplace(next_offset, file);
-        next_offset += file->GetSize();
+    files.reserve(files_.size());
+    for (auto& file : files_) {
+        const u64 file_size = file->GetSize();
+        files.push_back({size, file_size, std::move(file)});
+        size += file_size;
     }
 }
 
 ConcatenatedVfsFile::ConcatenatedVfsFile(std::multimap<u64, VirtualFile> files_, std::string name_)
-    : files(std::move(files_)), name(std::move(name_)) {
-    ASSERT(VerifyConcatenationMapContinuity(files));
+    : name(std::move(name_)) {
+    ASSERT(VerifyConcatenationMapContinuity(files_));
+    files.reserve(files_.size());
+    for (auto& [offset, file] : files_) {
+        const u64 file_size = file->GetSize();
+        files.push_back({offset, file_size, std::move(file)});
+        size = offset + file_size;
+    }
 }
 
 ConcatenatedVfsFile::~ConcatenatedVfsFile() = default;
@@ -81,14 +89,11 @@ std::string ConcatenatedVfsFile::GetName() const {
     if (!name.empty()) {
         return name;
     }
-    return files.begin()->second->GetName();
+    return files.front().file->GetName();
 }
 
 std::size_t ConcatenatedVfsFile::GetSize() const {
-    if (files.empty()) {
-        return 0;
-    }
-    return files.rbegin()->first + files.rbegin()->second->GetSize();
+    return size;
 }
 
 bool ConcatenatedVfsFile::Resize(std::size_t new_size) {
@@ -99,7 +104,7 @@ VirtualDir ConcatenatedVfsFile::GetContainingDirectory() const {
     if (files.empty()) {
         return nullptr;
     }
-    return files.begin()->second->GetContainingDirectory();
+    return files.front().file->GetContainingDirectory();
 }
 
 bool ConcatenatedVfsFile::IsWritable() const {
@@ -110,26 +115,59 @@ bool ConcatenatedVfsFile::IsReadable() const {
     return true;
 }
 
+std::vector<ConcatenatedVfsFile::ConcatenationEntry>::const_iterator ConcatenatedVfsFile::FindEntry(
+    u64 offset) const {
+    if (offset >= size) {
+        return files.end();
+    }
+    // Empty files share their offset with the next one, the last entry at an offset is the one
+    // holding it
+    const auto it = std::upper_bound(
+        files.begin(), files.end(), offset,
+        [](u64 value, const ConcatenationEntry& entry) { return value < entry.offset; });
+    return it == files.begin() ? files.end() : std::prev(it);
+}
+
 std::size_t ConcatenatedVfsFile::Read(u8* data, std::size_t length, std::size_t offset) const {
-    auto entry = --files.end();
-    for (auto iter = files.begin(); iter != files.end(); ++iter) {
-        if (iter->first > offset) {
-            entry = --iter;
+    auto entry = FindEntry(offset);
+
+    // Read every file covered by the range once
+    std::size_t total_read = 0;
+    for (; length > 0 && entry != files.end(); ++entry) {
+        const u64 relative_offset = offset - entry->offset;
+        if (relative_offset >= entry->size) {
+            continue;
+        }
+        const std::size_t chunk =
+            static_cast<std::size_t>(std::min<u64>(length, entry->size - relative_offset));
+        const std::size_t read = entry->file->Read(data, chunk, relative_offset);
+        total_read += read;
+        if (read != chunk) {
             break;
         }
+        data += chunk;
+        length -= chunk;
+        offset += chunk;
     }
+    return total_read;
+}
 
-    if (entry->first + entry->second->GetSize() <= offset)
-        return 0;
-
-    const auto read_in =
-        std::min<u64>(entry->first + entry->second->GetSize() - offset, entry->second->GetSize());
-    if (length > read_in) {
-        return entry->second->Read(data, read_in, offset - entry->first) +
-               Read(data + read_in, length - read_in, offset + read_in);
+std::optional<std::span<const u8>> ConcatenatedVfsFile::GetSpan(std::size_t length,
+                                                                std::size_t offset) const {
+    if (files.empty()) {
+        return std::nullopt;
+    }
+    const auto entry = FindEntry(offset);
+    if (entry == files.end()) {
+        return std::span<const u8>{};
     }
 
-    return entry->second->Read(data, std::min<u64>(read_in, length), offset - entry->first);
+    // Only ranges fully contained in a single file are contiguous
+    const auto relative_offset = offset - entry->offset;
+    if (length > entry->size - relative_offset && std::next(entry) != files.end()) {
+        return std::nullopt;
+    }
+    return entry->file->GetSpan(length, relative_offset);
 }
 
 std::size_t ConcatenatedVfsFile::Write(const u8* data, std::size_t length, std::size_t offset) {
@@ -7,6 +7,7 @@
 #include <map>
 #include <memory>
 #include <string_view>
+#include <vector>
 #include "core/file_sys/vfs.h"
 
 namespace FileSys {
@@ -36,11 +37,23 @@ public:
     bool IsReadable() const override;
     std::size_t Read(u8* data, std::size_t length, std::size_t offset) const override;
     std::size_t Write(const u8* data, std::size_t length, std::size_t offset) override;
+    std::optional<std::span<const u8>> GetSpan(std::size_t length,
+                                               std::size_t offset) const override;
     bool Rename(std::string_view new_name) override;
 
 private:
-    // Maps starting offset to file -- more efficient.
-    std::multimap<u64, VirtualFile> files;
+    struct ConcatenationEntry {
+        u64 offset;
+        u64 size;
+        VirtualFile file;
+    };
+
+    /// Returns the entry holding the given offset, or the end if it's past the end of the file.
+    std::vector<ConcatenationEntry>::const_iterator FindEntry(u64 offset) const;
+
+    // Sorted by starting offset, so the file holding an offset can be binary searched.
+    std::vector<ConcatenationEntry> files;
+    u64 size = 0;
     std::string name;
 };
 
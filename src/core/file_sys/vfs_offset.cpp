@@ -73,6 +73,14 @@ std::vector<u8> OffsetVfsFile::ReadAllBytes() const {
     return file->ReadBytes(size, offset);
 }
 
+std::optional<std::span<const u8>> OffsetVfsFile::GetSpan(std::size_t r_size,
+                                                          std::size_t r_offset) const {
+    if (r_offset >= size) {
+        return std::span<const u8>{};
+    }
+    return file->GetSpan(TrimToFit(r_size, r_offset), offset + r_offset);
+}
+
 bool OffsetVfsFile::WriteByte(u8 data, std::size_t r_offset) {
     if (r_offset < size)
         return file->WriteByte(data, offset + r_offset);
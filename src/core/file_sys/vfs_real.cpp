@@ -3,12 +3,17 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <atomic>
 #include <cstddef>
+#include <cstring>
 #include <iterator>
+#include <mutex>
+#include <shared_mutex>
 #include <utility>
 #include "common/assert.h"
 #include "common/fs/file.h"
 #include "common/fs/fs.h"
+#include "common/fs/mapped_file.h"
 #include "common/fs/path_util.h"
 #include "common/logging/log.h"
 #include "core/file_sys/vfs_real.h"
@@ -17,6 +22,17 @@ namespace FileSys {
 
 namespace FS = Common::FS;
 
+/// Read-only mapping of a file, shared by the RealVfsFiles that opened it for reading.
+struct RealVfsMapping {
+    explicit RealVfsMapping(const std::string& path) : file{path} {}
+
+    FS::MappedFile file;
+    /// Held shared while copying from the mapping, and exclusively to invalidate it
+    std::shared_mutex mutex;
+    /// Cleared when the file is opened for writing, reads go through IOFile from then on
+    std::atomic_bool is_valid{true};
+};
+
 namespace {
 
 constexpr FS::FileAccessMode ModeFlagsToFileAccessMode(Mode mode) {
@@ -76,7 +92,8 @@ VirtualFile RealVfsFilesystem::OpenFile(std::string_view path_, Mode perms) {
         const auto& weak = weak_iter->second;
 
         if (!weak.expired()) {
-            return std::shared_ptr<RealVfsFile>(new RealVfsFile(*this, weak.lock(), path, perms));
+            return std::shared_ptr<RealVfsFile>(
+                new RealVfsFile(*this, weak.lock(), OpenMapping(path, perms), path, perms));
         }
     }
 
@@ -89,7 +106,8 @@ VirtualFile RealVfsFilesystem::OpenFile(std::string_view path_, Mode perms) {
     cache.insert_or_assign(path, std::move(backing));
 
     // Cannot use make_shared as RealVfsFile constructor is private
-    return std::shared_ptr<RealVfsFile>(new RealVfsFile(*this, backing, path, perms));
+    return std::shared_ptr<RealVfsFile>(
+        new RealVfsFile(*this, backing, OpenMapping(path, perms), path, perms));
 }
 
 VirtualFile RealVfsFilesystem::CreateFile(std::string_view path_, Mode perms) {
@@ -123,6 +141,7 @@ VirtualFile RealVfsFilesystem::MoveFile(std::string_view old_path_, std::string_
     const auto old_path = FS::SanitizePath(old_path_, FS::DirectorySeparator::PlatformDefault);
     const auto new_path = FS::SanitizePath(new_path_, FS::DirectorySeparator::PlatformDefault);
     const auto cached_file_iter = cache.find(old_path);
+    CloseMapping(old_path);
 
     if (cached_file_iter != cache.cend()) {
         auto file = cached_file_iter->second.lock();
@@ -153,6 +172,7 @@ VirtualFile RealVfsFilesystem::MoveFile(std::string_view old_path_, std::string_
 bool RealVfsFilesystem::DeleteFile(std::string_view path_) {
     const auto path = FS::SanitizePath(path_, FS::DirectorySeparator::PlatformDefault);
     const auto cached_iter = cache.find(path);
+    CloseMapping(path);
 
     if (cached_iter != cache.cend()) {
         if (!cached_iter->second.expired()) {
@@ -164,6 +184,76 @@ bool RealVfsFilesystem::DeleteFile(std::string_view path_) {
     return FS::RemoveFile(path);
 }
 
+std::shared_ptr<RealVfsMapping> RealVfsFilesystem::OpenMapping(const std::string& path,
+                                                               Mode perms) {
+    // Only read-only files are mapped, any other mode could truncate the file under the mapping
+    // and fault the reads from it. Files still holding the mapping stop using it before then.
+    if (perms != Mode::Read) {
+        written_paths.insert(path);
+        if (const auto weak_iter = mapping_cache.find(path); weak_iter != mapping_cache.cend()) {
+            if (const auto mapping = weak_iter->second.lock()) {
+                std::scoped_lock lock{mapping->mutex};
+                mapping->is_valid = false;
+            }
+            mapping_cache.erase(weak_iter);
+        }
+        return nullptr;
+    }
+    if (written_paths.contains(path)) {
+        return nullptr;
+    }
+
+    if (const auto weak_iter = mapping_cache.find(path); weak_iter != mapping_cache.cend()) {
+        if (auto mapping = weak_iter->second.lock()) {
+            return mapping;
+        }
+    }
+
+    auto mapping = std::make_shared<RealVfsMapping>(path);
+    if (!mapping->file.IsOpen()) {
+        // Fall back to regular file reads
+        return nullptr;
+    }
+    mapping_cache.insert_or_assign(path, mapping);
+    return mapping;
+}
+
+void RealVfsFilesystem::CloseMapping(const std::string& path) {
+    const auto iter = mapping_cache.find(path);
+    if (iter == mapping_cache.cend()) {
+        return;
+    }
+    mapping_cache.erase(iter);
+}
+
+void RealVfsFilesystem::CloseMappings(const std::string& dir_path) {
+    for (auto iter = mapping_cache.begin(); iter != mapping_cache.end();) {
+        // If the path in the cache doesn't start with dir_path, then skip this file.
+        if (iter->first.rfind(dir_path, 0) != 0) {
+            ++iter;
+            continue;
+        }
+        iter = mapping_cache.erase(iter);
+    }
+}
+
+void RealVfsFilesystem::MoveWrittenPaths(const std::string& old_path,
+                                         const std::string& new_path) {
+    std::vector<std::string> moved_paths;
+    for (auto iter = written_paths.begin(); iter != written_paths.end();) {
+        const bool is_moved = iter->starts_with(old_path) &&
+                              (iter->size() == old_path.size() ||
+                               (*iter)[old_path.size()] == '/' || (*iter)[old_path.size()] == '\\');
+        if (!is_moved) {
+            ++iter;
+            continue;
+        }
+        moved_paths.push_back(new_path + iter->substr(old_path.size()));
+        iter = written_paths.erase(iter);
+    }
+    written_paths.insert(moved_paths.begin(), moved_paths.end());
+}
+
 VirtualDir RealVfsFilesystem::OpenDirectory(std::string_view path_, Mode perms) {
     const auto path = FS::SanitizePath(path_, FS::DirectorySeparator::PlatformDefault);
     // Cannot use make_shared as RealVfsDirectory constructor is private
@@ -190,9 +280,12 @@ VirtualDir RealVfsFilesystem::MoveDirectory(std::string_view old_path_,
     const auto old_path = FS::SanitizePath(old_path_, FS::DirectorySeparator::PlatformDefault);
     const auto new_path = FS::SanitizePath(new_path_, FS::DirectorySeparator::PlatformDefault);
 
+    CloseMappings(old_path);
+
     if (!FS::RenameDir(old_path, new_path)) {
         return nullptr;
     }
+    MoveWrittenPaths(old_path, new_path);
 
     for (auto& kv : cache) {
         // If the path in the cache doesn't start with old_path, then bail on this file.
@@ -225,6 +318,7 @@ VirtualDir RealVfsFilesystem::MoveDirectory(std::string_view old_path_,
 
 bool RealVfsFilesystem::DeleteDirectory(std::string_view path_) {
     const auto path = FS::SanitizePath(path_, FS::DirectorySeparator::PlatformDefault);
+    CloseMappings(path);
 
     for (auto& kv : cache) {
         // If the path in the cache doesn't start with path, then bail on this file.
@@ -244,9 +338,11 @@ bool RealVfsFilesystem::DeleteDirectory(std::string_view path_) {
 }
 
 RealVfsFile::RealVfsFile(RealVfsFilesystem& base_, std::shared_ptr<FS::IOFile> backing_,
-                         const std::string& path_, Mode perms_)
-    : base(base_), backing(std::move(backing_)), path(path_), parent_path(FS::GetParentPath(path_)),
-      path_components(FS::SplitPathComponents(path_)), perms(perms_) {}
+                         std::shared_ptr<RealVfsMapping> mapping_, const std::string& path_,
+                         Mode perms_)
+    : base(base_), backing(std::move(backing_)), mapping(std::move(mapping_)), path(path_),
+      parent_path(FS::GetParentPath(path_)), path_components(FS::SplitPathComponents(path_)),
+      perms(perms_) {}
 
 RealVfsFile::~RealVfsFile() = default;
 
@@ -275,6 +371,13 @@ bool RealVfsFile::IsReadable() const {
 }
 
 std::size_t RealVfsFile::Read(u8* data, std::size_t length, std::size_t offset) const {
+    if (mapping) {
+        std::shared_lock lock{mapping->mutex};
+        if (const auto span = GetSpan(length, offset)) {
+            std::memcpy(data, span->data(), span->size());
+            return span->size();
+        }
+    }
     if (!backing->Seek(static_cast<s64>(offset))) {
         return 0;
     }
@@ -288,6 +391,18 @@ std::size_t RealVfsFile::Write(const u8* data, std::size_t length, std::size_t o
     return backing->WriteSpan(std::span{data, length});
 }
 
+std::optional<std::span<const u8>> RealVfsFile::GetSpan(std::size_t length,
+                                                        std::size_t offset) const {
+    if (!mapping || !mapping->is_valid) {
+        return std::nullopt;
+    }
+    const auto contents = mapping->file.GetSpan();
+    if (offset >= contents.size()) {
+        return std::span<const u8>{};
+    }
+    return contents.subspan(offset, std::min(length, contents.size() - offset));
+}
+
 bool RealVfsFile::Rename(std::string_view name) {
     return base.MoveFile(path, parent_path + '/' + std::string(name)) != nullptr;
 }
@@ -6,15 +6,18 @@
 
 #include <string_view>
 #include <boost/container/flat_map.hpp>
+#include <boost/container/flat_set.hpp>
 #include "core/file_sys/mode.h"
 #include "core/file_sys/vfs.h"
 
 namespace Common::FS {
 class IOFile;
-}
+} // namespace Common::FS
 
 namespace FileSys {
 
+struct RealVfsMapping;
+
 class RealVfsFilesystem : public VfsFilesystem {
 public:
     RealVfsFilesystem();
@@ -36,7 +39,28 @@ public:
     bool DeleteDirectory(std::string_view path) override;
 
 private:
+    /**
+     * Returns a shared mapping of the file at path if it is opened read-only and was never opened
+     * for writing, nullptr otherwise. Opening a file for writing invalidates its mapping, as the
+     * file could be truncated under it, and the file is read through IOFile from then on.
+     */
+    std::shared_ptr<RealVfsMapping> OpenMapping(const std::string& path, Mode perms);
+
+    /// Stops sharing the mapping of the file at path, later opens map the file again. Files still
+    /// holding the mapping keep it alive, so views they handed out stay valid.
+    void CloseMapping(const std::string& path);
+
+    /// Stops sharing the mappings of every file inside the directory at dir_path.
+    void CloseMappings(const std::string& dir_path);
+
+    /// Carries over the paths opened for writing from old_path to new_path, for a file or for
+    /// every file inside a directory.
+    void MoveWrittenPaths(const std::string& old_path, const std::string& new_path);
+
     boost::container::flat_map<std::string, std::weak_ptr<Common::FS::IOFile>> cache;
+    boost::container::flat_map<std::string, std::weak_ptr<RealVfsMapping>> mapping_cache;
+    /// Files that were opened for writing, which are never mapped again
+    boost::container::flat_set<std::string> written_paths;
 };
 
 // An implmentation of VfsFile that represents a file on the user's computer.
@@ -55,16 +79,23 @@ public:
     bool IsReadable() const override;
     std::size_t Read(u8* data, std::size_t length, std::size_t offset) const override;
     std::size_t Write(const u8* data, std::size_t length, std::size_t offset) override;
+    /// Views of the mapping must not be held past the file being opened for writing, since it
+    /// may be truncated under them. Read copies under the mapping's lock instead.
+    std::optional<std::span<const u8>> GetSpan(std::size_t length,
+                                               std::size_t offset) const override;
     bool Rename(std::string_view name) override;
 
 private:
     RealVfsFile(RealVfsFilesystem& base, std::shared_ptr<Common::FS::IOFile> backing,
-                const std::string& path, Mode perms = Mode::Read);
+                std::shared_ptr<RealVfsMapping> mapping, const std::string& path,
+                Mode perms = Mode::Read);
 
     void Close();
 
     RealVfsFilesystem& base;
     std::shared_ptr<Common::FS::IOFile> backing;
+    /// Read-only mapping of the file, used to serve reads without a system call while it is valid
+    std::shared_ptr<RealVfsMapping> mapping;
     std::string path;
     std::string parent_path;
     std::vector<std::string> path_components;
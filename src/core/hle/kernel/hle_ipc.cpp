@@ -13,6 +13,7 @@
 #include "common/common_funcs.h"
 #include "common/common_types.h"
 #include "common/logging/log.h"
+#include "common/pool_allocator.h"
 #include "core/hle/ipc_helpers.h"
 #include "core/hle/kernel/hle_ipc.h"
 #include "core/hle/kernel/k_handle_table.h"
@@ -30,6 +31,38 @@
 
 namespace Kernel {
 
+namespace {
+
+/// Scratch buffers released by finished requests, kept to be reused by later ones.
+class ScratchBufferPool {
+public:
+    std::vector<u8> Acquire(std::size_t size) {
+        std::vector<u8> buffer;
+        if (!free_buffers.empty()) {
+            buffer = std::move(free_buffers.back());
+            free_buffers.pop_back();
+        }
+        buffer.resize(size);
+        return buffer;
+    }
+
+    void Release(std::vector<u8>&& buffer) {
+        if (free_buffers.size() < MAX_FREE_BUFFERS && buffer.capacity() <= MAX_BUFFER_CAPACITY) {
+            free_buffers.push_back(std::move(buffer));
+        }
+    }
+
+private:
+    static constexpr std::size_t MAX_FREE_BUFFERS = 8;
+    static constexpr std::size_t MAX_BUFFER_CAPACITY = 1024 * 1024;
+
+    std::vector<std::vector<u8>> free_buffers;
+};
+
+thread_local ScratchBufferPool scratch_buffer_pool;
+
+} // Anonymous namespace
+
 SessionRequestHandler::SessionRequestHandler(KernelCore& kernel_, const char* service_name_)
     : kernel{kernel_}, service_thread{kernel.CreateServiceThread(service_name_)} {}
 
@@ -70,7 +103,19 @@ HLERequestContext::HLERequestContext(KernelCore& kernel_, Core::Memory::Memory&
     cmd_buf[0] = 0;
 }
 
-HLERequestContext::~HLERequestContext() = default;
+HLERequestContext::~HLERequestContext() {
+    for (auto& buffer : scratch_buffers) {
+        scratch_buffer_pool.Release(std::move(buffer));
+    }
+}
+
+std::shared_ptr<HLERequestContext> HLERequestContext::Create(KernelCore& kernel,
+                                                             Core::Memory::Memory& memory,
+                                                             KServerSession* session,
+                                                             KThread* thread) {
+    return std::allocate_shared<HLERequestContext>(Common::PoolAllocator<HLERequestContext>{},
+                                                   kernel, memory, session, thread);
+}
 
 void HLERequestContext::ParseCommandBuffer(const KHandleTable& handle_table, u32_le* src_cmdbuf,
                                            bool incoming) {
@@ -234,6 +279,12 @@ ResultCode HLERequestContext::WriteToOutgoingCommandBuffer(KThread& requesting_t
         }
     }
 
+    // Copy the output buffers that could not be written in place to guest memory.
+    for (const auto& write : pending_writes) {
+        memory.WriteBlock(owner_process, write.address, write.data.data(), write.data.size());
+    }
+    pending_writes.clear();
+
     // Copy the translated command buffer back into the thread's command buffer area.
     memory.WriteBlock(owner_process, requesting_thread.GetTLSAddress(), cmd_buf.data(),
                       write_size * sizeof(u32));
@@ -296,6 +347,47 @@ std::size_t HLERequestContext::WriteBuffer(const void* buffer, std::size_t size,
     return size;
 }
 
+std::span<const u8> HLERequestContext::ReadBufferSpan(std::size_t buffer_index) {
+    const VAddr address = GetReadBufferAddress(buffer_index);
+    const std::size_t size = GetReadBufferSize(buffer_index);
+    if (size == 0) {
+        return {};
+    }
+    if (!OverlapsWriteBuffer(address, size)) {
+        if (const auto span = memory.GetSpan(address, size); !span.empty()) {
+            return span;
+        }
+    }
+    const std::span<u8> scratch = AcquireScratchBuffer(size);
+    memory.ReadBlock(address, scratch.data(), scratch.size());
+    return scratch;
+}
+
+std::span<u8> HLERequestContext::WriteBufferSpan(std::size_t buffer_index) {
+    const VAddr address = GetWriteBufferAddress(buffer_index);
+    const std::size_t size = GetWriteBufferSize(buffer_index);
+    if (size == 0) {
+        return {};
+    }
+    if (const auto span = memory.GetSpan(address, size); !span.empty()) {
+        return span;
+    }
+    const std::span<u8> scratch = AcquireScratchBuffer(size);
+    memory.ReadBlock(address, scratch.data(), scratch.size());
+    pending_writes.push_back({address, scratch});
+    return scratch;
+}
+
+std::span<u8> HLERequestContext::AcquireWriteBuffer(std::size_t buffer_index) {
+    const std::size_t size = GetWriteBufferSize(buffer_index);
+    if (size == 0) {
+        return {};
+    }
+    const std::span<u8> scratch = AcquireScratchBuffer(size);
+    std::fill(scratch.begin(), scratch.end(), u8{0});
+    return scratch;
+}
+
 std::size_t HLERequestContext::GetReadBufferSize(std::size_t buffer_index) const {
     const bool is_buffer_a{BufferDescriptorA().size() > buffer_index &&
                            BufferDescriptorA()[buffer_index].Size()};
@@ -351,6 +443,52 @@ bool HLERequestContext::CanWriteBuffer(std::size_t buffer_index) const {
     }
 }
 
+VAddr HLERequestContext::GetReadBufferAddress(std::size_t buffer_index) const {
+    const bool is_buffer_a{BufferDescriptorA().size() > buffer_index &&
+                           BufferDescriptorA()[buffer_index].Size()};
+    if (is_buffer_a) {
+        return BufferDescriptorA()[buffer_index].Address();
+    }
+    if (BufferDescriptorX().size() > buffer_index) {
+        return BufferDescriptorX()[buffer_index].Address();
+    }
+    return 0;
+}
+
+VAddr HLERequestContext::GetWriteBufferAddress(std::size_t buffer_index) const {
+    const bool is_buffer_b{BufferDescriptorB().size() > buffer_index &&
+                           BufferDescriptorB()[buffer_index].Size()};
+    if (is_buffer_b) {
+        return BufferDescriptorB()[buffer_index].Address();
+    }
+    if (BufferDescriptorC().size() > buffer_index) {
+        return BufferDescriptorC()[buffer_index].Address();
+    }
+    return 0;
+}
+
+bool HLERequestContext::OverlapsWriteBuffer(VAddr address, std::size_t size) const {
+    const auto overlaps = [address, size](VAddr buffer_address, std::size_t buffer_size) {
+        return buffer_size != 0 && address < buffer_address + buffer_size &&
+               buffer_address < address + size;
+    };
+    for (const auto& descriptor : BufferDescriptorB()) {
+        if (overlaps(descriptor.Address(), descriptor.Size())) {
+            return true;
+        }
+    }
+    for (const auto& descriptor : BufferDescriptorC()) {
+        if (overlaps(descriptor.Address(), descriptor.Size())) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::span<u8> HLERequestContext::AcquireScratchBuffer(std::size_t size) {
+    return scratch_buffers.emplace_back(scratch_buffer_pool.Acquire(size));
+}
+
 std::string HLERequestContext::Description() const {
     if (!command_header) {
         return "No command header available";
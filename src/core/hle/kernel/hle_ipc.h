@@ -8,10 +8,13 @@
 #include <functional>
 #include <memory>
 #include <optional>
+#include <span>
 #include <string>
 #include <type_traits>
 #include <vector>
 
+#include <boost/container/small_vector.hpp>
+
 #include "common/assert.h"
 #include "common/common_types.h"
 #include "common/concepts.h"
@@ -188,10 +191,19 @@ private:
  */
 class HLERequestContext {
 public:
+    /// Keeps the handles and buffers of typical requests inline, so they don't allocate.
+    template <typename T>
+    using IPCVector = boost::container::small_vector<T, 4>;
+
     explicit HLERequestContext(KernelCore& kernel, Core::Memory::Memory& memory,
                                KServerSession* session, KThread* thread);
     ~HLERequestContext();
 
+    /// Creates a context in memory recycled from finished requests, so it doesn't allocate.
+    static std::shared_ptr<HLERequestContext> Create(KernelCore& kernel,
+                                                     Core::Memory::Memory& memory,
+                                                     KServerSession* session, KThread* thread);
+
     /// Returns a pointer to the IPC command buffer for this request.
     u32* CommandBuffer() {
         return cmd_buf.data();
@@ -241,19 +253,19 @@ public:
         return data_payload_offset;
     }
 
-    const std::vector<IPC::BufferDescriptorX>& BufferDescriptorX() const {
+    const IPCVector<IPC::BufferDescriptorX>& BufferDescriptorX() const {
         return buffer_x_desciptors;
     }
 
-    const std::vector<IPC::BufferDescriptorABW>& BufferDescriptorA() const {
+    const IPCVector<IPC::BufferDescriptorABW>& BufferDescriptorA() const {
         return buffer_a_desciptors;
     }
 
-    const std::vector<IPC::BufferDescriptorABW>& BufferDescriptorB() const {
+    const IPCVector<IPC::BufferDescriptorABW>& BufferDescriptorB() const {
         return buffer_b_desciptors;
     }
 
-    const std::vector<IPC::BufferDescriptorC>& BufferDescriptorC() const {
+    const IPCVector<IPC::BufferDescriptorC>& BufferDescriptorC() const {
         return buffer_c_desciptors;
     }
 
@@ -294,6 +306,28 @@ public:
         }
     }
 
+    /**
+     * Returns the contents of an input buffer, in place when the buffer is contiguous in host
+     * memory and does not overlap an output buffer. Otherwise the contents are copied into a
+     * scratch buffer owned by the request. The span is valid for the lifetime of the request.
+     */
+    std::span<const u8> ReadBufferSpan(std::size_t buffer_index = 0);
+
+    /**
+     * Returns an output buffer that the reply can be written into directly. The span initially
+     * holds the current contents of the guest buffer. When the buffer is not contiguous in host
+     * memory, a scratch buffer is returned instead and copied to the guest with the rest of the
+     * reply, so it must not be mixed with WriteBuffer on the same buffer index.
+     */
+    std::span<u8> WriteBufferSpan(std::size_t buffer_index = 0);
+
+    /**
+     * Returns a zero-initialized scratch buffer the size of an output buffer. Nothing reaches the
+     * guest until the caller passes it to WriteBuffer, so handlers that only write their output
+     * on success can still avoid allocating.
+     */
+    std::span<u8> AcquireWriteBuffer(std::size_t buffer_index = 0);
+
     /// Helper function to get the size of the input buffer
     std::size_t GetReadBufferSize(std::size_t buffer_index = 0) const;
 
@@ -350,26 +384,46 @@ private:
 
     void ParseCommandBuffer(const KHandleTable& handle_table, u32_le* src_cmdbuf, bool incoming);
 
+    /// Returns the guest address of the input buffer at buffer_index, or 0 if there is none.
+    VAddr GetReadBufferAddress(std::size_t buffer_index) const;
+
+    /// Returns the guest address of the output buffer at buffer_index, or 0 if there is none.
+    VAddr GetWriteBufferAddress(std::size_t buffer_index) const;
+
+    /// Returns true if the given guest range overlaps any output buffer.
+    bool OverlapsWriteBuffer(VAddr address, std::size_t size) const;
+
+    /// Returns a pooled scratch buffer that lives as long as the request.
+    std::span<u8> AcquireScratchBuffer(std::size_t size);
+
+    struct PendingWrite {
+        VAddr address;
+        std::span<const u8> data;
+    };
+
     std::array<u32, IPC::COMMAND_BUFFER_LENGTH> cmd_buf;
     Kernel::KServerSession* server_session{};
     KThread* thread;
 
-    std::vector<Handle> incoming_move_handles;
-    std::vector<Handle> incoming_copy_handles;
+    IPCVector<Handle> incoming_move_handles;
+    IPCVector<Handle> incoming_copy_handles;
 
-    std::vector<KAutoObject*> outgoing_move_objects;
-    std::vector<KAutoObject*> outgoing_copy_objects;
-    std::vector<SessionRequestHandlerPtr> outgoing_domain_objects;
+    IPCVector<KAutoObject*> outgoing_move_objects;
+    IPCVector<KAutoObject*> outgoing_copy_objects;
+    IPCVector<SessionRequestHandlerPtr> outgoing_domain_objects;
 
     std::optional<IPC::CommandHeader> command_header;
     std::optional<IPC::HandleDescriptorHeader> handle_descriptor_header;
     std::optional<IPC::DataPayloadHeader> data_payload_header;
     std::optional<IPC::DomainMessageHeader> domain_message_header;
-    std::vector<IPC::BufferDescriptorX> buffer_x_desciptors;
-    std::vector<IPC::BufferDescriptorABW> buffer_a_desciptors;
-    std::vector<IPC::BufferDescriptorABW> buffer_b_desciptors;
-    std::vector<IPC::BufferDescriptorABW> buffer_w_desciptors;
-    std::vector<IPC::BufferDescriptorC> buffer_c_desciptors;
+    IPCVector<IPC::BufferDescriptorX> buffer_x_desciptors;
+    IPCVector<IPC::BufferDescriptorABW> buffer_a_desciptors;
+    IPCVector<IPC::BufferDescriptorABW> buffer_b_desciptors;
+    IPCVector<IPC::BufferDescriptorABW> buffer_w_desciptors;
+    IPCVector<IPC::BufferDescriptorC> buffer_c_desciptors;
+
+    IPCVector<std::vector<u8>> scratch_buffers;
+    IPCVector<PendingWrite> pending_writes;
 
     u32_le command{};
     u64 pid{};
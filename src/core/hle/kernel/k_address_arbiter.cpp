@@ -2,7 +2,6 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
-#include "core/arm/exclusive_monitor.h"
 #include "core/core.h"
 #include "core/hle/kernel/k_address_arbiter.h"
 #include "core/hle/kernel/k_scheduler.h"
@@ -27,29 +26,24 @@ bool ReadFromUser(Core::System& system, s32* out, VAddr address) {
 }
 
 bool DecrementIfLessThan(Core::System& system, s32* out, VAddr address, s32 value) {
-    auto& monitor = system.Monitor();
-    const auto current_core = system.CurrentCoreIndex();
+    auto& memory = system.Memory();
 
     // TODO(bunnei): We should disable interrupts here via KScopedInterruptDisable.
     // TODO(bunnei): We should call CanAccessAtomic(..) here.
 
-    // Load the value from the address.
-    const s32 current_value = static_cast<s32>(monitor.ExclusiveRead32(current_core, address));
+    // Compare and swap on the guest memory directly, a guest exclusive store racing with it fails
+    // the same way it would against another core.
+    s32 current_value{};
+    do {
+        // Load the value from the address.
+        current_value = static_cast<s32>(memory.Read32(address));
 
-    // Compare it to the desired one.
-    if (current_value < value) {
-        // If less than, we want to try to decrement.
-        const s32 decrement_value = current_value - 1;
-
-        // Decrement and try to store.
-        if (!monitor.ExclusiveWrite32(current_core, address, static_cast<u32>(decrement_value))) {
-            // If we failed to store, try again.
-            DecrementIfLessThan(system, out, address, value);
+        // If not less than the desired one, there's nothing to decrement.
+        if (current_value >= value) {
+            break;
         }
-    } else {
-        // Otherwise, clear our exclusive hold and finish
-        monitor.ClearExclusive();
-    }
+    } while (!memory.WriteExclusive32(address, static_cast<u32>(current_value - 1),
+                                      static_cast<u32>(current_value)));
 
     // We're done.
     *out = current_value;
@@ -57,28 +51,22 @@ bool DecrementIfLessThan(Core::System& system, s32* out, VAddr address, s32 valu
 }
 
 bool UpdateIfEqual(Core::System& system, s32* out, VAddr address, s32 value, s32 new_value) {
-    auto& monitor = system.Monitor();
-    const auto current_core = system.CurrentCoreIndex();
+    auto& memory = system.Memory();
 
     // TODO(bunnei): We should disable interrupts here via KScopedInterruptDisable.
     // TODO(bunnei): We should call CanAccessAtomic(..) here.
 
-    // Load the value from the address.
-    const s32 current_value = static_cast<s32>(monitor.ExclusiveRead32(current_core, address));
+    s32 current_value{};
+    do {
+        // Load the value from the address.
+        current_value = static_cast<s32>(memory.Read32(address));
 
-    // Compare it to the desired one.
-    if (current_value == value) {
-        // If equal, we want to try to write the new value.
-
-        // Try to store.
-        if (!monitor.ExclusiveWrite32(current_core, address, static_cast<u32>(new_value))) {
-            // If we failed to store, try again.
-            UpdateIfEqual(system, out, address, value, new_value);
+        // If not equal to the desired one, leave it untouched.
+        if (current_value != value) {
+            break;
         }
-    } else {
-        // Otherwise, clear our exclusive hold and finish.
-        monitor.ClearExclusive();
-    }
+    } while (!memory.WriteExclusive32(address, static_cast<u32>(new_value),
+                                      static_cast<u32>(current_value)));
 
     // We're done.
     *out = current_value;
@@ -88,10 +76,23 @@ bool UpdateIfEqual(Core::System& system, s32* out, VAddr address, s32 value, s32
 } // namespace
 
 ResultCode KAddressArbiter::Signal(VAddr addr, s32 count) {
+    auto& bucket = thread_trees.GetBucket(addr);
+    ThreadTree& thread_tree = bucket.tree;
+
+    // Waiters check the address with the bucket lock held, so a signal that finds none has
+    // nothing to do and doesn't need the scheduler lock.
+    {
+        KScopedSpinLock lk(bucket.lock);
+        if (!KThreadTreeTable::HasWaiter(bucket, addr)) {
+            return ResultSuccess;
+        }
+    }
+
     // Perform signaling.
     s32 num_waiters{};
     {
         KScopedSchedulerLock sl(kernel);
+        KScopedSpinLock lk(bucket.lock);
 
         auto it = thread_tree.nfind_light({addr, -1});
         while ((it != thread_tree.end()) && (count <= 0 || num_waiters < count) &&
@@ -111,10 +112,14 @@ ResultCode KAddressArbiter::Signal(VAddr addr, s32 count) {
 }
 
 ResultCode KAddressArbiter::SignalAndIncrementIfEqual(VAddr addr, s32 value, s32 count) {
+    auto& bucket = thread_trees.GetBucket(addr);
+    ThreadTree& thread_tree = bucket.tree;
+
     // Perform signaling.
     s32 num_waiters{};
     {
         KScopedSchedulerLock sl(kernel);
+        KScopedSpinLock lk(bucket.lock);
 
         // Check the userspace value.
         s32 user_value{};
@@ -144,10 +149,14 @@ ResultCode KAddressArbiter::SignalAndIncrementIfEqual(VAddr addr, s32 value, s32
 }
 
 ResultCode KAddressArbiter::SignalAndModifyByWaitingCountIfEqual(VAddr addr, s32 value, s32 count) {
+    auto& bucket = thread_trees.GetBucket(addr);
+    ThreadTree& thread_tree = bucket.tree;
+
     // Perform signaling.
     s32 num_waiters{};
     {
         [[maybe_unused]] const KScopedSchedulerLock sl(kernel);
+        [[maybe_unused]] const KScopedSpinLock lk(bucket.lock);
 
         auto it = thread_tree.nfind_light({addr, -1});
         // Determine the updated value.
@@ -212,6 +221,9 @@ ResultCode KAddressArbiter::SignalAndModifyByWaitingCountIfEqual(VAddr addr, s32
 }
 
 ResultCode KAddressArbiter::WaitIfLessThan(VAddr addr, s32 value, bool decrement, s64 timeout) {
+    auto& bucket = thread_trees.GetBucket(addr);
+    ThreadTree& thread_tree = bucket.tree;
+
     // Prepare to wait.
     KThread* cur_thread = kernel.CurrentScheduler()->GetCurrentThread();
 
@@ -227,6 +239,10 @@ ResultCode KAddressArbiter::WaitIfLessThan(VAddr addr, s32 value, bool decrement
         // Set the synced object.
         cur_thread->SetSyncedObject(nullptr, ResultTimedOut);
 
+        // Check the value and start waiting under the bucket lock, so that signals searching the
+        // bucket without the scheduler lock either find this thread or were sent before the check.
+        KScopedSpinLock lk(bucket.lock);
+
         // Read the value from userspace.
         s32 user_value{};
         bool succeeded{};
@@ -254,7 +270,7 @@ ResultCode KAddressArbiter::WaitIfLessThan(VAddr addr, s32 value, bool decrement
         }
 
         // Set the arbiter.
-        cur_thread->SetAddressArbiter(&thread_tree, addr);
+        cur_thread->SetAddressArbiter(&thread_tree, &bucket.lock, addr);
         thread_tree.insert(*cur_thread);
         cur_thread->SetState(ThreadState::Waiting);
         cur_thread->SetWaitReasonForDebugging(ThreadWaitReasonForDebugging::Arbitration);
@@ -266,6 +282,7 @@ ResultCode KAddressArbiter::WaitIfLessThan(VAddr addr, s32 value, bool decrement
     // Remove from the address arbiter.
     {
         KScopedSchedulerLock sl(kernel);
+        KScopedSpinLock lk(bucket.lock);
 
         if (cur_thread->IsWaitingForAddressArbiter()) {
             thread_tree.erase(thread_tree.iterator_to(*cur_thread));
@@ -279,6 +296,9 @@ ResultCode KAddressArbiter::WaitIfLessThan(VAddr addr, s32 value, bool decrement
 }
 
 ResultCode KAddressArbiter::WaitIfEqual(VAddr addr, s32 value, s64 timeout) {
+    auto& bucket = thread_trees.GetBucket(addr);
+    ThreadTree& thread_tree = bucket.tree;
+
     // Prepare to wait.
     KThread* cur_thread = kernel.CurrentScheduler()->GetCurrentThread();
 
@@ -294,6 +314,10 @@ ResultCode KAddressArbiter::WaitIfEqual(VAddr addr, s32 value, s64 timeout) {
         // Set the synced object.
         cur_thread->SetSyncedObject(nullptr, ResultTimedOut);
 
+        // Check the value and start waiting under the bucket lock, so that signals searching the
+        // bucket without the scheduler lock either find this thread or were sent before the check.
+        KScopedSpinLock lk(bucket.lock);
+
         // Read the value from userspace.
         s32 user_value{};
         if (!ReadFromUser(system, &user_value, addr)) {
@@ -314,7 +338,7 @@ ResultCode KAddressArbiter::WaitIfEqual(VAddr addr, s32 value, s64 timeout) {
         }
 
         // Set the arbiter.
-        cur_thread->SetAddressArbiter(&thread_tree, addr);
+        cur_thread->SetAddressArbiter(&thread_tree, &bucket.lock, addr);
         thread_tree.insert(*cur_thread);
         cur_thread->SetState(ThreadState::Waiting);
         cur_thread->SetWaitReasonForDebugging(ThreadWaitReasonForDebugging::Arbitration);
@@ -326,6 +350,7 @@ ResultCode KAddressArbiter::WaitIfEqual(VAddr addr, s32 value, s64 timeout) {
     // Remove from the address arbiter.
     {
         KScopedSchedulerLock sl(kernel);
+        KScopedSpinLock lk(bucket.lock);
 
         if (cur_thread->IsWaitingForAddressArbiter()) {
             thread_tree.erase(thread_tree.iterator_to(*cur_thread));
@@ -61,7 +61,7 @@ private:
     [[nodiscard]] ResultCode WaitIfLessThan(VAddr addr, s32 value, bool decrement, s64 timeout);
     [[nodiscard]] ResultCode WaitIfEqual(VAddr addr, s32 value, s64 timeout);
 
-    ThreadTree thread_tree;
+    KThreadTreeTable thread_trees;
 
     Core::System& system;
     KernelCore& kernel;
@@ -4,7 +4,6 @@
 
 #include <vector>
 
-#include "core/arm/exclusive_monitor.h"
 #include "core/core.h"
 #include "core/hle/kernel/k_condition_variable.h"
 #include "core/hle/kernel/k_linked_list.h"
@@ -34,25 +33,24 @@ bool WriteToUser(Core::System& system, VAddr address, const u32* p) {
 
 bool UpdateLockAtomic(Core::System& system, u32* out, VAddr address, u32 if_zero,
                       u32 new_orr_mask) {
-    auto& monitor = system.Monitor();
-    const auto current_core = system.CurrentCoreIndex();
+    auto& memory = system.Memory();
 
-    // Load the value from the address.
-    const auto expected = monitor.ExclusiveRead32(current_core, address);
+    u32 expected{};
+    u32 value{};
+    do {
+        // Load the value from the address.
+        expected = memory.Read32(address);
 
-    // Orr in the new mask.
-    u32 value = expected | new_orr_mask;
+        // Orr in the new mask.
+        value = expected | new_orr_mask;
 
-    // If the value is zero, use the if_zero value, otherwise use the newly orr'd value.
-    if (!expected) {
-        value = if_zero;
-    }
+        // If the value is zero, use the if_zero value, otherwise use the newly orr'd value.
+        if (!expected) {
+            value = if_zero;
+        }
 
-    // Try to store.
-    if (!monitor.ExclusiveWrite32(current_core, address, value)) {
-        // If we failed to store, try again.
-        return UpdateLockAtomic(system, out, address, if_zero, new_orr_mask);
-    }
+        // Try to store with a compare and swap on the guest memory, retrying if it changed.
+    } while (!memory.WriteExclusive32(address, value, expected));
 
     // We're done.
     *out = expected;
@@ -211,6 +209,20 @@ KThread* KConditionVariable::SignalImpl(KThread* thread) {
 }
 
 void KConditionVariable::Signal(u64 cv_key, s32 count) {
+    auto& bucket = thread_trees.GetBucket(cv_key);
+    ThreadTree& thread_tree = bucket.tree;
+
+    // Waiters set the has waiter flag with the bucket lock held. Without waiters there is nobody to
+    // wake up, clearing the flag doesn't need the scheduler lock.
+    {
+        KScopedSpinLock lk(bucket.lock);
+        if (!KThreadTreeTable::HasWaiter(bucket, cv_key)) {
+            const u32 has_waiter_flag{};
+            WriteToUser(system, cv_key, std::addressof(has_waiter_flag));
+            return;
+        }
+    }
+
     // Prepare for signaling.
     constexpr int MaxThreads = 16;
 
@@ -236,8 +248,13 @@ void KConditionVariable::Signal(u64 cv_key, s32 count) {
                 }
             }
 
-            it = thread_tree.erase(it);
-            target_thread->ClearConditionVariable();
+            // Signaling may update the priority of other waiters in the bucket, which takes the
+            // bucket lock, so it is only held to remove the thread.
+            {
+                KScopedSpinLock lk(bucket.lock);
+                it = thread_tree.erase(it);
+                target_thread->ClearConditionVariable();
+            }
             ++num_waiters;
         }
 
@@ -260,6 +277,9 @@ void KConditionVariable::Signal(u64 cv_key, s32 count) {
 }
 
 ResultCode KConditionVariable::Wait(VAddr addr, u64 key, u32 value, s64 timeout) {
+    auto& bucket = thread_trees.GetBucket(key);
+    ThreadTree& thread_tree = bucket.tree;
+
     // Prepare to wait.
     KThread* cur_thread = kernel.CurrentScheduler()->GetCurrentThread();
 
@@ -296,6 +316,11 @@ ResultCode KConditionVariable::Wait(VAddr addr, u64 key, u32 value, s64 timeout)
                 next_owner_thread->Wakeup();
             }
 
+            // Set the has waiter flag, release the lock and start waiting under the bucket lock, so
+            // that signals searching the bucket without the scheduler lock either find this thread
+            // or are sent before the flag is set.
+            KScopedSpinLock lk(bucket.lock);
+
             // Write to the cv key.
             {
                 const u32 has_waiter_flag = 1;
@@ -308,11 +333,10 @@ ResultCode KConditionVariable::Wait(VAddr addr, u64 key, u32 value, s64 timeout)
                 slp.CancelSleep();
                 return ResultInvalidCurrentMemory;
             }
-        }
 
-        // Update condition variable tracking.
-        {
-            cur_thread->SetConditionVariable(std::addressof(thread_tree), addr, key, value);
+            // Update condition variable tracking.
+            cur_thread->SetConditionVariable(std::addressof(thread_tree),
+                                             std::addressof(bucket.lock), addr, key, value);
             thread_tree.insert(*cur_thread);
         }
 
@@ -336,6 +360,7 @@ ResultCode KConditionVariable::Wait(VAddr addr, u64 key, u32 value, s64 timeout)
         }
 
         if (cur_thread->IsWaitingForConditionVariable()) {
+            KScopedSpinLock lk(bucket.lock);
             thread_tree.erase(thread_tree.iterator_to(*cur_thread));
             cur_thread->ClearConditionVariable();
         }
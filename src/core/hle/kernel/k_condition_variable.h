@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <array>
+
 #include "common/assert.h"
 #include "common/common_types.h"
 
@@ -18,10 +20,45 @@ class System;
 
 namespace Kernel {
 
-class KConditionVariable {
+/**
+ * Waiting threads hashed by the address or key they wait on. Threads waiting on the same key
+ * always share a tree, so lookups only search the waiters of a few addresses instead of every
+ * waiter in the process. Threads remember their tree, so removing them needs no lookup.
+ *
+ * Trees are only modified with both the scheduler lock and the lock of their bucket held, so
+ * holding either one is enough to search a tree. Signals search their bucket without the
+ * scheduler lock and only take it when there is a thread to wake up.
+ */
+class KThreadTreeTable {
 public:
     using ThreadTree = typename KThread::ConditionVariableThreadTreeType;
 
+    struct Bucket {
+        ThreadTree tree;
+        KSpinLock lock;
+    };
+
+    [[nodiscard]] Bucket& GetBucket(u64 key) {
+        // Keys are at least word aligned, Fibonacci hashing spreads them over the buckets
+        return buckets[(key * 0x9E3779B97F4A7C15ULL) >> (64 - NumBucketBits)];
+    }
+
+    /// Returns whether a thread waits on the key. The caller must hold one of the two locks.
+    [[nodiscard]] static bool HasWaiter(Bucket& bucket, u64 key) {
+        const auto it = bucket.tree.nfind_light({key, -1});
+        return it != bucket.tree.end() && it->GetConditionVariableKey() == key;
+    }
+
+private:
+    static constexpr size_t NumBucketBits = 6;
+
+    std::array<Bucket, 1ULL << NumBucketBits> buckets;
+};
+
+class KConditionVariable {
+public:
+    using ThreadTree = KThreadTreeTable::ThreadTree;
+
     explicit KConditionVariable(Core::System& system_);
     ~KConditionVariable();
 
@@ -36,7 +73,7 @@ public:
 private:
     [[nodiscard]] KThread* SignalImpl(KThread* thread);
 
-    ThreadTree thread_tree;
+    KThreadTreeTable thread_trees;
 
     Core::System& system;
     KernelCore& kernel;
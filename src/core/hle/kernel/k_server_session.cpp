@@ -116,7 +116,7 @@ ResultCode KServerSession::HandleDomainSyncRequest(Kernel::HLERequestContext& co
 
 ResultCode KServerSession::QueueSyncRequest(KThread* thread, Core::Memory::Memory& memory) {
     u32* cmd_buf{reinterpret_cast<u32*>(memory.GetPointer(thread->GetTLSAddress()))};
-    auto context = std::make_shared<HLERequestContext>(kernel, memory, this, thread);
+    auto context = HLERequestContext::Create(kernel, memory, this, thread);
 
     context->PopulateFromIncomingCommandBuffer(kernel.CurrentProcess()->GetHandleTable(), cmd_buf);
 
@@ -145,6 +145,21 @@ ResultCode KServerSession::QueueSyncRequest(KThread* thread, Core::Memory::Memor
 }
 
 ResultCode KServerSession::CompleteSyncRequest(HLERequestContext& context) {
+    const ResultCode result = HandleRequest(context);
+
+    // Some service requests require the thread to block
+    {
+        KScopedSchedulerLock lock(kernel);
+        if (!context.IsThreadWaiting()) {
+            context.GetThread().Wakeup();
+            context.GetThread().SetSyncedObject(nullptr, result);
+        }
+    }
+
+    return result;
+}
+
+ResultCode KServerSession::HandleRequest(HLERequestContext& context) {
     ResultCode result = ResultSuccess;
 
     // If the session has been converted to a domain, handle the domain request
@@ -168,15 +183,6 @@ ResultCode KServerSession::CompleteSyncRequest(HLERequestContext& context) {
         convert_to_domain = false;
     }
 
-    // Some service requests require the thread to block
-    {
-        KScopedSchedulerLock lock(kernel);
-        if (!context.IsThreadWaiting()) {
-            context.GetThread().Wakeup();
-            context.GetThread().SetSyncedObject(nullptr, result);
-        }
-    }
-
     return result;
 }
 
@@ -40,6 +40,7 @@ class KServerSession final : public KSynchronizationObject,
     KERNEL_AUTOOBJECT_TRAITS(KServerSession, KSynchronizationObject);
 
     friend class ServiceThread;
+    friend class ServiceThreadPool;
 
 public:
     explicit KServerSession(KernelCore& kernel_);
@@ -105,6 +106,9 @@ public:
         return manager;
     }
 
+    /// Forwards a request to the handler of the session, without waking up the requesting thread.
+    ResultCode HandleRequest(HLERequestContext& context);
+
 private:
     /// Queues a sync request from the emulated application.
     ResultCode QueueSyncRequest(KThread* thread, Core::Memory::Memory& memory);
@@ -124,6 +128,9 @@ private:
 
     /// KSession that owns this KServerSession
     KSession* parent{};
+
+    /// Requests waiting to be handled by the service thread pool, in the order they were sent
+    ServiceRequestQueue request_queue;
 };
 
 } // namespace Kernel
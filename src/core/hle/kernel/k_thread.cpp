@@ -116,6 +116,7 @@ ResultCode KThread::Initialize(KThreadFunction func, uintptr_t arg, VAddr user_s
     // Set parent and condvar tree.
     parent = nullptr;
     condvar_tree = nullptr;
+    condvar_tree_lock = nullptr;
 
     // Set sync booleans.
     signaled = false;
@@ -866,8 +867,11 @@ void KThread::RestorePriority(KernelCore& kernel_ctx, KThread* thread) {
             return;
         }
 
-        // Ensure we don't violate condition variable red black tree invariants.
-        if (auto* cv_tree = thread->GetConditionVariableTree(); cv_tree != nullptr) {
+        // Ensure we don't violate condition variable red black tree invariants. The tree lock is
+        // held until the thread is back in the tree, so signals never miss it.
+        auto* const cv_tree = thread->GetConditionVariableTree();
+        if (cv_tree != nullptr) {
+            thread->GetConditionVariableTreeLock()->Lock();
             BeforeUpdatePriority(kernel_ctx, cv_tree, thread);
         }
 
@@ -876,8 +880,9 @@ void KThread::RestorePriority(KernelCore& kernel_ctx, KThread* thread) {
         thread->SetPriority(new_priority);
 
         // Restore the condition variable, if relevant.
-        if (auto* cv_tree = thread->GetConditionVariableTree(); cv_tree != nullptr) {
+        if (cv_tree != nullptr) {
             AfterUpdatePriority(kernel_ctx, cv_tree, thread);
+            thread->GetConditionVariableTreeLock()->Unlock();
         }
 
         // Update the scheduler.
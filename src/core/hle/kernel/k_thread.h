@@ -662,6 +662,7 @@ private:
     using ConditionVariableThreadTree =
         ConditionVariableThreadTreeTraits::TreeType<ConditionVariableComparator>;
     ConditionVariableThreadTree* condvar_tree{};
+    KSpinLock* condvar_tree_lock{};
     u64 condvar_key{};
     u64 virtual_affinity_mask{};
     KAffinityMask physical_affinity_mask{};
@@ -718,9 +719,10 @@ private:
 public:
     using ConditionVariableThreadTreeType = ConditionVariableThreadTree;
 
-    void SetConditionVariable(ConditionVariableThreadTree* tree, VAddr address, u64 cv_key,
-                              u32 value) {
+    void SetConditionVariable(ConditionVariableThreadTree* tree, KSpinLock* tree_lock,
+                              VAddr address, u64 cv_key, u32 value) {
         condvar_tree = tree;
+        condvar_tree_lock = tree_lock;
         condvar_key = cv_key;
         address_key = address;
         address_key_value = value;
@@ -728,19 +730,23 @@ public:
 
     void ClearConditionVariable() {
         condvar_tree = nullptr;
+        condvar_tree_lock = nullptr;
     }
 
     [[nodiscard]] bool IsWaitingForConditionVariable() const {
         return condvar_tree != nullptr;
     }
 
-    void SetAddressArbiter(ConditionVariableThreadTree* tree, u64 address) {
+    void SetAddressArbiter(ConditionVariableThreadTree* tree, KSpinLock* tree_lock,
+                           u64 address) {
         condvar_tree = tree;
+        condvar_tree_lock = tree_lock;
         condvar_key = address;
     }
 
     void ClearAddressArbiter() {
         condvar_tree = nullptr;
+        condvar_tree_lock = nullptr;
     }
 
     [[nodiscard]] bool IsWaitingForAddressArbiter() const {
@@ -750,6 +756,11 @@ public:
     [[nodiscard]] ConditionVariableThreadTree* GetConditionVariableTree() const {
         return condvar_tree;
     }
+
+    /// Returns the lock that must be held, with the scheduler lock, to modify the tree.
+    [[nodiscard]] KSpinLock* GetConditionVariableTreeLock() const {
+        return condvar_tree_lock;
+    }
 };
 
 } // namespace Kernel
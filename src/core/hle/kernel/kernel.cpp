@@ -7,6 +7,7 @@
 #include <bitset>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <thread>
 #include <unordered_set>
 #include <utility>
@@ -51,6 +52,23 @@ MICROPROFILE_DEFINE(Kernel_SVC, "Kernel", "SVC", MP_RGB(70, 200, 70));
 
 namespace Kernel {
 
+namespace {
+
+void LogServiceThreadStats(const ServiceThread& service_thread) {
+    const ServiceThreadStats stats = service_thread.GetStats();
+    if (stats.requests == 0) {
+        return;
+    }
+    LOG_DEBUG(Kernel,
+              "Service {}: {} requests, max queue depth {}, average wait {:.1f} us, "
+              "max wait {:.1f} us, total run time {:.1f} ms",
+              service_thread.GetName(), stats.requests, stats.max_queue_depth,
+              stats.AverageWaitNs() / 1000.0, static_cast<double>(stats.max_wait_ns) / 1000.0,
+              static_cast<double>(stats.total_run_ns) / 1000000.0);
+}
+
+} // Anonymous namespace
+
 struct KernelCore::Impl {
     explicit Impl(Core::System& system_, KernelCore& kernel_)
         : time_manager{system_}, object_list_container{kernel_}, system{system_} {}
@@ -93,8 +111,24 @@ struct KernelCore::Impl {
     void Shutdown() {
         process_list.clear();
 
-        // Ensures all service threads gracefully shutdown
-        service_threads.clear();
+        // Ensures all service threads gracefully shutdown. The pool is destroyed without holding
+        // the lock, as requests still being handled may create service threads. Those may bring
+        // up a new pool, which is shut down in turn.
+        while (true) {
+            std::unique_ptr<Kernel::ServiceThreadPool> pool;
+            {
+                std::scoped_lock lock{service_threads_lock};
+                for (const auto& service_thread : service_threads) {
+                    LogServiceThreadStats(*service_thread);
+                }
+                service_threads.clear();
+                pool = std::move(service_thread_pool);
+            }
+            if (!pool) {
+                break;
+            }
+            pool.reset();
+        }
 
         next_object_id = 0;
         next_kernel_process_id = KProcess::InitialKIPIDMin;
@@ -675,7 +709,9 @@ struct KernelCore::Impl {
     Kernel::KSharedMemory* time_shared_mem{};
 
     // Threads used for services
+    std::unique_ptr<Kernel::ServiceThreadPool> service_thread_pool;
     std::unordered_set<std::shared_ptr<Kernel::ServiceThread>> service_threads;
+    std::mutex service_threads_lock;
 
     std::array<KThread*, Core::Hardware::NUM_CPU_CORES> suspend_threads;
     std::array<Core::CPUInterruptHandler, Core::Hardware::NUM_CPU_CORES> interrupts{};
@@ -978,13 +1014,19 @@ void KernelCore::ExitSVCProfile() {
 }
 
 std::weak_ptr<Kernel::ServiceThread> KernelCore::CreateServiceThread(const std::string& name) {
-    auto service_thread = std::make_shared<Kernel::ServiceThread>(*this, 1, name);
+    std::scoped_lock lock{impl->service_threads_lock};
+    if (!impl->service_thread_pool) {
+        impl->service_thread_pool = std::make_unique<Kernel::ServiceThreadPool>(*this);
+    }
+    auto service_thread =
+        std::make_shared<Kernel::ServiceThread>(*impl->service_thread_pool, name);
     impl->service_threads.emplace(service_thread);
     return service_thread;
 }
 
 void KernelCore::ReleaseServiceThread(std::weak_ptr<Kernel::ServiceThread> service_thread) {
     if (auto strong_ptr = service_thread.lock()) {
+        std::scoped_lock lock{impl->service_threads_lock};
         impl->service_threads.erase(strong_ptr);
     }
 }
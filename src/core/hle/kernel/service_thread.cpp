@@ -2,15 +2,16 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
-#include <condition_variable>
-#include <functional>
-#include <mutex>
+#include <algorithm>
+#include <chrono>
 #include <thread>
 #include <vector>
-#include <queue>
+
+#include <fmt/format.h>
 
 #include "common/assert.h"
-#include "common/scope_exit.h"
+#include "common/bounded_threadsafe_queue.h"
+#include "common/pool_allocator.h"
 #include "common/thread.h"
 #include "core/core.h"
 #include "core/hle/kernel/k_session.h"
@@ -21,89 +22,332 @@
 
 namespace Kernel {
 
-class ServiceThread::Impl final {
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/// Number of session queues each worker can hold before new ones spill to the other workers
+constexpr std::size_t WORKER_QUEUE_CAPACITY = 256;
+
+u64 ToNanoseconds(Clock::duration duration) {
+    return static_cast<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+}
+
+void UpdateMax(std::atomic<u64>& max, u64 value) {
+    u64 current = max.load(std::memory_order_relaxed);
+    while (current < value &&
+           !max.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+struct ServiceCounters {
+    std::atomic<u64> queue_depth{};
+    std::atomic<u64> max_queue_depth{};
+    std::atomic<u64> requests{};
+    std::atomic<u64> total_wait_ns{};
+    std::atomic<u64> max_wait_ns{};
+    std::atomic<u64> total_run_ns{};
+};
+
+struct ServiceTask final : ServiceRequestNode {
+    // Tasks are created for every request, keep them out of the heap
+    static void* operator new(std::size_t) {
+        return Common::BlockPool<sizeof(ServiceTask), alignof(ServiceTask)>::Allocate();
+    }
+
+    static void operator delete(void* pointer) {
+        Common::BlockPool<sizeof(ServiceTask), alignof(ServiceTask)>::Free(pointer);
+    }
+
+    KServerSession* server_session;
+    std::shared_ptr<HLERequestContext> context;
+    std::shared_ptr<ServiceCounters> counters;
+    Clock::time_point queue_time;
+};
+
+} // Anonymous namespace
+
+ServiceRequestQueue::ServiceRequestQueue() : head{&stub}, tail{&stub} {}
+
+bool ServiceRequestQueue::Push(ServiceRequestNode* node) {
+    Link(node);
+    return pending.fetch_add(1, std::memory_order_acq_rel) == 0;
+}
+
+ServiceRequestNode* ServiceRequestQueue::Pop() {
+    // A pending request may have claimed its place in the queue without being linked to its
+    // predecessor yet, wait for the pushing thread to finish
+    ServiceRequestNode* node = TryPop();
+    while (node == nullptr) {
+        std::this_thread::yield();
+        node = TryPop();
+    }
+    return node;
+}
+
+bool ServiceRequestQueue::Finish() {
+    return pending.fetch_sub(1, std::memory_order_acq_rel) > 1;
+}
+
+void ServiceRequestQueue::Link(ServiceRequestNode* node) {
+    node->next.store(nullptr, std::memory_order_relaxed);
+    ServiceRequestNode* const previous = head.exchange(node, std::memory_order_acq_rel);
+    previous->next.store(node, std::memory_order_release);
+}
+
+ServiceRequestNode* ServiceRequestQueue::TryPop() {
+    ServiceRequestNode* first = tail;
+    ServiceRequestNode* next = first->next.load(std::memory_order_acquire);
+    if (first == &stub) {
+        if (next == nullptr) {
+            return nullptr;
+        }
+        tail = next;
+        first = next;
+        next = next->next.load(std::memory_order_acquire);
+    }
+    if (next != nullptr) {
+        tail = next;
+        return first;
+    }
+    if (first != head.load(std::memory_order_acquire)) {
+        return nullptr;
+    }
+    // The last node can't be handed out while it's the tail, put the stub behind it
+    Link(&stub);
+    next = first->next.load(std::memory_order_acquire);
+    if (next != nullptr) {
+        tail = next;
+        return first;
+    }
+    return nullptr;
+}
+
+class ServiceThreadPool::Impl final {
 public:
-    explicit Impl(KernelCore& kernel, std::size_t num_threads, const std::string& name);
+    explicit Impl(KernelCore& kernel);
     ~Impl();
 
-    void QueueSyncRequest(KSession& session, std::shared_ptr<HLERequestContext>&& context);
+    void Schedule(ServiceRequestQueue& queue);
 
 private:
+    using WorkerQueue = Common::BoundedMPMCQueue<ServiceRequestQueue*, WORKER_QUEUE_CAPACITY>;
+
+    void WorkerLoop(std::size_t worker_index);
+
+    /// Pushes a session queue to the given worker, spilling to the next ones when it's full.
+    void PushToWorker(std::size_t worker_index, ServiceRequestQueue* queue);
+
+    /// Takes a session queue from the worker's own ring, or steals one from another worker.
+    bool TakeWork(std::size_t worker_index, ServiceRequestQueue*& queue);
+
+    /// Handles the oldest request of a session queue held by the worker.
+    void HandleRequest(std::size_t worker_index, ServiceRequestQueue& queue);
+
+    KernelCore& kernel;
+    std::vector<std::unique_ptr<WorkerQueue>> worker_queues;
     std::vector<std::thread> threads;
-    std::queue<std::function<void()>> requests;
-    std::mutex queue_mutex;
-    std::condition_variable condition;
-    const std::string service_name;
-    bool stop{};
+    std::atomic<std::size_t> next_worker{};
+    std::atomic<u32> work_epoch{};
+    std::atomic_bool stop{};
 };
 
-ServiceThread::Impl::Impl(KernelCore& kernel, std::size_t num_threads, const std::string& name)
-    : service_name{name} {
-    for (std::size_t i = 0; i < num_threads; ++i)
-        threads.emplace_back([this, &kernel] {
-            Common::SetCurrentThreadName(std::string{"yuzu:HleService:" + service_name}.c_str());
+ServiceThreadPool::Impl::Impl(KernelCore& kernel_) : kernel{kernel_} {
+    const std::size_t num_threads = std::max(std::thread::hardware_concurrency(), 2U);
+    for (std::size_t i = 0; i < num_threads; ++i) {
+        worker_queues.push_back(std::make_unique<WorkerQueue>());
+    }
+    for (std::size_t i = 0; i < num_threads; ++i) {
+        threads.emplace_back([this, i] { WorkerLoop(i); });
+    }
+}
+
+ServiceThreadPool::Impl::~Impl() {
+    stop.store(true, std::memory_order_release);
+    work_epoch.fetch_add(1, std::memory_order_release);
+    work_epoch.notify_all();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    // Drop the requests that were never handled, emulation is shutting down
+    for (auto& worker_queue : worker_queues) {
+        ServiceRequestQueue* queue = nullptr;
+        while (worker_queue->TryPop(queue)) {
+            bool has_more = true;
+            while (has_more) {
+                const std::unique_ptr<ServiceTask> task{static_cast<ServiceTask*>(queue->Pop())};
+                task->counters->queue_depth.fetch_sub(1, std::memory_order_relaxed);
+                has_more = queue->Finish();
 
-            // Wait for first request before trying to acquire a render context
-            {
-                std::unique_lock lock{queue_mutex};
-                condition.wait(lock, [this] { return stop || !requests.empty(); });
+                // Close the reference opened when queueing the request. The session owns the
+                // queue and may be destroyed, the remaining requests keep it alive until then.
+                task->server_session->Close();
             }
+        }
+    }
+}
 
-            kernel.RegisterHostThread();
+void ServiceThreadPool::Impl::Schedule(ServiceRequestQueue& queue) {
+    const std::size_t worker_index =
+        next_worker.fetch_add(1, std::memory_order_relaxed) % worker_queues.size();
+    PushToWorker(worker_index, &queue);
+    work_epoch.fetch_add(1, std::memory_order_release);
+    work_epoch.notify_one();
+}
 
-            while (true) {
-                std::function<void()> task;
+void ServiceThreadPool::Impl::PushToWorker(std::size_t worker_index, ServiceRequestQueue* queue) {
+    const std::size_t num_workers = worker_queues.size();
+    while (true) {
+        for (std::size_t i = 0; i < num_workers; ++i) {
+            if (worker_queues[(worker_index + i) % num_workers]->TryPush(queue)) {
+                return;
+            }
+        }
+        std::this_thread::yield();
+    }
+}
 
-                {
-                    std::unique_lock lock{queue_mutex};
-                    condition.wait(lock, [this] { return stop || !requests.empty(); });
-                    if (stop || requests.empty()) {
-                        return;
-                    }
-                    task = std::move(requests.front());
-                    requests.pop();
-                }
+bool ServiceThreadPool::Impl::TakeWork(std::size_t worker_index, ServiceRequestQueue*& queue) {
+    const std::size_t num_workers = worker_queues.size();
+    for (std::size_t i = 0; i < num_workers; ++i) {
+        if (worker_queues[(worker_index + i) % num_workers]->TryPop(queue)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ServiceThreadPool::Impl::WorkerLoop(std::size_t worker_index) {
+    Common::SetCurrentThreadName(fmt::format("yuzu:HleService:{}", worker_index).c_str());
 
-                task();
+    // The thread is registered with the kernel once it has a request to handle
+    bool is_registered = false;
+
+    while (true) {
+        ServiceRequestQueue* queue = nullptr;
+        if (!TakeWork(worker_index, queue)) {
+            // Sample the epoch before checking again, so work scheduled in between wakes us up
+            const u32 epoch = work_epoch.load(std::memory_order_acquire);
+            if (stop.load(std::memory_order_acquire)) {
+                return;
+            }
+            if (!TakeWork(worker_index, queue)) {
+                work_epoch.wait(epoch, std::memory_order_acquire);
+                continue;
             }
-        });
+        }
+        if (stop.load(std::memory_order_acquire)) {
+            PushToWorker(worker_index, queue);
+            return;
+        }
+        if (!is_registered) {
+            kernel.RegisterHostThread();
+            is_registered = true;
+        }
+        HandleRequest(worker_index, *queue);
+    }
+}
+
+void ServiceThreadPool::Impl::HandleRequest(std::size_t worker_index, ServiceRequestQueue& queue) {
+    const std::unique_ptr<ServiceTask> task{static_cast<ServiceTask*>(queue.Pop())};
+    auto* const server_session = task->server_session;
+    auto& counters = *task->counters;
+
+    // Complete the service request.
+    const Clock::time_point start_time = Clock::now();
+    server_session->CompleteSyncRequest(*task->context);
+    const Clock::time_point end_time = Clock::now();
+
+    const u64 wait_ns = ToNanoseconds(start_time - task->queue_time);
+    counters.queue_depth.fetch_sub(1, std::memory_order_relaxed);
+    counters.requests.fetch_add(1, std::memory_order_relaxed);
+    counters.total_wait_ns.fetch_add(wait_ns, std::memory_order_relaxed);
+    counters.total_run_ns.fetch_add(ToNanoseconds(end_time - start_time),
+                                    std::memory_order_relaxed);
+    UpdateMax(counters.max_wait_ns, wait_ns);
+
+    // Requeue the session behind the other scheduled work, so busy sessions can't starve others.
+    // Nothing may touch the queue after this, it's owned by the session and the next request may
+    // already be running on another worker.
+    if (queue.Finish()) {
+        PushToWorker(worker_index, &queue);
+    }
+
+    // Close the reference opened when queueing the request, this may destroy the session.
+    server_session->Close();
+}
+
+ServiceThreadPool::ServiceThreadPool(KernelCore& kernel)
+    : impl{std::make_unique<Impl>(kernel)} {}
+
+ServiceThreadPool::~ServiceThreadPool() = default;
+
+void ServiceThreadPool::Schedule(ServiceRequestQueue& queue) {
+    impl->Schedule(queue);
 }
 
+class ServiceThread::Impl final {
+public:
+    explicit Impl(ServiceThreadPool& pool, const std::string& name);
+    ~Impl();
+
+    void QueueSyncRequest(KSession& session, std::shared_ptr<HLERequestContext>&& context);
+
+    const std::string& GetName() const {
+        return service_name;
+    }
+
+    ServiceThreadStats GetStats() const;
+
+private:
+    ServiceThreadPool& pool;
+    const std::string service_name;
+
+    // Shared with the queued requests, which can outlive the service
+    std::shared_ptr<ServiceCounters> counters;
+};
+
+ServiceThread::Impl::Impl(ServiceThreadPool& pool_, const std::string& name)
+    : pool{pool_}, service_name{name}, counters{std::make_shared<ServiceCounters>()} {}
+
+ServiceThread::Impl::~Impl() = default;
+
 void ServiceThread::Impl::QueueSyncRequest(KSession& session,
                                            std::shared_ptr<HLERequestContext>&& context) {
-    {
-        std::unique_lock lock{queue_mutex};
+    auto* server_session{&session.GetServerSession()};
 
-        auto* server_session{&session.GetServerSession()};
+    // Open a reference to the session to ensure it is not closes while the service request
+    // completes asynchronously.
+    server_session->Open();
 
-        // Open a reference to the session to ensure it is not closes while the service request
-        // completes asynchronously.
-        server_session->Open();
+    const u64 queue_depth = counters->queue_depth.fetch_add(1, std::memory_order_relaxed) + 1;
+    UpdateMax(counters->max_queue_depth, queue_depth);
 
-        requests.emplace([server_session, context{std::move(context)}]() {
-            // Close the reference.
-            SCOPE_EXIT({ server_session->Close(); });
+    auto* const task = new ServiceTask;
+    task->server_session = server_session;
+    task->context = std::move(context);
+    task->counters = counters;
+    task->queue_time = Clock::now();
 
-            // Complete the service request.
-            server_session->CompleteSyncRequest(*context);
-        });
+    if (server_session->request_queue.Push(task)) {
+        pool.Schedule(server_session->request_queue);
     }
-    condition.notify_one();
 }
 
-ServiceThread::Impl::~Impl() {
-    {
-        std::unique_lock lock{queue_mutex};
-        stop = true;
-    }
-    condition.notify_all();
-    for (std::thread& thread : threads) {
-        thread.join();
-    }
+ServiceThreadStats ServiceThread::Impl::GetStats() const {
+    return {
+        .queue_depth = counters->queue_depth.load(std::memory_order_relaxed),
+        .max_queue_depth = counters->max_queue_depth.load(std::memory_order_relaxed),
+        .requests = counters->requests.load(std::memory_order_relaxed),
+        .total_wait_ns = counters->total_wait_ns.load(std::memory_order_relaxed),
+        .max_wait_ns = counters->max_wait_ns.load(std::memory_order_relaxed),
+        .total_run_ns = counters->total_run_ns.load(std::memory_order_relaxed),
+    };
 }
 
-ServiceThread::ServiceThread(KernelCore& kernel, std::size_t num_threads, const std::string& name)
-    : impl{std::make_unique<Impl>(kernel, num_threads, name)} {}
+ServiceThread::ServiceThread(ServiceThreadPool& pool, const std::string& name)
+    : impl{std::make_unique<Impl>(pool, name)} {}
 
 ServiceThread::~ServiceThread() = default;
 
@@ -112,4 +356,12 @@ void ServiceThread::QueueSyncRequest(KSession& session,
     impl->QueueSyncRequest(session, std::move(context));
 }
 
+const std::string& ServiceThread::GetName() const {
+    return impl->GetName();
+}
+
+ServiceThreadStats ServiceThread::GetStats() const {
+    return impl->GetStats();
+}
+
 } // namespace Kernel
@@ -4,22 +4,107 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <string>
 
+#include "common/common_types.h"
+
 namespace Kernel {
 
 class HLERequestContext;
 class KernelCore;
 class KSession;
+class ServiceThreadPool;
+
+/// Counters describing the requests handled for a service.
+struct ServiceThreadStats {
+    /// Requests queued or being handled right now
+    u64 queue_depth;
+    u64 max_queue_depth;
+    /// Requests handled to completion
+    u64 requests;
+    /// Time requests spent queued before a worker picked them up
+    u64 total_wait_ns;
+    u64 max_wait_ns;
+    /// Time spent handling requests
+    u64 total_run_ns;
+
+    /// Returns the average time a request spent queued, in nanoseconds.
+    double AverageWaitNs() const {
+        return requests == 0 ? 0.0
+                             : static_cast<double>(total_wait_ns) / static_cast<double>(requests);
+    }
+};
+
+/// Node of a ServiceRequestQueue.
+struct ServiceRequestNode {
+    std::atomic<ServiceRequestNode*> next{};
+};
+
+/**
+ * Queue of the requests sent to a session, handled in the order they were sent.
+ * Any thread can push without locking. The queue is scheduled onto the ServiceThreadPool when it
+ * goes from empty to non-empty, and only the worker that holds it pops from it.
+ */
+class ServiceRequestQueue final {
+public:
+    ServiceRequestQueue();
+
+    ServiceRequestQueue(const ServiceRequestQueue&) = delete;
+    ServiceRequestQueue& operator=(const ServiceRequestQueue&) = delete;
+
+    /// Pushes a request. Returns true if the queue was idle and has to be scheduled.
+    bool Push(ServiceRequestNode* node);
+
+    /// Pops the oldest request, waiting for pushes that are still in flight.
+    ServiceRequestNode* Pop();
+
+    /// Marks the popped request as handled. Returns true if more requests are pending.
+    bool Finish();
+
+private:
+    void Link(ServiceRequestNode* node);
+    ServiceRequestNode* TryPop();
+
+    std::atomic<ServiceRequestNode*> head;
+    ServiceRequestNode* tail;
+    ServiceRequestNode stub;
+    std::atomic<u64> pending{};
+};
 
+/**
+ * Pool of host threads, sized to the host core count, that handles the requests of every HLE
+ * service. Each worker owns a ring of scheduled session queues and steals from the rings of the
+ * other workers when its own is empty.
+ */
+class ServiceThreadPool final {
+public:
+    explicit ServiceThreadPool(KernelCore& kernel);
+    ~ServiceThreadPool();
+
+    /// Schedules a session queue that has pending requests.
+    void Schedule(ServiceRequestQueue& queue);
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> impl;
+};
+
+/// Front-end through which a service queues its requests onto the ServiceThreadPool.
 class ServiceThread final {
 public:
-    explicit ServiceThread(KernelCore& kernel, std::size_t num_threads, const std::string& name);
+    explicit ServiceThread(ServiceThreadPool& pool, const std::string& name);
     ~ServiceThread();
 
     void QueueSyncRequest(KSession& session, std::shared_ptr<HLERequestContext>&& context);
 
+    /// Returns the name of the service.
+    const std::string& GetName() const;
+
+    /// Returns the counters of the requests queued through this service thread.
+    ServiceThreadStats GetStats() const;
+
 private:
     class Impl;
     std::unique_ptr<Impl> impl;
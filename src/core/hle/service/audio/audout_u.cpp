@@ -133,7 +133,7 @@ private:
         LOG_DEBUG(Service_Audio, "(STUBBED) called {}", ctx.Description());
         IPC::RequestParser rp{ctx};
 
-        const auto& input_buffer{ctx.ReadBuffer()};
+        const auto input_buffer{ctx.ReadBufferSpan()};
         ASSERT_MSG(input_buffer.size() == sizeof(AudioBuffer),
                    "AudioBuffer input is an invalid size!");
         AudioBuffer audio_buffer{};
@@ -96,11 +96,12 @@ private:
     void RequestUpdateImpl(Kernel::HLERequestContext& ctx) {
         LOG_DEBUG(Service_Audio, "(STUBBED) called");
 
-        std::vector<u8> output_params(ctx.GetWriteBufferSize());
-        auto result = renderer->UpdateAudioRenderer(ctx.ReadBuffer(), output_params);
+        const auto input_params = ctx.ReadBufferSpan();
+        const auto output_params = ctx.AcquireWriteBuffer();
+        auto result = renderer->UpdateAudioRenderer(input_params, output_params);
 
         if (result.IsSuccess()) {
-            ctx.WriteBuffer(output_params);
+            ctx.WriteBuffer(output_params.data(), output_params.size());
         }
 
         IPC::ResponseBuilder rb{ctx, 2};
@@ -5,6 +5,7 @@
 #include <cinttypes>
 #include <cstring>
 #include <iterator>
+#include <span>
 #include <string>
 #include <utility>
 #include <vector>
@@ -56,6 +57,23 @@ enum class FileSystemType : u8 {
     ApplicationPackage = 7,
 };
 
+/**
+ * Reads length bytes at offset of the file into the output buffer of the request. The file is read
+ * straight into guest memory whenever the buffer is contiguous in host memory, skipping the
+ * intermediate copy. Returns the number of bytes read from the file.
+ */
+static std::size_t ReadFileToBuffer(Kernel::HLERequestContext& ctx,
+                                    const FileSys::VirtualFile& file, std::size_t length,
+                                    std::size_t offset) {
+    const std::span<u8> output = ctx.WriteBufferSpan();
+    if (length > output.size()) {
+        LOG_CRITICAL(Service_FS, "length ({:016X}) is greater than buffer_size ({:016X})", length,
+                     output.size());
+        length = output.size();
+    }
+    return file->Read(output.data(), length, offset);
+}
+
 class IStorage final : public ServiceFramework<IStorage> {
 public:
     explicit IStorage(Core::System& system_, FileSys::VirtualFile backend_)
@@ -95,10 +113,9 @@ private:
             return;
         }
 
-        // Read the data from the Storage backend
-        std::vector<u8> output = backend->ReadBytes(length, offset);
-        // Write the data to memory
-        ctx.WriteBuffer(output);
+        // Read the data from the Storage backend into memory
+        ReadFileToBuffer(ctx, backend, static_cast<std::size_t>(length),
+                         static_cast<std::size_t>(offset));
 
         IPC::ResponseBuilder rb{ctx, 2};
         rb.Push(ResultSuccess);
@@ -156,15 +173,14 @@ private:
             return;
         }
 
-        // Read the data from the Storage backend
-        std::vector<u8> output = backend->ReadBytes(length, offset);
-
-        // Write the data to memory
-        ctx.WriteBuffer(output);
+        // Read the data from the Storage backend into memory
+        const std::size_t read_size =
+            ReadFileToBuffer(ctx, backend, static_cast<std::size_t>(length),
+                             static_cast<std::size_t>(offset));
 
         IPC::ResponseBuilder rb{ctx, 4};
         rb.Push(ResultSuccess);
-        rb.Push(static_cast<u64>(output.size()));
+        rb.Push(static_cast<u64>(read_size));
     }
 
     void Write(Kernel::HLERequestContext& ctx) {
@@ -190,7 +206,7 @@ private:
             return;
         }
 
-        const std::vector<u8> data = ctx.ReadBuffer();
+        const std::span<const u8> data = ctx.ReadBufferSpan();
 
         ASSERT_MSG(
             static_cast<s64>(data.size()) <= length,
@@ -164,7 +164,7 @@ public:
     void SetSupportedStyleSet(NpadStyleSet style_set);
     NpadStyleSet GetSupportedStyleSet() const;
 
-    void SetSupportedNpadIdTypes(u8* data, std::size_t length);
+    void SetSupportedNpadIdTypes(const u8* data, std::size_t length);
     void GetSupportedNpadIdTypes(u32* data, std::size_t max_length);
     std::size_t GetSupportedNpadIdTypesSize() const;
 
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <span>
 #include <vector>
 #include "common/bit_field.h"
 #include "common/common_types.h"
@@ -31,8 +32,8 @@ public:
      * @param output A buffer where the output data will be written to.
      * @returns The result code of the ioctl.
      */
-    virtual NvResult Ioctl1(DeviceFD fd, Ioctl command, const std::vector<u8>& input,
-                            std::vector<u8>& output) = 0;
+    virtual NvResult Ioctl1(DeviceFD fd, Ioctl command, std::span<const u8> input,
+                            std::span<u8> output) = 0;
 
     /**
      * Handles an ioctl2 request.
@@ -42,8 +43,8 @@ public:
      * @param output A buffer where the output data will be written to.
      * @returns The result code of the ioctl.
      */
-    virtual NvResult Ioctl2(DeviceFD fd, Ioctl command, const std::vector<u8>& input,
-                            const std::vector<u8>& inline_input, std::vector<u8>& output) = 0;
+    virtual NvResult Ioctl2(DeviceFD fd, Ioctl command, std::span<const u8> input,
+                            std::span<const u8> inline_input, std::span<u8> output) = 0;
 
     /**
      * Handles an ioctl3 request.
@@ -53,8 +54,8 @@ public:
      * @param inline_output A buffer where the inlined output data will be written to.
      * @returns The result code of the ioctl.
      */
-    virtual NvResult Ioctl3(DeviceFD fd, Ioctl command, const std::vector<u8>& input,
-                            std::vector<u8>& output, std::vector<u8>& inline_output) = 0;
+    virtual NvResult Ioctl3(DeviceFD fd, Ioctl command, std::span<const u8> input,
+                            std::span<u8> output, std::span<u8> inline_output) = 0;
 
     /**
      * Called once a device is openned
@@ -69,12 +69,12 @@ void NVDRV::Ioctl1(Kernel::HLERequestContext& ctx) {
     }
 
     // Check device
-    std::vector<u8> output_buffer(ctx.GetWriteBufferSize(0));
-    const auto input_buffer = ctx.ReadBuffer(0);
+    const auto input_buffer = ctx.ReadBufferSpan(0);
+    const auto output_buffer = ctx.AcquireWriteBuffer(0);
 
     const auto nv_result = nvdrv->Ioctl1(fd, command, input_buffer, output_buffer);
     if (command.is_out != 0) {
-        ctx.WriteBuffer(output_buffer);
+        ctx.WriteBuffer(output_buffer.data(), output_buffer.size());
     }
 
     IPC::ResponseBuilder rb{ctx, 3};
@@ -94,14 +94,14 @@ void NVDRV::Ioctl2(Kernel::HLERequestContext& ctx) {
         return;
     }
 
-    const auto input_buffer = ctx.ReadBuffer(0);
-    const auto input_inlined_buffer = ctx.ReadBuffer(1);
-    std::vector<u8> output_buffer(ctx.GetWriteBufferSize(0));
+    const auto input_buffer = ctx.ReadBufferSpan(0);
+    const auto input_inlined_buffer = ctx.ReadBufferSpan(1);
+    const auto output_buffer = ctx.AcquireWriteBuffer(0);
 
     const auto nv_result =
         nvdrv->Ioctl2(fd, command, input_buffer, input_inlined_buffer, output_buffer);
     if (command.is_out != 0) {
-        ctx.WriteBuffer(output_buffer);
+        ctx.WriteBuffer(output_buffer.data(), output_buffer.size());
     }
 
     IPC::ResponseBuilder rb{ctx, 3};
@@ -121,15 +121,15 @@ void NVDRV::Ioctl3(Kernel::HLERequestContext& ctx) {
         return;
     }
 
-    const auto input_buffer = ctx.ReadBuffer(0);
-    std::vector<u8> output_buffer(ctx.GetWriteBufferSize(0));
-    std::vector<u8> output_buffer_inline(ctx.GetWriteBufferSize(1));
+    const auto input_buffer = ctx.ReadBufferSpan(0);
+    const auto output_buffer = ctx.AcquireWriteBuffer(0);
+    const auto output_buffer_inline = ctx.AcquireWriteBuffer(1);
 
     const auto nv_result =
         nvdrv->Ioctl3(fd, command, input_buffer, output_buffer, output_buffer_inline);
     if (command.is_out != 0) {
-        ctx.WriteBuffer(output_buffer, 0);
-        ctx.WriteBuffer(output_buffer_inline, 1);
+        ctx.WriteBuffer(output_buffer.data(), output_buffer.size(), 0);
+        ctx.WriteBuffer(output_buffer_inline.data(), output_buffer_inline.size(), 1);
     }
 
     IPC::ResponseBuilder rb{ctx, 3};
@@ -40,6 +40,20 @@ struct Memory::Impl {
         system.ArmInterface(core_id).PageTableChanged(*current_page_table, address_space_width);
     }
 
+    void SetCurrentPageTable(Common::PageTable& page_table) {
+        current_page_table = &page_table;
+        current_page_table->fastmem_arena = system.DeviceMemory().buffer.VirtualBasePointer();
+    }
+
+    /// Returns the page table of the current process, or the current page table when no process
+    /// is running
+    const Common::PageTable& CurrentProcessPageTable() const {
+        if (const Kernel::KProcess* const process = system.CurrentProcess()) {
+            return process->PageTable().PageTableImpl();
+        }
+        return *current_page_table;
+    }
+
     void MapMemoryRegion(Common::PageTable& page_table, VAddr base, u64 size, PAddr target) {
         ASSERT_MSG((size & PAGE_MASK) == 0, "non-page aligned size: {:016X}", size);
         ASSERT_MSG((base & PAGE_MASK) == 0, "non-page aligned base: {:016X}", base);
@@ -94,6 +108,31 @@ struct Memory::Impl {
         return nullptr;
     }
 
+    std::span<u8> GetSpan(const VAddr vaddr, const std::size_t size) const {
+        if (size == 0 || vaddr + size < vaddr) {
+            return {};
+        }
+        const auto& pointers = current_page_table->pointers;
+        const std::size_t first_page = vaddr >> PAGE_BITS;
+        const std::size_t last_page = (vaddr + size - 1) >> PAGE_BITS;
+        if (last_page >= pointers.size()) {
+            return {};
+        }
+        // Pages are contiguous in host memory when they store the same offset from guest memory,
+        // rasterizer cached pages have no pointer and are never exposed directly
+        const uintptr_t raw_pointer = pointers[first_page].Raw();
+        u8* const pointer = Common::PageTable::PageInfo::ExtractPointer(raw_pointer);
+        if (!pointer) {
+            return {};
+        }
+        for (std::size_t page = first_page + 1; page <= last_page; ++page) {
+            if (pointers[page].Raw() != raw_pointer) {
+                return {};
+            }
+        }
+        return {pointer + vaddr, size};
+    }
+
     u8 Read8(const VAddr addr) {
         return Read<u8>(addr);
     }
@@ -190,10 +229,8 @@ struct Memory::Impl {
         return string;
     }
 
-    void ReadBlock(const Kernel::KProcess& process, const VAddr src_addr, void* dest_buffer,
+    void ReadBlock(const Common::PageTable& page_table, const VAddr src_addr, void* dest_buffer,
                    const std::size_t size) {
-        const auto& page_table = process.PageTable().PageTableImpl();
-
         std::size_t remaining_size = size;
         std::size_t page_index = src_addr >> PAGE_BITS;
         std::size_t page_offset = src_addr & PAGE_MASK;
@@ -235,10 +272,8 @@ struct Memory::Impl {
         }
     }
 
-    void ReadBlockUnsafe(const Kernel::KProcess& process, const VAddr src_addr, void* dest_buffer,
-                         const std::size_t size) {
-        const auto& page_table = process.PageTable().PageTableImpl();
-
+    void ReadBlockUnsafe(const Common::PageTable& page_table, const VAddr src_addr,
+                         void* dest_buffer, const std::size_t size) {
         std::size_t remaining_size = size;
         std::size_t page_index = src_addr >> PAGE_BITS;
         std::size_t page_offset = src_addr & PAGE_MASK;
@@ -280,16 +315,15 @@ struct Memory::Impl {
     }
 
     void ReadBlock(const VAddr src_addr, void* dest_buffer, const std::size_t size) {
-        ReadBlock(*system.CurrentProcess(), src_addr, dest_buffer, size);
+        ReadBlock(CurrentProcessPageTable(), src_addr, dest_buffer, size);
     }
 
     void ReadBlockUnsafe(const VAddr src_addr, void* dest_buffer, const std::size_t size) {
-        ReadBlockUnsafe(*system.CurrentProcess(), src_addr, dest_buffer, size);
+        ReadBlockUnsafe(CurrentProcessPageTable(), src_addr, dest_buffer, size);
     }
 
-    void WriteBlock(const Kernel::KProcess& process, const VAddr dest_addr, const void* src_buffer,
-                    const std::size_t size) {
-        const auto& page_table = process.PageTable().PageTableImpl();
+    void WriteBlock(const Common::PageTable& page_table, const VAddr dest_addr,
+                    const void* src_buffer, const std::size_t size) {
         std::size_t remaining_size = size;
         std::size_t page_index = dest_addr >> PAGE_BITS;
         std::size_t page_offset = dest_addr & PAGE_MASK;
@@ -330,9 +364,8 @@ struct Memory::Impl {
         }
     }
 
-    void WriteBlockUnsafe(const Kernel::KProcess& process, const VAddr dest_addr,
+    void WriteBlockUnsafe(const Common::PageTable& page_table, const VAddr dest_addr,
                           const void* src_buffer, const std::size_t size) {
-        const auto& page_table = process.PageTable().PageTableImpl();
         std::size_t remaining_size = size;
         std::size_t page_index = dest_addr >> PAGE_BITS;
         std::size_t page_offset = dest_addr & PAGE_MASK;
@@ -373,15 +406,15 @@ struct Memory::Impl {
     }
 
     void WriteBlock(const VAddr dest_addr, const void* src_buffer, const std::size_t size) {
-        WriteBlock(*system.CurrentProcess(), dest_addr, src_buffer, size);
+        WriteBlock(CurrentProcessPageTable(), dest_addr, src_buffer, size);
     }
 
     void WriteBlockUnsafe(const VAddr dest_addr, const void* src_buffer, const std::size_t size) {
-        WriteBlockUnsafe(*system.CurrentProcess(), dest_addr, src_buffer, size);
+        WriteBlockUnsafe(CurrentProcessPageTable(), dest_addr, src_buffer, size);
     }
 
-    void ZeroBlock(const Kernel::KProcess& process, const VAddr dest_addr, const std::size_t size) {
-        const auto& page_table = process.PageTable().PageTableImpl();
+    void ZeroBlock(const Common::PageTable& page_table, const VAddr dest_addr,
+                   const std::size_t size) {
         std::size_t remaining_size = size;
         std::size_t page_index = dest_addr >> PAGE_BITS;
         std::size_t page_offset = dest_addr & PAGE_MASK;
@@ -422,12 +455,11 @@ struct Memory::Impl {
     }
 
     void ZeroBlock(const VAddr dest_addr, const std::size_t size) {
-        ZeroBlock(*system.CurrentProcess(), dest_addr, size);
+        ZeroBlock(CurrentProcessPageTable(), dest_addr, size);
     }
 
-    void CopyBlock(const Kernel::KProcess& process, VAddr dest_addr, VAddr src_addr,
+    void CopyBlock(const Common::PageTable& page_table, VAddr dest_addr, VAddr src_addr,
                    const std::size_t size) {
-        const auto& page_table = process.PageTable().PageTableImpl();
         std::size_t remaining_size = size;
         std::size_t page_index = src_addr >> PAGE_BITS;
         std::size_t page_offset = src_addr & PAGE_MASK;
@@ -443,19 +475,19 @@ struct Memory::Impl {
                 LOG_ERROR(HW_Memory,
                           "Unmapped CopyBlock @ 0x{:016X} (start address = 0x{:016X}, size = {})",
                           current_vaddr, src_addr, size);
-                ZeroBlock(process, dest_addr, copy_amount);
+                ZeroBlock(page_table, dest_addr, copy_amount);
                 break;
             }
             case Common::PageType::Memory: {
                 DEBUG_ASSERT(pointer);
                 const u8* src_ptr = pointer + page_offset + (page_index << PAGE_BITS);
-                WriteBlock(process, dest_addr, src_ptr, copy_amount);
+                WriteBlock(page_table, dest_addr, src_ptr, copy_amount);
                 break;
             }
             case Common::PageType::RasterizerCachedMemory: {
                 const u8* const host_ptr{GetPointerFromRasterizerCachedMemory(current_vaddr)};
                 system.GPU().FlushRegion(current_vaddr, copy_amount);
-                WriteBlock(process, dest_addr, host_ptr, copy_amount);
+                WriteBlock(page_table, dest_addr, host_ptr, copy_amount);
                 break;
             }
             default:
@@ -471,7 +503,7 @@ struct Memory::Impl {
     }
 
     void CopyBlock(VAddr dest_addr, VAddr src_addr, std::size_t size) {
-        return CopyBlock(*system.CurrentProcess(), dest_addr, src_addr, size);
+        return CopyBlock(CurrentProcessPageTable(), dest_addr, src_addr, size);
     }
 
     void RasterizerMarkRegionCached(VAddr vaddr, u64 size, bool cached) {
@@ -781,6 +813,10 @@ void Memory::SetCurrentPageTable(Kernel::KProcess& process, u32 core_id) {
     impl->SetCurrentPageTable(process, core_id);
 }
 
+void Memory::SetCurrentPageTable(Common::PageTable& page_table) {
+    impl->SetCurrentPageTable(page_table);
+}
+
 void Memory::MapMemoryRegion(Common::PageTable& page_table, VAddr base, u64 size, PAddr target) {
     impl->MapMemoryRegion(page_table, base, size, target);
 }
@@ -805,6 +841,14 @@ const u8* Memory::GetPointer(VAddr vaddr) const {
     return impl->GetPointer(vaddr);
 }
 
+std::span<u8> Memory::GetSpan(VAddr vaddr, std::size_t size) {
+    return impl->GetSpan(vaddr, size);
+}
+
+std::span<const u8> Memory::GetSpan(VAddr vaddr, std::size_t size) const {
+    return impl->GetSpan(vaddr, size);
+}
+
 u8 Memory::Read8(const VAddr addr) {
     return impl->Read8(addr);
 }
@@ -863,7 +907,7 @@ std::string Memory::ReadCString(VAddr vaddr, std::size_t max_length) {
 
 void Memory::ReadBlock(const Kernel::KProcess& process, const VAddr src_addr, void* dest_buffer,
                        const std::size_t size) {
-    impl->ReadBlock(process, src_addr, dest_buffer, size);
+    impl->ReadBlock(process.PageTable().PageTableImpl(), src_addr, dest_buffer, size);
 }
 
 void Memory::ReadBlock(const VAddr src_addr, void* dest_buffer, const std::size_t size) {
@@ -872,7 +916,7 @@ void Memory::ReadBlock(const VAddr src_addr, void* dest_buffer, const std::size_
 
 void Memory::ReadBlockUnsafe(const Kernel::KProcess& process, const VAddr src_addr,
                              void* dest_buffer, const std::size_t size) {
-    impl->ReadBlockUnsafe(process, src_addr, dest_buffer, size);
+    impl->ReadBlockUnsafe(process.PageTable().PageTableImpl(), src_addr, dest_buffer, size);
 }
 
 void Memory::ReadBlockUnsafe(const VAddr src_addr, void* dest_buffer, const std::size_t size) {
@@ -881,7 +925,7 @@ void Memory::ReadBlockUnsafe(const VAddr src_addr, void* dest_buffer, const std:
 
 void Memory::WriteBlock(const Kernel::KProcess& process, VAddr dest_addr, const void* src_buffer,
                         std::size_t size) {
-    impl->WriteBlock(process, dest_addr, src_buffer, size);
+    impl->WriteBlock(process.PageTable().PageTableImpl(), dest_addr, src_buffer, size);
 }
 
 void Memory::WriteBlock(const VAddr dest_addr, const void* src_buffer, const std::size_t size) {
@@ -890,7 +934,7 @@ void Memory::WriteBlock(const VAddr dest_addr, const void* src_buffer, const std
 
 void Memory::WriteBlockUnsafe(const Kernel::KProcess& process, VAddr dest_addr,
                               const void* src_buffer, std::size_t size) {
-    impl->WriteBlockUnsafe(process, dest_addr, src_buffer, size);
+    impl->WriteBlockUnsafe(process.PageTable().PageTableImpl(), dest_addr, src_buffer, size);
 }
 
 void Memory::WriteBlockUnsafe(const VAddr dest_addr, const void* src_buffer,
@@ -899,7 +943,7 @@ void Memory::WriteBlockUnsafe(const VAddr dest_addr, const void* src_buffer,
 }
 
 void Memory::ZeroBlock(const Kernel::KProcess& process, VAddr dest_addr, std::size_t size) {
-    impl->ZeroBlock(process, dest_addr, size);
+    impl->ZeroBlock(process.PageTable().PageTableImpl(), dest_addr, size);
 }
 
 void Memory::ZeroBlock(VAddr dest_addr, std::size_t size) {
@@ -908,7 +952,7 @@ void Memory::ZeroBlock(VAddr dest_addr, std::size_t size) {
 
 void Memory::CopyBlock(const Kernel::KProcess& process, VAddr dest_addr, VAddr src_addr,
                        const std::size_t size) {
-    impl->CopyBlock(process, dest_addr, src_addr, size);
+    impl->CopyBlock(process.PageTable().PageTableImpl(), dest_addr, src_addr, size);
 }
 
 void Memory::CopyBlock(VAddr dest_addr, VAddr src_addr, std::size_t size) {
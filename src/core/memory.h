@@ -6,6 +6,7 @@
 
 #include <cstddef>
 #include <memory>
+#include <span>
 #include <string>
 #include "common/common_types.h"
 
@@ -70,6 +71,15 @@ public:
      */
     void SetCurrentPageTable(Kernel::KProcess& process, u32 core_id);
 
+    /**
+     * Changes the currently active page table to one that doesn't belong to a process. Accesses
+     * that don't name a process use it while no process is running. Used by tools that drive the
+     * GPU without loading an application.
+     *
+     * @param page_table The page table to use.
+     */
+    void SetCurrentPageTable(Common::PageTable& page_table);
+
     /**
      * Maps an allocated buffer onto a region of the emulated process address space.
      *
@@ -141,6 +151,28 @@ public:
         return reinterpret_cast<T*>(GetPointer(vaddr));
     }
 
+    /**
+     * Gets a span over the given range of guest memory, without copying.
+     *
+     * @param vaddr Virtual address of the start of the range.
+     * @param size  Size of the range in bytes.
+     *
+     * @returns The span over the range if it is mapped contiguously in host memory and needs no
+     *          rasterizer cache management, otherwise an empty span.
+     */
+    std::span<u8> GetSpan(VAddr vaddr, std::size_t size);
+
+    /**
+     * Gets a span over the given range of guest memory, without copying.
+     *
+     * @param vaddr Virtual address of the start of the range.
+     * @param size  Size of the range in bytes.
+     *
+     * @returns The span over the range if it is mapped contiguously in host memory and needs no
+     *          rasterizer cache management, otherwise an empty span.
+     */
+    std::span<const u8> GetSpan(VAddr vaddr, std::size_t size) const;
+
     /**
      * Reads an 8-bit unsigned value from the current process' address space
      * at the given virtual address.
@@ -11,12 +11,14 @@
 #include <thread>
 #include <fmt/chrono.h>
 #include <fmt/format.h>
+#include "audio_core/sink_stream.h"
 #include "common/fs/file.h"
 #include "common/fs/fs.h"
 #include "common/fs/path_util.h"
 #include "common/math_util.h"
 #include "common/settings.h"
 #include "core/perf_stats.h"
+#include "video_core/texture_cache/memory_budget.h"
 
 using namespace std::chrono_literals;
 using DoubleSecs = std::chrono::duration<double, std::chrono::seconds::period>;
@@ -101,12 +103,23 @@ PerfStatsResults PerfStats::GetAndResetStats(microseconds current_system_time_us
     const auto system_us_per_second = (current_system_time_us - reset_point_system_us) / interval;
     const auto current_frames = static_cast<double>(game_frames.load(std::memory_order_relaxed));
     const auto current_fps = current_frames / interval;
+    const auto audio_stats = AudioCore::GetAndResetSinkStatistics();
+    const auto texture_stats = VideoCommon::GetAndResetTextureCacheStatistics();
     const PerfStatsResults results{
         .system_fps = static_cast<double>(system_frames) / interval,
         .average_game_fps = (current_fps + previous_fps) / 2.0,
         .frametime = duration_cast<DoubleSecs>(accumulated_frametime).count() /
                      static_cast<double>(system_frames),
         .emulation_speed = system_us_per_second.count() / 1'000'000.0,
+        .audio_underruns = audio_stats.underruns,
+        .audio_overruns = audio_stats.overruns,
+        .audio_queue_latency = audio_stats.queue_latency,
+        .audio_stretch_ratio = audio_stats.stretch_ratio,
+        .texture_resident_bytes = texture_stats.resident_bytes,
+        .texture_evictions_per_frame =
+            current_frames > 0.0
+                ? static_cast<double>(texture_stats.evicted_images) / current_frames
+                : 0.0,
     };
 
     // Reset counters
@@ -22,6 +22,18 @@ struct PerfStatsResults {
     double frametime;
     /// Ratio of walltime / emulated time elapsed
     double emulation_speed;
+    /// Number of times the audio output ran out of samples
+    u32 audio_underruns;
+    /// Number of times audio samples were dropped because the output queue was full
+    u32 audio_overruns;
+    /// Average time audio samples waited in the output queue, in seconds
+    double audio_queue_latency;
+    /// Tempo the audio time stretcher last played at, 1.0 when it is not in use
+    double audio_stretch_ratio;
+    /// Host memory used by the images in the texture cache, in bytes
+    u64 texture_resident_bytes;
+    /// Average number of images evicted from the texture cache per game frame
+    double texture_evictions_per_frame;
 };
 
 /**
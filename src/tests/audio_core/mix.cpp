@@ -0,0 +1,208 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "audio_core/algorithm/interpolate.h"
+#include "audio_core/algorithm/mix.h"
+#include "common/common_types.h"
+
+namespace {
+constexpr s32 SAMPLE_COUNT = 240;
+
+// The scalar kernels the command generator used before they were vectorized
+namespace Reference {
+void ApplyMix(s32* output, const s32* input, s32 gain, s32 sample_count) {
+    for (s32 i = 0; i < sample_count; i++) {
+        output[i] += static_cast<s32>((static_cast<s64>(input[i]) * gain + 0x4000) >> 15);
+    }
+}
+
+s32 ApplyMixRamp(s32* output, const s32* input, float gain, float delta, s32 sample_count) {
+    s32 x = 0;
+    for (s32 i = 0; i < sample_count; i++) {
+        x = static_cast<s32>(static_cast<float>(input[i]) * gain);
+        output[i] += x;
+        gain += delta;
+    }
+    return x;
+}
+
+void ApplyGain(s32* output, const s32* input, s32 gain, s32 delta, s32 sample_count) {
+    for (s32 i = 0; i < sample_count; i++) {
+        output[i] = static_cast<s32>((static_cast<s64>(input[i]) * gain + 0x4000) >> 15);
+        gain += delta;
+    }
+}
+
+void ApplyGainWithoutDelta(s32* output, const s32* input, s32 gain, s32 sample_count) {
+    for (s32 i = 0; i < sample_count; i++) {
+        output[i] = static_cast<s32>((static_cast<s64>(input[i]) * gain + 0x4000) >> 15);
+    }
+}
+
+s32 ApplyMixDepop(s32* output, s32 first_sample, s32 delta, s32 sample_count) {
+    const bool positive = first_sample > 0;
+    auto final_sample = std::abs(first_sample);
+    for (s32 i = 0; i < sample_count; i++) {
+        final_sample = static_cast<s32>((static_cast<s64>(final_sample) * delta) >> 15);
+        if (positive) {
+            output[i] += final_sample;
+        } else {
+            output[i] -= final_sample;
+        }
+    }
+    return positive ? final_sample : -final_sample;
+}
+} // namespace Reference
+
+u32 NextRandom(u32& state) {
+    state = state * 1664525 + 1013904223;
+    return state;
+}
+
+/// Makes samples in the range the DSP produces, with a few at the extremes
+std::vector<s32> MakeSamples(std::size_t count, u32 seed) {
+    std::vector<s32> samples(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const s32 value = static_cast<s32>(NextRandom(seed)) >> 8;
+        samples[i] = i % 61 == 0 ? (i % 2 ? 0x7FFFFF : -0x800000) : value;
+    }
+    return samples;
+}
+
+/// Sample counts covering empty frames, the vector tails and the usual frame sizes
+constexpr std::array<s32, 8> TEST_COUNTS{0, 1, 3, 7, 9, 31, 160, SAMPLE_COUNT};
+
+constexpr std::array<s32, 6> TEST_GAINS{0, 1, 0x4000, 0x8000, 0x12345, -0x8000};
+} // Anonymous namespace
+
+TEST_CASE("AudioMix: Kernels match the scalar implementation", "[audio_core]") {
+    const std::vector<s32> input = MakeSamples(SAMPLE_COUNT, 1);
+    const std::vector<s32> initial = MakeSamples(SAMPLE_COUNT, 2);
+
+    for (const s32 count : TEST_COUNTS) {
+        for (const s32 gain : TEST_GAINS) {
+            std::vector<s32> expected = initial;
+            std::vector<s32> output = initial;
+            Reference::ApplyMix(expected.data(), input.data(), gain, count);
+            AudioCore::ApplyMix(output.data(), input.data(), gain, count);
+            REQUIRE(output == expected);
+
+            Reference::ApplyGainWithoutDelta(expected.data(), input.data(), gain, count);
+            AudioCore::ApplyGainWithoutDelta(output.data(), input.data(), gain, count);
+            REQUIRE(output == expected);
+
+            for (const s32 delta : {0, 1, -37, 0x100}) {
+                Reference::ApplyGain(expected.data(), input.data(), gain, delta, count);
+                AudioCore::ApplyGain(output.data(), input.data(), gain, delta, count);
+                REQUIRE(output == expected);
+
+                // In place, like volume ramps are applied
+                Reference::ApplyGain(expected.data(), expected.data(), gain, delta, count);
+                AudioCore::ApplyGain(output.data(), output.data(), gain, delta, count);
+                REQUIRE(output == expected);
+            }
+
+            const float volume = static_cast<float>(gain) / 32768.0f;
+            for (const float delta : {0.0f, 0.001f, -1.0f / 240.0f}) {
+                const s32 expected_last =
+                    Reference::ApplyMixRamp(expected.data(), input.data(), volume, delta, count);
+                REQUIRE(AudioCore::ApplyMixRamp(output.data(), input.data(), volume, delta,
+                                                count) == expected_last);
+                REQUIRE(output == expected);
+            }
+
+            for (const s32 first_sample : {0, 1000, -123456, 0x7FFFFF}) {
+                const s32 delta = gain & 0x7FFF;
+                REQUIRE(AudioCore::ApplyMixDepop(output.data(), first_sample, delta, count) ==
+                        Reference::ApplyMixDepop(expected.data(), first_sample, delta, count));
+                REQUIRE(output == expected);
+            }
+        }
+    }
+}
+
+TEST_CASE("AudioMix: Resample matches the scalar implementation", "[audio_core]") {
+    // Generic resampler with the same lookup tables, the curve is selected by the pitch
+    const auto reference_resample = [](s32* output, const s32* input, s32 pitch, s32& fraction,
+                                       std::size_t sample_count) {
+        for (std::size_t i = 0; i < sample_count; i++) {
+            // One sample at a time never reaches the vectorized loop
+            const s32 previous_fraction = fraction;
+            AudioCore::Resample(&output[i], input, pitch, fraction, 1);
+            input += (previous_fraction + pitch) >> 15;
+        }
+    };
+
+    const std::vector<s32> input = MakeSamples(SAMPLE_COUNT * 3 + 8, 3);
+    for (const s32 pitch : {0x4000, 0x8000, 0x9000, 0xC000, 0x17FFF}) {
+        for (const s32 count : TEST_COUNTS) {
+            s32 expected_fraction = 0x1234;
+            s32 fraction = expected_fraction;
+            std::vector<s32> expected(SAMPLE_COUNT);
+            std::vector<s32> output(SAMPLE_COUNT);
+            reference_resample(expected.data(), input.data(), pitch, expected_fraction,
+                               static_cast<std::size_t>(count));
+            AudioCore::Resample(output.data(), input.data(), pitch, fraction,
+                                static_cast<std::size_t>(count));
+            REQUIRE(output == expected);
+            REQUIRE(fraction == expected_fraction);
+        }
+    }
+}
+
+TEST_CASE("AudioMix: Voice rendering throughput", "[audio_core]") {
+    constexpr std::size_t num_voices = 128;
+    constexpr std::size_t num_mix_buffers = 6;
+    constexpr std::size_t num_frames = 200;
+    constexpr s32 pitch = 0x8000 * 32000 / 48000;
+
+    const std::vector<s32> source = MakeSamples(SAMPLE_COUNT * 2, 4);
+    std::vector<s32> voice(SAMPLE_COUNT);
+    std::vector<std::vector<s32>> mix_buffers(num_mix_buffers, std::vector<s32>(SAMPLE_COUNT));
+
+    // Renders every voice like the command generator does: resampling, a volume ramp and a mix
+    // into every mix buffer, then the final mix gain. Only the first mix volume is ramping, the
+    // others are steady like they are most frames.
+    const auto render = [&](auto&& apply_gain, auto&& apply_mix_ramp, auto&& apply_gain_final) {
+        const auto start = std::chrono::steady_clock::now();
+        for (std::size_t frame = 0; frame < num_frames; ++frame) {
+            for (auto& buffer : mix_buffers) {
+                std::fill(buffer.begin(), buffer.end(), 0);
+            }
+            for (std::size_t v = 0; v < num_voices; ++v) {
+                s32 fraction = 0;
+                AudioCore::Resample(voice.data(), source.data(), pitch, fraction, SAMPLE_COUNT);
+                apply_gain(voice.data(), voice.data(), 0x6000, 3, SAMPLE_COUNT);
+                for (std::size_t b = 0; b < num_mix_buffers; ++b) {
+                    apply_mix_ramp(mix_buffers[b].data(), voice.data(), 0.25f,
+                                   b == 0 ? 0.0001f : 0.0f, SAMPLE_COUNT);
+                }
+            }
+            for (auto& buffer : mix_buffers) {
+                apply_gain_final(buffer.data(), buffer.data(), 0x7000, SAMPLE_COUNT);
+            }
+        }
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+            .count();
+    };
+
+    const double scalar_time =
+        render(Reference::ApplyGain, Reference::ApplyMixRamp, Reference::ApplyGainWithoutDelta);
+    const std::vector<std::vector<s32>> expected = mix_buffers;
+    const double vector_time = render(AudioCore::ApplyGain, AudioCore::ApplyMixRamp,
+                                      AudioCore::ApplyGainWithoutDelta);
+    REQUIRE(mix_buffers == expected);
+
+    printf("Rendering %zu frames of %zu voices into %zu mix buffers: scalar %.3f ms, vectorized "
+           "%.3f ms\n",
+           num_frames, num_voices, num_mix_buffers, scalar_time, vector_time);
+}
@@ -0,0 +1,83 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <span>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "audio_core/sink_stream.h"
+#include "common/common_types.h"
+
+namespace {
+/// Sink stream exposing the helpers shared by the sink implementations
+class TestSinkStream final : public AudioCore::SinkStream {
+public:
+    using SinkStream::ConvertFrames;
+    using SinkStream::RecordOverrun;
+    using SinkStream::RecordQueueLatency;
+    using SinkStream::RecordUnderrun;
+
+    void EnqueueSamples(u32, const std::vector<s16>&, float) override {}
+
+    std::size_t SamplesInQueue(u32) const override {
+        return 0;
+    }
+
+    void Flush() override {}
+};
+} // Anonymous namespace
+
+TEST_CASE("SinkStream: Frames are converted across both regions", "[audio_core]") {
+    const std::vector<s16> samples{100, -200, 300, -400, 500, -600};
+    std::vector<s16> first(3);
+    std::vector<s16> second(3);
+
+    TestSinkStream::ConvertFrames(first, second, samples, 2, 2, 1.0f);
+    REQUIRE(first == std::vector<s16>{100, -200, 300});
+    REQUIRE(second == std::vector<s16>{-400, 500, -600});
+
+    TestSinkStream::ConvertFrames(first, second, samples, 2, 2, 0.5f);
+    REQUIRE(first == std::vector<s16>{50, -100, 150});
+    REQUIRE(second == std::vector<s16>{-200, 250, -300});
+}
+
+TEST_CASE("SinkStream: 5.1 frames are downmixed to stereo", "[audio_core]") {
+    // Two frames: front left, front right, center, low frequency, surround left, surround right
+    const std::vector<s16> samples{1000, 2000, 1000, 30000, 100, 200,
+                                   -1000, 0, 0, 0, -1000, 1000};
+    std::vector<s16> first(1);
+    std::vector<s16> second(3);
+
+    TestSinkStream::ConvertFrames(first, second, samples, 6, 2, 1.0f);
+    REQUIRE(first[0] == 1000 + 707 + 70);
+    REQUIRE(second == std::vector<s16>{2000 + 707 + 141, -1000 - 707, 707});
+
+    TestSinkStream::ConvertFrames(first, second, samples, 6, 2, 0.5f);
+    REQUIRE(first[0] == 500 + 353 + 35);
+}
+
+TEST_CASE("SinkStream: Statistics are reset when read", "[audio_core]") {
+    AudioCore::GetAndResetSinkStatistics();
+
+    TestSinkStream::RecordUnderrun();
+    TestSinkStream::RecordUnderrun();
+    TestSinkStream::RecordOverrun();
+    TestSinkStream::RecordQueueLatency(4800, 48000);
+    TestSinkStream::RecordQueueLatency(14400, 48000);
+    AudioCore::RecordStretchRatio(1.25);
+
+    const auto stats = AudioCore::GetAndResetSinkStatistics();
+    REQUIRE(stats.underruns == 2);
+    REQUIRE(stats.overruns == 1);
+    REQUIRE(stats.queue_latency == Approx(0.2));
+    REQUIRE(stats.stretch_ratio == 1.25);
+
+    const auto empty = AudioCore::GetAndResetSinkStatistics();
+    REQUIRE(empty.underruns == 0);
+    REQUIRE(empty.overruns == 0);
+    REQUIRE(empty.queue_latency == 0.0);
+    REQUIRE(empty.stretch_ratio == 1.25);
+    AudioCore::RecordStretchRatio(1.0);
+}
@@ -0,0 +1,125 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <array>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "common/bounded_threadsafe_queue.h"
+#include "common/common_types.h"
+
+namespace Common {
+
+TEST_CASE("BoundedMPSCQueue: Single producer", "[common]") {
+    BoundedMPSCQueue<u32, 4> queue;
+    REQUIRE(queue.Empty());
+
+    for (u32 i = 0; i < 4; ++i) {
+        REQUIRE(queue.Push(i * 10) == i);
+    }
+    REQUIRE(!queue.Empty());
+    for (u32 i = 0; i < 4; ++i) {
+        REQUIRE(queue.PopWait() == i * 10);
+    }
+    REQUIRE(queue.Empty());
+
+    // Slots are reused on the next lap
+    REQUIRE(queue.Push(42) == 4);
+    REQUIRE(queue.PopWait() == 42);
+}
+
+TEST_CASE("BoundedMPSCQueue: Multiple producers", "[common]") {
+    static constexpr u32 num_producers = 4;
+    static constexpr u32 num_elements = 10000;
+
+    // Small capacity to make producers block on a full queue
+    BoundedMPSCQueue<u64, 16> queue;
+    std::array<std::thread, num_producers> producers;
+    for (u32 producer = 0; producer < num_producers; ++producer) {
+        producers[producer] = std::thread([&queue, producer] {
+            for (u32 i = 0; i < num_elements; ++i) {
+                queue.Push((static_cast<u64>(producer) << 32) | i);
+            }
+        });
+    }
+
+    // Each producer's elements must be popped in the order they were pushed
+    std::array<u32, num_producers> next_element{};
+    for (u32 i = 0; i < num_producers * num_elements; ++i) {
+        const u64 value = queue.PopWait();
+        const u32 producer = static_cast<u32>(value >> 32);
+        REQUIRE(producer < num_producers);
+        REQUIRE(static_cast<u32>(value) == next_element[producer]);
+        ++next_element[producer];
+    }
+    for (std::thread& thread : producers) {
+        thread.join();
+    }
+    REQUIRE(queue.Empty());
+}
+
+TEST_CASE("BoundedMPMCQueue: Full and empty", "[common]") {
+    BoundedMPMCQueue<u32, 4> queue;
+    u32 value = 0;
+    REQUIRE(queue.Empty());
+    REQUIRE(!queue.TryPop(value));
+
+    for (u32 i = 0; i < 4; ++i) {
+        REQUIRE(queue.TryPush(i));
+    }
+    REQUIRE(!queue.TryPush(4U));
+    for (u32 i = 0; i < 4; ++i) {
+        REQUIRE(queue.TryPop(value));
+        REQUIRE(value == i);
+    }
+    REQUIRE(!queue.TryPop(value));
+    REQUIRE(queue.Empty());
+}
+
+TEST_CASE("BoundedMPMCQueue: Multiple producers and consumers", "[common]") {
+    static constexpr u32 num_threads = 4;
+    static constexpr u32 num_elements = 10000;
+
+    BoundedMPMCQueue<u32, 16> queue;
+    std::array<std::thread, num_threads> producers;
+    std::array<std::thread, num_threads> consumers;
+    std::array<std::vector<u32>, num_threads> popped;
+    for (u32 thread = 0; thread < num_threads; ++thread) {
+        producers[thread] = std::thread([&queue, thread] {
+            for (u32 i = 0; i < num_elements; ++i) {
+                while (!queue.TryPush(thread * num_elements + i)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+        consumers[thread] = std::thread([&queue, &popped, thread] {
+            u32 value = 0;
+            while (popped[thread].size() < num_elements) {
+                if (queue.TryPop(value)) {
+                    popped[thread].push_back(value);
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (u32 thread = 0; thread < num_threads; ++thread) {
+        producers[thread].join();
+        consumers[thread].join();
+    }
+
+    // Every element must be popped exactly once
+    std::vector<bool> seen(num_threads * num_elements);
+    for (const auto& values : popped) {
+        for (const u32 value : values) {
+            REQUIRE(!seen[value]);
+            seen[value] = true;
+        }
+    }
+    REQUIRE(queue.Empty());
+}
+
+} // namespace Common
@@ -0,0 +1,114 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <string>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <fmt/format.h>
+
+#include "common/common_types.h"
+#include "common/logging/binary_log.h"
+#include "common/logging/deferred.h"
+
+namespace {
+using namespace Common::Log;
+
+template <typename... Args>
+std::vector<u8> Encode(const Args&... args) {
+    std::vector<u8> data(DeferredArgsSize<Args...>);
+    EncodeDeferredArgs(data.data(), args...);
+    return data;
+}
+
+template <typename... Args>
+void CheckFormat(const char* format, const Args&... args) {
+    REQUIRE(FormatDeferredArgs(format, Encode(args...)) ==
+            fmt::vformat(format, fmt::make_format_args(args...)));
+}
+} // Anonymous namespace
+
+TEST_CASE("DeferredLogging: Deferred arguments format like fmt", "[common]") {
+    CheckFormat("no arguments");
+    CheckFormat("{} {} {}", true, 'x', static_cast<u8>(200));
+    CheckFormat("{:08X} {:#x} {}", u32{0xDEADBEEF}, u64{0x123456789ABCDEF0}, s64{-42});
+    CheckFormat("{} {:d} {}", s16{-7}, static_cast<s8>(-100), std::size_t{1} << 40);
+    CheckFormat("{:.3f} {}", 3.14159f, -2.5);
+    CheckFormat("{}", reinterpret_cast<const void*>(std::uintptr_t{0x1000}));
+}
+
+TEST_CASE("DeferredLogging: Malformed arguments are reported", "[common]") {
+    std::vector<u8> data = Encode(u64{1});
+    data.pop_back();
+    REQUIRE(FormatDeferredArgs("{}", data).starts_with("<malformed"));
+
+    // Missing arguments must not throw out of the logging thread
+    REQUIRE_NOTHROW(FormatDeferredArgs("{} {}", Encode(1)));
+}
+
+TEST_CASE("DeferredLogging: Binary logs decode to the logged messages", "[common]") {
+    static constexpr const char* format = "Read {} bytes at {:#x}";
+    const std::vector<u8> args = Encode(u32{512}, u64{0x8000});
+    const std::string text = "formatted on capture";
+
+    BinaryLogWriter writer;
+    for (int i = 0; i < 2; ++i) {
+        writer.Write(DeferredEntry{
+            .timestamp = std::chrono::microseconds{i},
+            .log_class = Class::Service_FS,
+            .log_level = Level::Trace,
+            .filename = "core/hle/service/filesystem/fsp_srv.cpp",
+            .line_num = 100,
+            .function = "Read",
+            .format = format,
+            .data = args,
+        });
+    }
+    writer.Write(DeferredEntry{
+        .timestamp = std::chrono::microseconds{2},
+        .log_class = Class::Kernel_SVC,
+        .log_level = Level::Debug,
+        .filename = "core/hle/kernel/svc.cpp",
+        .line_num = 200,
+        .function = "SendSyncRequest",
+        .format = nullptr,
+        .data = {reinterpret_cast<const u8*>(text.data()), text.size()},
+    });
+    writer.Write(Entry{
+        .timestamp = std::chrono::microseconds{3},
+        .log_class = Class::Frontend,
+        .log_level = Level::Error,
+        .filename = "yuzu/main.cpp",
+        .line_num = 300,
+        .function = "Boot",
+        .message = "regular entry",
+    });
+
+    // Filenames point to strings owned by the decoder, copy them while decoding
+    std::vector<Entry> entries;
+    std::vector<std::string> filenames;
+    const auto data = writer.GetData();
+    REQUIRE(DecodeBinaryLog(data, [&](const Entry& entry) {
+        entries.push_back(entry);
+        filenames.emplace_back(entry.filename);
+    }));
+    REQUIRE(entries.size() == 4);
+    REQUIRE(entries[0].message == "Read 512 bytes at 0x8000");
+    REQUIRE(entries[1].timestamp.count() == 1);
+    REQUIRE(entries[1].log_class == Class::Service_FS);
+    REQUIRE(entries[1].log_level == Level::Trace);
+    REQUIRE(filenames[1] == "core/hle/service/filesystem/fsp_srv.cpp");
+    REQUIRE(entries[1].line_num == 100);
+    REQUIRE(entries[1].function == "Read");
+    REQUIRE(entries[2].message == text);
+    REQUIRE(entries[3].message == "regular entry");
+    REQUIRE(entries[3].function == "Boot");
+
+    // Truncated logs decode up to the last complete message
+    std::vector<Entry> truncated_entries;
+    REQUIRE(!DecodeBinaryLog(data.first(data.size() - 1), [&](const Entry& entry) {
+        truncated_entries.push_back(entry);
+    }));
+    REQUIRE(truncated_entries.size() == 3);
+}
@@ -0,0 +1,90 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <thread>
+
+#include <catch2/catch.hpp>
+
+#include "common/bounded_threadsafe_queue.h"
+#include "common/common_types.h"
+#include "common/pool_allocator.h"
+
+namespace Common {
+
+namespace {
+
+template <std::size_t Size>
+struct Payload {
+    std::array<u32, Size> words{};
+};
+
+template <typename T>
+std::shared_ptr<T> MakePooled(u32 seed) {
+    auto object = std::allocate_shared<T>(PoolAllocator<T>{});
+    object->words[0] = seed;
+    return object;
+}
+
+} // Anonymous namespace
+
+TEST_CASE("PoolAllocator: Steady state doesn't allocate", "[common]") {
+    using TestPayload = Payload<64>;
+    constexpr std::size_t NUM_LIVE = 16;
+
+    std::array<std::shared_ptr<TestPayload>, NUM_LIVE> live;
+    const auto run_cycle = [&live](u32 cycle) {
+        for (u32 i = 0; i < NUM_LIVE; ++i) {
+            live[i] = MakePooled<TestPayload>(cycle + i);
+        }
+        for (u32 i = 0; i < NUM_LIVE; ++i) {
+            REQUIRE(live[i]->words[0] == cycle + i);
+            live[i].reset();
+        }
+    };
+
+    // The first cycle grows the pool to the peak number of live objects
+    run_cycle(0);
+    const std::size_t warm_blocks = GetBlockPoolHeapBlocks();
+
+    for (u32 cycle = 1; cycle < 1000; ++cycle) {
+        run_cycle(cycle);
+    }
+    REQUIRE(GetBlockPoolHeapBlocks() == warm_blocks);
+}
+
+TEST_CASE("PoolAllocator: Blocks freed on another thread are reused", "[common]") {
+    using TestPayload = Payload<128>;
+    constexpr u32 NUM_OBJECTS = 100000;
+
+    BoundedMPMCQueue<std::shared_ptr<TestPayload>, 64> queue;
+    std::atomic_bool is_done{};
+    std::thread consumer([&queue, &is_done] {
+        std::shared_ptr<TestPayload> object;
+        while (!is_done.load(std::memory_order_acquire) || !queue.Empty()) {
+            if (queue.TryPop(object)) {
+                object.reset();
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    const std::size_t start_blocks = GetBlockPoolHeapBlocks();
+    for (u32 i = 0; i < NUM_OBJECTS; ++i) {
+        auto object = MakePooled<TestPayload>(i);
+        while (!queue.TryPush(object)) {
+            std::this_thread::yield();
+        }
+    }
+    is_done.store(true, std::memory_order_release);
+    consumer.join();
+
+    // Bounded by the objects in flight and the blocks cached by both threads
+    REQUIRE(GetBlockPoolHeapBlocks() - start_blocks < 512);
+}
+
+} // namespace Common
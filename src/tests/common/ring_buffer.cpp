@@ -6,6 +6,7 @@
 #include <array>
 #include <cstddef>
 #include <numeric>
+#include <span>
 #include <thread>
 #include <vector>
 #include <catch2/catch.hpp>
@@ -76,6 +77,41 @@ TEST_CASE("RingBuffer: Basic Tests", "[common]") {
     REQUIRE(buf.Size() == 0U);
 }
 
+TEST_CASE("RingBuffer: Push in place", "[common]") {
+    RingBuffer<char, 8> buf;
+
+    // Move the write index close to the end so the next push wraps around.
+    REQUIRE(buf.Push(std::vector<char>(6, 1)) == 6U);
+    REQUIRE(buf.Pop(6).size() == 6U);
+
+    std::size_t first_size = 0;
+    std::size_t second_size = 0;
+    const std::size_t count = buf.PushWith(5, [&](std::span<char> first, std::span<char> second) {
+        first_size = first.size();
+        second_size = second.size();
+        char value = 10;
+        for (char& slot : first) {
+            slot = value++;
+        }
+        for (char& slot : second) {
+            slot = value++;
+        }
+    });
+    REQUIRE(count == 5U);
+    REQUIRE(first_size == 2U);
+    REQUIRE(second_size == 3U);
+    REQUIRE(buf.Pop(8) == std::vector<char>{10, 11, 12, 13, 14});
+
+    // Only the free slots are offered to the writer.
+    REQUIRE(buf.Push(std::vector<char>(7, 1)) == 7U);
+    REQUIRE(buf.PushWith(4, [](std::span<char> first, std::span<char> second) {
+        REQUIRE(first.size() + second.size() == 1U);
+        std::fill(first.begin(), first.end(), char{2});
+        std::fill(second.begin(), second.end(), char{2});
+    }) == 1U);
+    REQUIRE(buf.Size() == 8U);
+}
+
 TEST_CASE("RingBuffer: Threaded Test", "[common]") {
     RingBuffer<char, 8> buf;
     const char seed = 42;
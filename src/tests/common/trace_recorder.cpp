@@ -0,0 +1,128 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "common/fs/file.h"
+#include "common/trace_recorder.h"
+
+namespace {
+std::filesystem::path TracePath() {
+    return std::filesystem::temp_directory_path() / "yuzu_test_trace.json";
+}
+
+/// Returns the lines of a trace, one per event, without the enclosing brackets and separators
+std::vector<std::string> ReadTraceEvents(const std::filesystem::path& path) {
+    const std::string contents =
+        Common::FS::ReadStringFromFile(path, Common::FS::FileType::TextFile);
+    REQUIRE(contents.starts_with("[\n"));
+    REQUIRE(contents.ends_with("\n]\n"));
+
+    std::vector<std::string> events;
+    std::string_view remaining{contents};
+    remaining = remaining.substr(2, remaining.size() - 5);
+    while (!remaining.empty()) {
+        const std::size_t end = remaining.find(",\n");
+        events.emplace_back(remaining.substr(0, end));
+        if (end == std::string_view::npos) {
+            break;
+        }
+        remaining.remove_prefix(end + 2);
+    }
+    return events;
+}
+
+/// Returns the index of the first event containing the text, or the number of events
+std::size_t FindEvent(const std::vector<std::string>& events, std::string_view text) {
+    const auto it = std::find_if(events.begin(), events.end(), [text](const std::string& event) {
+        return event.find(text) != std::string::npos;
+    });
+    return static_cast<std::size_t>(std::distance(events.begin(), it));
+}
+} // Anonymous namespace
+
+TEST_CASE("TraceRecorder: Interned names are shared", "[common]") {
+    const std::string name = "interned_name";
+    const char* const interned = Common::Trace::InternName(name);
+    REQUIRE(std::string_view{interned} == name);
+    REQUIRE(Common::Trace::InternName("interned_name") == interned);
+    REQUIRE(Common::Trace::InternName("other_name") != interned);
+}
+
+TEST_CASE("TraceRecorder: Recorded events are written as Chrome trace events", "[common]") {
+    const auto path = TracePath();
+
+    // Nothing is recorded before the trace starts
+    REQUIRE(!Common::Trace::IsRecording());
+    Common::Trace::RecordScope("test", "before_start", 0, 1000);
+
+    REQUIRE(Common::Trace::Start(path));
+    REQUIRE(Common::Trace::IsRecording());
+    Common::Trace::RecordScope("test", "first_scope", 1000, 3500);
+    Common::Trace::RecordInstant("test", "instant", "value", 42);
+    Common::Trace::RecordScope("test", Common::Trace::InternName("escaped \"name\"\n"), 4000,
+                               4250);
+    std::thread([] { Common::Trace::RecordScope("test", "exited_thread", 5000, 6000); }).join();
+    Common::Trace::Stop();
+    REQUIRE(!Common::Trace::IsRecording());
+
+    const auto events = ReadTraceEvents(path);
+    REQUIRE(FindEvent(events, "before_start") == events.size());
+
+    const std::size_t first_scope = FindEvent(events, R"({"name":"first_scope")");
+    REQUIRE(first_scope < events.size());
+    REQUIRE(events[first_scope].starts_with(
+        R"({"name":"first_scope","cat":"test","ph":"X","ts":1.000,"dur":2.500,"pid":1,"tid":)"));
+
+    const std::size_t instant = FindEvent(events, R"({"name":"instant")");
+    REQUIRE(instant < events.size());
+    REQUIRE(events[instant].find(R"("ph":"i","s":"t")") != std::string::npos);
+    REQUIRE(events[instant].ends_with(R"("args":{"value":42}})"));
+
+    // Events of a thread are written in the order they were recorded
+    const std::size_t escaped = FindEvent(events, R"({"name":"escaped \"name\"\u000a")");
+    REQUIRE(escaped < events.size());
+    REQUIRE(first_scope < instant);
+    REQUIRE(instant < escaped);
+
+    // Rings of threads that exited are still written, each thread is named once
+    const std::size_t exited_thread = FindEvent(events, R"({"name":"exited_thread")");
+    REQUIRE(exited_thread < events.size());
+    REQUIRE(events[exited_thread].substr(events[exited_thread].find(R"("tid":)")) !=
+            events[first_scope].substr(events[first_scope].find(R"("tid":)")));
+    const auto num_thread_names =
+        std::count_if(events.begin(), events.end(), [](const std::string& event) {
+            return event.starts_with(R"({"name":"thread_name","ph":"M")");
+        });
+    REQUIRE(num_thread_names == 2);
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("TraceRecorder: Each trace only holds its own events", "[common]") {
+    const auto path = TracePath();
+
+    REQUIRE(Common::Trace::Start(path));
+    Common::Trace::RecordScope("test", "first_trace", 0, 1000);
+    Common::Trace::Stop();
+    Common::Trace::RecordScope("test", "after_stop", 0, 1000);
+
+    REQUIRE(Common::Trace::Start(path));
+    Common::Trace::RecordScope("test", "second_trace", 0, 1000);
+    Common::Trace::Stop();
+
+    const auto events = ReadTraceEvents(path);
+    REQUIRE(FindEvent(events, "first_trace") == events.size());
+    REQUIRE(FindEvent(events, "after_stop") == events.size());
+    REQUIRE(FindEvent(events, "second_trace") < events.size());
+
+    std::filesystem::remove(path);
+}
@@ -4,15 +4,21 @@
 
 #include <catch2/catch.hpp>
 
+#include <algorithm>
 #include <array>
 #include <bitset>
 #include <chrono>
 #include <cstdlib>
+#include <functional>
 #include <memory>
+#include <random>
 #include <string>
+#include <tuple>
+#include <vector>
 
 #include "core/core.h"
 #include "core/core_timing.h"
+#include "core/core_timing_wheel.h"
 
 namespace {
 // Numbers are chosen randomly to make sure the correct one is given.
@@ -55,6 +61,78 @@ u64 TestTimerSpeed(Core::Timing::CoreTiming& core_timing) {
     return end - start;
 }
 
+/// Binary heap event queue, the way CoreTiming kept its events before the timing wheel
+class HeapEventQueue {
+public:
+    void Schedule(u64 time, u64 fifo_order, const std::shared_ptr<Core::Timing::EventType>& type,
+                  std::uintptr_t user_data) {
+        events.push_back(Event{time, fifo_order, user_data, type});
+        std::push_heap(events.begin(), events.end(), std::greater<>());
+    }
+
+    void Unschedule(const Core::Timing::EventType* type, std::uintptr_t user_data) {
+        const auto it = std::remove_if(events.begin(), events.end(), [&](const Event& e) {
+            return e.type.lock().get() == type && e.user_data == user_data;
+        });
+        if (it != events.end()) {
+            events.erase(it, events.end());
+            std::make_heap(events.begin(), events.end(), std::greater<>());
+        }
+    }
+
+    bool PopDue(u64 now) {
+        if (events.empty() || events.front().time > now) {
+            return false;
+        }
+        std::pop_heap(events.begin(), events.end(), std::greater<>());
+        events.pop_back();
+        return true;
+    }
+
+private:
+    struct Event {
+        u64 time;
+        u64 fifo_order;
+        std::uintptr_t user_data;
+        std::weak_ptr<Core::Timing::EventType> type;
+
+        friend bool operator>(const Event& left, const Event& right) {
+            return std::tie(left.time, left.fifo_order) > std::tie(right.time, right.fifo_order);
+        }
+    };
+
+    std::vector<Event> events;
+};
+
+/// Keeps a number of timeouts outstanding, cancelling a quarter of them before they expire like
+/// the kernel does with thread timeouts. Returns the elapsed time in nanoseconds.
+template <typename Queue>
+u64 RunTimeoutWorkload(Queue& queue, const std::shared_ptr<Core::Timing::EventType>& type,
+                       std::size_t outstanding, std::size_t operations) {
+    std::mt19937_64 rng{1234};
+    std::uniform_int_distribution<u64> delay{1'000, 16'000'000};
+    u64 now = 0;
+    u64 fifo_order = 0;
+    for (std::size_t i = 0; i < outstanding; ++i) {
+        queue.Schedule(now + delay(rng), fifo_order++, type, i);
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < operations; ++i) {
+        const std::uintptr_t user_data = outstanding + i;
+        if (i % 4 == 0) {
+            queue.Schedule(now + delay(rng), fifo_order++, type, user_data);
+            queue.Unschedule(type.get(), user_data);
+        }
+        queue.Schedule(now + delay(rng), fifo_order++, type, user_data);
+        now += 4'000;
+        while (queue.PopDue(now)) {
+        }
+    }
+    const auto end = std::chrono::steady_clock::now();
+    return static_cast<u64>(std::chrono::nanoseconds{end - start}.count());
+}
+
 } // Anonymous namespace
 
 TEST_CASE("CoreTiming[BasicOrder]", "[core]") {
@@ -144,3 +222,81 @@ TEST_CASE("CoreTiming[BasicOrderNoPausing]", "[core]") {
     printf("HostTimer No Pausing Timer Time: %.3f %.6f\n", timer_time / 1000.f,
            timer_time / 1000000.f);
 }
+
+TEST_CASE("CoreTiming[TimingWheelOrder]", "[core]") {
+    const auto event_type = Core::Timing::CreateEvent("wheel", [](std::uintptr_t, auto) {});
+    Core::Timing::TimingWheel wheel;
+    std::vector<std::tuple<u64, u64, std::uintptr_t>> expected;
+    std::mt19937_64 rng{42};
+    u64 fifo_order = 0;
+
+    const auto schedule = [&](u64 time, std::uintptr_t user_data) {
+        wheel.Schedule(time, fifo_order, event_type, user_data);
+        expected.emplace_back(time, fifo_order, user_data);
+        ++fifo_order;
+    };
+    const auto check_pop_until = [&](u64 now) {
+        std::sort(expected.begin(), expected.end());
+        const auto due_end = std::find_if(expected.begin(), expected.end(),
+                                          [now](const auto& e) { return std::get<0>(e) > now; });
+        for (auto it = expected.begin(); it != due_end; ++it) {
+            const auto event = wheel.PopDue(now);
+            REQUIRE(event);
+            REQUIRE(event->time == std::get<0>(*it));
+            REQUIRE(event->fifo_order == std::get<1>(*it));
+            REQUIRE(event->user_data == std::get<2>(*it));
+            REQUIRE(event->type.lock() == event_type);
+        }
+        REQUIRE(!wheel.PopDue(now));
+        expected.erase(expected.begin(), due_end);
+        REQUIRE(wheel.Size() == expected.size());
+    };
+
+    // Spread the events over every level of the wheel, with some sharing a time
+    for (std::uintptr_t i = 0; i < 4096; ++i) {
+        const u64 time = rng() >> (rng() % 64);
+        schedule(time, i);
+        if (i % 8 == 0) {
+            schedule(time, i + 100'000);
+        }
+    }
+    const auto unschedule = [&](std::uintptr_t user_data) {
+        wheel.Unschedule(event_type.get(), user_data);
+        std::erase_if(expected, [&](const auto& e) { return std::get<2>(e) == user_data; });
+    };
+    for (std::uintptr_t i = 0; i < 4096; i += 3) {
+        unschedule(i);
+    }
+    check_pop_until(1'000);
+    check_pop_until(1'000'000);
+
+    // Events before the cursor still run in order
+    REQUIRE(wheel.NextTime() == std::get<0>(expected.front()));
+    schedule(1'000'001, 200'000);
+    schedule(1'000'001, 200'001);
+    unschedule(200'000);
+    check_pop_until(1'000'001);
+
+    check_pop_until(u64{1} << 40);
+    wheel.Remove(event_type.get());
+    expected.clear();
+    REQUIRE(wheel.Empty());
+    REQUIRE(!wheel.NextTime());
+}
+
+TEST_CASE("CoreTiming[TimingWheelThroughput]", "[core]") {
+    const auto event_type = Core::Timing::CreateEvent("throughput", [](std::uintptr_t, auto) {});
+    constexpr std::size_t outstanding = 16384;
+    constexpr std::size_t operations = 10000;
+
+    HeapEventQueue heap;
+    const u64 heap_time = RunTimeoutWorkload(heap, event_type, outstanding, operations);
+
+    Core::Timing::TimingWheel wheel;
+    const u64 wheel_time = RunTimeoutWorkload(wheel, event_type, outstanding, operations);
+
+    printf("Event queue with %zu outstanding events, %zu operations: heap %.3f ms, timing wheel "
+           "%.3f ms\n",
+           outstanding, operations, static_cast<double>(heap_time) / 1000000.0,
+           static_cast<double>(wheel_time) / 1000000.0);
+}
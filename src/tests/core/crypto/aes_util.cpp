@@ -0,0 +1,149 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "common/common_types.h"
+#include "core/crypto/aes_ni.h"
+#include "core/crypto/aes_util.h"
+#include "core/crypto/key_manager.h"
+
+namespace {
+using Core::Crypto::AESCipher;
+using Core::Crypto::AESNIEngine;
+using Core::Crypto::Key128;
+using Core::Crypto::Key256;
+using Core::Crypto::Mode;
+using Core::Crypto::Op;
+
+std::vector<u8> MakeData(std::size_t size, u32 seed) {
+    std::vector<u8> data(size);
+    u32 state = seed;
+    for (u8& value : data) {
+        state = state * 1664525 + 1013904223;
+        value = static_cast<u8>(state >> 24);
+    }
+    return data;
+}
+
+template <typename Key>
+Key MakeKey(u32 seed) {
+    const std::vector<u8> data = MakeData(sizeof(Key), seed);
+    Key key;
+    std::copy(data.begin(), data.end(), key.begin());
+    return key;
+}
+
+/// Counter whose low 64 bits are about to wrap around
+constexpr std::array<u8, 16> CTR_IV{0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08,
+                                    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFD};
+} // Anonymous namespace
+
+TEST_CASE("AESCipher: Hardware CTR matches mbedtls", "[core]") {
+    if (!AESNIEngine::IsSupported()) {
+        return;
+    }
+    const Key128 key = MakeKey<Key128>(1);
+    AESCipher<Key128> hardware(key, Mode::CTR);
+    AESCipher<Key128> software(key, Mode::CTR, false);
+
+    for (const std::size_t size : {1, 15, 16, 17, 127, 128, 129, 0x4000 + 5}) {
+        const std::vector<u8> input = MakeData(size, static_cast<u32>(size));
+        std::vector<u8> hardware_output(size);
+        std::vector<u8> software_output(size);
+        hardware.SetIV(CTR_IV);
+        software.SetIV(CTR_IV);
+
+        // Run twice to check the counter is carried over between calls
+        for (int pass = 0; pass < 2; ++pass) {
+            hardware.Transcode(input.data(), size, hardware_output.data(), Op::Decrypt);
+            software.Transcode(input.data(), size, software_output.data(), Op::Decrypt);
+            REQUIRE(hardware_output == software_output);
+        }
+    }
+}
+
+TEST_CASE("AESCipher: Hardware XTS matches mbedtls", "[core]") {
+    if (!AESNIEngine::IsSupported()) {
+        return;
+    }
+    const Key256 key = MakeKey<Key256>(2);
+    AESCipher<Key256> hardware(key, Mode::XTS);
+    AESCipher<Key256> software(key, Mode::XTS, false);
+
+    for (const std::size_t sector_size : {0x200, 0x4000}) {
+        const std::size_t size = sector_size * 3;
+        const std::vector<u8> input = MakeData(size, static_cast<u32>(sector_size));
+        std::vector<u8> hardware_output(size);
+        std::vector<u8> software_output(size);
+
+        hardware.XTSTranscode(input.data(), size, hardware_output.data(), 7, sector_size,
+                              Op::Encrypt);
+        software.XTSTranscode(input.data(), size, software_output.data(), 7, sector_size,
+                              Op::Encrypt);
+        REQUIRE(hardware_output == software_output);
+
+        hardware.XTSTranscode(input.data(), size, hardware_output.data(), 7, sector_size,
+                              Op::Decrypt);
+        software.XTSTranscode(input.data(), size, software_output.data(), 7, sector_size,
+                              Op::Decrypt);
+        REQUIRE(hardware_output == software_output);
+    }
+}
+
+TEST_CASE("AESCipher: Hardware ECB matches mbedtls", "[core]") {
+    if (!AESNIEngine::IsSupported()) {
+        return;
+    }
+    const Key128 key = MakeKey<Key128>(3);
+    AESCipher<Key128> hardware(key, Mode::ECB);
+    AESCipher<Key128> software(key, Mode::ECB, false);
+
+    for (const Op op : {Op::Encrypt, Op::Decrypt}) {
+        const std::vector<u8> input = MakeData(0x10 * 19, 3);
+        std::vector<u8> hardware_output(input.size());
+        std::vector<u8> software_output(input.size());
+        hardware.Transcode(input.data(), input.size(), hardware_output.data(), op);
+        software.Transcode(input.data(), input.size(), software_output.data(), op);
+        REQUIRE(hardware_output == software_output);
+    }
+}
+
+TEST_CASE("AESCipher: Transcode throughput", "[core]") {
+    static constexpr std::size_t size = 16 * 1024 * 1024;
+    static constexpr std::size_t sector_size = 0x4000;
+
+    const std::vector<u8> input = MakeData(size, 4);
+    std::vector<u8> output(size);
+    const auto measure = [&](const char* name, auto&& transcode) {
+        const auto start = std::chrono::steady_clock::now();
+        transcode();
+        const auto end = std::chrono::steady_clock::now();
+
+        const double seconds = std::chrono::duration<double>(end - start).count();
+        const double megabytes = static_cast<double>(size) / (1024.0 * 1024.0);
+        printf("AES %s: %.3f ms, %.1f MB/s\n", name, seconds * 1000.0, megabytes / seconds);
+    };
+
+    for (const bool allow_hardware : {false, true}) {
+        if (allow_hardware && !AESNIEngine::IsSupported()) {
+            continue;
+        }
+        AESCipher<Key128> ctr(MakeKey<Key128>(5), Mode::CTR, allow_hardware);
+        ctr.SetIV(CTR_IV);
+        measure(allow_hardware ? "CTR hardware" : "CTR mbedtls", [&] {
+            ctr.Transcode(input.data(), size, output.data(), Op::Decrypt);
+        });
+
+        AESCipher<Key256> xts(MakeKey<Key256>(6), Mode::XTS, allow_hardware);
+        measure(allow_hardware ? "XTS hardware" : "XTS mbedtls", [&] {
+            xts.XTSTranscode(input.data(), size, output.data(), 0, sector_size, Op::Decrypt);
+        });
+    }
+}
@@ -0,0 +1,214 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "common/common_types.h"
+#include "core/file_sys/nca_patch.h"
+#include "core/file_sys/vfs_vector.h"
+
+namespace {
+using FileSys::BKTR;
+using FileSys::RelocationBlock;
+using FileSys::RelocationBucket;
+using FileSys::RelocationEntry;
+using FileSys::SubsectionBlock;
+using FileSys::SubsectionBucket;
+using FileSys::VectorVfsFile;
+
+constexpr std::size_t ENTRIES_PER_BUCKET = 0x332;
+
+/// Vector file counting the reads made to it
+class CountingVfsFile : public VectorVfsFile {
+public:
+    using VectorVfsFile::VectorVfsFile;
+
+    std::size_t Read(u8* data, std::size_t length, std::size_t offset) const override {
+        ++num_reads;
+        return VectorVfsFile::Read(data, length, offset);
+    }
+
+    mutable std::size_t num_reads = 0;
+};
+
+u32 NextRandom(u32& state) {
+    state = state * 1664525 + 1013904223;
+    return state >> 8;
+}
+
+std::vector<u8> MakeData(std::size_t size, u32 seed) {
+    std::vector<u8> data(size);
+    for (u8& value : data) {
+        value = static_cast<u8>(NextRandom(seed));
+    }
+    return data;
+}
+
+struct SyntheticPatch {
+    std::vector<u8> base_data;
+    std::vector<u8> patch_data;
+    std::vector<RelocationEntry> entries;
+    u64 size;
+
+    /// Builds the patched file the way the original implementation did, one entry at a time
+    /// looked up with a linear search.
+    std::size_t ReferenceRead(u8* data, std::size_t length, std::size_t offset) const {
+        std::size_t total_read = 0;
+        while (length > 0 && offset < size) {
+            std::size_t index = 0;
+            while (index + 1 < entries.size() && entries[index + 1].address_patch <= offset) {
+                ++index;
+            }
+            const RelocationEntry& entry = entries[index];
+            const u64 end = index + 1 < entries.size() ? entries[index + 1].address_patch : size;
+            const std::size_t chunk = static_cast<std::size_t>(std::min<u64>(length, end - offset));
+            const auto& source = entry.from_patch ? patch_data : base_data;
+            const u64 source_offset = offset - entry.address_patch + entry.address_source;
+            std::copy_n(source.begin() + source_offset, chunk, data);
+            data += chunk;
+            length -= chunk;
+            offset += chunk;
+            total_read += chunk;
+        }
+        return total_read;
+    }
+};
+
+/// Makes a patch of runs alternating between the base and patch romfs. Every fourth run continues
+/// the previous one, like the tables of real updates do.
+SyntheticPatch MakeSyntheticPatch(std::size_t num_entries, u32 seed) {
+    constexpr std::size_t DATA_SIZE = 4 << 20;
+    constexpr u32 MAX_RUN = 0x800;
+
+    SyntheticPatch patch;
+    patch.base_data = MakeData(DATA_SIZE, seed);
+    patch.patch_data = MakeData(DATA_SIZE, seed + 1);
+    u64 address_patch = 0;
+    for (std::size_t i = 0; i < num_entries; ++i) {
+        const u32 run = 0x10 + NextRandom(seed) % MAX_RUN;
+        RelocationEntry entry{address_patch, NextRandom(seed) % (DATA_SIZE - MAX_RUN * 2),
+                              NextRandom(seed) % 2};
+        if (i % 4 == 3) {
+            const RelocationEntry& previous = patch.entries.back();
+            entry.address_source =
+                previous.address_source + (address_patch - previous.address_patch);
+            entry.from_patch = previous.from_patch;
+        }
+        patch.entries.push_back(entry);
+        address_patch += run;
+    }
+    patch.size = address_patch;
+    return patch;
+}
+
+BKTR MakeBKTR(const SyntheticPatch& patch, std::shared_ptr<VectorVfsFile> base_romfs,
+              std::shared_ptr<VectorVfsFile> patch_romfs) {
+    RelocationBlock relocation{};
+    relocation.size = patch.size;
+    std::vector<RelocationBucket> relocation_buckets;
+    for (std::size_t i = 0; i < patch.entries.size(); i += ENTRIES_PER_BUCKET) {
+        const std::size_t end = std::min(patch.entries.size(), i + ENTRIES_PER_BUCKET);
+        relocation.base_offsets[relocation_buckets.size()] = patch.entries[i].address_patch;
+        relocation_buckets.push_back({
+            static_cast<u32>(end - i),
+            end < patch.entries.size() ? u64{patch.entries[end].address_patch} : patch.size,
+            {patch.entries.begin() + i, patch.entries.begin() + end},
+        });
+    }
+    relocation.number_buckets = static_cast<u32>(relocation_buckets.size());
+
+    SubsectionBlock subsection{};
+    subsection.number_buckets = 1;
+    std::vector<SubsectionBucket> subsection_buckets{{1, patch.size, {{}}}};
+
+    return BKTR(std::move(base_romfs), std::move(patch_romfs), relocation,
+                std::move(relocation_buckets), subsection, std::move(subsection_buckets), false,
+                {}, 0, 0, {});
+}
+} // Anonymous namespace
+
+TEST_CASE("BKTR: Reads match the relocation table", "[core]") {
+    const SyntheticPatch patch = MakeSyntheticPatch(4000, 0x1234);
+    const BKTR bktr = MakeBKTR(patch, std::make_shared<VectorVfsFile>(patch.base_data),
+                               std::make_shared<VectorVfsFile>(patch.patch_data));
+    REQUIRE(bktr.GetSize() == patch.size);
+
+    u32 state = 0x5678;
+    std::vector<u8> output;
+    std::vector<u8> expected;
+    for (int i = 0; i < 2000; ++i) {
+        const std::size_t length = NextRandom(state) % 0x4000;
+        const std::size_t offset = NextRandom(state) % (patch.size + 0x100);
+        output.assign(length, 0);
+        expected.assign(length, 0);
+        const std::size_t expected_read = patch.ReferenceRead(expected.data(), length, offset);
+        REQUIRE(bktr.Read(output.data(), length, offset) == expected_read);
+        REQUIRE(output == expected);
+    }
+}
+
+TEST_CASE("BKTR: Continuous runs are read at once", "[core]") {
+    SyntheticPatch patch;
+    patch.base_data = MakeData(0x10000, 1);
+    patch.patch_data = MakeData(0x10000, 2);
+    // Three runs reading one contiguous range of the base, then one of the patch
+    patch.entries = {
+        {0x000, 0x1000, 0},
+        {0x100, 0x1100, 0},
+        {0x300, 0x1300, 0},
+        {0x800, 0x0000, 1},
+    };
+    patch.size = 0x1000;
+
+    const auto base_romfs = std::make_shared<CountingVfsFile>(patch.base_data);
+    const auto patch_romfs = std::make_shared<CountingVfsFile>(patch.patch_data);
+    const BKTR bktr = MakeBKTR(patch, base_romfs, patch_romfs);
+
+    std::vector<u8> output(0x1000);
+    std::vector<u8> expected(0x1000);
+    REQUIRE(bktr.Read(output.data(), output.size(), 0) == output.size());
+    REQUIRE(patch.ReferenceRead(expected.data(), expected.size(), 0) == expected.size());
+    REQUIRE(output == expected);
+    REQUIRE(base_romfs->num_reads == 1);
+    REQUIRE(patch_romfs->num_reads == 1);
+}
+
+TEST_CASE("BKTR: Lookup throughput", "[core]") {
+    static constexpr std::size_t num_entries = ENTRIES_PER_BUCKET * 64;
+    static constexpr std::size_t num_reads = 20000;
+    static constexpr std::size_t read_size = 0x1000;
+
+    const SyntheticPatch patch = MakeSyntheticPatch(num_entries, 0x9ABC);
+    const BKTR bktr = MakeBKTR(patch, std::make_shared<VectorVfsFile>(patch.base_data),
+                               std::make_shared<VectorVfsFile>(patch.patch_data));
+
+    const auto run_reads = [&patch](auto&& read) {
+        u32 state = 0xDEF0;
+        std::vector<u8> output(read_size);
+        const auto start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < num_reads; ++i) {
+            const std::size_t offset = NextRandom(state) % (patch.size - read_size);
+            REQUIRE(read(output.data(), read_size, offset) == read_size);
+        }
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+            .count();
+    };
+    const double linear_time =
+        run_reads([&patch](u8* data, std::size_t length, std::size_t offset) {
+            return patch.ReferenceRead(data, length, offset);
+        });
+    const double index_time = run_reads([&bktr](u8* data, std::size_t length, std::size_t offset) {
+        return bktr.Read(data, length, offset);
+    });
+
+    printf("BKTR with %zu relocation entries, %zu reads of %zu bytes: linear search %.3f ms, "
+           "index %.3f ms\n",
+           num_entries, num_reads, read_size, linear_time, index_time);
+}
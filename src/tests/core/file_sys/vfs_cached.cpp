@@ -0,0 +1,82 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <memory>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "common/common_types.h"
+#include "core/file_sys/vfs_cached.h"
+#include "core/file_sys/vfs_vector.h"
+
+namespace {
+using FileSys::BlockCache;
+using FileSys::CachedVfsFile;
+using FileSys::VectorVfsFile;
+
+constexpr std::size_t BLOCK_SIZE = BlockCache::BLOCK_SIZE;
+
+std::vector<u8> MakeData(std::size_t size) {
+    std::vector<u8> data(size);
+    u32 state = 0xDEADBEEF;
+    for (u8& value : data) {
+        state = state * 1664525 + 1013904223;
+        value = static_cast<u8>(state >> 24);
+    }
+    return data;
+}
+} // Anonymous namespace
+
+TEST_CASE("CachedVfsFile: Reads match the base file", "[core]") {
+    const std::vector<u8> data = MakeData(BLOCK_SIZE * 5 + 123);
+    BlockCache cache{BLOCK_SIZE * 3};
+    const CachedVfsFile file{std::make_shared<VectorVfsFile>(data), cache};
+    REQUIRE(file.GetSize() == data.size());
+
+    // Unaligned reads crossing blocks, repeated so they are served from the cache, and reads
+    // crossing the end of the file
+    for (int pass = 0; pass < 2; ++pass) {
+        for (const std::size_t offset : {std::size_t{0}, BLOCK_SIZE - 7, BLOCK_SIZE * 4 + 99}) {
+            std::vector<u8> output(BLOCK_SIZE + 500);
+            const std::size_t expected = std::min(output.size(), data.size() - offset);
+            REQUIRE(file.Read(output.data(), output.size(), offset) == expected);
+            REQUIRE(std::equal(output.begin(), output.begin() + expected, data.begin() + offset));
+        }
+    }
+    REQUIRE(file.Read(nullptr, 16, data.size()) == 0);
+    REQUIRE(cache.GetStats().used_bytes <= BLOCK_SIZE * 3);
+}
+
+TEST_CASE("CachedVfsFile: Repeated reads hit the cache", "[core]") {
+    const std::vector<u8> data = MakeData(BLOCK_SIZE * 4);
+    BlockCache cache{BLOCK_SIZE * 16};
+    const CachedVfsFile file{std::make_shared<VectorVfsFile>(data), cache};
+
+    std::vector<u8> output(64);
+    REQUIRE(file.Read(output.data(), output.size(), 100) == output.size());
+    REQUIRE(cache.GetStats().hits == 0);
+    REQUIRE(cache.GetStats().misses == 1);
+
+    for (int i = 0; i < 9; ++i) {
+        REQUIRE(file.Read(output.data(), output.size(), 100) == output.size());
+    }
+    REQUIRE(cache.GetStats().hits == 9);
+    REQUIRE(cache.GetStats().HitRate() == Approx(0.9));
+}
+
+TEST_CASE("CachedVfsFile: Sequential reads fetch ahead", "[core]") {
+    const std::vector<u8> data = MakeData(BLOCK_SIZE * 32);
+    BlockCache cache{BLOCK_SIZE * 64};
+    const CachedVfsFile file{std::make_shared<VectorVfsFile>(data), cache};
+
+    std::vector<u8> output(BLOCK_SIZE);
+    for (std::size_t offset = 0; offset < data.size(); offset += output.size()) {
+        REQUIRE(file.Read(output.data(), output.size(), offset) == output.size());
+        REQUIRE(std::equal(output.begin(), output.end(), data.begin() + offset));
+    }
+    const auto stats = cache.GetStats();
+    REQUIRE(stats.read_ahead_blocks > 0);
+    REQUIRE(stats.hits > stats.misses);
+}
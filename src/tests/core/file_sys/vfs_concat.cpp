@@ -0,0 +1,66 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "common/common_types.h"
+#include "core/file_sys/vfs_concat.h"
+#include "core/file_sys/vfs_vector.h"
+
+namespace {
+using FileSys::ConcatenatedVfsFile;
+using FileSys::VectorVfsFile;
+using FileSys::VirtualFile;
+
+std::vector<u8> MakeData(std::size_t size, u8 seed) {
+    std::vector<u8> data(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        data[i] = static_cast<u8>(seed + i * 7);
+    }
+    return data;
+}
+} // Anonymous namespace
+
+TEST_CASE("ConcatenatedVfsFile: Reads span the pieces", "[core]") {
+    std::vector<u8> expected;
+    std::vector<VirtualFile> pieces;
+    for (const std::size_t size : {100, 0, 1, 4096, 0, 333, 17}) {
+        const auto data = MakeData(size, static_cast<u8>(pieces.size()));
+        expected.insert(expected.end(), data.begin(), data.end());
+        pieces.push_back(std::make_shared<VectorVfsFile>(data));
+    }
+    const auto file = ConcatenatedVfsFile::MakeConcatenatedFile(pieces, "concat");
+    REQUIRE(file->GetSize() == expected.size());
+
+    for (std::size_t offset = 0; offset <= expected.size(); offset += 37) {
+        for (const std::size_t length : {1, 99, 500, 5000}) {
+            std::vector<u8> output(length);
+            const std::size_t expected_read = std::min(length, expected.size() - offset);
+            REQUIRE(file->Read(output.data(), length, offset) == expected_read);
+            REQUIRE(std::equal(output.begin(), output.begin() + expected_read,
+                               expected.begin() + offset));
+        }
+    }
+    REQUIRE(file->Read(nullptr, 16, expected.size() + 1) == 0);
+}
+
+TEST_CASE("ConcatenatedVfsFile: Gaps are filled", "[core]") {
+    std::multimap<u64, VirtualFile> pieces;
+    pieces.emplace(0x10, std::make_shared<VectorVfsFile>(MakeData(0x20, 1)));
+    pieces.emplace(0x40, std::make_shared<VectorVfsFile>(MakeData(0x10, 2)));
+    const auto file = ConcatenatedVfsFile::MakeConcatenatedFile(0xFF, std::move(pieces), "gaps");
+    REQUIRE(file->GetSize() == 0x50);
+
+    std::vector<u8> output(0x50);
+    REQUIRE(file->Read(output.data(), output.size(), 0) == output.size());
+    REQUIRE(std::all_of(output.begin(), output.begin() + 0x10, [](u8 v) { return v == 0xFF; }));
+    REQUIRE(output[0x10] == MakeData(1, 1)[0]);
+    REQUIRE(std::all_of(output.begin() + 0x30, output.begin() + 0x40,
+                        [](u8 v) { return v == 0xFF; }));
+    REQUIRE(output[0x40] == MakeData(1, 2)[0]);
+}
@@ -0,0 +1,116 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "common/common_types.h"
+#include "common/fs/file.h"
+#include "common/fs/path_util.h"
+#include "core/file_sys/mode.h"
+#include "core/file_sys/vfs_real.h"
+
+namespace {
+using FileSys::Mode;
+using FileSys::RealVfsFilesystem;
+
+std::string TestFilePath() {
+    return Common::FS::PathToUTF8String(std::filesystem::temp_directory_path() /
+                                        "yuzu_test_vfs_real.bin");
+}
+
+std::vector<u8> WriteTestFile(const std::string& path, std::size_t size) {
+    std::vector<u8> data(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        data[i] = static_cast<u8>(i * 13 + 5);
+    }
+    Common::FS::IOFile file{path, Common::FS::FileAccessMode::Write};
+    REQUIRE(file.WriteSpan(std::span<const u8>(data)) == data.size());
+    return data;
+}
+} // Anonymous namespace
+
+TEST_CASE("RealVfsFile: Read-only files are read through the mapping", "[core]") {
+    const auto path = TestFilePath();
+    const auto expected = WriteTestFile(path, 0x3001);
+    {
+        RealVfsFilesystem filesystem;
+        const auto file = filesystem.OpenFile(path, Mode::Read);
+        REQUIRE(file != nullptr);
+        REQUIRE(file->GetSize() == expected.size());
+
+        const auto span = file->GetSpan(expected.size(), 0);
+        REQUIRE(span.has_value());
+        REQUIRE(std::equal(span->begin(), span->end(), expected.begin(), expected.end()));
+
+        for (const std::size_t offset : {0x0, 0x1, 0xFFF, 0x3000, 0x3001, 0x4000}) {
+            std::vector<u8> output(0x100);
+            const std::size_t expected_read =
+                offset < expected.size() ? std::min(output.size(), expected.size() - offset) : 0;
+            REQUIRE(file->Read(output.data(), output.size(), offset) == expected_read);
+            REQUIRE(std::equal(output.begin(), output.begin() + expected_read,
+                               expected.begin() + std::min(offset, expected.size())));
+        }
+
+        // Files opened read-only share the same mapping
+        const auto other = filesystem.OpenFile(path, Mode::Read);
+        REQUIRE(other != nullptr);
+        const auto other_span = other->GetSpan(expected.size(), 0);
+        REQUIRE(other_span.has_value());
+        REQUIRE(other_span->data() == span->data());
+    }
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("RealVfsFile: Files opened for writing are no longer mapped", "[core]") {
+    const auto path = TestFilePath();
+    const auto expected = WriteTestFile(path, 0x2000);
+    {
+        RealVfsFilesystem filesystem;
+        const auto file = filesystem.OpenFile(path, Mode::Read);
+        REQUIRE(file != nullptr);
+        REQUIRE(file->GetSpan(expected.size(), 0).has_value());
+
+        // Opening the file for writing invalidates the mapping held by the read-only file, so
+        // truncating the file does not fault its reads
+        const auto writable = filesystem.OpenFile(path, Mode::ReadWrite);
+        REQUIRE(writable != nullptr);
+        REQUIRE(!writable->GetSpan(expected.size(), 0).has_value());
+        REQUIRE(!file->GetSpan(expected.size(), 0).has_value());
+
+        constexpr std::size_t truncated_size = 0x10;
+        std::filesystem::resize_file(path, truncated_size);
+
+        std::vector<u8> output(expected.size());
+        REQUIRE(file->Read(output.data(), output.size(), 0) == truncated_size);
+        REQUIRE(std::equal(output.begin(), output.begin() + truncated_size, expected.begin()));
+        REQUIRE(file->Read(output.data(), output.size(), 0x1000) == 0);
+
+        // Later read-only opens don't map the file again
+        const auto reopened = filesystem.OpenFile(path, Mode::Read);
+        REQUIRE(reopened != nullptr);
+        REQUIRE(!reopened->GetSpan(truncated_size, 0).has_value());
+        REQUIRE(reopened->Read(output.data(), output.size(), 0) == truncated_size);
+        REQUIRE(std::equal(output.begin(), output.begin() + truncated_size, expected.begin()));
+    }
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("RealVfsFile: Empty files fall back to file reads", "[core]") {
+    const auto path = TestFilePath();
+    WriteTestFile(path, 0);
+    {
+        RealVfsFilesystem filesystem;
+        const auto file = filesystem.OpenFile(path, Mode::Read);
+        REQUIRE(file != nullptr);
+        REQUIRE(!file->GetSpan(1, 0).has_value());
+        u8 value = 0;
+        REQUIRE(file->Read(&value, 1, 0) == 0);
+    }
+    std::filesystem::remove(path);
+}
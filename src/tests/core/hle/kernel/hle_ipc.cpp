@@ -0,0 +1,154 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <thread>
+
+#include <catch2/catch.hpp>
+
+#include "common/bounded_threadsafe_queue.h"
+#include "common/common_funcs.h"
+#include "common/common_types.h"
+#include "common/pool_allocator.h"
+#include "core/core.h"
+#include "core/hle/ipc.h"
+#include "core/hle/ipc_helpers.h"
+#include "core/hle/kernel/hle_ipc.h"
+#include "core/hle/kernel/k_handle_table.h"
+#include "core/hle/kernel/k_server_session.h"
+
+namespace Kernel {
+
+namespace {
+
+/// Answers every request with its argument plus one
+class IncrementHandler final : public SessionRequestHandler {
+public:
+    explicit IncrementHandler(KernelCore& kernel_) : SessionRequestHandler{kernel_, "Increment"} {}
+
+    ResultCode HandleSyncRequest(KServerSession& session, HLERequestContext& context) override {
+        IPC::RequestParser rp{context};
+        const u32 value = rp.Pop<u32>();
+
+        IPC::ResponseBuilder rb{context, 3};
+        rb.Push(ResultSuccess);
+        rb.Push(value + 1);
+        return ResultSuccess;
+    }
+};
+
+/// Session with an HLE handler, as the service manager would connect it
+struct TestSession {
+    explicit TestSession(Core::System& system)
+        : kernel{system.Kernel()}, memory{system.Memory()}, handle_table{kernel},
+          server_session{kernel}, handler{std::make_shared<IncrementHandler>(kernel)} {
+        server_session.Initialize(nullptr, "IncrementSession", nullptr);
+        handler->ClientConnected(&server_session);
+    }
+
+    /// Creates a context for a request through the same path KServerSession uses for guest requests
+    std::shared_ptr<HLERequestContext> MakeRequest(u32 value) {
+        std::array<u32, IPC::COMMAND_BUFFER_LENGTH> cmd_buf{};
+        IPC::CommandHeader header{};
+        header.type.Assign(IPC::CommandType::Request);
+        header.data_size.Assign(8);
+        std::memcpy(cmd_buf.data(), &header, sizeof(header));
+
+        // The payload starts 16 bytes aligned, after the padding of the header
+        cmd_buf[4] = Common::MakeMagic('S', 'F', 'C', 'I');
+        cmd_buf[6] = 0; // Command id
+        cmd_buf[8] = value;
+
+        auto context = HLERequestContext::Create(kernel, memory, &server_session, nullptr);
+        REQUIRE(context->PopulateFromIncomingCommandBuffer(handle_table, cmd_buf.data()) ==
+                ResultSuccess);
+        return context;
+    }
+
+    /// Handles the request on the session and returns the value of the response.
+    u32 Complete(HLERequestContext& context) {
+        REQUIRE(server_session.HandleRequest(context) == ResultSuccess);
+        const u32* const response = context.CommandBuffer();
+        const u32 offset = context.GetDataPayloadOffset();
+        REQUIRE(response[offset] == ResultSuccess.raw);
+        return response[offset + 2];
+    }
+
+    KernelCore& kernel;
+    Core::Memory::Memory& memory;
+    KHandleTable handle_table;
+    KServerSession server_session;
+    std::shared_ptr<IncrementHandler> handler;
+};
+
+} // Anonymous namespace
+
+TEST_CASE("HLERequestContext: Round trips don't allocate once warm", "[core]") {
+    TestSession session{Core::System::GetInstance()};
+    constexpr std::size_t NUM_LIVE = 16;
+
+    std::array<std::shared_ptr<HLERequestContext>, NUM_LIVE> live;
+    const auto run_cycle = [&](u32 cycle) {
+        for (u32 i = 0; i < NUM_LIVE; ++i) {
+            live[i] = session.MakeRequest(cycle + i);
+        }
+        for (u32 i = 0; i < NUM_LIVE; ++i) {
+            REQUIRE(session.Complete(*live[i]) == cycle + i + 1);
+            live[i].reset();
+        }
+    };
+
+    // The first cycle grows the pool to the peak number of requests in flight
+    run_cycle(0);
+    const std::size_t warm_blocks = Common::GetBlockPoolHeapBlocks();
+
+    for (u32 cycle = 1; cycle < 1000; ++cycle) {
+        run_cycle(cycle);
+    }
+    REQUIRE(Common::GetBlockPoolHeapBlocks() == warm_blocks);
+}
+
+TEST_CASE("HLERequestContext: Contexts completed on another thread are reused", "[core]") {
+    TestSession session{Core::System::GetInstance()};
+    constexpr u32 NUM_REQUESTS = 100000;
+
+    // Requests are created by the emulated cores and completed and freed by the service threads
+    Common::BoundedMPMCQueue<std::shared_ptr<HLERequestContext>, 64> queue;
+    std::atomic_bool is_done{};
+    std::atomic<u32> num_wrong{};
+    std::thread service_thread([&] {
+        std::shared_ptr<HLERequestContext> context;
+        while (!is_done.load(std::memory_order_acquire) || !queue.Empty()) {
+            if (!queue.TryPop(context)) {
+                std::this_thread::yield();
+                continue;
+            }
+            const u32 value = context->CommandBuffer()[8];
+            if (!session.server_session.HandleRequest(*context).IsSuccess() ||
+                context->CommandBuffer()[context->GetDataPayloadOffset() + 2] != value + 1) {
+                num_wrong.fetch_add(1, std::memory_order_relaxed);
+            }
+            context.reset();
+        }
+    });
+
+    const std::size_t start_blocks = Common::GetBlockPoolHeapBlocks();
+    for (u32 i = 0; i < NUM_REQUESTS; ++i) {
+        auto context = session.MakeRequest(i);
+        while (!queue.TryPush(context)) {
+            std::this_thread::yield();
+        }
+    }
+    is_done.store(true, std::memory_order_release);
+    service_thread.join();
+
+    REQUIRE(num_wrong.load() == 0);
+    // Bounded by the requests in flight and the blocks cached by both threads
+    REQUIRE(Common::GetBlockPoolHeapBlocks() - start_blocks < 512);
+}
+
+} // namespace Kernel
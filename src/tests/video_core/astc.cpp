@@ -0,0 +1,115 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <span>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "common/common_types.h"
+#include "video_core/textures/astc.h"
+
+namespace {
+using Tegra::Texture::ASTC::Decompress;
+
+constexpr u32 BLOCK_SIZE = 16;
+
+struct Footprint {
+    u32 width;
+    u32 height;
+};
+
+constexpr std::array<Footprint, 3> FOOTPRINTS{{{4, 4}, {6, 6}, {8, 8}}};
+
+/// Generates blocks with a 2x2 weight grid, a single partition and random endpoints and weights
+std::vector<u8> MakeBlocks(std::size_t num_blocks) {
+    // Block mode 0x11D with direct LDR RGBA endpoints (CEM 12)
+    static constexpr u32 BLOCK_HEADER = 0x11D | (12U << 13);
+    static constexpr u32 HEADER_BITS = 17;
+
+    std::vector<u8> blocks(num_blocks * BLOCK_SIZE);
+    u32 state = 0xDEADBEEF;
+    for (u8& value : blocks) {
+        state = state * 1664525 + 1013904223;
+        value = static_cast<u8>(state >> 24);
+    }
+    for (std::size_t block = 0; block < num_blocks; ++block) {
+        u8* const data = blocks.data() + block * BLOCK_SIZE;
+        u32 header;
+        std::memcpy(&header, data, sizeof(header));
+        header = (header & ~((1U << HEADER_BITS) - 1)) | BLOCK_HEADER;
+        std::memcpy(data, &header, sizeof(header));
+    }
+    return blocks;
+}
+
+std::size_t NumBlocks(u32 width, u32 height, u32 depth, const Footprint& footprint) {
+    const u32 blocks_x = (width + footprint.width - 1) / footprint.width;
+    const u32 blocks_y = (height + footprint.height - 1) / footprint.height;
+    return static_cast<std::size_t>(blocks_x) * blocks_y * depth;
+}
+} // Anonymous namespace
+
+TEST_CASE("ASTC: Parallel decode matches per block decode", "[video_core]") {
+    static constexpr u32 width = 203;
+    static constexpr u32 height = 157;
+    static constexpr u32 depth = 2;
+
+    for (const Footprint& footprint : FOOTPRINTS) {
+        const u32 blocks_x = (width + footprint.width - 1) / footprint.width;
+        const u32 blocks_y = (height + footprint.height - 1) / footprint.height;
+        const std::vector<u8> blocks = MakeBlocks(NumBlocks(width, height, depth, footprint));
+
+        std::vector<u8> image(width * height * depth * 4);
+        Decompress(blocks, width, height, depth, footprint.width, footprint.height, image);
+
+        std::vector<u8> texels(footprint.width * footprint.height * 4);
+        std::size_t block_index = 0;
+        for (u32 z = 0; z < depth; ++z) {
+            for (u32 block_y = 0; block_y < blocks_y; ++block_y) {
+                for (u32 block_x = 0; block_x < blocks_x; ++block_x, ++block_index) {
+                    const std::span<const u8> block{blocks.data() + block_index * BLOCK_SIZE,
+                                                    BLOCK_SIZE};
+                    Decompress(block, footprint.width, footprint.height, 1, footprint.width,
+                               footprint.height, texels);
+
+                    const u32 x = block_x * footprint.width;
+                    const u32 y = block_y * footprint.height;
+                    const u32 copy_width = std::min(footprint.width, width - x);
+                    const u32 copy_height = std::min(footprint.height, height - y);
+                    for (u32 line = 0; line < copy_height; ++line) {
+                        const std::size_t offset = ((z * height + y + line) * width + x) * 4;
+                        REQUIRE(std::memcmp(image.data() + offset,
+                                            texels.data() + line * footprint.width * 4,
+                                            copy_width * 4) == 0);
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("ASTC: Decode throughput", "[video_core]") {
+    static constexpr u32 width = 2048;
+    static constexpr u32 height = 2048;
+
+    for (const Footprint& footprint : FOOTPRINTS) {
+        const std::vector<u8> blocks = MakeBlocks(NumBlocks(width, height, 1, footprint));
+        std::vector<u8> image(width * height * 4);
+
+        const auto start = std::chrono::steady_clock::now();
+        Decompress(blocks, width, height, 1, footprint.width, footprint.height, image);
+        const auto end = std::chrono::steady_clock::now();
+
+        const double seconds = std::chrono::duration<double>(end - start).count();
+        const double megabytes = static_cast<double>(image.size()) / (1024.0 * 1024.0);
+        printf("ASTC %ux%u: %.3f ms, %.1f MB/s\n", footprint.width, footprint.height,
+               seconds * 1000.0, megabytes / seconds);
+    }
+}
@@ -0,0 +1,176 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "common/common_types.h"
+#include "common/div_ceil.h"
+#include "video_core/textures/decoders.h"
+
+namespace {
+using namespace Tegra::Texture;
+
+constexpr std::array<u32, 5> BYTES_PER_PIXEL{1, 2, 4, 8, 16};
+constexpr u32 MAX_BLOCK_HEIGHT = 5;
+constexpr u32 MAX_BLOCK_DEPTH = 5;
+
+struct Extent {
+    u32 width;
+    u32 height;
+    u32 depth;
+};
+
+// Widths are picked to hit full GOB rows, partial sectors and partial GOB rows
+constexpr std::array<Extent, 4> EXTENTS{{
+    {1, 1, 1},
+    {37, 11, 3},
+    {64, 16, 2},
+    {129, 35, 5},
+}};
+
+/// Returns the offset of a pixel in a block linear texture, one pixel at a time
+u32 ReferenceSwizzledOffset(u32 x, u32 y, u32 z, u32 bytes_per_pixel, u32 width, u32 height,
+                            u32 block_height, u32 block_depth) {
+    const u32 stride = width * bytes_per_pixel;
+    const u32 gobs_in_x = Common::DivCeilLog2(stride, GOB_SIZE_X_SHIFT);
+    const u32 block_size = gobs_in_x << (GOB_SIZE_SHIFT + block_height + block_depth);
+    const u32 slice_size =
+        Common::DivCeilLog2(height, block_height + GOB_SIZE_Y_SHIFT) * block_size;
+    const u32 offset_z = (z >> block_depth) * slice_size +
+                         ((z & ((1U << block_depth) - 1)) << (GOB_SIZE_SHIFT + block_height));
+    const u32 block_y = y >> GOB_SIZE_Y_SHIFT;
+    const u32 offset_y = (block_y >> block_height) * block_size +
+                         ((block_y & ((1U << block_height) - 1)) << GOB_SIZE_SHIFT);
+    const u32 byte_x = x * bytes_per_pixel;
+    const u32 offset_x = (byte_x >> GOB_SIZE_X_SHIFT)
+                         << (GOB_SIZE_SHIFT + block_height + block_depth);
+    return offset_z + offset_y + offset_x + SWIZZLE_TABLE[y % GOB_SIZE_Y][byte_x % GOB_SIZE_X];
+}
+
+std::vector<u8> MakePattern(std::size_t size) {
+    std::vector<u8> pattern(size);
+    u32 state = 0x12345678;
+    for (u8& value : pattern) {
+        state = state * 1664525 + 1013904223;
+        value = static_cast<u8>(state >> 24);
+    }
+    return pattern;
+}
+
+template <typename Func>
+void ForEachLayout(Func&& func) {
+    for (const u32 bytes_per_pixel : BYTES_PER_PIXEL) {
+        for (u32 block_height = 0; block_height <= MAX_BLOCK_HEIGHT; ++block_height) {
+            for (u32 block_depth = 0; block_depth <= MAX_BLOCK_DEPTH; ++block_depth) {
+                for (const Extent& extent : EXTENTS) {
+                    func(bytes_per_pixel, block_height, block_depth, extent);
+                }
+            }
+        }
+    }
+}
+
+/// Unswizzles every layout with the given kernel and compares it against the reference
+void CheckUnswizzle(SwizzleKernel kernel) {
+    ForEachLayout([kernel](u32 bytes_per_pixel, u32 block_height, u32 block_depth, Extent extent) {
+        const auto [width, height, depth] = extent;
+        const std::vector<u8> swizzled = MakePattern(CalculateSize(
+            true, bytes_per_pixel, width, height, depth, block_height, block_depth));
+        std::vector<u8> linear(
+            CalculateSize(false, bytes_per_pixel, width, height, depth, block_height, block_depth));
+        UnswizzleTexture(kernel, linear, swizzled, bytes_per_pixel, width, height, depth,
+                         block_height, block_depth);
+
+        std::vector<u8> expected(linear.size());
+        u8* dst = expected.data();
+        for (u32 z = 0; z < depth; ++z) {
+            for (u32 y = 0; y < height; ++y) {
+                for (u32 x = 0; x < width; ++x, dst += bytes_per_pixel) {
+                    const u32 offset = ReferenceSwizzledOffset(x, y, z, bytes_per_pixel, width,
+                                                               height, block_height, block_depth);
+                    std::memcpy(dst, swizzled.data() + offset, bytes_per_pixel);
+                }
+            }
+        }
+        INFO("bpp=" << bytes_per_pixel << " block_height=" << block_height
+                    << " block_depth=" << block_depth << " width=" << width);
+        REQUIRE(linear == expected);
+    });
+}
+
+/// Swizzles every layout with the given kernel and compares it against the reference
+void CheckSwizzle(SwizzleKernel kernel) {
+    ForEachLayout([kernel](u32 bytes_per_pixel, u32 block_height, u32 block_depth, Extent extent) {
+        const auto [width, height, depth] = extent;
+        const std::vector<u8> linear = MakePattern(
+            CalculateSize(false, bytes_per_pixel, width, height, depth, block_height, block_depth));
+        std::vector<u8> swizzled(
+            CalculateSize(true, bytes_per_pixel, width, height, depth, block_height, block_depth));
+        SwizzleTexture(kernel, swizzled, linear, bytes_per_pixel, width, height, depth,
+                       block_height, block_depth);
+
+        std::vector<u8> expected(swizzled.size());
+        const u8* src = linear.data();
+        for (u32 z = 0; z < depth; ++z) {
+            for (u32 y = 0; y < height; ++y) {
+                for (u32 x = 0; x < width; ++x, src += bytes_per_pixel) {
+                    const u32 offset = ReferenceSwizzledOffset(x, y, z, bytes_per_pixel, width,
+                                                               height, block_height, block_depth);
+                    std::memcpy(expected.data() + offset, src, bytes_per_pixel);
+                }
+            }
+        }
+        INFO("bpp=" << bytes_per_pixel << " block_height=" << block_height
+                    << " block_depth=" << block_depth << " width=" << width);
+        REQUIRE(swizzled == expected);
+    });
+}
+
+/// Checks both directions of a kernel, kernels the host can't run are skipped
+void CheckKernel(SwizzleKernel kernel, const char* name) {
+    if (!IsSwizzleKernelSupported(kernel)) {
+        WARN(name << " is not supported by the host CPU, skipping");
+        return;
+    }
+    CheckUnswizzle(kernel);
+    CheckSwizzle(kernel);
+}
+} // Anonymous namespace
+
+TEST_CASE("Decoders: Generic kernel matches reference", "[video_core]") {
+    CheckKernel(SwizzleKernel::Generic, "Generic");
+}
+
+TEST_CASE("Decoders: SSE4.1 kernel matches reference", "[video_core]") {
+    CheckKernel(SwizzleKernel::SSE41, "SSE4.1");
+}
+
+TEST_CASE("Decoders: AVX2 kernel matches reference", "[video_core]") {
+    CheckKernel(SwizzleKernel::AVX2, "AVX2");
+}
+
+TEST_CASE("Decoders: Default kernel is supported", "[video_core]") {
+    REQUIRE(IsSwizzleKernelSupported(GetFastestSwizzleKernel()));
+}
+
+TEST_CASE("Decoders: Swizzle round trip", "[video_core]") {
+    ForEachLayout([](u32 bytes_per_pixel, u32 block_height, u32 block_depth, Extent extent) {
+        const auto [width, height, depth] = extent;
+        const std::vector<u8> linear = MakePattern(
+            CalculateSize(false, bytes_per_pixel, width, height, depth, block_height, block_depth));
+        std::vector<u8> swizzled(
+            CalculateSize(true, bytes_per_pixel, width, height, depth, block_height, block_depth));
+        std::vector<u8> result(linear.size());
+        SwizzleTexture(swizzled, linear, bytes_per_pixel, width, height, depth, block_height,
+                       block_depth);
+        UnswizzleTexture(result, swizzled, bytes_per_pixel, width, height, depth, block_height,
+                         block_depth);
+        REQUIRE(result == linear);
+    });
+}
@@ -0,0 +1,112 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <array>
+#include <filesystem>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "common/common_types.h"
+#include "common/fs/file.h"
+#include "video_core/gpu_trace.h"
+
+namespace {
+using Tegra::CommandHeader;
+using Tegra::GPUTraceReader;
+using Tegra::GPUTraceRecord;
+using Tegra::GPUTraceRecordType;
+using Tegra::GPUTraceWriter;
+
+std::filesystem::path TracePath() {
+    return std::filesystem::temp_directory_path() / "yuzu_test_gpu_trace.bin";
+}
+
+std::vector<CommandHeader> MakeCommands(std::size_t size) {
+    std::vector<CommandHeader> commands(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        commands[i].argument = static_cast<u32>(i * 0x9E3779B9);
+    }
+    return commands;
+}
+
+/// Overwrites the payload size of the first record, right after the trace header
+void PatchFirstRecordSize(const std::filesystem::path& path, u32 size) {
+    Common::FS::IOFile file{path, Common::FS::FileAccessMode::ReadWrite};
+    REQUIRE(file.Seek(12));
+    REQUIRE(file.WriteObject(size));
+}
+} // Anonymous namespace
+
+TEST_CASE("GPUTrace: Records round trip", "[video_core]") {
+    const auto path = TracePath();
+    const std::vector<CommandHeader> commands = MakeCommands(100);
+    {
+        GPUTraceWriter writer{path};
+        REQUIRE(writer.IsOpen());
+        writer.RecordMap(0x10000, 0x8000000, 0x2000);
+        writer.RecordCommandList(commands);
+        writer.RecordFrameEnd();
+        writer.RecordUnmap(0x10000, 0x2000);
+    }
+    GPUTraceReader reader{path};
+    REQUIRE(reader.IsValid());
+    GPUTraceRecord record;
+    REQUIRE(reader.ReadRecord(record));
+    REQUIRE(record.type == GPUTraceRecordType::Map);
+    REQUIRE(record.gpu_addr == 0x10000);
+    REQUIRE(record.cpu_addr == 0x8000000);
+    REQUIRE(record.size == 0x2000);
+    REQUIRE(reader.ReadRecord(record));
+    REQUIRE(record.type == GPUTraceRecordType::CommandList);
+    REQUIRE(record.commands.size() == commands.size());
+    for (std::size_t i = 0; i < commands.size(); ++i) {
+        REQUIRE(record.commands[i].argument == commands[i].argument);
+    }
+    REQUIRE(reader.ReadRecord(record));
+    REQUIRE(record.type == GPUTraceRecordType::FrameEnd);
+    REQUIRE(reader.ReadRecord(record));
+    REQUIRE(record.type == GPUTraceRecordType::Unmap);
+    REQUIRE(record.gpu_addr == 0x10000);
+    REQUIRE(record.size == 0x2000);
+    REQUIRE(!reader.ReadRecord(record));
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("GPUTrace: Corrupt record sizes are rejected", "[video_core]") {
+    const auto path = TracePath();
+    // Larger than the trace, not a whole number of words, larger than the trace again
+    for (const u32 size : {404U, 398U, 0xFFFFFFFFU}) {
+        {
+            GPUTraceWriter writer{path};
+            writer.RecordCommandList(MakeCommands(100));
+        }
+        PatchFirstRecordSize(path, size);
+
+        GPUTraceReader reader{path};
+        REQUIRE(reader.IsValid());
+        GPUTraceRecord record;
+        REQUIRE(!reader.ReadRecord(record));
+        REQUIRE(record.commands.empty());
+        REQUIRE(!reader.IsValid());
+    }
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("GPUTrace: Map records of the wrong size are rejected", "[video_core]") {
+    const auto path = TracePath();
+    {
+        GPUTraceWriter writer{path};
+        writer.RecordMap(0x10000, 0x8000000, 0x1000);
+        writer.RecordFrameEnd();
+    }
+    PatchFirstRecordSize(path, 16);
+
+    GPUTraceReader reader{path};
+    REQUIRE(reader.IsValid());
+    GPUTraceRecord record;
+    REQUIRE(!reader.ReadRecord(record));
+    REQUIRE(!reader.IsValid());
+    std::filesystem::remove(path);
+}
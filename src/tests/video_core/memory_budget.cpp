@@ -0,0 +1,52 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <catch2/catch.hpp>
+
+#include "common/common_types.h"
+#include "video_core/texture_cache/memory_budget.h"
+
+namespace {
+using VideoCommon::ComputeTextureMemoryBudget;
+using VideoCommon::GetAndResetTextureCacheStatistics;
+using VideoCommon::RecordTextureCacheEviction;
+using VideoCommon::RecordTextureCacheResidency;
+
+constexpr u64 GiB = 1ULL << 30;
+} // Anonymous namespace
+
+TEST_CASE("TextureMemoryBudget: Scales with the device memory", "[video_core]") {
+    for (const u64 memory : {2 * GiB, 4 * GiB, 8 * GiB, 24 * GiB}) {
+        const auto budget = ComputeTextureMemoryBudget(memory);
+        REQUIRE(budget.expected > 0);
+        REQUIRE(budget.expected < budget.critical);
+        REQUIRE(budget.critical < memory);
+    }
+    REQUIRE(ComputeTextureMemoryBudget(8 * GiB).expected >
+            ComputeTextureMemoryBudget(4 * GiB).expected);
+}
+
+TEST_CASE("TextureMemoryBudget: Unknown device memory uses a default", "[video_core]") {
+    const auto budget = ComputeTextureMemoryBudget(0);
+    REQUIRE(budget.expected > 0);
+    REQUIRE(budget.expected < budget.critical);
+}
+
+TEST_CASE("TextureMemoryBudget: Statistics count evictions until queried", "[video_core]") {
+    static_cast<void>(GetAndResetTextureCacheStatistics());
+
+    RecordTextureCacheResidency(3 * GiB);
+    RecordTextureCacheEviction(0x1000);
+    RecordTextureCacheEviction(0x4000);
+    const auto stats = GetAndResetTextureCacheStatistics();
+    REQUIRE(stats.resident_bytes == 3 * GiB);
+    REQUIRE(stats.evicted_images == 2);
+    REQUIRE(stats.evicted_bytes == 0x5000);
+
+    // The residency is a snapshot, only the eviction counters are reset
+    const auto next_stats = GetAndResetTextureCacheStatistics();
+    REQUIRE(next_stats.resident_bytes == 3 * GiB);
+    REQUIRE(next_stats.evicted_images == 0);
+    REQUIRE(next_stats.evicted_bytes == 0);
+}
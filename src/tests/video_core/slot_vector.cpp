@@ -0,0 +1,40 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "common/common_types.h"
+#include "video_core/texture_cache/slot_vector.h"
+
+TEST_CASE("SlotVector: ForEach visits the stored objects", "[video_core]") {
+    using VideoCommon::SlotId;
+
+    VideoCommon::SlotVector<u32> slots;
+    std::vector<SlotId> ids;
+    for (u32 i = 0; i < 200; ++i) {
+        ids.push_back(slots.insert(i));
+    }
+    // Leave holes inside and across the 64 slot words
+    for (u32 i = 0; i < 200; i += 3) {
+        slots.erase(ids[i]);
+    }
+
+    std::vector<u32> visited;
+    slots.ForEach([&](SlotId id, u32& value) {
+        REQUIRE(slots[id] == value);
+        visited.push_back(value);
+    });
+    // Slots are not allocated in insertion order
+    std::sort(visited.begin(), visited.end());
+    std::vector<u32> expected;
+    for (u32 i = 0; i < 200; ++i) {
+        if (i % 3 != 0) {
+            expected.push_back(i);
+        }
+    }
+    REQUIRE(visited == expected);
+}
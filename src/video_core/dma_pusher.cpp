@@ -9,6 +9,7 @@
 #include "video_core/dma_pusher.h"
 #include "video_core/engines/maxwell_3d.h"
 #include "video_core/gpu.h"
+#include "video_core/gpu_trace.h"
 #include "video_core/memory_manager.h"
 
 namespace Tegra {
@@ -24,6 +25,11 @@ void DmaPusher::DispatchCalls() {
 
     gpu.SyncGuestHost();
 
+    if (trace_writer) {
+        // The commands read what the guest wrote to memory since the last submission
+        trace_writer->RecordMemoryChanges(system.Memory());
+    }
+
     dma_pushbuffer_subindex = 0;
 
     dma_state.is_last_call = true;
@@ -79,6 +85,9 @@ bool DmaPusher::Step() {
         gpu.MemoryManager().ReadBlockUnsafe(dma_get, command_headers.data(),
                                             command_list_header.size * sizeof(u32));
     }
+    if (trace_writer) {
+        trace_writer->RecordCommandList(command_headers);
+    }
     for (std::size_t index = 0; index < command_headers.size();) {
         const CommandHeader& command_header = command_headers[index];
 
@@ -93,6 +102,17 @@ bool DmaPusher::Step() {
                 dma_state.is_last_call = true;
                 index += max_write;
                 continue;
+            } else if (!dma_increment_once && dma_state.method >= non_puller_methods) {
+                // Hand the whole run of incrementing writes in this segment to the engine
+                const u32 max_write = static_cast<u32>(
+                    std::min<std::size_t>(index + dma_state.method_count, command_headers.size()) -
+                    index);
+                CallMethodRange(&command_header.argument, max_write);
+                dma_state.method += max_write;
+                dma_state.method_count -= max_write;
+                dma_state.is_last_call = true;
+                index += max_write;
+                continue;
             } else {
                 dma_state.is_last_call = dma_state.method_count <= 1;
                 CallMethod(command_header.argument);
@@ -172,4 +192,9 @@ void DmaPusher::CallMultiMethod(const u32* base_start, u32 num_methods) const {
     }
 }
 
+void DmaPusher::CallMethodRange(const u32* base_start, u32 num_methods) const {
+    subchannels[dma_state.subchannel]->CallMethodRange(dma_state.method, base_start, num_methods,
+                                                       dma_state.method_count);
+}
+
 } // namespace Tegra
@@ -19,6 +19,7 @@ class System;
 namespace Tegra {
 
 class GPU;
+class GPUTraceWriter;
 
 enum class SubmissionMode : u32 {
     IncreasingOld = 0,
@@ -116,6 +117,12 @@ public:
         subchannels[subchannel_id] = engine;
     }
 
+    /// Records every processed pushbuffer segment, and the guest memory changed before each
+    /// submission, into the given trace. nullptr disables it.
+    void BindTraceWriter(GPUTraceWriter* writer) {
+        trace_writer = writer;
+    }
+
 private:
     static constexpr u32 non_puller_methods = 0x40;
     static constexpr u32 max_subchannels = 8;
@@ -125,6 +132,7 @@ private:
 
     void CallMethod(u32 argument) const;
     void CallMultiMethod(const u32* base_start, u32 num_methods) const;
+    void CallMethodRange(const u32* base_start, u32 num_methods) const;
 
     std::vector<CommandHeader> command_headers; ///< Buffer for list of commands fetched at once
 
@@ -147,6 +155,8 @@ private:
 
     std::array<Engines::EngineInterface*, max_subchannels> subchannels{};
 
+    GPUTraceWriter* trace_writer{}; ///< Optional recorder of processed segments
+
     GPU& gpu;
     Core::System& system;
 };
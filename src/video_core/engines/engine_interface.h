@@ -18,6 +18,15 @@ public:
     /// Write multiple values to the register identified by method.
     virtual void CallMultiMethod(u32 method, const u32* base_start, u32 amount,
                                  u32 methods_pending) = 0;
+
+    /// Write consecutive values to the registers starting at method, one value per register.
+    /// Engines can override this to apply plain register writes in bulk.
+    virtual void CallMethodRange(u32 method, const u32* base_start, u32 amount,
+                                 u32 methods_pending) {
+        for (u32 i = 0; i < amount; ++i) {
+            CallMethod(method + i, base_start[i], methods_pending - i <= 1);
+        }
+    }
 };
 
 } // namespace Tegra::Engines
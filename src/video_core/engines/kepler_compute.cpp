@@ -2,6 +2,7 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include <bitset>
 #include "common/assert.h"
 #include "common/logging/log.h"
@@ -57,6 +58,31 @@ void KeplerCompute::CallMultiMethod(u32 method, const u32* base_start, u32 amoun
     }
 }
 
+void KeplerCompute::CallMethodRange(u32 method, const u32* base_start, u32 amount,
+                                    u32 methods_pending) {
+    ASSERT_MSG(method + amount <= Regs::NUM_REGS,
+               "Invalid KeplerCompute register, increase the size of the Regs structure");
+
+    const auto has_side_effects = [](u32 reg) {
+        return reg == KEPLER_COMPUTE_REG_INDEX(exec_upload) ||
+               reg == KEPLER_COMPUTE_REG_INDEX(data_upload) ||
+               reg == KEPLER_COMPUTE_REG_INDEX(launch);
+    };
+    u32 index = 0;
+    while (index < amount) {
+        u32 run_end = index;
+        while (run_end < amount && !has_side_effects(method + run_end)) {
+            ++run_end;
+        }
+        std::copy(base_start + index, base_start + run_end, &regs.reg_array[method + index]);
+        if (run_end == amount) {
+            break;
+        }
+        CallMethod(method + run_end, base_start[run_end], methods_pending - run_end <= 1);
+        index = run_end + 1;
+    }
+}
+
 u32 KeplerCompute::AccessConstBuffer32(ShaderType stage, u64 const_buffer, u64 offset) const {
     ASSERT(stage == ShaderType::Compute);
     const auto& buffer = launch_description.const_buffer_config[const_buffer];
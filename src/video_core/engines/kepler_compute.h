@@ -209,6 +209,10 @@ public:
     void CallMultiMethod(u32 method, const u32* base_start, u32 amount,
                          u32 methods_pending) override;
 
+    /// Write consecutive values to the registers starting at method.
+    void CallMethodRange(u32 method, const u32* base_start, u32 amount,
+                         u32 methods_pending) override;
+
     u32 AccessConstBuffer32(ShaderType stage, u64 const_buffer, u64 offset) const override;
 
     SamplerDescriptor AccessBoundSampler(ShaderType stage, u64 offset) const override;
@@ -121,6 +121,27 @@ void Maxwell3D::InitializeRegisterDefaults() {
     mme_inline[MAXWELL3D_REG_INDEX(draw.vertex_begin_gl)] = true;
     mme_inline[MAXWELL3D_REG_INDEX(vertex_buffer.count)] = true;
     mme_inline[MAXWELL3D_REG_INDEX(index_array.count)] = true;
+
+    // Keep in sync with the methods handled in ProcessMethodCall
+    static constexpr std::array side_effect_methods{
+        MAXWELL3D_REG_INDEX(wait_for_idle),         MAXWELL3D_REG_INDEX(shadow_ram_control),
+        MAXWELL3D_REG_INDEX(macros.upload_address), MAXWELL3D_REG_INDEX(macros.data),
+        MAXWELL3D_REG_INDEX(macros.bind),           MAXWELL3D_REG_INDEX(firmware[4]),
+        MAXWELL3D_REG_INDEX(cb_bind[0]),            MAXWELL3D_REG_INDEX(cb_bind[1]),
+        MAXWELL3D_REG_INDEX(cb_bind[2]),            MAXWELL3D_REG_INDEX(cb_bind[3]),
+        MAXWELL3D_REG_INDEX(cb_bind[4]),            MAXWELL3D_REG_INDEX(draw.vertex_end_gl),
+        MAXWELL3D_REG_INDEX(clear_buffers),         MAXWELL3D_REG_INDEX(query.query_get),
+        MAXWELL3D_REG_INDEX(condition.mode),        MAXWELL3D_REG_INDEX(counter_reset),
+        MAXWELL3D_REG_INDEX(sync_info),             MAXWELL3D_REG_INDEX(exec_upload),
+        MAXWELL3D_REG_INDEX(data_upload),           MAXWELL3D_REG_INDEX(fragment_barrier),
+        MAXWELL3D_REG_INDEX(tiled_cache_barrier),
+    };
+    for (const std::size_t method : side_effect_methods) {
+        method_side_effects[method] = true;
+    }
+    for (std::size_t i = 0; i < 16; ++i) {
+        method_side_effects[MAXWELL3D_REG_INDEX(const_buffer.cb_data) + i] = true;
+    }
 }
 
 void Maxwell3D::ProcessMacro(u32 method, const u32* base_start, u32 amount, bool is_last_call) {
@@ -131,6 +152,12 @@ void Maxwell3D::ProcessMacro(u32 method, const u32* base_start, u32 amount, bool
         executing_macro = method;
     }
 
+    // Calls with all their parameters in one command buffer entry read them in place
+    if (is_last_call && macro_params.empty()) {
+        CallMacroMethod(executing_macro, std::span(base_start, amount));
+        return;
+    }
+
     macro_params.insert(macro_params.end(), base_start, base_start + amount);
 
     // Call the macro when there are no more parameters in the command buffer
@@ -165,6 +192,31 @@ void Maxwell3D::ProcessDirtyRegisters(u32 method, u32 argument) {
     }
 }
 
+void Maxwell3D::ProcessRegisterRange(u32 method, const u32* base_start, u32 amount) {
+    const auto control = shadow_state.shadow_ram_control;
+    if (control == Regs::ShadowRamControl::Track ||
+        control == Regs::ShadowRamControl::TrackWithFilter) {
+        std::memcpy(&shadow_state.reg_array[method], base_start, amount * sizeof(u32));
+    } else if (control == Regs::ShadowRamControl::Replay) {
+        base_start = &shadow_state.reg_array[method];
+    }
+
+    // Games commonly resubmit whole register blocks with the same values, skip those quickly
+    u32* const dest = &regs.reg_array[method];
+    if (std::memcmp(dest, base_start, amount * sizeof(u32)) == 0) {
+        return;
+    }
+    for (u32 i = 0; i < amount; ++i) {
+        if (dest[i] == base_start[i]) {
+            continue;
+        }
+        dest[i] = base_start[i];
+        for (const auto& table : dirty.tables) {
+            dirty.flags[table[method + i]] = true;
+        }
+    }
+}
+
 void Maxwell3D::ProcessMethodCall(u32 method, u32 argument, u32 nonshadow_argument,
                                   bool is_last_call) {
     switch (method) {
@@ -173,6 +225,8 @@ void Maxwell3D::ProcessMethodCall(u32 method, u32 argument, u32 nonshadow_argume
     case MAXWELL3D_REG_INDEX(shadow_ram_control):
         shadow_state.shadow_ram_control = static_cast<Regs::ShadowRamControl>(nonshadow_argument);
         return;
+    case MAXWELL3D_REG_INDEX(macros.upload_address):
+        return macro_engine->ClearCode(regs.macros.upload_address);
     case MAXWELL3D_REG_INDEX(macros.data):
         return macro_engine->AddCode(regs.macros.upload_address, argument);
     case MAXWELL3D_REG_INDEX(macros.bind):
@@ -232,7 +286,7 @@ void Maxwell3D::ProcessMethodCall(u32 method, u32 argument, u32 nonshadow_argume
     }
 }
 
-void Maxwell3D::CallMacroMethod(u32 method, const std::vector<u32>& parameters) {
+void Maxwell3D::CallMacroMethod(u32 method, std::span<const u32> parameters) {
     // Reset the current macro.
     executing_macro = 0;
 
@@ -312,6 +366,32 @@ void Maxwell3D::CallMultiMethod(u32 method, const u32* base_start, u32 amount,
     }
 }
 
+void Maxwell3D::CallMethodRange(u32 method, const u32* base_start, u32 amount,
+                                u32 methods_pending) {
+    // Macro calls and registers with side effects go through the regular path, plain registers
+    // in between are written as a single run.
+    u32 index = 0;
+    while (index < amount) {
+        const u32 current = method + index;
+        if (current >= MacroRegistersStart || executing_macro != 0 ||
+            method_side_effects[current]) {
+            CallMethod(current, base_start[index], methods_pending - index <= 1);
+            ++index;
+            continue;
+        }
+        u32 run_end = index + 1;
+        while (run_end < amount && method + run_end < MacroRegistersStart &&
+               !method_side_effects[method + run_end]) {
+            ++run_end;
+        }
+        if (cb_data_state.current != null_cb_data) {
+            FinishCBData();
+        }
+        ProcessRegisterRange(current, base_start + index, run_end - index);
+        index = run_end;
+    }
+}
+
 void Maxwell3D::StepInstance(const MMEDrawMode expected_mode, const u32 count) {
     if (mme_draw.current_mode == MMEDrawMode::Undefined) {
         if (mme_draw.gl_begin_consume) {
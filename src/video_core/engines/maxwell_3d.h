@@ -8,6 +8,7 @@
 #include <bitset>
 #include <limits>
 #include <optional>
+#include <span>
 #include <type_traits>
 #include <unordered_map>
 #include <vector>
@@ -1418,6 +1419,10 @@ public:
     void CallMultiMethod(u32 method, const u32* base_start, u32 amount,
                          u32 methods_pending) override;
 
+    /// Write consecutive values to the registers starting at method.
+    void CallMethodRange(u32 method, const u32* base_start, u32 amount,
+                         u32 methods_pending) override;
+
     /// Write the value to the register identified by method.
     void CallMethodFromMME(u32 method, u32 method_argument);
 
@@ -1452,6 +1457,10 @@ public:
         return *rasterizer;
     }
 
+    const MacroEngine::Statistics& GetMacroStatistics() const {
+        return macro_engine->GetStatistics();
+    }
+
     enum class MMEDrawMode : u32 {
         Undefined,
         Array,
@@ -1487,6 +1496,9 @@ private:
 
     void ProcessMethodCall(u32 method, u32 argument, u32 nonshadow_argument, bool is_last_call);
 
+    /// Writes a run of registers that have no side effects besides dirty tracking.
+    void ProcessRegisterRange(u32 method, const u32* base_start, u32 amount);
+
     /// Retrieves information about a specific TIC entry from the TIC buffer.
     Texture::TICEntry GetTICEntry(u32 tic_index) const;
 
@@ -1499,7 +1511,7 @@ private:
      * @param method Method to call
      * @param parameters Arguments to the method call
      */
-    void CallMacroMethod(u32 method, const std::vector<u32>& parameters);
+    void CallMacroMethod(u32 method, std::span<const u32> parameters);
 
     /// Handles writes to the macro uploading register.
     void ProcessMacroUpload(u32 data);
@@ -1556,6 +1568,9 @@ private:
 
     std::array<bool, Regs::NUM_REGS> mme_inline{};
 
+    /// Registers handled by ProcessMethodCall, these can't be written in bulk.
+    std::array<bool, Regs::NUM_REGS> method_side_effects{};
+
     /// Macro method that is currently being executed / being fed parameters.
     u32 executing_macro = 0;
     /// Parameters that have been submitted to the macro call so far.
@@ -2,6 +2,8 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
+
 #include "common/assert.h"
 #include "common/logging/log.h"
 #include "common/settings.h"
@@ -38,6 +40,23 @@ void MaxwellDMA::CallMultiMethod(u32 method, const u32* base_start, u32 amount,
     }
 }
 
+void MaxwellDMA::CallMethodRange(u32 method, const u32* base_start, u32 amount,
+                                 u32 methods_pending) {
+    ASSERT_MSG(method + amount <= NUM_REGS, "Invalid MaxwellDMA register");
+
+    // Only launch_dma has side effects, registers before and after it are plain writes
+    static constexpr u32 launch_method = offsetof(Regs, launch_dma) / sizeof(u32);
+    if (method > launch_method || method + amount <= launch_method) {
+        std::copy(base_start, base_start + amount, &regs.reg_array[method]);
+        return;
+    }
+    const u32 launch_index = launch_method - method;
+    std::copy(base_start, base_start + launch_index, &regs.reg_array[method]);
+    CallMethod(launch_method, base_start[launch_index], methods_pending - launch_index <= 1);
+    std::copy(base_start + launch_index + 1, base_start + amount,
+              &regs.reg_array[launch_method + 1]);
+}
+
 void MaxwellDMA::Launch() {
     LOG_TRACE(Render_OpenGL, "DMA copy 0x{:x} -> 0x{:x}", static_cast<GPUVAddr>(regs.offset_in),
               static_cast<GPUVAddr>(regs.offset_out));
@@ -197,6 +197,10 @@ public:
     void CallMultiMethod(u32 method, const u32* base_start, u32 amount,
                          u32 methods_pending) override;
 
+    /// Write consecutive values to the registers starting at method.
+    void CallMethodRange(u32 method, const u32* base_start, u32 amount,
+                         u32 methods_pending) override;
+
 private:
     /// Performs the copy from the source buffer to the destination buffer as configured in the
     /// registers.
@@ -8,6 +8,7 @@
 #include <queue>
 
 #include "common/common_types.h"
+#include "common/trace_recorder.h"
 #include "core/core.h"
 #include "video_core/delayed_destruction_ring.h"
 #include "video_core/gpu.h"
@@ -60,6 +61,7 @@ public:
         TFence new_fence = CreateFence(addr, value, !should_flush);
         fences.push(new_fence);
         QueueFence(new_fence);
+        Common::Trace::RecordInstant("gpu", "Semaphore fence queued", "payload", value);
         if (should_flush) {
             rasterizer.FlushCommands();
         }
@@ -73,6 +75,7 @@ public:
         TFence new_fence = CreateFence(value, !should_flush);
         fences.push(new_fence);
         QueueFence(new_fence);
+        Common::Trace::RecordInstant("gpu", "Syncpoint fence queued", "syncpoint", value);
         if (should_flush) {
             rasterizer.FlushCommands();
         }
@@ -86,6 +89,8 @@ public:
                 WaitFence(current_fence);
             }
             PopAsyncFlushes();
+            Common::Trace::RecordInstant("gpu", "Fence released", "payload",
+                                         current_fence->GetPayload());
             if (current_fence->IsSemaphore()) {
                 gpu_memory.template Write<u32>(current_fence->GetAddress(),
                                                current_fence->GetPayload());
@@ -132,6 +137,8 @@ private:
                 return;
             }
             PopAsyncFlushes();
+            Common::Trace::RecordInstant("gpu", "Fence released", "payload",
+                                         current_fence->GetPayload());
             if (current_fence->IsSemaphore()) {
                 gpu_memory.template Write<u32>(current_fence->GetAddress(),
                                                current_fence->GetPayload());
@@ -20,6 +20,7 @@
 #include "video_core/engines/maxwell_3d.h"
 #include "video_core/engines/maxwell_dma.h"
 #include "video_core/gpu.h"
+#include "video_core/gpu_trace.h"
 #include "video_core/memory_manager.h"
 #include "video_core/renderer_base.h"
 #include "video_core/shader_notify.h"
@@ -38,7 +39,13 @@ GPU::GPU(Core::System& system_, bool is_async_, bool use_nvdec_)
       maxwell_dma{std::make_unique<Engines::MaxwellDMA>(system, *memory_manager)},
       kepler_memory{std::make_unique<Engines::KeplerMemory>(system, *memory_manager)},
       shader_notify{std::make_unique<VideoCore::ShaderNotify>()}, is_async{is_async_},
-      gpu_thread{system_, is_async_} {}
+      gpu_thread{system_, is_async_} {
+    if (!Settings::values.gpu_trace_path.empty()) {
+        trace_writer = std::make_unique<GPUTraceWriter>(Settings::values.gpu_trace_path);
+        dma_pusher->BindTraceWriter(trace_writer.get());
+        memory_manager->BindTraceWriter(trace_writer.get());
+    }
+}
 
 GPU::~GPU() = default;
 
@@ -200,6 +207,9 @@ u64 GPU::GetTicks() const {
 
 void GPU::RendererFrameEndNotify() {
     system.GetPerfStats().EndGameFrame();
+    if (trace_writer) {
+        trace_writer->RecordFrameEnd();
+    }
 }
 
 void GPU::FlushCommands() {
@@ -119,6 +119,7 @@ enum class EngineID {
     MAXWELL_DMA_COPY_A = 0xB0B5,
 };
 
+class GPUTraceWriter;
 class MemoryManager;
 
 class GPU final {
@@ -389,6 +390,8 @@ private:
     std::unique_ptr<Engines::KeplerMemory> kepler_memory;
     /// Shader build notifier
     std::unique_ptr<VideoCore::ShaderNotify> shader_notify;
+    /// Command list recorder, only present when a GPU trace was requested
+    std::unique_ptr<GPUTraceWriter> trace_writer;
     /// When true, we are about to shut down emulation session, so terminate outstanding tasks
     std::atomic_bool shutting_down{};
 
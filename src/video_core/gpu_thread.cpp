@@ -2,6 +2,8 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <limits>
+
 #include "common/assert.h"
 #include "common/microprofile.h"
 #include "common/scope_exit.h"
@@ -16,6 +18,13 @@
 
 namespace VideoCommon::GPUThread {
 
+/// Discards the commands left up to the EndProcessingCommand pushed by ThreadManager::ShutDown.
+/// Their producers took their slots before it, and may be blocked on a full queue until then.
+static void DrainQueue(SynchState& state) {
+    while (!std::holds_alternative<EndProcessingCommand>(state.queue.PopWait().data)) {
+    }
+}
+
 /// Runs the GPU thread
 static void RunThread(Core::System& system, VideoCore::RendererBase& renderer,
                       Core::Frontend::GraphicsContext& context, Tegra::DmaPusher& dma_pusher,
@@ -33,6 +42,7 @@ static void RunThread(Core::System& system, VideoCore::RendererBase& renderer,
 
     // If emulation was stopped during disk shader loading, abort before trying to acquire context
     if (!state.is_running) {
+        DrainQueue(state);
         return;
     }
 
@@ -40,8 +50,10 @@ static void RunThread(Core::System& system, VideoCore::RendererBase& renderer,
     VideoCore::RasterizerInterface* const rasterizer = renderer.ReadRasterizer();
 
     CommandDataContainer next;
+    u64 fence = 0;
     while (state.is_running) {
         next = state.queue.PopWait();
+        ++fence;
         if (auto* submit_list = std::get_if<SubmitListCommand>(&next.data)) {
             dma_pusher.Push(std::move(submit_list->entries));
             dma_pusher.DispatchCalls();
@@ -57,17 +69,16 @@ static void RunThread(Core::System& system, VideoCore::RendererBase& renderer,
             rasterizer->OnCPUWrite(invalidate->addr, invalidate->size);
         } else if (std::holds_alternative<EndProcessingCommand>(next.data)) {
             ASSERT(state.is_running == false);
+            return;
         } else {
             UNREACHABLE();
         }
-        state.signaled_fence.store(next.fence);
+        state.signaled_fence.store(fence, std::memory_order_release);
         if (next.block) {
-            // We have to lock the write_lock to ensure that the condition_variable wait not get a
-            // race between the check and the lock itself.
-            std::lock_guard lk(state.write_lock);
-            state.cv.notify_all();
+            state.signaled_fence.notify_all();
         }
     }
+    DrainQueue(state);
 }
 
 ThreadManager::ThreadManager(Core::System& system_, bool is_async_)
@@ -122,11 +133,10 @@ void ThreadManager::ShutDown() {
         return;
     }
 
-    {
-        std::lock_guard lk(state.write_lock);
-        state.is_running = false;
-        state.cv.notify_all();
-    }
+    // Wake up threads waiting for a fence, they will observe that the GPU is no longer running
+    state.is_running = false;
+    state.signaled_fence.store(std::numeric_limits<u64>::max(), std::memory_order_release);
+    state.signaled_fence.notify_all();
 
     if (!thread.joinable()) {
         return;
@@ -147,15 +157,15 @@ u64 ThreadManager::PushCommand(CommandData&& command_data, bool block) {
         block = true;
     }
 
-    std::unique_lock lk(state.write_lock);
-    const u64 fence{++state.last_fence};
-    state.queue.Push(CommandDataContainer(std::move(command_data), fence, block));
+    // Fences are the queue positions plus one, so they are signaled in the order they are pushed
+    const u64 fence = state.queue.Push(CommandDataContainer(std::move(command_data), block)) + 1;
 
     if (block) {
-        state.cv.wait(lk, [this, fence] {
-            return fence <= state.signaled_fence.load(std::memory_order_relaxed) ||
-                   !state.is_running;
-        });
+        for (u64 signaled = state.signaled_fence.load(std::memory_order_acquire);
+             signaled < fence && state.is_running;
+             signaled = state.signaled_fence.load(std::memory_order_acquire)) {
+            state.signaled_fence.wait(signaled, std::memory_order_acquire);
+        }
     }
 
     return fence;
@@ -5,13 +5,11 @@
 #pragma once
 
 #include <atomic>
-#include <condition_variable>
-#include <mutex>
 #include <optional>
 #include <thread>
 #include <variant>
 
-#include "common/threadsafe_queue.h"
+#include "common/bounded_threadsafe_queue.h"
 #include "video_core/framebuffer_config.h"
 
 namespace Tegra {
@@ -90,24 +88,23 @@ using CommandData =
 struct CommandDataContainer {
     CommandDataContainer() = default;
 
-    explicit CommandDataContainer(CommandData&& data_, u64 next_fence_, bool block_)
-        : data{std::move(data_)}, fence{next_fence_}, block(block_) {}
+    explicit CommandDataContainer(CommandData&& data_, bool block_)
+        : data{std::move(data_)}, block(block_) {}
 
     CommandData data;
-    u64 fence{};
     bool block{};
 };
 
 /// Struct used to synchronize the GPU thread
 struct SynchState final {
+    /// Maximum number of commands in flight before submitting threads block
+    static constexpr std::size_t QUEUE_SIZE = 1024;
+
     std::atomic_bool is_running{true};
 
-    using CommandQueue = Common::SPSCQueue<CommandDataContainer>;
-    std::mutex write_lock;
+    using CommandQueue = Common::BoundedMPSCQueue<CommandDataContainer, QUEUE_SIZE>;
     CommandQueue queue;
-    u64 last_fence{};
     std::atomic<u64> signaled_fence{};
-    std::condition_variable cv;
 };
 
 /// Class used to manage the GPU thread
@@ -0,0 +1,288 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <cstring>
+
+#include "common/alignment.h"
+#include "common/logging/log.h"
+#include "video_core/gpu_trace.h"
+
+namespace Tegra {
+
+namespace {
+
+constexpr u32 TRACE_MAGIC = 0x54475A59; // "YZGT"
+constexpr u32 TRACE_VERSION = 2;
+
+struct TraceHeader {
+    u32 magic;
+    u32 version;
+};
+static_assert(sizeof(TraceHeader) == 8, "TraceHeader has wrong size");
+
+struct RecordHeader {
+    GPUTraceRecordType type;
+    u32 size; ///< Size in bytes of the payload following the header
+};
+static_assert(sizeof(RecordHeader) == 8, "RecordHeader has wrong size");
+
+struct MapPayload {
+    GPUVAddr gpu_addr;
+    VAddr cpu_addr;
+    u64 size;
+};
+static_assert(sizeof(MapPayload) == 24, "MapPayload has wrong size");
+
+struct UnmapPayload {
+    GPUVAddr gpu_addr;
+    u64 size;
+};
+static_assert(sizeof(UnmapPayload) == 16, "UnmapPayload has wrong size");
+
+/// Precedes the memory contents of a MemoryWrite record
+struct MemoryWriteHeader {
+    VAddr cpu_addr;
+};
+static_assert(sizeof(MemoryWriteHeader) == 8, "MemoryWriteHeader has wrong size");
+
+/// Largest segment the DMA pusher can fetch, the size of a command list entry is 21 bits wide
+constexpr u32 MAX_COMMAND_LIST_SIZE = ((1U << 21) - 1) * sizeof(CommandHeader);
+
+/// Changed pages are split in records of at most this size
+constexpr u32 MAX_MEMORY_WRITE_SIZE = 16U << 20;
+
+constexpr u64 PAGE_SIZE = Core::Memory::PAGE_SIZE;
+
+template <typename T>
+std::span<const u8> AsBytes(const T& object) {
+    return std::span(reinterpret_cast<const u8*>(&object), sizeof(object));
+}
+
+} // Anonymous namespace
+
+GPUTraceWriter::GPUTraceWriter(const std::filesystem::path& path)
+    : file{path, Common::FS::FileAccessMode::Write} {
+    if (!file.IsOpen()) {
+        LOG_ERROR(HW_GPU, "Failed to create GPU trace file {}", path.string());
+        return;
+    }
+    const TraceHeader header{
+        .magic = TRACE_MAGIC,
+        .version = TRACE_VERSION,
+    };
+    if (!file.WriteObject(header)) {
+        LOG_ERROR(HW_GPU, "Failed to write GPU trace header");
+        file.Close();
+        return;
+    }
+    LOG_INFO(HW_GPU, "Recording GPU trace to {}", path.string());
+}
+
+GPUTraceWriter::~GPUTraceWriter() = default;
+
+bool GPUTraceWriter::IsOpen() const {
+    std::scoped_lock lock{mutex};
+    return file.IsOpen();
+}
+
+void GPUTraceWriter::RecordCommandList(std::span<const CommandHeader> commands) {
+    std::scoped_lock lock{mutex};
+    WriteRecord(GPUTraceRecordType::CommandList,
+                std::span(reinterpret_cast<const u8*>(commands.data()), commands.size_bytes()));
+}
+
+void GPUTraceWriter::RecordFrameEnd() {
+    std::scoped_lock lock{mutex};
+    WriteRecord(GPUTraceRecordType::FrameEnd, {});
+}
+
+void GPUTraceWriter::RecordMap(GPUVAddr gpu_addr, VAddr cpu_addr, u64 size) {
+    std::scoped_lock lock{mutex};
+    if (!file.IsOpen()) {
+        return;
+    }
+    const auto [it, is_new] = mappings.try_emplace(gpu_addr, MappedRange{cpu_addr, size});
+    if (!is_new) {
+        RemoveMappedPages(it->second.cpu_addr, it->second.size);
+        it->second = MappedRange{cpu_addr, size};
+    }
+    AddMappedPages(cpu_addr, size);
+
+    WriteRecord(GPUTraceRecordType::Map, AsBytes(MapPayload{
+                                             .gpu_addr = gpu_addr,
+                                             .cpu_addr = cpu_addr,
+                                             .size = size,
+                                         }));
+}
+
+void GPUTraceWriter::RecordUnmap(GPUVAddr gpu_addr, u64 size) {
+    std::scoped_lock lock{mutex};
+    if (!file.IsOpen()) {
+        return;
+    }
+    if (const auto it = mappings.find(gpu_addr); it != mappings.end()) {
+        RemoveMappedPages(it->second.cpu_addr, it->second.size);
+        mappings.erase(it);
+    }
+    WriteRecord(GPUTraceRecordType::Unmap, AsBytes(UnmapPayload{
+                                               .gpu_addr = gpu_addr,
+                                               .size = size,
+                                           }));
+}
+
+void GPUTraceWriter::RecordMemoryChanges(const Core::Memory::Memory& memory) {
+    std::scoped_lock lock{mutex};
+    if (!file.IsOpen()) {
+        return;
+    }
+    VAddr changed_addr = 0;
+    const auto flush = [this, &changed_addr] {
+        if (changed_pages.empty()) {
+            return;
+        }
+        WriteRecord(GPUTraceRecordType::MemoryWrite, AsBytes(MemoryWriteHeader{changed_addr}),
+                    changed_pages);
+        changed_pages.clear();
+    };
+    for (auto& [page_addr, page] : shadow_pages) {
+        const u8* const pointer = memory.GetPointer(page_addr);
+        if (!pointer || (page.is_recorded &&
+                         std::memcmp(page.contents.data(), pointer, page.contents.size()) == 0)) {
+            flush();
+            continue;
+        }
+        if (changed_addr + changed_pages.size() != page_addr ||
+            changed_pages.size() >= MAX_MEMORY_WRITE_SIZE) {
+            flush();
+        }
+        if (changed_pages.empty()) {
+            changed_addr = page_addr;
+        }
+        std::memcpy(page.contents.data(), pointer, page.contents.size());
+        page.is_recorded = true;
+        changed_pages.insert(changed_pages.end(), page.contents.begin(), page.contents.end());
+    }
+    flush();
+}
+
+void GPUTraceWriter::WriteRecord(GPUTraceRecordType type, std::span<const u8> header,
+                                 std::span<const u8> payload) {
+    if (!file.IsOpen()) {
+        return;
+    }
+    const RecordHeader record_header{
+        .type = type,
+        .size = static_cast<u32>(header.size() + payload.size()),
+    };
+    if (!file.WriteObject(record_header) || file.WriteSpan(header) != header.size() ||
+        file.WriteSpan(payload) != payload.size()) {
+        LOG_ERROR(HW_GPU, "Failed to write GPU trace record, stopping the trace");
+        file.Close();
+    }
+}
+
+void GPUTraceWriter::AddMappedPages(VAddr cpu_addr, u64 size) {
+    const VAddr end = Common::AlignUp(cpu_addr + size, PAGE_SIZE);
+    for (VAddr page = Common::AlignDown(cpu_addr, PAGE_SIZE); page < end; page += PAGE_SIZE) {
+        ++shadow_pages[page].num_mappings;
+    }
+}
+
+void GPUTraceWriter::RemoveMappedPages(VAddr cpu_addr, u64 size) {
+    const VAddr end = Common::AlignUp(cpu_addr + size, PAGE_SIZE);
+    for (VAddr page = Common::AlignDown(cpu_addr, PAGE_SIZE); page < end; page += PAGE_SIZE) {
+        const auto it = shadow_pages.find(page);
+        if (it != shadow_pages.end() && --it->second.num_mappings == 0) {
+            shadow_pages.erase(it);
+        }
+    }
+}
+
+GPUTraceReader::GPUTraceReader(const std::filesystem::path& path)
+    : file{path, Common::FS::FileAccessMode::Read} {
+    TraceHeader header{};
+    if (!file.IsOpen() || !file.ReadObject(header)) {
+        return;
+    }
+    if (header.magic != TRACE_MAGIC || header.version != TRACE_VERSION) {
+        LOG_ERROR(HW_GPU, "Invalid GPU trace header magic={:08x} version={}", header.magic,
+                  header.version);
+        return;
+    }
+    file_size = file.GetSize();
+    is_valid = true;
+}
+
+GPUTraceReader::~GPUTraceReader() = default;
+
+bool GPUTraceReader::ReadRecord(GPUTraceRecord& record) {
+    if (!is_valid) {
+        return false;
+    }
+    RecordHeader header{};
+    if (!file.ReadObject(header)) {
+        return false;
+    }
+    // Validate the size before allocating, a corrupt trace could request any amount of memory
+    const s64 position = file.Tell();
+    if (position < 0 || header.size > file_size - static_cast<u64>(position)) {
+        LOG_ERROR(HW_GPU, "GPU trace record of {} bytes is truncated", header.size);
+        is_valid = false;
+        return false;
+    }
+    record.type = header.type;
+    if (!ReadPayload(record, header.size)) {
+        LOG_ERROR(HW_GPU, "GPU trace record of type {} and {} bytes is corrupt",
+                  static_cast<u32>(header.type), header.size);
+        is_valid = false;
+        return false;
+    }
+    return true;
+}
+
+bool GPUTraceReader::ReadPayload(GPUTraceRecord& record, u32 size) {
+    switch (record.type) {
+    case GPUTraceRecordType::CommandList:
+        if (size > MAX_COMMAND_LIST_SIZE || size % sizeof(CommandHeader) != 0) {
+            return false;
+        }
+        record.commands.resize(size / sizeof(CommandHeader));
+        return file.ReadSpan(std::span<CommandHeader>(record.commands)) == record.commands.size();
+    case GPUTraceRecordType::FrameEnd:
+        return size == 0;
+    case GPUTraceRecordType::Map: {
+        MapPayload payload{};
+        if (size != sizeof(payload) || !file.ReadObject(payload)) {
+            return false;
+        }
+        record.gpu_addr = payload.gpu_addr;
+        record.cpu_addr = payload.cpu_addr;
+        record.size = payload.size;
+        return true;
+    }
+    case GPUTraceRecordType::Unmap: {
+        UnmapPayload payload{};
+        if (size != sizeof(payload) || !file.ReadObject(payload)) {
+            return false;
+        }
+        record.gpu_addr = payload.gpu_addr;
+        record.size = payload.size;
+        return true;
+    }
+    case GPUTraceRecordType::MemoryWrite: {
+        MemoryWriteHeader write_header{};
+        if (size < sizeof(write_header) || size - sizeof(write_header) > MAX_MEMORY_WRITE_SIZE ||
+            !file.ReadObject(write_header)) {
+            return false;
+        }
+        record.cpu_addr = write_header.cpu_addr;
+        record.data.resize(size - sizeof(write_header));
+        return file.ReadSpan(std::span<u8>(record.data)) == record.data.size();
+    }
+    default:
+        return false;
+    }
+}
+
+} // namespace Tegra
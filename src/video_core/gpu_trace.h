@@ -0,0 +1,135 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <span>
+#include <vector>
+
+#include "common/common_types.h"
+#include "common/fs/file.h"
+#include "core/memory.h"
+#include "video_core/dma_pusher.h"
+
+namespace Tegra {
+
+enum class GPUTraceRecordType : u32 {
+    CommandList, ///< Command words of a pushbuffer segment, as read by the DMA pusher
+    FrameEnd,    ///< The guest presented a frame
+    Map,         ///< A range of guest memory was mapped into the GPU address space
+    Unmap,       ///< A range of the GPU address space was unmapped
+    MemoryWrite, ///< Contents of guest memory mapped to the GPU, as the next commands read it
+};
+
+struct GPUTraceRecord {
+    GPUTraceRecordType type{};
+    std::vector<CommandHeader> commands; ///< Command words of CommandList records
+    GPUVAddr gpu_addr{};                 ///< GPU address of Map and Unmap records
+    VAddr cpu_addr{};                    ///< Guest address of Map and MemoryWrite records
+    u64 size{};                          ///< Size in bytes of Map and Unmap records
+    std::vector<u8> data;                ///< Memory contents of MemoryWrite records
+};
+
+/**
+ * Writes the command lists processed by the DMA pusher to a trace file, along with the GPU
+ * address space mappings and the guest memory they expose.
+ * Command list entries are resolved from guest memory when they are recorded, so the trace can be
+ * replayed without the guest process that produced it.
+ * Mapped memory is compared against a copy of its last recorded contents before each submission,
+ * only the pages that changed are written. The copy takes as much host memory as the guest has
+ * mapped into the GPU address space.
+ * Mappings are recorded from the threads of the guest, command lists from the GPU thread.
+ */
+class GPUTraceWriter {
+public:
+    explicit GPUTraceWriter(const std::filesystem::path& path);
+    ~GPUTraceWriter();
+
+    /// Returns true when the trace file was created successfully.
+    [[nodiscard]] bool IsOpen() const;
+
+    /// Records the command words of a pushbuffer segment.
+    void RecordCommandList(std::span<const CommandHeader> commands);
+
+    /// Records the end of a guest frame.
+    void RecordFrameEnd();
+
+    /// Records a mapping of guest memory into the GPU address space, replacing the mapping that
+    /// started at the same GPU address.
+    void RecordMap(GPUVAddr gpu_addr, VAddr cpu_addr, u64 size);
+
+    /// Records the removal of the mapping starting at the given GPU address.
+    void RecordUnmap(GPUVAddr gpu_addr, u64 size);
+
+    /**
+     * Records the mapped guest memory that changed since it was last recorded. It has to be called
+     * before the commands reading that memory are recorded.
+     *
+     * @param memory Guest memory of the process owning the GPU address space
+     */
+    void RecordMemoryChanges(const Core::Memory::Memory& memory);
+
+private:
+    struct MappedRange {
+        VAddr cpu_addr;
+        u64 size;
+    };
+
+    struct ShadowPage {
+        u32 num_mappings = 0;
+        bool is_recorded = false;
+        std::array<u8, Core::Memory::PAGE_SIZE> contents;
+    };
+
+    void WriteRecord(GPUTraceRecordType type, std::span<const u8> header,
+                     std::span<const u8> payload = {});
+
+    void AddMappedPages(VAddr cpu_addr, u64 size);
+
+    void RemoveMappedPages(VAddr cpu_addr, u64 size);
+
+    mutable std::mutex mutex;
+    Common::FS::IOFile file;
+
+    /// Mappings of the GPU address space by the GPU address they start at
+    std::map<GPUVAddr, MappedRange> mappings;
+    /// Last recorded contents of the guest pages mapped to the GPU, by guest page address
+    std::map<VAddr, ShadowPage> shadow_pages;
+    /// Contiguous changed pages, written as a single record
+    std::vector<u8> changed_pages;
+};
+
+/// Reads the records of a trace file written by GPUTraceWriter.
+class GPUTraceReader {
+public:
+    explicit GPUTraceReader(const std::filesystem::path& path);
+    ~GPUTraceReader();
+
+    /// Returns true when the file is open and has a valid trace header.
+    [[nodiscard]] bool IsValid() const {
+        return is_valid;
+    }
+
+    /**
+     * Reads the next record of the trace.
+     *
+     * @param record Record to read into, its buffers are reused between calls
+     *
+     * @returns True on success, false at the end of the trace or on a corrupt or truncated record.
+     */
+    bool ReadRecord(GPUTraceRecord& record);
+
+private:
+    bool ReadPayload(GPUTraceRecord& record, u32 size);
+
+    Common::FS::IOFile file;
+    u64 file_size = 0;
+    bool is_valid = false;
+};
+
+} // namespace Tegra
@@ -24,10 +24,34 @@ void MacroEngine::AddCode(u32 method, u32 data) {
     uploaded_macro_code[method].push_back(data);
 }
 
+void MacroEngine::ClearCode(u32 method) {
+    macro_cache.erase(method);
+    uploaded_macro_code.erase(method);
+}
+
+std::shared_ptr<CachedMacro> MacroEngine::GetProgram(const std::vector<u32>& code, u64 hash) {
+    auto& compiled = program_cache[hash];
+    if (!compiled.program) {
+        // Keep the code to tell a later upload with the same hash apart from this one
+        compiled.code = code;
+        compiled.program = Compile(code);
+        ++statistics.compilations;
+    } else if (compiled.code != code) {
+        LOG_WARNING(HW_GPU, "Macro hash collision 0x{:016x}", hash);
+        ++statistics.compilations;
+        return Compile(code);
+    } else {
+        ++statistics.program_cache_hits;
+    }
+    return compiled.program;
+}
+
 void MacroEngine::Execute(Engines::Maxwell3D& maxwell3d, u32 method,
-                          const std::vector<u32>& parameters) {
+                          std::span<const u32> parameters) {
+    ++statistics.executions;
     auto compiled_macro = macro_cache.find(method);
     if (compiled_macro != macro_cache.end()) {
+        ++statistics.macro_cache_hits;
         const auto& cache_info = compiled_macro->second;
         if (cache_info.has_hle_program) {
             cache_info.hle_program->Execute(parameters, method);
@@ -53,8 +77,8 @@ void MacroEngine::Execute(Engines::Maxwell3D& maxwell3d, u32 method,
         auto& cache_info = macro_cache[method];
 
         if (!mid_method.has_value()) {
-            cache_info.lle_program = Compile(macro_code->second);
             cache_info.hash = boost::hash_value(macro_code->second);
+            cache_info.lle_program = GetProgram(macro_code->second, cache_info.hash);
         } else {
             const auto& macro_cached = uploaded_macro_code[mid_method.value()];
             const auto rebased_method = method - mid_method.value();
@@ -63,7 +87,7 @@ void MacroEngine::Execute(Engines::Maxwell3D& maxwell3d, u32 method,
             std::memcpy(code.data(), macro_cached.data() + rebased_method,
                         code.size() * sizeof(u32));
             cache_info.hash = boost::hash_value(code);
-            cache_info.lle_program = Compile(code);
+            cache_info.lle_program = GetProgram(code, cache_info.hash);
         }
 
         auto hle_program = hle_macros->GetHLEProgram(cache_info.hash);
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <memory>
+#include <span>
 #include <unordered_map>
 #include <vector>
 #include "common/bit_field.h"
@@ -104,37 +105,65 @@ public:
     /**
      * Executes the macro code with the specified input parameters.
      *
-     * @param parameters The parameters of the macro
+     * @param parameters The parameters of the macro, only valid during the call
      * @param method     The method to execute
      */
-    virtual void Execute(const std::vector<u32>& parameters, u32 method) = 0;
+    virtual void Execute(std::span<const u32> parameters, u32 method) = 0;
 };
 
 class MacroEngine {
 public:
+    /// Counts how often macro calls find a compiled program, to measure the caches
+    struct Statistics {
+        u64 executions = 0;         ///< Macro calls
+        u64 macro_cache_hits = 0;   ///< Calls that found the macro compiled at their method
+        u64 program_cache_hits = 0; ///< Compilations avoided by a program compiled from the code
+        u64 compilations = 0;       ///< Programs compiled
+    };
+
     explicit MacroEngine(Engines::Maxwell3D& maxwell3d);
     virtual ~MacroEngine();
 
     // Store the uploaded macro code to compile them when they're called.
     void AddCode(u32 method, u32 data);
 
+    // Forget the macro uploaded at the method, a new one is about to be uploaded there.
+    void ClearCode(u32 method);
+
     // Compiles the macro if its not in the cache, and executes the compiled macro
-    void Execute(Engines::Maxwell3D& maxwell3d, u32 method, const std::vector<u32>& parameters);
+    void Execute(Engines::Maxwell3D& maxwell3d, u32 method, std::span<const u32> parameters);
+
+    [[nodiscard]] const Statistics& GetStatistics() const {
+        return statistics;
+    }
 
 protected:
+    /// Compiles the macro code, the returned program keeps its own copy of the code it needs.
     virtual std::unique_ptr<CachedMacro> Compile(const std::vector<u32>& code) = 0;
 
 private:
     struct CacheInfo {
-        std::unique_ptr<CachedMacro> lle_program{};
+        std::shared_ptr<CachedMacro> lle_program{};
         std::unique_ptr<CachedMacro> hle_program{};
         u64 hash{};
         bool has_hle_program{};
     };
 
+    struct CompiledProgram {
+        std::vector<u32> code;
+        std::shared_ptr<CachedMacro> program;
+    };
+
+    /// Returns the program compiled from the code, compiling it only the first time it's seen.
+    std::shared_ptr<CachedMacro> GetProgram(const std::vector<u32>& code, u64 hash);
+
     std::unordered_map<u32, CacheInfo> macro_cache;
+    /// Programs compiled for the running title by the hash of their code. Games upload the same
+    /// macros again when they change scenes, those reuse the program compiled the first time.
+    std::unordered_map<u64, CompiledProgram> program_cache;
     std::unordered_map<u32, std::vector<u32>> uploaded_macro_code;
     std::unique_ptr<HLEMacro> hle_macros;
+    Statistics statistics;
 };
 
 std::unique_ptr<MacroEngine> GetMacroEngine(Engines::Maxwell3D& maxwell3d);
@@ -3,7 +3,7 @@
 // Refer to the license.txt file included.
 
 #include <array>
-#include <vector>
+#include <span>
 #include "video_core/engines/maxwell_3d.h"
 #include "video_core/macro/macro_hle.h"
 #include "video_core/rasterizer_interface.h"
@@ -12,7 +12,7 @@ namespace Tegra {
 
 namespace {
 // HLE'd functions
-void HLE_771BB18C62444DA0(Engines::Maxwell3D& maxwell3d, const std::vector<u32>& parameters) {
+void HLE_771BB18C62444DA0(Engines::Maxwell3D& maxwell3d, std::span<const u32> parameters) {
     const u32 instance_count = parameters[2] & maxwell3d.GetRegisterValue(0xD1B);
 
     maxwell3d.regs.draw.topology.Assign(
@@ -31,7 +31,7 @@ void HLE_771BB18C62444DA0(Engines::Maxwell3D& maxwell3d, const std::vector<u32>&
     maxwell3d.mme_draw.current_mode = Engines::Maxwell3D::MMEDrawMode::Undefined;
 }
 
-void HLE_0D61FC9FAAC9FCAD(Engines::Maxwell3D& maxwell3d, const std::vector<u32>& parameters) {
+void HLE_0D61FC9FAAC9FCAD(Engines::Maxwell3D& maxwell3d, std::span<const u32> parameters) {
     const u32 count = (maxwell3d.GetRegisterValue(0xD1B) & parameters[2]);
 
     maxwell3d.regs.vertex_buffer.first = parameters[3];
@@ -49,7 +49,7 @@ void HLE_0D61FC9FAAC9FCAD(Engines::Maxwell3D& maxwell3d, const std::vector<u32>&
     maxwell3d.mme_draw.current_mode = Engines::Maxwell3D::MMEDrawMode::Undefined;
 }
 
-void HLE_0217920100488FF7(Engines::Maxwell3D& maxwell3d, const std::vector<u32>& parameters) {
+void HLE_0217920100488FF7(Engines::Maxwell3D& maxwell3d, std::span<const u32> parameters) {
     const u32 instance_count = (maxwell3d.GetRegisterValue(0xD1B) & parameters[2]);
     const u32 element_base = parameters[4];
     const u32 base_instance = parameters[5];
@@ -102,7 +102,7 @@ HLEMacroImpl::~HLEMacroImpl() = default;
 HLEMacroImpl::HLEMacroImpl(Engines::Maxwell3D& maxwell3d_, HLEFunction func_)
     : maxwell3d{maxwell3d_}, func{func_} {}
 
-void HLEMacroImpl::Execute(const std::vector<u32>& parameters, u32 method) {
+void HLEMacroImpl::Execute(std::span<const u32> parameters, u32 method) {
     func(maxwell3d, parameters);
 }
 
@@ -22,18 +22,12 @@ MacroInterpreterImpl::MacroInterpreterImpl(Engines::Maxwell3D& maxwell3d_,
                                            const std::vector<u32>& code_)
     : maxwell3d{maxwell3d_}, code{code_} {}
 
-void MacroInterpreterImpl::Execute(const std::vector<u32>& params, u32 method) {
+void MacroInterpreterImpl::Execute(std::span<const u32> params, u32 method) {
     MICROPROFILE_SCOPE(MacroInterp);
     Reset();
 
     registers[1] = params[0];
-    num_parameters = params.size();
-
-    if (num_parameters > parameters_capacity) {
-        parameters_capacity = num_parameters;
-        parameters = std::make_unique<u32[]>(num_parameters);
-    }
-    std::memcpy(parameters.get(), params.data(), num_parameters * sizeof(u32));
+    parameters = params;
 
     // Execute the code until we hit an exit condition.
     bool keep_executing = true;
@@ -42,7 +36,7 @@ void MacroInterpreterImpl::Execute(const std::vector<u32>& params, u32 method) {
     }
 
     // Assert the the macro used all the input parameters
-    ASSERT(next_parameter_index == num_parameters);
+    ASSERT(next_parameter_index == parameters.size());
 }
 
 void MacroInterpreterImpl::Reset() {
@@ -50,7 +44,7 @@ void MacroInterpreterImpl::Reset() {
     pc = 0;
     delayed_pc = {};
     method_address.raw = 0;
-    num_parameters = 0;
+    parameters = {};
     // The next parameter index starts at 1, because $r1 already has the value of the first
     // parameter.
     next_parameter_index = 1;
@@ -280,7 +274,7 @@ u32 MacroInterpreterImpl::Read(u32 method) const {
 }
 
 u32 MacroInterpreterImpl::FetchParameter() {
-    ASSERT(next_parameter_index < num_parameters);
+    ASSERT(next_parameter_index < parameters.size());
     return parameters[next_parameter_index++];
 }
 
@@ -5,6 +5,7 @@
 #pragma once
 #include <array>
 #include <optional>
+#include <span>
 #include <vector>
 #include "common/bit_field.h"
 #include "common/common_types.h"
@@ -29,7 +30,7 @@ private:
 class MacroInterpreterImpl : public CachedMacro {
 public:
     explicit MacroInterpreterImpl(Engines::Maxwell3D& maxwell3d_, const std::vector<u32>& code_);
-    void Execute(const std::vector<u32>& params, u32 method) override;
+    void Execute(std::span<const u32> params, u32 method) override;
 
 private:
     /// Resets the execution engine state, zeroing registers, etc.
@@ -88,15 +89,13 @@ private:
     /// Method address to use for the next Send instruction.
     Macro::MethodAddress method_address = {};
 
-    /// Input parameters of the current macro.
-    std::unique_ptr<u32[]> parameters;
-    std::size_t num_parameters = 0;
-    std::size_t parameters_capacity = 0;
+    /// Input parameters of the current macro, read in place from the command buffer.
+    std::span<const u32> parameters;
     /// Index of the next parameter that will be fetched by the 'parm' instruction.
     u32 next_parameter_index = 0;
 
     bool carry_flag = false;
-    const std::vector<u32>& code;
+    const std::vector<u32> code;
 };
 
 } // namespace Tegra
@@ -42,7 +42,7 @@ MacroJITx64Impl::MacroJITx64Impl(Engines::Maxwell3D& maxwell3d_, const std::vect
 
 MacroJITx64Impl::~MacroJITx64Impl() = default;
 
-void MacroJITx64Impl::Execute(const std::vector<u32>& parameters, u32 method) {
+void MacroJITx64Impl::Execute(std::span<const u32> parameters, u32 method) {
     MICROPROFILE_SCOPE(MacroJitExecute);
     ASSERT_OR_EXECUTE(program != nullptr, { return; });
     JITState state{};
@@ -186,19 +186,22 @@ void MacroJITx64Impl::Compile_AddImmediate(Macro::Opcode opcode) {
             const auto next = *next_opcode;
             if (next.result_operation == Macro::ResultOperation::MoveAndSetMethod &&
                 opcode.dst == next.dst) {
+                Optimizer_SetKnownRegister(opcode.dst, std::nullopt);
                 return;
             }
         }
     }
-    if (optimizer.zero_reg_skip && opcode.src_a == 0) {
-        if (opcode.immediate == 0) {
+    std::optional<u32> result_value;
+    if (const auto src_a = Optimizer_GetKnownRegister(opcode.src_a)) {
+        result_value = *src_a + static_cast<u32>(opcode.immediate.Value());
+        if (*result_value == 0) {
             xor_(RESULT, RESULT);
         } else {
-            mov(RESULT, opcode.immediate);
+            mov(RESULT, *result_value);
         }
     } else {
         auto result = Compile_GetRegister(opcode.src_a, RESULT);
-        if (opcode.immediate > 2) {
+        if (opcode.immediate > 1) {
             add(result, opcode.immediate);
         } else if (opcode.immediate == 1) {
             inc(result);
@@ -206,7 +209,7 @@ void MacroJITx64Impl::Compile_AddImmediate(Macro::Opcode opcode) {
             sub(result, opcode.immediate * -1);
         }
     }
-    Compile_ProcessResult(opcode.result_operation, opcode.dst);
+    Compile_ProcessResult(opcode.result_operation, opcode.dst, result_value);
 }
 
 void MacroJITx64Impl::Compile_ExtractInsert(Macro::Opcode opcode) {
@@ -274,15 +277,22 @@ void MacroJITx64Impl::Compile_ExtractShiftLeftRegister(Macro::Opcode opcode) {
 }
 
 void MacroJITx64Impl::Compile_Read(Macro::Opcode opcode) {
-    if (optimizer.zero_reg_skip && opcode.src_a == 0) {
-        if (opcode.immediate == 0) {
-            xor_(RESULT, RESULT);
-        } else {
-            mov(RESULT, opcode.immediate);
-        }
+    const auto src_a = Optimizer_GetKnownRegister(opcode.src_a);
+    const u32 index = src_a.value_or(0) + static_cast<u32>(opcode.immediate.Value());
+    if (src_a && index < Engines::Maxwell3D::Regs::NUM_REGS) {
+        // The register read is known while compiling, load it without computing its address
+        mov(rax, qword[STATE]);
+        mov(RESULT, dword[rax + offsetof(Engines::Maxwell3D, regs) +
+                          offsetof(Engines::Maxwell3D::Regs, reg_array) + index * sizeof(u32)]);
+        Compile_ProcessResult(opcode.result_operation, opcode.dst);
+        return;
+    }
+
+    if (src_a) {
+        mov(RESULT, index);
     } else {
         auto result = Compile_GetRegister(opcode.src_a, RESULT);
-        if (opcode.immediate > 2) {
+        if (opcode.immediate > 1) {
             add(result, opcode.immediate);
         } else if (opcode.immediate == 1) {
             inc(result);
@@ -395,9 +405,10 @@ void Tegra::MacroJITx64Impl::Compile_Branch(Macro::Opcode opcode) {
 void Tegra::MacroJITx64Impl::Optimizer_ScanFlags() {
     optimizer.can_skip_carry = true;
     optimizer.has_delayed_pc = false;
-    for (auto raw_op : code) {
+    branch_targets.assign(code.size(), false);
+    for (std::size_t i = 0; i < code.size(); i++) {
         Macro::Opcode op{};
-        op.raw = raw_op;
+        op.raw = code[i];
 
         if (op.operation == Macro::Operation::ALU) {
             // Scan for any ALU operations which actually use the carry flag, if they don't exist in
@@ -412,10 +423,35 @@ void Tegra::MacroJITx64Impl::Optimizer_ScanFlags() {
             if (!op.branch_annul) {
                 optimizer.has_delayed_pc = true;
             }
+            const s64 target = static_cast<s64>(i) + op.immediate;
+            if (target >= 0 && target < static_cast<s64>(code.size())) {
+                branch_targets[static_cast<std::size_t>(target)] = true;
+            }
         }
     }
 }
 
+std::optional<u32> MacroJITx64Impl::Optimizer_GetKnownRegister(u32 index) const {
+    if (index == 0) {
+        // Register 0 is always zero
+        return optimizer.zero_reg_skip ? std::optional<u32>{0} : std::nullopt;
+    }
+    if (!optimizer.fold_known_registers) {
+        return std::nullopt;
+    }
+    return known_registers[index];
+}
+
+void MacroJITx64Impl::Optimizer_SetKnownRegister(u32 index, std::optional<u32> value) {
+    if (index != 0) {
+        known_registers[index] = value;
+    }
+}
+
+void MacroJITx64Impl::Optimizer_ForgetKnownRegisters() {
+    known_registers.fill(std::nullopt);
+}
+
 void MacroJITx64Impl::Compile() {
     MICROPROFILE_SCOPE(MacroJitCompile);
     labels.fill(Xbyak::Label());
@@ -441,12 +477,20 @@ void MacroJITx64Impl::Compile() {
     // one if our register isn't "dirty"
     optimizer.optimize_for_method_move = true;
 
+    // Registers assigned from immediates are known until the code branches, fold their values
+    // into the instructions using them. Reads of registers known this way load them directly.
+    optimizer.fold_known_registers = true;
+
     // Enable run-time assertions in JITted code
     optimizer.enable_asserts = false;
 
     // Check to see if we can skip emitting certain instructions
     Optimizer_ScanFlags();
 
+    // Every register but the first parameter starts zeroed
+    known_registers.fill(0);
+    known_registers[1] = std::nullopt;
+
     const u32 op_count = static_cast<u32>(code.size());
     for (u32 i = 0; i < op_count; i++) {
         if (i < op_count - 1) {
@@ -456,7 +500,14 @@ void MacroJITx64Impl::Compile() {
             next_opcode = {};
         }
         pc = i;
+        if (branch_targets[i]) {
+            Optimizer_ForgetKnownRegisters();
+        }
+        const auto opcode = GetOpCode();
         Compile_NextInstruction();
+        if (opcode.operation == Macro::Operation::Branch) {
+            Optimizer_ForgetKnownRegisters();
+        }
     }
 
     L(end_of_code);
@@ -541,9 +592,12 @@ Xbyak::Reg32 Tegra::MacroJITx64Impl::Compile_FetchParameter() {
 }
 
 Xbyak::Reg32 MacroJITx64Impl::Compile_GetRegister(u32 index, Xbyak::Reg32 dst) {
-    if (index == 0) {
+    const auto value = index != 0 ? Optimizer_GetKnownRegister(index) : std::nullopt;
+    if (index == 0 || value == 0u) {
         // Register 0 is always zero
         xor_(dst, dst);
+    } else if (value) {
+        mov(dst, *value);
     } else {
         mov(dst, dword[STATE + offsetof(JITState, registers) + index * sizeof(u32)]);
     }
@@ -551,52 +605,55 @@ Xbyak::Reg32 MacroJITx64Impl::Compile_GetRegister(u32 index, Xbyak::Reg32 dst) {
     return dst;
 }
 
-void MacroJITx64Impl::Compile_ProcessResult(Macro::ResultOperation operation, u32 reg) {
-    const auto SetRegister = [this](u32 reg_index, const Xbyak::Reg32& result) {
+void MacroJITx64Impl::Compile_ProcessResult(Macro::ResultOperation operation, u32 reg,
+                                            std::optional<u32> result_value) {
+    const auto SetRegister = [this](u32 reg_index, const Xbyak::Reg32& result,
+                                    std::optional<u32> value) {
         // Register 0 is supposed to always return 0. NOP is implemented as a store to the zero
         // register.
         if (reg_index == 0) {
             return;
         }
+        Optimizer_SetKnownRegister(reg_index, value);
         mov(dword[STATE + offsetof(JITState, registers) + reg_index * sizeof(u32)], result);
     };
     const auto SetMethodAddress = [this](const Xbyak::Reg32& reg32) { mov(METHOD_ADDRESS, reg32); };
 
     switch (operation) {
     case Macro::ResultOperation::IgnoreAndFetch:
-        SetRegister(reg, Compile_FetchParameter());
+        SetRegister(reg, Compile_FetchParameter(), std::nullopt);
         break;
     case Macro::ResultOperation::Move:
-        SetRegister(reg, RESULT);
+        SetRegister(reg, RESULT, result_value);
         break;
     case Macro::ResultOperation::MoveAndSetMethod:
-        SetRegister(reg, RESULT);
+        SetRegister(reg, RESULT, result_value);
         SetMethodAddress(RESULT);
         break;
     case Macro::ResultOperation::FetchAndSend:
         // Fetch parameter and send result.
-        SetRegister(reg, Compile_FetchParameter());
+        SetRegister(reg, Compile_FetchParameter(), std::nullopt);
         Compile_Send(RESULT);
         break;
     case Macro::ResultOperation::MoveAndSend:
         // Move and send result.
-        SetRegister(reg, RESULT);
+        SetRegister(reg, RESULT, result_value);
         Compile_Send(RESULT);
         break;
     case Macro::ResultOperation::FetchAndSetMethod:
         // Fetch parameter and use result as Method Address.
-        SetRegister(reg, Compile_FetchParameter());
+        SetRegister(reg, Compile_FetchParameter(), std::nullopt);
         SetMethodAddress(RESULT);
         break;
     case Macro::ResultOperation::MoveAndSetMethodFetchAndSend:
         // Move result and use as Method Address, then fetch and send parameter.
-        SetRegister(reg, RESULT);
+        SetRegister(reg, RESULT, result_value);
         SetMethodAddress(RESULT);
         Compile_Send(Compile_FetchParameter());
         break;
     case Macro::ResultOperation::MoveAndSetMethodSend:
         // Move result and use as Method Address, then send bits 12:17 of result.
-        SetRegister(reg, RESULT);
+        SetRegister(reg, RESULT, result_value);
         SetMethodAddress(RESULT);
         shr(RESULT, 12);
         and_(RESULT, 0b111111);
@@ -6,6 +6,9 @@
 
 #include <array>
 #include <bitset>
+#include <optional>
+#include <span>
+#include <vector>
 #include <xbyak.h>
 #include "common/bit_field.h"
 #include "common/common_types.h"
@@ -37,7 +40,7 @@ public:
     explicit MacroJITx64Impl(Engines::Maxwell3D& maxwell3d_, const std::vector<u32>& code_);
     ~MacroJITx64Impl();
 
-    void Execute(const std::vector<u32>& parameters, u32 method) override;
+    void Execute(std::span<const u32> parameters, u32 method) override;
 
     void Compile_ALU(Macro::Opcode opcode);
     void Compile_AddImmediate(Macro::Opcode opcode);
@@ -50,13 +53,21 @@ public:
 private:
     void Optimizer_ScanFlags();
 
+    /// Returns the value of a macro register when it's known while compiling.
+    std::optional<u32> Optimizer_GetKnownRegister(u32 index) const;
+    void Optimizer_SetKnownRegister(u32 index, std::optional<u32> value);
+    void Optimizer_ForgetKnownRegisters();
+
     void Compile();
     bool Compile_NextInstruction();
 
     Xbyak::Reg32 Compile_FetchParameter();
     Xbyak::Reg32 Compile_GetRegister(u32 index, Xbyak::Reg32 dst);
 
-    void Compile_ProcessResult(Macro::ResultOperation operation, u32 reg);
+    /// Stores the result to the register, result_value is the result when it's known while
+    /// compiling.
+    void Compile_ProcessResult(Macro::ResultOperation operation, u32 reg,
+                               std::optional<u32> result_value = std::nullopt);
     void Compile_Send(Xbyak::Reg32 value);
 
     Macro::Opcode GetOpCode() const;
@@ -76,10 +87,16 @@ private:
         bool zero_reg_skip{};
         bool skip_dummy_addimmediate{};
         bool optimize_for_method_move{};
+        bool fold_known_registers{};
         bool enable_asserts{};
     };
     OptimizerState optimizer{};
 
+    /// Values the macro registers hold at the instruction being compiled, when they're known
+    std::array<std::optional<u32>, Macro::NUM_MACRO_REGISTERS> known_registers{};
+    /// Instructions reached from a branch, what is known about the registers is lost there
+    std::vector<bool> branch_targets;
+
     std::optional<Macro::Opcode> next_opcode{};
     ProgramType program{nullptr};
 
@@ -91,7 +108,7 @@ private:
     u32 pc{};
     std::optional<u32> delayed_pc;
 
-    const std::vector<u32>& code;
+    const std::vector<u32> code;
     Engines::Maxwell3D& maxwell3d;
 };
 
@@ -10,6 +10,7 @@
 #include "core/hle/kernel/k_process.h"
 #include "core/memory.h"
 #include "video_core/gpu.h"
+#include "video_core/gpu_trace.h"
 #include "video_core/memory_manager.h"
 #include "video_core/rasterizer_interface.h"
 #include "video_core/renderer_base.h"
@@ -39,6 +40,9 @@ GPUVAddr MemoryManager::UpdateRange(GPUVAddr gpu_addr, PageEntry page_entry, std
 }
 
 GPUVAddr MemoryManager::Map(VAddr cpu_addr, GPUVAddr gpu_addr, std::size_t size) {
+    if (trace_writer) {
+        trace_writer->RecordMap(gpu_addr, cpu_addr, size);
+    }
     const auto it = std::ranges::lower_bound(map_ranges, gpu_addr, {}, &MapRange::first);
     if (it != map_ranges.end() && it->first == gpu_addr) {
         it->second = size;
@@ -74,6 +78,9 @@ void MemoryManager::Unmap(GPUVAddr gpu_addr, std::size_t size) {
     ASSERT(cpu_addr);
 
     rasterizer->UnmapMemory(*cpu_addr, size);
+    if (trace_writer) {
+        trace_writer->RecordUnmap(gpu_addr, size);
+    }
 
     UpdateRange(gpu_addr, PageEntry::State::Unmapped, size);
 }
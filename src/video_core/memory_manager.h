@@ -20,6 +20,8 @@ class System;
 
 namespace Tegra {
 
+class GPUTraceWriter;
+
 class PageEntry final {
 public:
     enum class State : u32 {
@@ -74,6 +76,11 @@ public:
     /// Binds a renderer to the memory manager.
     void BindRasterizer(VideoCore::RasterizerInterface* rasterizer);
 
+    /// Records every map and unmap into the given trace, nullptr disables it.
+    void BindTraceWriter(GPUTraceWriter* writer) {
+        trace_writer = writer;
+    }
+
     [[nodiscard]] std::optional<VAddr> GpuToCpuAddress(GPUVAddr addr) const;
 
     template <typename T>
@@ -153,6 +160,8 @@ private:
 
     VideoCore::RasterizerInterface* rasterizer = nullptr;
 
+    GPUTraceWriter* trace_writer = nullptr;
+
     std::vector<PageEntry> page_table;
 
     using MapRange = std::pair<GPUVAddr, size_t>;
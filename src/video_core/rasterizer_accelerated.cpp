@@ -2,7 +2,9 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include <atomic>
+#include <memory>
 
 #include "common/assert.h"
 #include "common/common_types.h"
@@ -16,48 +18,78 @@ using namespace Core::Memory;
 
 RasterizerAccelerated::RasterizerAccelerated(Memory& cpu_memory_) : cpu_memory{cpu_memory_} {}
 
-RasterizerAccelerated::~RasterizerAccelerated() = default;
+RasterizerAccelerated::~RasterizerAccelerated() {
+    for (std::atomic<CacheBlock*>& block : cached_blocks) {
+        delete block.load(std::memory_order_relaxed);
+    }
+}
 
 void RasterizerAccelerated::UpdatePagesCachedCount(VAddr addr, u64 size, int delta) {
+    ASSERT_MSG(delta == 1 || delta == -1, "Delta must be 1 or -1!");
+
     u64 uncache_begin = 0;
     u64 cache_begin = 0;
     u64 uncache_bytes = 0;
     u64 cache_bytes = 0;
 
-    std::atomic_thread_fence(std::memory_order_acquire);
     const u64 page_end = Common::DivCeil(addr + size, PAGE_SIZE);
-    for (u64 page = addr >> PAGE_BITS; page != page_end; ++page) {
-        std::atomic_uint16_t& count = cached_pages.at(page >> 2).Count(page);
-
-        if (delta > 0) {
-            ASSERT_MSG(count.load(std::memory_order::relaxed) < UINT16_MAX, "Count may overflow!");
-        } else if (delta < 0) {
-            ASSERT_MSG(count.load(std::memory_order::relaxed) > 0, "Count may underflow!");
-        } else {
-            ASSERT_MSG(false, "Delta must be non-zero!");
+    u64 page = addr >> PAGE_BITS;
+    while (page != page_end) {
+        // Build a mask with a one on each counter of the word touched by this range
+        const u64 first_lane = page % PAGES_PER_WORD;
+        const u64 last_lane = std::min(PAGES_PER_WORD, first_lane + (page_end - page));
+        u64 increment = 0;
+        for (u64 lane = first_lane; lane < last_lane; ++lane) {
+            increment |= u64{1} << (lane * COUNT_BITS);
         }
+        // A carry or borrow out of a lane would corrupt the neighbouring counter, so counters are
+        // validated before the word is updated. Saturated counters are left untouched.
+        std::atomic_uint64_t& word = CacheWord(page / PAGES_PER_WORD);
+        u64 old_counts = word.load(std::memory_order_relaxed);
+        u64 applied_increment;
+        do {
+            applied_increment = increment;
+            for (u64 lane = first_lane; lane < last_lane; ++lane) {
+                const u64 old_count = (old_counts >> (lane * COUNT_BITS)) & COUNT_MASK;
+                if (delta > 0 ? old_count == COUNT_MASK : old_count == 0) {
+                    applied_increment &= ~(u64{1} << (lane * COUNT_BITS));
+                }
+            }
+        } while (!word.compare_exchange_weak(old_counts,
+                                             delta > 0 ? old_counts + applied_increment
+                                                       : old_counts - applied_increment,
+                                             std::memory_order_acq_rel,
+                                             std::memory_order_relaxed));
 
-        // Adds or subtracts 1, as count is a unsigned 8-bit value
-        count.fetch_add(static_cast<u16>(delta), std::memory_order_release);
+        for (u64 lane = first_lane; lane < last_lane; ++lane, ++page) {
+            const u64 old_count = (old_counts >> (lane * COUNT_BITS)) & COUNT_MASK;
+            const bool is_applied = ((applied_increment >> (lane * COUNT_BITS)) & 1) != 0;
+            if (delta > 0) {
+                ASSERT_MSG(is_applied, "Count may overflow!");
+            } else {
+                ASSERT_MSG(is_applied, "Count may underflow!");
+            }
+            const u64 count = !is_applied ? old_count : delta > 0 ? old_count + 1 : old_count - 1;
 
-        // Assume delta is either -1 or 1
-        if (count.load(std::memory_order::relaxed) == 0) {
-            if (uncache_bytes == 0) {
-                uncache_begin = page;
+            if (count == 0) {
+                if (uncache_bytes == 0) {
+                    uncache_begin = page;
+                }
+                uncache_bytes += PAGE_SIZE;
+            } else if (uncache_bytes > 0) {
+                cpu_memory.RasterizerMarkRegionCached(uncache_begin << PAGE_BITS, uncache_bytes,
+                                                      false);
+                uncache_bytes = 0;
             }
-            uncache_bytes += PAGE_SIZE;
-        } else if (uncache_bytes > 0) {
-            cpu_memory.RasterizerMarkRegionCached(uncache_begin << PAGE_BITS, uncache_bytes, false);
-            uncache_bytes = 0;
-        }
-        if (count.load(std::memory_order::relaxed) == 1 && delta > 0) {
-            if (cache_bytes == 0) {
-                cache_begin = page;
+            if (count == 1 && delta > 0) {
+                if (cache_bytes == 0) {
+                    cache_begin = page;
+                }
+                cache_bytes += PAGE_SIZE;
+            } else if (cache_bytes > 0) {
+                cpu_memory.RasterizerMarkRegionCached(cache_begin << PAGE_BITS, cache_bytes, true);
+                cache_bytes = 0;
             }
-            cache_bytes += PAGE_SIZE;
-        } else if (cache_bytes > 0) {
-            cpu_memory.RasterizerMarkRegionCached(cache_begin << PAGE_BITS, cache_bytes, true);
-            cache_bytes = 0;
         }
     }
     if (uncache_bytes > 0) {
@@ -68,4 +100,18 @@ void RasterizerAccelerated::UpdatePagesCachedCount(VAddr addr, u64 size, int del
     }
 }
 
+std::atomic_uint64_t& RasterizerAccelerated::CacheWord(u64 word_index) {
+    std::atomic<CacheBlock*>& block_slot = cached_blocks.at(word_index / WORDS_PER_BLOCK);
+    CacheBlock* block = block_slot.load(std::memory_order_acquire);
+    if (!block) {
+        // Blocks are only committed the first time a page inside them is cached
+        auto new_block = std::make_unique<CacheBlock>();
+        if (block_slot.compare_exchange_strong(block, new_block.get(),
+                                               std::memory_order_acq_rel)) {
+            block = new_block.release();
+        }
+    }
+    return (*block)[word_index % WORDS_PER_BLOCK];
+}
+
 } // namespace VideoCore
@@ -25,24 +25,22 @@ public:
     void UpdatePagesCachedCount(VAddr addr, u64 size, int delta) override;
 
 private:
-    class CacheEntry final {
-    public:
-        CacheEntry() = default;
-
-        std::atomic_uint16_t& Count(std::size_t page) {
-            return values[page & 3];
-        }
-
-        const std::atomic_uint16_t& Count(std::size_t page) const {
-            return values[page & 3];
-        }
-
-    private:
-        std::array<std::atomic_uint16_t, 4> values{};
-    };
-    static_assert(sizeof(CacheEntry) == 8, "CacheEntry should be 8 bytes!");
-
-    std::array<CacheEntry, 0x1000000> cached_pages;
+    /// Number of bits used by each page counter
+    static constexpr u64 COUNT_BITS = 16;
+    static constexpr u64 COUNT_MASK = (u64{1} << COUNT_BITS) - 1;
+    /// Page counters are packed in 64-bit words to update runs of pages with a single atomic
+    static constexpr u64 PAGES_PER_WORD = 64 / COUNT_BITS;
+    /// Words in a lazily allocated block, each block tracks 64 MiB of guest memory
+    static constexpr u64 WORDS_PER_BLOCK = 0x1000;
+    static constexpr u64 NUM_BLOCKS = 0x1000000 / WORDS_PER_BLOCK;
+
+    using CacheBlock = std::array<std::atomic_uint64_t, WORDS_PER_BLOCK>;
+
+    /// Returns the word holding the counters of the given word index, allocating its block if
+    /// it doesn't exist yet
+    std::atomic_uint64_t& CacheWord(u64 word_index);
+
+    std::array<std::atomic<CacheBlock*>, NUM_BLOCKS> cached_blocks{};
     Core::Memory::Memory& cpu_memory;
 };
 
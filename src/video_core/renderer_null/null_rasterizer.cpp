@@ -0,0 +1,101 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include "video_core/gpu.h"
+#include "video_core/memory_manager.h"
+#include "video_core/renderer_null/null_rasterizer.h"
+
+namespace Null {
+
+namespace {
+
+/// Offset of the timestamp in a long query result
+constexpr GPUVAddr TIMESTAMP_OFFSET = 8;
+
+} // Anonymous namespace
+
+RasterizerNull::RasterizerNull(Tegra::GPU& gpu_) : gpu{gpu_}, gpu_memory{gpu.MemoryManager()} {}
+
+RasterizerNull::~RasterizerNull() = default;
+
+void RasterizerNull::Draw(bool is_indexed, bool is_instanced) {}
+
+void RasterizerNull::Clear() {}
+
+void RasterizerNull::DispatchCompute(GPUVAddr code_addr) {}
+
+void RasterizerNull::ResetCounter(VideoCore::QueryType type) {}
+
+void RasterizerNull::Query(GPUVAddr gpu_addr, VideoCore::QueryType type,
+                           std::optional<u64> timestamp) {
+    // Nothing is rasterized, so no samples ever pass
+    if (!gpu_memory.GpuToCpuAddress(gpu_addr)) {
+        return;
+    }
+    if (timestamp) {
+        gpu_memory.Write<u64>(gpu_addr, 0);
+        gpu_memory.Write<u64>(gpu_addr + TIMESTAMP_OFFSET, *timestamp);
+    } else {
+        gpu_memory.Write<u32>(gpu_addr, 0);
+    }
+}
+
+void RasterizerNull::BindGraphicsUniformBuffer(size_t stage, u32 index, GPUVAddr gpu_addr,
+                                               u32 size) {}
+
+void RasterizerNull::DisableGraphicsUniformBuffer(size_t stage, u32 index) {}
+
+void RasterizerNull::SignalSemaphore(GPUVAddr addr, u32 value) {
+    if (!gpu_memory.GpuToCpuAddress(addr)) {
+        return;
+    }
+    gpu_memory.Write<u32>(addr, value);
+}
+
+void RasterizerNull::SignalSyncPoint(u32 value) {
+    gpu.IncrementSyncPoint(value);
+}
+
+void RasterizerNull::ReleaseFences() {}
+
+void RasterizerNull::FlushAll() {}
+
+void RasterizerNull::FlushRegion(VAddr addr, u64 size) {}
+
+bool RasterizerNull::MustFlushRegion(VAddr addr, u64 size) {
+    return false;
+}
+
+void RasterizerNull::InvalidateRegion(VAddr addr, u64 size) {}
+
+void RasterizerNull::OnCPUWrite(VAddr addr, u64 size) {}
+
+void RasterizerNull::SyncGuestHost() {}
+
+void RasterizerNull::UnmapMemory(VAddr addr, u64 size) {}
+
+void RasterizerNull::FlushAndInvalidateRegion(VAddr addr, u64 size) {}
+
+void RasterizerNull::WaitForIdle() {}
+
+void RasterizerNull::FragmentBarrier() {}
+
+void RasterizerNull::TiledCacheBarrier() {}
+
+void RasterizerNull::FlushCommands() {}
+
+void RasterizerNull::TickFrame() {}
+
+bool RasterizerNull::AccelerateSurfaceCopy(const Tegra::Engines::Fermi2D::Surface& src,
+                                           const Tegra::Engines::Fermi2D::Surface& dst,
+                                           const Tegra::Engines::Fermi2D::Config& copy_config) {
+    return true;
+}
+
+bool RasterizerNull::AccelerateDisplay(const Tegra::FramebufferConfig& config,
+                                       VAddr framebuffer_addr, u32 pixel_stride) {
+    return true;
+}
+
+} // namespace Null
@@ -0,0 +1,65 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <optional>
+
+#include "common/common_types.h"
+#include "video_core/rasterizer_interface.h"
+
+namespace Tegra {
+class GPU;
+class MemoryManager;
+} // namespace Tegra
+
+namespace Null {
+
+/**
+ * Rasterizer that accepts every request without doing host GPU work.
+ * Nothing is cached on the host, so guest memory is always up to date and CPU writes never need
+ * to be tracked. Fences, semaphores and queries are signaled immediately so the guest makes
+ * progress.
+ */
+class RasterizerNull final : public VideoCore::RasterizerInterface {
+public:
+    explicit RasterizerNull(Tegra::GPU& gpu_);
+    ~RasterizerNull() override;
+
+    void Draw(bool is_indexed, bool is_instanced) override;
+    void Clear() override;
+    void DispatchCompute(GPUVAddr code_addr) override;
+    void ResetCounter(VideoCore::QueryType type) override;
+    void Query(GPUVAddr gpu_addr, VideoCore::QueryType type,
+               std::optional<u64> timestamp) override;
+    void BindGraphicsUniformBuffer(size_t stage, u32 index, GPUVAddr gpu_addr, u32 size) override;
+    void DisableGraphicsUniformBuffer(size_t stage, u32 index) override;
+    void SignalSemaphore(GPUVAddr addr, u32 value) override;
+    void SignalSyncPoint(u32 value) override;
+    void ReleaseFences() override;
+    void FlushAll() override;
+    void FlushRegion(VAddr addr, u64 size) override;
+    bool MustFlushRegion(VAddr addr, u64 size) override;
+    void InvalidateRegion(VAddr addr, u64 size) override;
+    void OnCPUWrite(VAddr addr, u64 size) override;
+    void SyncGuestHost() override;
+    void UnmapMemory(VAddr addr, u64 size) override;
+    void FlushAndInvalidateRegion(VAddr addr, u64 size) override;
+    void WaitForIdle() override;
+    void FragmentBarrier() override;
+    void TiledCacheBarrier() override;
+    void FlushCommands() override;
+    void TickFrame() override;
+    bool AccelerateSurfaceCopy(const Tegra::Engines::Fermi2D::Surface& src,
+                               const Tegra::Engines::Fermi2D::Surface& dst,
+                               const Tegra::Engines::Fermi2D::Config& copy_config) override;
+    bool AccelerateDisplay(const Tegra::FramebufferConfig& config, VAddr framebuffer_addr,
+                           u32 pixel_stride) override;
+
+private:
+    Tegra::GPU& gpu;
+    Tegra::MemoryManager& gpu_memory;
+};
+
+} // namespace Null
@@ -0,0 +1,41 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <memory>
+
+#include "video_core/renderer_base.h"
+#include "video_core/renderer_null/null_rasterizer.h"
+
+namespace Core::Frontend {
+class EmuWindow;
+class GraphicsContext;
+} // namespace Core::Frontend
+
+namespace Tegra {
+class GPU;
+}
+
+namespace Null {
+
+/// Renderer without a host graphics API, used to measure the CPU side of emulation.
+class RendererNull final : public VideoCore::RendererBase {
+public:
+    explicit RendererNull(Core::Frontend::EmuWindow& emu_window_, Tegra::GPU& gpu_,
+                          std::unique_ptr<Core::Frontend::GraphicsContext> context_);
+    ~RendererNull() override;
+
+    void SwapBuffers(const Tegra::FramebufferConfig* framebuffer) override;
+
+    VideoCore::RasterizerInterface* ReadRasterizer() override {
+        return &rasterizer;
+    }
+
+private:
+    Tegra::GPU& gpu;
+    RasterizerNull rasterizer;
+};
+
+} // namespace Null
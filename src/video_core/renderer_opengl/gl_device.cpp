@@ -191,6 +191,20 @@ bool IsASTCSupported() {
     return true;
 }
 
+/// Returns the size of the dedicated video memory in bytes, or zero when it can't be queried
+u64 QueryDeviceLocalMemory() {
+    if (GLAD_GL_NVX_gpu_memory_info) {
+        return GetInteger<u64>(GL_GPU_MEMORY_INFO_DEDICATED_VIDMEM_NVX) * 1024;
+    }
+    if (GLAD_GL_ATI_meminfo) {
+        // Only the free memory is reported, this is queried before the emulator allocates much
+        std::array<GLint, 4> free_memory{};
+        glGetIntegerv(GL_TEXTURE_FREE_MEMORY_ATI, free_memory.data());
+        return static_cast<u64>(free_memory[0]) * 1024;
+    }
+    return 0;
+}
+
 [[nodiscard]] bool IsDebugToolAttached(std::span<const std::string_view> extensions) {
     const bool nsight = std::getenv("NVTX_INJECTION64_PATH") || std::getenv("NSIGHT_LAUNCHED");
     return nsight || HasExtension(extensions, "GL_EXT_debug_tool");
@@ -246,6 +260,7 @@ Device::Device() {
     has_vertex_buffer_unified_memory = GLAD_GL_NV_vertex_buffer_unified_memory;
     has_debugging_tool_attached = IsDebugToolAttached(extensions);
     has_depth_buffer_float = HasExtension(extensions, "GL_NV_depth_buffer_float");
+    device_local_memory = QueryDeviceLocalMemory();
 
     // At the moment of writing this, only Nvidia's driver optimizes BufferSubData on exclusive
     // uniform buffers as "push constants"
@@ -265,6 +280,7 @@ Device::Device() {
     LOG_INFO(Render_OpenGL, "Renderer_PreciseBug: {}", has_precise_bug);
     LOG_INFO(Render_OpenGL, "Renderer_BrokenTextureViewFormats: {}",
              has_broken_texture_view_formats);
+    LOG_INFO(Render_OpenGL, "Renderer_DeviceLocalMemory: {} MiB", device_local_memory >> 20);
 
     if (Settings::values.use_assembly_shaders.GetValue() && !use_assembly_shaders) {
         LOG_ERROR(Render_OpenGL, "Assembly shaders enabled but not supported");
@@ -126,6 +126,11 @@ public:
         return has_depth_buffer_float;
     }
 
+    /// Returns the size of the dedicated video memory in bytes, zero when it's unknown.
+    u64 GetDeviceLocalMemory() const {
+        return device_local_memory;
+    }
+
 private:
     static bool TestVariableAoffi();
     static bool TestPreciseBug();
@@ -137,6 +142,7 @@ private:
     u32 max_vertex_attributes{};
     u32 max_varyings{};
     u32 max_compute_shared_memory_size{};
+    u64 device_local_memory{};
     bool has_warp_intrinsics{};
     bool has_shader_ballot{};
     bool has_vertex_viewport_layer{};
@@ -611,6 +611,10 @@ bool TextureCacheRuntime::HasNativeASTC() const noexcept {
     return device.HasASTC();
 }
 
+u64 TextureCacheRuntime::GetDeviceLocalMemory() const noexcept {
+    return device.GetDeviceLocalMemory();
+}
+
 TextureCacheRuntime::StagingBuffers::StagingBuffers(GLenum storage_flags_, GLenum map_flags_)
     : storage_flags{storage_flags_}, map_flags{map_flags_} {}
 
@@ -95,6 +95,8 @@ public:
 
     bool HasNativeASTC() const noexcept;
 
+    u64 GetDeviceLocalMemory() const noexcept;
+
 private:
     struct StagingBuffers {
         explicit StagingBuffers(GLenum storage_flags_, GLenum map_flags_);
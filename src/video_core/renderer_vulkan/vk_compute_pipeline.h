@@ -20,7 +20,7 @@ public:
     explicit VKComputePipeline(const Device& device_, VKScheduler& scheduler_,
                                VKDescriptorPool& descriptor_pool_,
                                VKUpdateDescriptorQueue& update_descriptor_queue_,
-                               const SPIRVShader& shader_);
+                               const SPIRVShader& shader_, VkPipelineCache pipeline_cache);
     ~VKComputePipeline();
 
     VkDescriptorSet CommitDescriptorSet();
@@ -46,7 +46,7 @@ private:
 
     vk::ShaderModule CreateShaderModule(const std::vector<u32>& code) const;
 
-    vk::Pipeline CreatePipeline() const;
+    vk::Pipeline CreatePipeline(VkPipelineCache pipeline_cache) const;
 
     const Device& device;
     VKScheduler& scheduler;
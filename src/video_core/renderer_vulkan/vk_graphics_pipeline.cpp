@@ -99,14 +99,16 @@ VKGraphicsPipeline::VKGraphicsPipeline(const Device& device_, VKScheduler& sched
                                        VKUpdateDescriptorQueue& update_descriptor_queue_,
                                        const GraphicsPipelineCacheKey& key,
                                        vk::Span<VkDescriptorSetLayoutBinding> bindings,
-                                       const SPIRVProgram& program, u32 num_color_buffers)
+                                       const SPIRVProgram& program, u32 num_color_buffers,
+                                       VkPipelineCache pipeline_cache)
     : device{device_}, scheduler{scheduler_}, cache_key{key}, hash{cache_key.Hash()},
       descriptor_set_layout{CreateDescriptorSetLayout(bindings)},
       descriptor_allocator{descriptor_pool_, *descriptor_set_layout},
       update_descriptor_queue{update_descriptor_queue_}, layout{CreatePipelineLayout()},
       descriptor_template{CreateDescriptorUpdateTemplate(program)},
       modules(CreateShaderModules(program)),
-      pipeline(CreatePipeline(program, cache_key.renderpass, num_color_buffers)) {}
+      pipeline(
+          CreatePipeline(program, cache_key.renderpass, num_color_buffers, pipeline_cache)) {}
 
 VKGraphicsPipeline::~VKGraphicsPipeline() = default;
 
@@ -203,7 +205,8 @@ std::vector<vk::ShaderModule> VKGraphicsPipeline::CreateShaderModules(
 
 vk::Pipeline VKGraphicsPipeline::CreatePipeline(const SPIRVProgram& program,
                                                 VkRenderPass renderpass,
-                                                u32 num_color_buffers) const {
+                                                u32 num_color_buffers,
+                                                VkPipelineCache pipeline_cache) const {
     const auto& state = cache_key.fixed_state;
     const auto& viewport_swizzles = state.viewport_swizzles;
 
@@ -458,7 +461,7 @@ vk::Pipeline VKGraphicsPipeline::CreatePipeline(const SPIRVProgram& program,
             stage_ci.pNext = &subgroup_size_ci;
         }
     }
-    return device.GetLogical().CreateGraphicsPipeline(VkGraphicsPipelineCreateInfo{
+    const VkGraphicsPipelineCreateInfo ci{
         .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
         .pNext = nullptr,
         .flags = 0,
@@ -478,7 +481,8 @@ vk::Pipeline VKGraphicsPipeline::CreatePipeline(const SPIRVProgram& program,
         .subpass = 0,
         .basePipelineHandle = nullptr,
         .basePipelineIndex = 0,
-    });
+    };
+    return device.GetLogical().CreateGraphicsPipeline(ci, pipeline_cache);
 }
 
 } // namespace Vulkan
@@ -54,7 +54,8 @@ public:
                                 VKUpdateDescriptorQueue& update_descriptor_queue_,
                                 const GraphicsPipelineCacheKey& key,
                                 vk::Span<VkDescriptorSetLayoutBinding> bindings,
-                                const SPIRVProgram& program, u32 num_color_buffers);
+                                const SPIRVProgram& program, u32 num_color_buffers,
+                                VkPipelineCache pipeline_cache);
     ~VKGraphicsPipeline();
 
     VkDescriptorSet CommitDescriptorSet();
@@ -83,7 +84,7 @@ private:
     std::vector<vk::ShaderModule> CreateShaderModules(const SPIRVProgram& program) const;
 
     vk::Pipeline CreatePipeline(const SPIRVProgram& program, VkRenderPass renderpass,
-                                u32 num_color_buffers) const;
+                                u32 num_color_buffers, VkPipelineCache pipeline_cache) const;
 
     const Device& device;
     VKScheduler& scheduler;
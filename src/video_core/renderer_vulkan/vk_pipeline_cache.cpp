@@ -3,13 +3,19 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <cstddef>
+#include <cstring>
 #include <memory>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 #include "common/bit_cast.h"
 #include "common/cityhash.h"
 #include "common/microprofile.h"
+#include "common/thread_worker.h"
 #include "core/core.h"
 #include "core/memory.h"
 #include "video_core/engines/kepler_compute.h"
@@ -23,6 +29,7 @@
 #include "video_core/renderer_vulkan/vk_pipeline_cache.h"
 #include "video_core/renderer_vulkan/vk_rasterizer.h"
 #include "video_core/renderer_vulkan/vk_scheduler.h"
+#include "video_core/renderer_vulkan/vk_texture_cache.h"
 #include "video_core/renderer_vulkan/vk_update_descriptor.h"
 #include "video_core/shader/compiler_settings.h"
 #include "video_core/shader/memory_util.h"
@@ -38,6 +45,7 @@ MICROPROFILE_DECLARE(Vulkan_PipelineCache);
 using Tegra::Engines::ShaderType;
 using VideoCommon::Shader::GetShaderAddress;
 using VideoCommon::Shader::GetShaderCode;
+using VideoCommon::Shader::GetUniqueIdentifier;
 using VideoCommon::Shader::KERNEL_MAIN_OFFSET;
 using VideoCommon::Shader::ProgramCode;
 using VideoCommon::Shader::STAGE_MAIN_OFFSET;
@@ -118,6 +126,59 @@ u32 FillDescriptorLayout(const ShaderEntries& entries,
     return binding;
 }
 
+Specialization MakeComputeSpecialization(u32 shared_memory_size,
+                                         const std::array<u32, 3>& workgroup_size) {
+    return Specialization{
+        .base_binding = 0,
+        .workgroup_size = workgroup_size,
+        .shared_memory_size = shared_memory_size,
+        .point_size = std::nullopt,
+        .enabled_attributes = {},
+        .attribute_types = {},
+        .ndc_minus_one_to_one = false,
+    };
+}
+
+/// Returns the SPIR-V code of each stage, leaving disabled stages empty
+std::vector<std::vector<u32>> ExtractSPIRV(const SPIRVProgram& program) {
+    std::vector<std::vector<u32>> spirv(program.size());
+    for (std::size_t stage = 0; stage < program.size(); ++stage) {
+        if (program[stage]) {
+            spirv[stage] = program[stage]->code;
+        }
+    }
+    return spirv;
+}
+
+/// Runs func for every index in [0, count) on the given workers and the calling thread
+template <typename Func>
+void ParallelFor(Common::ThreadWorker& workers, std::size_t num_workers, std::size_t count,
+                 Func&& func) {
+    // Indices are claimed dynamically so slow pipelines don't stall the other tasks. The calling
+    // thread runs them too, then waits for the queued tasks to release their references.
+    std::atomic<std::size_t> next_index{0};
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::size_t pending_tasks = std::min(num_workers, count);
+    const auto run_indices = [&] {
+        for (std::size_t index = next_index++; index < count; index = next_index++) {
+            func(index);
+        }
+    };
+    for (std::size_t task = 0; task < std::min(num_workers, count); ++task) {
+        workers.QueueWork([&] {
+            run_indices();
+            std::scoped_lock lock{mutex};
+            if (--pending_tasks == 0) {
+                cv.notify_one();
+            }
+        });
+    }
+    run_indices();
+    std::unique_lock lock{mutex};
+    cv.wait(lock, [&] { return pending_tasks == 0; });
+}
+
 } // Anonymous namespace
 
 std::size_t GraphicsPipelineCacheKey::Hash() const noexcept {
@@ -139,25 +200,207 @@ bool ComputePipelineCacheKey::operator==(const ComputePipelineCacheKey& rhs) con
 }
 
 Shader::Shader(Tegra::Engines::ConstBufferEngineInterface& engine_, ShaderType stage_,
-               GPUVAddr gpu_addr_, VAddr cpu_addr_, ProgramCode program_code_, u32 main_offset_)
-    : gpu_addr(gpu_addr_), program_code(std::move(program_code_)), registry(stage_, engine_),
+               GPUVAddr gpu_addr_, VAddr cpu_addr_, ProgramCode program_code_, u32 main_offset_,
+               u64 unique_identifier_)
+    : gpu_addr(gpu_addr_), stage(stage_), unique_identifier(unique_identifier_),
+      program_code(std::move(program_code_)), registry(stage_, engine_),
+      shader_ir(program_code, main_offset_, compiler_settings, registry),
+      entries(GenerateShaderEntries(shader_ir)) {}
+
+Shader::Shader(const ShaderDiskCacheEntry& entry, u32 main_offset_)
+    : stage(entry.type), unique_identifier(entry.unique_identifier), program_code(entry.code),
+      registry(entry.MakeRegistry()),
       shader_ir(program_code, main_offset_, compiler_settings, registry),
       entries(GenerateShaderEntries(shader_ir)) {}
 
 Shader::~Shader() = default;
 
+ShaderDiskCacheEntry Shader::MakeDiskCacheEntry() const {
+    ShaderDiskCacheEntry entry;
+    entry.type = stage;
+    entry.code = program_code;
+    entry.unique_identifier = unique_identifier;
+    entry.bound_buffer = registry.GetBoundBuffer();
+    if (stage == ShaderType::Compute) {
+        entry.compute_info = registry.GetComputeInfo();
+    } else {
+        entry.graphics_info = registry.GetGraphicsInfo();
+    }
+    entry.keys = registry.GetKeys();
+    entry.bound_samplers = registry.GetBoundSamplers();
+    entry.bindless_samplers = registry.GetBindlessSamplers();
+    return entry;
+}
+
 VKPipelineCache::VKPipelineCache(RasterizerVulkan& rasterizer_, Tegra::GPU& gpu_,
                                  Tegra::Engines::Maxwell3D& maxwell3d_,
                                  Tegra::Engines::KeplerCompute& kepler_compute_,
                                  Tegra::MemoryManager& gpu_memory_, const Device& device_,
                                  VKScheduler& scheduler_, VKDescriptorPool& descriptor_pool_,
-                                 VKUpdateDescriptorQueue& update_descriptor_queue_)
+                                 VKUpdateDescriptorQueue& update_descriptor_queue_,
+                                 TextureCacheRuntime& texture_cache_runtime_)
     : VideoCommon::ShaderCache<Shader>{rasterizer_}, gpu{gpu_}, maxwell3d{maxwell3d_},
       kepler_compute{kepler_compute_}, gpu_memory{gpu_memory_}, device{device_},
-      scheduler{scheduler_}, descriptor_pool{descriptor_pool_}, update_descriptor_queue{
-                                                                    update_descriptor_queue_} {}
+      scheduler{scheduler_}, descriptor_pool{descriptor_pool_},
+      update_descriptor_queue{update_descriptor_queue_},
+      texture_cache_runtime{texture_cache_runtime_}, disk_cache{device_},
+      driver_cache{CreateDriverCache({})},
+      save_worker{std::make_unique<Common::ThreadWorker>(1, "yuzu:PipelineCacheSaver")} {}
+
+VKPipelineCache::~VKPipelineCache() {
+    // Appends still queued are dropped, the full save below writes their pipelines too
+    save_worker.reset();
+    SavePrecompiled();
+}
+
+void VKPipelineCache::LoadDiskResources(u64 title_id, const std::atomic_bool& stop_loading,
+                                        const VideoCore::DiskResourceLoadCallback& callback) {
+    disk_cache.BindTitleID(title_id);
+    const std::optional transferable = disk_cache.LoadTransferable();
+    if (!transferable) {
+        return;
+    }
+    const auto& graphics_keys = transferable->graphics_pipelines;
+    const auto& compute_keys = transferable->compute_pipelines;
+    LOG_INFO(Render_Vulkan, "Total Shader Count: {}, Pipeline Count: {}",
+             transferable->shaders.size(), graphics_keys.size() + compute_keys.size());
+
+    precompiled = disk_cache.LoadPrecompiled();
+    if (!precompiled.driver_cache.empty()) {
+        // No pipelines have been built yet, it's safe to replace the driver cache here
+        driver_cache = CreateDriverCache(precompiled.driver_cache);
+        precompiled.driver_cache = {};
+    } else {
+        precompiled_altered = true;
+    }
+
+    const std::size_t total = transferable->shaders.size() + graphics_keys.size() +
+                              compute_keys.size();
+    if (callback) {
+        callback(VideoCore::LoadCallbackStage::Build, 0, total);
+    }
+
+    // Workers are shared by every phase, one less than the host threads to leave room for the
+    // calling thread
+    const std::size_t num_workers = std::max(std::thread::hardware_concurrency(), 2U) - 1;
+    Common::ThreadWorker workers(num_workers, "yuzu:PipelineBuilder");
+
+    std::mutex mutex;
+    std::size_t built = 0; // It doesn't have be atomic since it's used behind a mutex
+    std::unordered_map<u64, std::vector<std::vector<u32>>> new_spirv;
+    const auto report_progress = [&] {
+        if (callback) {
+            callback(VideoCore::LoadCallbackStage::Build, ++built, total);
+        }
+    };
+
+    ParallelFor(workers, num_workers, transferable->shaders.size(), [&](std::size_t index) {
+        if (stop_loading) {
+            return;
+        }
+        const ShaderDiskCacheEntry& entry = transferable->shaders[index];
+        const bool is_compute = entry.type == ShaderType::Compute;
+        const u32 main_offset = is_compute ? KERNEL_MAIN_OFFSET : STAGE_MAIN_OFFSET;
+        auto shader = std::make_unique<Shader>(entry, main_offset);
+
+        std::scoped_lock lock{mutex};
+        disk_shaders.emplace(entry.unique_identifier, std::move(shader));
+        report_progress();
+    });
+
+    // Render passes are owned by the texture cache runtime, resolve them outside of the workers
+    std::vector<VkRenderPass> renderpasses;
+    renderpasses.reserve(graphics_keys.size());
+    for (const GraphicsPipelineDiskKey& key : graphics_keys) {
+        renderpasses.push_back(texture_cache_runtime.GetRenderPass(key.renderpass));
+    }
+
+    const auto find_shader = [this](u64 unique_identifier) -> Shader* {
+        const auto it = disk_shaders.find(unique_identifier);
+        return it != disk_shaders.end() ? it->second.get() : nullptr;
+    };
+
+    ParallelFor(workers, num_workers, graphics_keys.size(), [&](std::size_t index) {
+        if (stop_loading) {
+            return;
+        }
+        const GraphicsPipelineDiskKey& key = graphics_keys[index];
+        std::array<Shader*, Maxwell::MaxShaderProgram> shaders{};
+        for (std::size_t stage = 0; stage < Maxwell::MaxShaderProgram; ++stage) {
+            const u64 unique_identifier = key.unique_identifiers[stage];
+            if (unique_identifier == 0) {
+                continue;
+            }
+            shaders[stage] = find_shader(unique_identifier);
+            if (!shaders[stage]) {
+                LOG_WARNING(Render_Vulkan, "Pipeline references a missing shader, skipping");
+                return;
+            }
+        }
+        const u64 hash = key.Hash();
+        const auto spirv_it = precompiled.spirv.find(hash);
+        const bool is_precompiled = spirv_it != precompiled.spirv.end() &&
+                                    spirv_it->second.size() == Maxwell::MaxShaderStage;
+        const auto [program, bindings] = DecompileShaders(
+            key.fixed_state, shaders, is_precompiled ? &spirv_it->second : nullptr);
+
+        GraphicsPipelineCacheKey cache_key{};
+        cache_key.renderpass = renderpasses[index];
+        std::memcpy(&cache_key.fixed_state, &key.fixed_state, key.fixed_state.Size());
+        auto pipeline = std::make_unique<VKGraphicsPipeline>(
+            device, scheduler, descriptor_pool, update_descriptor_queue, cache_key, bindings,
+            program, key.num_color_buffers, *driver_cache);
+
+        std::scoped_lock lock{mutex};
+        if (!is_precompiled) {
+            new_spirv.emplace(hash, ExtractSPIRV(program));
+        }
+        disk_graphics_pipelines.emplace(key, std::move(pipeline));
+        report_progress();
+    });
+
+    ParallelFor(workers, num_workers, compute_keys.size(), [&](std::size_t index) {
+        if (stop_loading) {
+            return;
+        }
+        const ComputePipelineDiskKey& key = compute_keys[index];
+        const Shader* const shader = find_shader(key.unique_identifier);
+        if (!shader) {
+            LOG_WARNING(Render_Vulkan, "Pipeline references a missing shader, skipping");
+            return;
+        }
+        const u64 hash = key.Hash();
+        const auto spirv_it = precompiled.spirv.find(hash);
+        const bool is_precompiled =
+            spirv_it != precompiled.spirv.end() && spirv_it->second.size() == 1;
+        const SPIRVShader spirv_shader{
+            is_precompiled ? spirv_it->second[0]
+                           : Decompile(device, shader->GetIR(), ShaderType::Compute,
+                                       shader->GetRegistry(),
+                                       MakeComputeSpecialization(key.shared_memory_size,
+                                                                 key.workgroup_size)),
+            shader->GetEntries(),
+        };
+        auto pipeline =
+            std::make_unique<VKComputePipeline>(device, scheduler, descriptor_pool,
+                                                update_descriptor_queue, spirv_shader,
+                                                *driver_cache);
+
+        std::scoped_lock lock{mutex};
+        if (!is_precompiled) {
+            new_spirv.emplace(hash, std::vector<std::vector<u32>>{spirv_shader.code});
+        }
+        disk_compute_pipelines.emplace(key, std::move(pipeline));
+        report_progress();
+    });
 
-VKPipelineCache::~VKPipelineCache() = default;
+    if (!new_spirv.empty()) {
+        precompiled.spirv.merge(new_spirv);
+        precompiled_altered = true;
+    }
+    // Persist what was built at boot right away instead of waiting for the session to end
+    SavePrecompiled();
+}
 
 std::array<Shader*, Maxwell::MaxShaderProgram> VKPipelineCache::GetShaders() {
     std::array<Shader*, Maxwell::MaxShaderProgram> shaders{};
@@ -184,8 +427,8 @@ std::array<Shader*, Maxwell::MaxShaderProgram> VKPipelineCache::GetShaders() {
             ProgramCode code = GetShaderCode(gpu_memory, gpu_addr, host_ptr, false);
             const std::size_t size_in_bytes = code.size() * sizeof(u64);
 
-            auto shader = std::make_unique<Shader>(maxwell3d, stage, gpu_addr, *cpu_addr,
-                                                   std::move(code), stage_offset);
+            auto shader = CreateShader(maxwell3d, stage, gpu_addr, cpu_addr.value_or(0),
+                                       std::move(code), stage_offset);
             result = shader.get();
 
             if (cpu_addr) {
@@ -200,7 +443,7 @@ std::array<Shader*, Maxwell::MaxShaderProgram> VKPipelineCache::GetShaders() {
 }
 
 VKGraphicsPipeline* VKPipelineCache::GetGraphicsPipeline(
-    const GraphicsPipelineCacheKey& key, u32 num_color_buffers,
+    const GraphicsPipelineCacheKey& key, const Framebuffer& framebuffer,
     VideoCommon::Shader::AsyncShaders& async_shaders) {
     MICROPROFILE_SCOPE(Vulkan_PipelineCache);
 
@@ -209,16 +452,30 @@ VKGraphicsPipeline* VKPipelineCache::GetGraphicsPipeline(
     }
     last_graphics_key = key;
 
+    const u32 num_color_buffers = framebuffer.NumColorBuffers();
+    const auto take_from_disk = [this](const GraphicsPipelineDiskKey& disk_key) {
+        std::unique_ptr<VKGraphicsPipeline> pipeline;
+        if (const auto node = disk_graphics_pipelines.extract(disk_key)) {
+            pipeline = std::move(node.mapped());
+        }
+        return pipeline;
+    };
+
     if (device.UseAsynchronousShaders() && async_shaders.IsShaderAsync(gpu)) {
         std::unique_lock lock{pipeline_cache};
         const auto [pair, is_cache_miss] = graphics_cache.try_emplace(key);
         if (is_cache_miss) {
-            gpu.ShaderNotify().MarkSharderBuilding();
-            LOG_INFO(Render_Vulkan, "Compile 0x{:016X}", key.Hash());
-            const auto [program, bindings] = DecompileShaders(key.fixed_state);
-            async_shaders.QueueVulkanShader(this, device, scheduler, descriptor_pool,
-                                            update_descriptor_queue, bindings, program, key,
-                                            num_color_buffers);
+            const GraphicsPipelineDiskKey disk_key = MakeGraphicsDiskKey(key, framebuffer);
+            pair->second = take_from_disk(disk_key);
+            if (!pair->second) {
+                gpu.ShaderNotify().MarkSharderBuilding();
+                LOG_INFO(Render_Vulkan, "Compile 0x{:016X}", key.Hash());
+                const auto [program, bindings] = DecompileShaders(key.fixed_state, last_shaders);
+                SaveGraphicsPipeline(disk_key, program);
+                async_shaders.QueueVulkanShader(this, device, scheduler, descriptor_pool,
+                                                update_descriptor_queue, bindings, program, key,
+                                                num_color_buffers);
+            }
         }
         last_graphics_pipeline = pair->second.get();
         return last_graphics_pipeline;
@@ -227,13 +484,18 @@ VKGraphicsPipeline* VKPipelineCache::GetGraphicsPipeline(
     const auto [pair, is_cache_miss] = graphics_cache.try_emplace(key);
     auto& entry = pair->second;
     if (is_cache_miss) {
-        gpu.ShaderNotify().MarkSharderBuilding();
-        LOG_INFO(Render_Vulkan, "Compile 0x{:016X}", key.Hash());
-        const auto [program, bindings] = DecompileShaders(key.fixed_state);
-        entry = std::make_unique<VKGraphicsPipeline>(device, scheduler, descriptor_pool,
-                                                     update_descriptor_queue, key, bindings,
-                                                     program, num_color_buffers);
-        gpu.ShaderNotify().MarkShaderComplete();
+        const GraphicsPipelineDiskKey disk_key = MakeGraphicsDiskKey(key, framebuffer);
+        entry = take_from_disk(disk_key);
+        if (!entry) {
+            gpu.ShaderNotify().MarkSharderBuilding();
+            LOG_INFO(Render_Vulkan, "Compile 0x{:016X}", key.Hash());
+            const auto [program, bindings] = DecompileShaders(key.fixed_state, last_shaders);
+            SaveGraphicsPipeline(disk_key, program);
+            entry = std::make_unique<VKGraphicsPipeline>(
+                device, scheduler, descriptor_pool, update_descriptor_queue, key, bindings,
+                program, num_color_buffers, *driver_cache);
+            gpu.ShaderNotify().MarkShaderComplete();
+        }
     }
     last_graphics_pipeline = entry.get();
     return last_graphics_pipeline;
@@ -247,7 +509,6 @@ VKComputePipeline& VKPipelineCache::GetComputePipeline(const ComputePipelineCach
     if (!is_cache_miss) {
         return *entry;
     }
-    LOG_INFO(Render_Vulkan, "Compile 0x{:016X}", key.Hash());
 
     const GPUVAddr gpu_addr = key.shader;
 
@@ -262,8 +523,8 @@ VKComputePipeline& VKPipelineCache::GetComputePipeline(const ComputePipelineCach
         ProgramCode code = GetShaderCode(gpu_memory, gpu_addr, host_ptr, true);
         const std::size_t size_in_bytes = code.size() * sizeof(u64);
 
-        auto shader_info = std::make_unique<Shader>(kepler_compute, ShaderType::Compute, gpu_addr,
-                                                    *cpu_addr, std::move(code), KERNEL_MAIN_OFFSET);
+        auto shader_info = CreateShader(kepler_compute, ShaderType::Compute, gpu_addr,
+                                        cpu_addr.value_or(0), std::move(code), KERNEL_MAIN_OFFSET);
         shader = shader_info.get();
 
         if (cpu_addr) {
@@ -273,20 +534,28 @@ VKComputePipeline& VKPipelineCache::GetComputePipeline(const ComputePipelineCach
         }
     }
 
-    const Specialization specialization{
-        .base_binding = 0,
-        .workgroup_size = key.workgroup_size,
+    const ComputePipelineDiskKey disk_key{
+        .unique_identifier = shader->GetUniqueIdentifier(),
         .shared_memory_size = key.shared_memory_size,
-        .point_size = std::nullopt,
-        .enabled_attributes = {},
-        .attribute_types = {},
-        .ndc_minus_one_to_one = false,
+        .workgroup_size = key.workgroup_size,
+    };
+    if (auto node = disk_compute_pipelines.extract(disk_key)) {
+        entry = std::move(node.mapped());
+        return *entry;
+    }
+    LOG_INFO(Render_Vulkan, "Compile 0x{:016X}", key.Hash());
+
+    const SPIRVShader spirv_shader{
+        Decompile(device, shader->GetIR(), ShaderType::Compute, shader->GetRegistry(),
+                  MakeComputeSpecialization(key.shared_memory_size, key.workgroup_size)),
+        shader->GetEntries(),
     };
-    const SPIRVShader spirv_shader{Decompile(device, shader->GetIR(), ShaderType::Compute,
-                                             shader->GetRegistry(), specialization),
-                                   shader->GetEntries()};
+    disk_cache.SaveComputePipeline(disk_key);
+    NotifyPipelineBuilt(disk_key.Hash(), {spirv_shader.code});
+
     entry = std::make_unique<VKComputePipeline>(device, scheduler, descriptor_pool,
-                                                update_descriptor_queue, spirv_shader);
+                                                update_descriptor_queue, spirv_shader,
+                                                *driver_cache);
     return *entry;
 }
 
@@ -331,7 +600,9 @@ void VKPipelineCache::OnShaderRemoval(Shader* shader) {
 }
 
 std::pair<SPIRVProgram, std::vector<VkDescriptorSetLayoutBinding>>
-VKPipelineCache::DecompileShaders(const FixedPipelineState& fixed_state) {
+VKPipelineCache::DecompileShaders(const FixedPipelineState& fixed_state,
+                                  const std::array<Shader*, Maxwell::MaxShaderProgram>& shaders,
+                                  const std::vector<std::vector<u32>>* spirv) const {
     Specialization specialization;
     if (fixed_state.topology == Maxwell::PrimitiveTopology::Points) {
         float point_size;
@@ -358,18 +629,17 @@ VKPipelineCache::DecompileShaders(const FixedPipelineState& fixed_state) {
     for (std::size_t index = 1; index < Maxwell::MaxShaderProgram; ++index) {
         const auto program_enum = static_cast<Maxwell::ShaderProgram>(index);
         // Skip stages that are not enabled
-        if (!maxwell3d.regs.IsShaderConfigEnabled(index)) {
+        const Shader* const shader = shaders[index];
+        if (!shader) {
             continue;
         }
-        const GPUVAddr gpu_addr = GetShaderAddress(maxwell3d, program_enum);
-        const std::optional<VAddr> cpu_addr = gpu_memory.GpuToCpuAddress(gpu_addr);
-        Shader* const shader = cpu_addr ? TryGet(*cpu_addr) : null_shader.get();
-
         const std::size_t stage = index == 0 ? 0 : index - 1; // Stage indices are 0 - 5
         const ShaderType program_type = GetShaderType(program_enum);
         const auto& entries = shader->GetEntries();
         program[stage] = {
-            Decompile(device, shader->GetIR(), program_type, shader->GetRegistry(), specialization),
+            spirv ? (*spirv)[stage]
+                  : Decompile(device, shader->GetIR(), program_type, shader->GetRegistry(),
+                              specialization),
             entries,
         };
 
@@ -381,6 +651,82 @@ VKPipelineCache::DecompileShaders(const FixedPipelineState& fixed_state) {
     return {std::move(program), std::move(bindings)};
 }
 
+std::unique_ptr<Shader> VKPipelineCache::CreateShader(
+    Tegra::Engines::ConstBufferEngineInterface& engine, ShaderType stage, GPUVAddr gpu_addr,
+    VAddr cpu_addr, ProgramCode code, u32 main_offset) {
+    const u64 unique_identifier = GetUniqueIdentifier(stage, false, code);
+    if (auto node = disk_shaders.extract(unique_identifier)) {
+        std::unique_ptr<Shader> shader = std::move(node.mapped());
+        shader->SetGpuAddr(gpu_addr);
+        return shader;
+    }
+    auto shader = std::make_unique<Shader>(engine, stage, gpu_addr, cpu_addr, std::move(code),
+                                           main_offset, unique_identifier);
+    disk_cache.SaveShader(shader->MakeDiskCacheEntry());
+    return shader;
+}
+
+GraphicsPipelineDiskKey VKPipelineCache::MakeGraphicsDiskKey(
+    const GraphicsPipelineCacheKey& key, const Framebuffer& framebuffer) const {
+    GraphicsPipelineDiskKey disk_key{};
+    for (std::size_t index = 0; index < Maxwell::MaxShaderProgram; ++index) {
+        const Shader* const shader = last_shaders[index];
+        disk_key.unique_identifiers[index] = shader ? shader->GetUniqueIdentifier() : 0;
+    }
+    disk_key.renderpass = framebuffer.GetRenderPassKey();
+    disk_key.num_color_buffers = framebuffer.NumColorBuffers();
+    std::memcpy(&disk_key.fixed_state, &key.fixed_state, key.fixed_state.Size());
+    return disk_key;
+}
+
+void VKPipelineCache::SaveGraphicsPipeline(const GraphicsPipelineDiskKey& disk_key,
+                                           const SPIRVProgram& program) {
+    disk_cache.SaveGraphicsPipeline(disk_key);
+    NotifyPipelineBuilt(disk_key.Hash(), ExtractSPIRV(program));
+}
+
+void VKPipelineCache::NotifyPipelineBuilt(u64 hash, std::vector<std::vector<u32>> spirv) {
+    precompiled_altered = true;
+    if (disk_cache.IsUsable()) {
+        unsaved_spirv.insert_or_assign(hash, spirv);
+    }
+    precompiled.spirv.insert_or_assign(hash, std::move(spirv));
+    if (unsaved_spirv.size() < PIPELINES_PER_SAVE) {
+        return;
+    }
+    // Only the new pipelines are written, so the cost doesn't grow with the size of the cache
+    save_worker->QueueWork(
+        [this, batch = std::move(unsaved_spirv)] { disk_cache.AppendPrecompiled(batch); });
+    unsaved_spirv.clear();
+}
+
+void VKPipelineCache::SavePrecompiled() {
+    if (!disk_cache.IsUsable() || !precompiled_altered) {
+        return;
+    }
+    try {
+        precompiled.driver_cache = driver_cache.GetData();
+    } catch (const vk::Exception& exception) {
+        LOG_ERROR(Render_Vulkan, "Failed to read driver pipeline cache: {}", exception.what());
+        precompiled.driver_cache.clear();
+    }
+    disk_cache.SavePrecompiled(precompiled);
+    // The driver cache is read again on the next save, don't keep a stale copy around
+    precompiled.driver_cache = {};
+    precompiled_altered = false;
+    unsaved_spirv.clear();
+}
+
+vk::PipelineCache VKPipelineCache::CreateDriverCache(const std::vector<u8>& initial_data) const {
+    return device.GetLogical().CreatePipelineCache({
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
+        .pNext = nullptr,
+        .flags = 0,
+        .initialDataSize = initial_data.size(),
+        .pInitialData = initial_data.data(),
+    });
+}
+
 template <VkDescriptorType descriptor_type, class Container>
 void AddEntry(std::vector<VkDescriptorUpdateTemplateEntry>& template_entries, u32& binding,
               u32& offset, const Container& container) {
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <cstddef>
 #include <memory>
 #include <type_traits>
@@ -15,11 +16,14 @@
 #include <boost/functional/hash.hpp>
 
 #include "common/common_types.h"
+#include "common/thread_worker.h"
 #include "video_core/engines/const_buffer_engine_interface.h"
 #include "video_core/engines/maxwell_3d.h"
+#include "video_core/rasterizer_interface.h"
 #include "video_core/renderer_vulkan/fixed_pipeline_state.h"
 #include "video_core/renderer_vulkan/vk_graphics_pipeline.h"
 #include "video_core/renderer_vulkan/vk_shader_decompiler.h"
+#include "video_core/renderer_vulkan/vk_shader_disk_cache.h"
 #include "video_core/shader/async_shaders.h"
 #include "video_core/shader/memory_util.h"
 #include "video_core/shader/registry.h"
@@ -34,11 +38,13 @@ class System;
 namespace Vulkan {
 
 class Device;
+class Framebuffer;
 class RasterizerVulkan;
 class VKComputePipeline;
 class VKDescriptorPool;
 class VKScheduler;
 class VKUpdateDescriptorQueue;
+struct TextureCacheRuntime;
 
 using Maxwell = Tegra::Engines::Maxwell3D::Regs;
 
@@ -85,13 +91,29 @@ class Shader {
 public:
     explicit Shader(Tegra::Engines::ConstBufferEngineInterface& engine_,
                     Tegra::Engines::ShaderType stage_, GPUVAddr gpu_addr, VAddr cpu_addr_,
-                    VideoCommon::Shader::ProgramCode program_code, u32 main_offset_);
+                    VideoCommon::Shader::ProgramCode program_code, u32 main_offset_,
+                    u64 unique_identifier_);
+
+    /// Creates a shader detached from the engines from a disk cache entry
+    explicit Shader(const ShaderDiskCacheEntry& entry, u32 main_offset_);
+
     ~Shader();
 
+    /// Builds a transferable disk cache entry describing this shader
+    ShaderDiskCacheEntry MakeDiskCacheEntry() const;
+
     GPUVAddr GetGpuAddr() const {
         return gpu_addr;
     }
 
+    void SetGpuAddr(GPUVAddr gpu_addr_) {
+        gpu_addr = gpu_addr_;
+    }
+
+    u64 GetUniqueIdentifier() const {
+        return unique_identifier;
+    }
+
     VideoCommon::Shader::ShaderIR& GetIR() {
         return shader_ir;
     }
@@ -110,6 +132,8 @@ public:
 
 private:
     GPUVAddr gpu_addr{};
+    Tegra::Engines::ShaderType stage{};
+    u64 unique_identifier{};
     VideoCommon::Shader::ProgramCode program_code;
     VideoCommon::Shader::Registry registry;
     VideoCommon::Shader::ShaderIR shader_ir;
@@ -123,25 +147,63 @@ public:
                              Tegra::Engines::KeplerCompute& kepler_compute,
                              Tegra::MemoryManager& gpu_memory, const Device& device,
                              VKScheduler& scheduler, VKDescriptorPool& descriptor_pool,
-                             VKUpdateDescriptorQueue& update_descriptor_queue);
+                             VKUpdateDescriptorQueue& update_descriptor_queue,
+                             TextureCacheRuntime& texture_cache_runtime);
     ~VKPipelineCache() override;
 
+    /// Loads the title's pipeline disk cache and builds its pipelines in parallel
+    void LoadDiskResources(u64 title_id, const std::atomic_bool& stop_loading,
+                           const VideoCore::DiskResourceLoadCallback& callback);
+
     std::array<Shader*, Maxwell::MaxShaderProgram> GetShaders();
 
     VKGraphicsPipeline* GetGraphicsPipeline(const GraphicsPipelineCacheKey& key,
-                                            u32 num_color_buffers,
+                                            const Framebuffer& framebuffer,
                                             VideoCommon::Shader::AsyncShaders& async_shaders);
 
     VKComputePipeline& GetComputePipeline(const ComputePipelineCacheKey& key);
 
     void EmplacePipeline(std::unique_ptr<VKGraphicsPipeline> pipeline);
 
+    /// Returns the driver pipeline cache used to create pipelines
+    VkPipelineCache GetDriverCache() const {
+        return *driver_cache;
+    }
+
 protected:
     void OnShaderRemoval(Shader* shader) final;
 
 private:
+    /// Decompiles the given shaders, using the precompiled SPIR-V modules when they are provided
     std::pair<SPIRVProgram, std::vector<VkDescriptorSetLayoutBinding>> DecompileShaders(
-        const FixedPipelineState& fixed_state);
+        const FixedPipelineState& fixed_state,
+        const std::array<Shader*, Maxwell::MaxShaderProgram>& shaders,
+        const std::vector<std::vector<u32>>* spirv = nullptr) const;
+
+    /// Returns a shader previously loaded from the disk cache or creates a new one from memory
+    std::unique_ptr<Shader> CreateShader(Tegra::Engines::ConstBufferEngineInterface& engine,
+                                         Tegra::Engines::ShaderType stage, GPUVAddr gpu_addr,
+                                         VAddr cpu_addr, VideoCommon::Shader::ProgramCode code,
+                                         u32 main_offset);
+
+    /// Builds a session independent key for the given graphics pipeline
+    GraphicsPipelineDiskKey MakeGraphicsDiskKey(const GraphicsPipelineCacheKey& key,
+                                                const Framebuffer& framebuffer) const;
+
+    /// Records a newly built pipeline in the transferable and precompiled caches
+    void SaveGraphicsPipeline(const GraphicsPipelineDiskKey& disk_key,
+                              const SPIRVProgram& program);
+
+    /// Records the SPIR-V of a newly built pipeline, appending a batch of them to the precompiled
+    /// cache on the save worker once enough are pending
+    void NotifyPipelineBuilt(u64 hash, std::vector<std::vector<u32>> spirv);
+
+    /// Rewrites the whole precompiled cache with the current driver cache contents if it was
+    /// altered. This is only done while loading and at shutdown, as its cost grows with the cache.
+    void SavePrecompiled();
+
+    /// Creates the driver pipeline cache with optional initial contents
+    vk::PipelineCache CreateDriverCache(const std::vector<u8>& initial_data) const;
 
     Tegra::GPU& gpu;
     Tegra::Engines::Maxwell3D& maxwell3d;
@@ -152,6 +214,19 @@ private:
     VKScheduler& scheduler;
     VKDescriptorPool& descriptor_pool;
     VKUpdateDescriptorQueue& update_descriptor_queue;
+    TextureCacheRuntime& texture_cache_runtime;
+
+    ShaderDiskCacheVulkan disk_cache;
+    ShaderDiskCachePrecompiled precompiled;
+    bool precompiled_altered = false;
+    vk::PipelineCache driver_cache;
+
+    /// New pipelines built before they are appended to the precompiled cache, so a crash doesn't
+    /// lose the work of the whole session
+    static constexpr std::size_t PIPELINES_PER_SAVE = 32;
+    std::unordered_map<u64, std::vector<std::vector<u32>>> unsaved_spirv;
+    /// Appends new pipelines to the precompiled cache off the render thread
+    std::unique_ptr<Common::ThreadWorker> save_worker;
 
     std::unique_ptr<Shader> null_shader;
     std::unique_ptr<Shader> null_kernel;
@@ -165,6 +240,13 @@ private:
     std::unordered_map<GraphicsPipelineCacheKey, std::unique_ptr<VKGraphicsPipeline>>
         graphics_cache;
     std::unordered_map<ComputePipelineCacheKey, std::unique_ptr<VKComputePipeline>> compute_cache;
+
+    // Shaders and pipelines loaded from the disk cache that haven't been used by the guest yet
+    std::unordered_map<u64, std::unique_ptr<Shader>> disk_shaders;
+    std::unordered_map<GraphicsPipelineDiskKey, std::unique_ptr<VKGraphicsPipeline>>
+        disk_graphics_pipelines;
+    std::unordered_map<ComputePipelineDiskKey, std::unique_ptr<VKComputePipeline>>
+        disk_compute_pipelines;
 };
 
 void FillDescriptorUpdateTemplateEntries(
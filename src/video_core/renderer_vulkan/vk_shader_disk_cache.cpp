@@ -0,0 +1,526 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <cstring>
+#include <span>
+
+#include <fmt/format.h>
+
+#include "common/cityhash.h"
+#include "common/common_types.h"
+#include "common/fs/file.h"
+#include "common/fs/fs.h"
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
+#include "common/scm_rev.h"
+#include "common/settings.h"
+#include "common/zstd_compression.h"
+#include "video_core/renderer_vulkan/vk_shader_disk_cache.h"
+#include "video_core/vulkan_common/vulkan_device.h"
+
+namespace Vulkan {
+
+using ShaderCacheVersionHash = std::array<u8, 64>;
+
+namespace {
+
+constexpr u32 NativeVersion = 1;
+
+enum class RecordTag : u32 {
+    Shader,
+    GraphicsPipeline,
+    ComputePipeline,
+};
+
+/// Identifies the host device and driver the precompiled cache was generated for
+struct PrecompiledHeader {
+    ShaderCacheVersionHash version_hash;
+    u32 driver_id;
+    u32 driver_version;
+};
+static_assert(std::is_trivially_copyable_v<PrecompiledHeader>);
+
+/// Kinds of the compressed blocks following the header of the precompiled cache
+enum class PrecompiledBlockTag : u32 {
+    /// SPIR-V modules of pipelines, later blocks replace the modules of earlier ones
+    Pipelines,
+    /// Serialized VkPipelineCache contents, only the last block is used
+    DriverCache,
+};
+
+/// Precedes each compressed block of the precompiled cache
+struct PrecompiledBlockHeader {
+    PrecompiledBlockTag tag;
+    u32 compressed_size;
+};
+static_assert(std::is_trivially_copyable_v<PrecompiledBlockHeader>);
+
+ShaderCacheVersionHash GetShaderCacheVersionHash() {
+    ShaderCacheVersionHash hash{};
+    const std::size_t length = std::min(std::strlen(Common::g_shader_cache_version), hash.size());
+    std::memcpy(hash.data(), Common::g_shader_cache_version, length);
+    return hash;
+}
+
+PrecompiledHeader MakePrecompiledHeader(const Device& device) {
+    return {
+        .version_hash = GetShaderCacheVersionHash(),
+        .driver_id = static_cast<u32>(device.GetDriverID()),
+        .driver_version = device.GetDriverVersion(),
+    };
+}
+
+template <typename T>
+void Append(std::vector<u8>& buffer, std::span<const T> data) {
+    const std::size_t offset = buffer.size();
+    buffer.resize(offset + data.size_bytes());
+    std::memcpy(buffer.data() + offset, data.data(), data.size_bytes());
+}
+
+template <typename T>
+void AppendObject(std::vector<u8>& buffer, const T& object) {
+    Append(buffer, std::span<const T>(&object, 1));
+}
+
+template <typename T>
+bool Consume(std::span<const u8>& buffer, std::span<T> data) {
+    if (buffer.size() < data.size_bytes()) {
+        return false;
+    }
+    std::memcpy(data.data(), buffer.data(), data.size_bytes());
+    buffer = buffer.subspan(data.size_bytes());
+    return true;
+}
+
+template <typename T>
+bool ConsumeObject(std::span<const u8>& buffer, T& object) {
+    return Consume(buffer, std::span<T>(&object, 1));
+}
+
+/// Serializes the SPIR-V modules of the given pipelines into a block
+std::vector<u8> SerializePipelines(
+    const std::unordered_map<u64, std::vector<std::vector<u32>>>& spirv) {
+    std::vector<u8> uncompressed;
+    AppendObject(uncompressed, static_cast<u32>(spirv.size()));
+    for (const auto& [hash, modules] : spirv) {
+        AppendObject(uncompressed, hash);
+        AppendObject(uncompressed, static_cast<u32>(modules.size()));
+        for (const std::vector<u32>& code : modules) {
+            AppendObject(uncompressed, static_cast<u32>(code.size()));
+            Append(uncompressed, std::span(code));
+        }
+    }
+    return uncompressed;
+}
+
+/// Deserializes a pipelines block, replacing the modules of the pipelines already present
+bool DeserializePipelines(std::span<const u8> buffer,
+                          std::unordered_map<u64, std::vector<std::vector<u32>>>& spirv) {
+    u32 num_pipelines{};
+    if (!ConsumeObject(buffer, num_pipelines)) {
+        return false;
+    }
+    for (u32 pipeline = 0; pipeline < num_pipelines; ++pipeline) {
+        u64 hash{};
+        u32 num_modules{};
+        if (!ConsumeObject(buffer, hash) || !ConsumeObject(buffer, num_modules) ||
+            num_modules > Maxwell::MaxShaderStage) {
+            return false;
+        }
+        auto& modules = spirv[hash];
+        modules.resize(num_modules);
+        for (std::vector<u32>& code : modules) {
+            u32 code_size{};
+            if (!ConsumeObject(buffer, code_size)) {
+                return false;
+            }
+            code.resize(code_size);
+            if (!Consume(buffer, std::span(code))) {
+                return false;
+            }
+        }
+    }
+    return buffer.empty();
+}
+
+/// Compresses a block and appends it along with its header
+void AppendBlock(std::vector<u8>& buffer, PrecompiledBlockTag tag, std::span<const u8> block) {
+    const std::vector<u8> compressed =
+        Common::Compression::CompressDataZSTDDefault(block.data(), block.size());
+    AppendObject(buffer, PrecompiledBlockHeader{
+                             .tag = tag,
+                             .compressed_size = static_cast<u32>(compressed.size()),
+                         });
+    Append(buffer, std::span(compressed));
+}
+
+} // Anonymous namespace
+
+std::size_t GraphicsPipelineDiskKey::Hash() const noexcept {
+    const u64 hash = Common::CityHash64(reinterpret_cast<const char*>(this), Size());
+    return static_cast<std::size_t>(hash);
+}
+
+bool GraphicsPipelineDiskKey::operator==(const GraphicsPipelineDiskKey& rhs) const noexcept {
+    return std::memcmp(&rhs, this, Size()) == 0;
+}
+
+std::size_t ComputePipelineDiskKey::Hash() const noexcept {
+    const u64 hash = Common::CityHash64(reinterpret_cast<const char*>(this), sizeof *this);
+    return static_cast<std::size_t>(hash);
+}
+
+bool ComputePipelineDiskKey::operator==(const ComputePipelineDiskKey& rhs) const noexcept {
+    return std::memcmp(&rhs, this, sizeof *this) == 0;
+}
+
+ShaderDiskCacheVulkan::ShaderDiskCacheVulkan(const Device& device_) : device{device_} {}
+
+ShaderDiskCacheVulkan::~ShaderDiskCacheVulkan() = default;
+
+void ShaderDiskCacheVulkan::BindTitleID(u64 title_id_) {
+    title_id = title_id_;
+}
+
+std::optional<ShaderDiskCacheTransferable> ShaderDiskCacheVulkan::LoadTransferable() {
+    // Skip games without title id
+    const bool has_title_id = title_id != 0;
+    if (!Settings::values.use_disk_shader_cache.GetValue() || !has_title_id) {
+        return std::nullopt;
+    }
+
+    Common::FS::IOFile file{GetTransferablePath(), Common::FS::FileAccessMode::Read,
+                            Common::FS::FileType::BinaryFile};
+    if (!file.IsOpen()) {
+        LOG_INFO(Render_Vulkan, "No transferable pipeline cache found");
+        is_usable = true;
+        return std::nullopt;
+    }
+
+    u32 version{};
+    if (!file.ReadObject(version)) {
+        LOG_ERROR(Render_Vulkan, "Failed to get transferable cache version, skipping it");
+        return std::nullopt;
+    }
+    if (version < NativeVersion) {
+        LOG_INFO(Render_Vulkan, "Transferable pipeline cache is old, removing");
+        file.Close();
+        InvalidateTransferable();
+        is_usable = true;
+        return std::nullopt;
+    }
+    if (version > NativeVersion) {
+        LOG_WARNING(Render_Vulkan, "Transferable pipeline cache was generated with a newer version "
+                                   "of the emulator, skipping");
+        return std::nullopt;
+    }
+
+    // Version is valid, load the records
+    ShaderDiskCacheTransferable transferable;
+    while (static_cast<u64>(file.Tell()) < file.GetSize()) {
+        RecordTag tag{};
+        if (!file.ReadObject(tag)) {
+            LOG_ERROR(Render_Vulkan, "Failed to load transferable record tag, skipping");
+            return std::nullopt;
+        }
+        bool success = false;
+        switch (tag) {
+        case RecordTag::Shader: {
+            ShaderDiskCacheEntry& entry = transferable.shaders.emplace_back();
+            success = entry.Load(file);
+            stored_shaders.insert(entry.unique_identifier);
+            break;
+        }
+        case RecordTag::GraphicsPipeline: {
+            GraphicsPipelineDiskKey key{};
+            u32 key_size{};
+            success = file.ReadObject(key_size) && key_size <= sizeof(key) &&
+                      file.ReadSpan(std::span(reinterpret_cast<u8*>(&key), key_size)) == key_size &&
+                      key.Size() == key_size;
+            if (success) {
+                transferable.graphics_pipelines.push_back(key);
+                stored_graphics.insert(key);
+            }
+            break;
+        }
+        case RecordTag::ComputePipeline: {
+            ComputePipelineDiskKey key{};
+            success = file.ReadObject(key);
+            if (success) {
+                transferable.compute_pipelines.push_back(key);
+                stored_compute.insert(key);
+            }
+            break;
+        }
+        }
+        if (!success) {
+            LOG_ERROR(Render_Vulkan, "Failed to load transferable raw entry, skipping");
+            return std::nullopt;
+        }
+    }
+
+    is_usable = true;
+    return {std::move(transferable)};
+}
+
+ShaderDiskCachePrecompiled ShaderDiskCacheVulkan::LoadPrecompiled() {
+    if (!is_usable) {
+        return {};
+    }
+
+    const auto precompiled_path = GetPrecompiledPath();
+    Common::FS::IOFile file{precompiled_path, Common::FS::FileAccessMode::Read,
+                            Common::FS::FileType::BinaryFile};
+    if (!file.IsOpen()) {
+        LOG_INFO(Render_Vulkan, "No precompiled pipeline cache found");
+        return {};
+    }
+
+    std::vector<u8> contents(file.GetSize());
+    if (file.Read(contents) != contents.size()) {
+        LOG_ERROR(Render_Vulkan, "Failed to read precompiled cache");
+        return {};
+    }
+    file.Close();
+    std::span<const u8> buffer{contents};
+
+    const auto invalidate = [this] {
+        LOG_INFO(Render_Vulkan, "Failed to load precompiled cache");
+        InvalidatePrecompiled();
+        return ShaderDiskCachePrecompiled{};
+    };
+
+    PrecompiledHeader header{};
+    if (!ConsumeObject(buffer, header)) {
+        return invalidate();
+    }
+    if (header.version_hash != GetShaderCacheVersionHash()) {
+        LOG_INFO(Render_Vulkan, "Precompiled cache is from another version of the emulator");
+        return invalidate();
+    }
+    if (header.driver_id != static_cast<u32>(device.GetDriverID()) ||
+        header.driver_version != device.GetDriverVersion()) {
+        LOG_INFO(Render_Vulkan, "Precompiled cache was generated with a different driver");
+        return invalidate();
+    }
+
+    ShaderDiskCachePrecompiled precompiled;
+    while (!buffer.empty()) {
+        const std::size_t block_offset = contents.size() - buffer.size();
+        PrecompiledBlockHeader block_header{};
+        if (!ConsumeObject(buffer, block_header) ||
+            block_header.compressed_size > buffer.size()) {
+            // The last block was cut short while it was being appended, drop it so that the next
+            // appended blocks follow the valid ones
+            LOG_WARNING(Render_Vulkan, "Precompiled cache ends with an incomplete block");
+            Common::FS::IOFile truncate_file{precompiled_path,
+                                             Common::FS::FileAccessMode::ReadWrite,
+                                             Common::FS::FileType::BinaryFile};
+            if (!truncate_file.IsOpen() || !truncate_file.SetSize(block_offset)) {
+                return invalidate();
+            }
+            break;
+        }
+        const std::vector<u8> block = Common::Compression::DecompressDataZSTD(
+            buffer.first(block_header.compressed_size));
+        buffer = buffer.subspan(block_header.compressed_size);
+
+        switch (block_header.tag) {
+        case PrecompiledBlockTag::Pipelines:
+            if (!DeserializePipelines(block, precompiled.spirv)) {
+                return invalidate();
+            }
+            break;
+        case PrecompiledBlockTag::DriverCache:
+            precompiled.driver_cache = block;
+            break;
+        default:
+            return invalidate();
+        }
+    }
+    return precompiled;
+}
+
+void ShaderDiskCacheVulkan::InvalidateTransferable() {
+    if (!Common::FS::RemoveFile(GetTransferablePath())) {
+        LOG_ERROR(Render_Vulkan, "Failed to invalidate transferable file={}",
+                  Common::FS::PathToUTF8String(GetTransferablePath()));
+    }
+    stored_shaders.clear();
+    stored_graphics.clear();
+    stored_compute.clear();
+    InvalidatePrecompiled();
+}
+
+void ShaderDiskCacheVulkan::InvalidatePrecompiled() {
+    if (!Common::FS::RemoveFile(GetPrecompiledPath())) {
+        LOG_ERROR(Render_Vulkan, "Failed to invalidate precompiled file={}",
+                  Common::FS::PathToUTF8String(GetPrecompiledPath()));
+    }
+}
+
+void ShaderDiskCacheVulkan::SaveShader(const ShaderDiskCacheEntry& entry) {
+    if (!is_usable || stored_shaders.contains(entry.unique_identifier)) {
+        return;
+    }
+    AppendTransferableRecord(static_cast<u32>(RecordTag::Shader),
+                             [&entry](Common::FS::IOFile& file) { return entry.Save(file); });
+    stored_shaders.insert(entry.unique_identifier);
+}
+
+void ShaderDiskCacheVulkan::SaveGraphicsPipeline(const GraphicsPipelineDiskKey& key) {
+    if (!is_usable || stored_graphics.contains(key)) {
+        return;
+    }
+    AppendTransferableRecord(static_cast<u32>(RecordTag::GraphicsPipeline),
+                             [&key](Common::FS::IOFile& file) {
+                                 const auto key_size = static_cast<u32>(key.Size());
+                                 const auto bytes = reinterpret_cast<const u8*>(&key);
+                                 return file.WriteObject(key_size) &&
+                                        file.WriteSpan(std::span(bytes, key_size)) == key_size;
+                             });
+    stored_graphics.insert(key);
+}
+
+void ShaderDiskCacheVulkan::SaveComputePipeline(const ComputePipelineDiskKey& key) {
+    if (!is_usable || stored_compute.contains(key)) {
+        return;
+    }
+    AppendTransferableRecord(static_cast<u32>(RecordTag::ComputePipeline),
+                             [&key](Common::FS::IOFile& file) { return file.WriteObject(key); });
+    stored_compute.insert(key);
+}
+
+void ShaderDiskCacheVulkan::SavePrecompiled(const ShaderDiskCachePrecompiled& precompiled) {
+    if (!is_usable || !EnsureDirectories()) {
+        return;
+    }
+
+    std::vector<u8> contents;
+    AppendObject(contents, MakePrecompiledHeader(device));
+    AppendBlock(contents, PrecompiledBlockTag::Pipelines, SerializePipelines(precompiled.spirv));
+    if (!precompiled.driver_cache.empty()) {
+        AppendBlock(contents, PrecompiledBlockTag::DriverCache, precompiled.driver_cache);
+    }
+
+    const auto precompiled_path = GetPrecompiledPath();
+    Common::FS::IOFile file{precompiled_path, Common::FS::FileAccessMode::Write,
+                            Common::FS::FileType::BinaryFile};
+    if (!file.IsOpen()) {
+        LOG_ERROR(Render_Vulkan, "Failed to open precompiled cache in path={}",
+                  Common::FS::PathToUTF8String(precompiled_path));
+        return;
+    }
+    if (file.Write(contents) != contents.size()) {
+        LOG_ERROR(Render_Vulkan, "Failed to write precompiled cache in path={}",
+                  Common::FS::PathToUTF8String(precompiled_path));
+    }
+}
+
+void ShaderDiskCacheVulkan::AppendPrecompiled(
+    const std::unordered_map<u64, std::vector<std::vector<u32>>>& spirv) {
+    if (!is_usable || spirv.empty() || !EnsureDirectories()) {
+        return;
+    }
+
+    const auto precompiled_path = GetPrecompiledPath();
+    Common::FS::IOFile file{precompiled_path, Common::FS::FileAccessMode::Append,
+                            Common::FS::FileType::BinaryFile};
+    if (!file.IsOpen()) {
+        LOG_ERROR(Render_Vulkan, "Failed to open precompiled cache in path={}",
+                  Common::FS::PathToUTF8String(precompiled_path));
+        return;
+    }
+
+    std::vector<u8> contents;
+    if (file.GetSize() == 0) {
+        AppendObject(contents, MakePrecompiledHeader(device));
+    }
+    AppendBlock(contents, PrecompiledBlockTag::Pipelines, SerializePipelines(spirv));
+    if (file.Write(contents) != contents.size()) {
+        LOG_ERROR(Render_Vulkan, "Failed to append to precompiled cache in path={}",
+                  Common::FS::PathToUTF8String(precompiled_path));
+    }
+}
+
+Common::FS::IOFile ShaderDiskCacheVulkan::AppendTransferableFile() const {
+    if (!EnsureDirectories()) {
+        return {};
+    }
+
+    const auto transferable_path{GetTransferablePath()};
+    const bool existed = Common::FS::Exists(transferable_path);
+
+    Common::FS::IOFile file{transferable_path, Common::FS::FileAccessMode::Append,
+                            Common::FS::FileType::BinaryFile};
+    if (!file.IsOpen()) {
+        LOG_ERROR(Render_Vulkan, "Failed to open transferable cache in path={}",
+                  Common::FS::PathToUTF8String(transferable_path));
+        return {};
+    }
+    if (!existed || file.GetSize() == 0) {
+        // If the file didn't exist, write its version
+        if (!file.WriteObject(NativeVersion)) {
+            LOG_ERROR(Render_Vulkan, "Failed to write transferable cache version in path={}",
+                      Common::FS::PathToUTF8String(transferable_path));
+            return {};
+        }
+    }
+    return file;
+}
+
+template <typename Func>
+void ShaderDiskCacheVulkan::AppendTransferableRecord(u32 tag, Func&& func) {
+    Common::FS::IOFile file = AppendTransferableFile();
+    if (!file.IsOpen()) {
+        return;
+    }
+    if (!file.WriteObject(tag) || !func(file)) {
+        LOG_ERROR(Render_Vulkan, "Failed to save raw transferable cache entry, removing");
+        file.Close();
+        InvalidateTransferable();
+    }
+}
+
+bool ShaderDiskCacheVulkan::EnsureDirectories() const {
+    const auto CreateDir = [](const std::filesystem::path& dir) {
+        if (!Common::FS::CreateDir(dir)) {
+            LOG_ERROR(Render_Vulkan, "Failed to create directory={}",
+                      Common::FS::PathToUTF8String(dir));
+            return false;
+        }
+        return true;
+    };
+
+    return CreateDir(Common::FS::GetYuzuPath(Common::FS::YuzuPath::ShaderDir)) &&
+           CreateDir(GetBaseDir()) && CreateDir(GetTransferableDir()) &&
+           CreateDir(GetPrecompiledDir());
+}
+
+std::filesystem::path ShaderDiskCacheVulkan::GetTransferablePath() const {
+    return GetTransferableDir() / fmt::format("{}.bin", GetTitleID());
+}
+
+std::filesystem::path ShaderDiskCacheVulkan::GetPrecompiledPath() const {
+    return GetPrecompiledDir() / fmt::format("{}.bin", GetTitleID());
+}
+
+std::filesystem::path ShaderDiskCacheVulkan::GetTransferableDir() const {
+    return GetBaseDir() / "transferable";
+}
+
+std::filesystem::path ShaderDiskCacheVulkan::GetPrecompiledDir() const {
+    return GetBaseDir() / "precompiled";
+}
+
+std::filesystem::path ShaderDiskCacheVulkan::GetBaseDir() const {
+    return Common::FS::GetYuzuPath(Common::FS::YuzuPath::ShaderDir) / "vulkan";
+}
+
+std::string ShaderDiskCacheVulkan::GetTitleID() const {
+    return fmt::format("{:016X}", title_id);
+}
+
+} // namespace Vulkan
@@ -0,0 +1,197 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "common/common_types.h"
+#include "video_core/engines/maxwell_3d.h"
+#include "video_core/renderer_vulkan/fixed_pipeline_state.h"
+#include "video_core/renderer_vulkan/vk_texture_cache.h"
+#include "video_core/shader/shader_disk_cache_entry.h"
+
+namespace Common::FS {
+class IOFile;
+}
+
+namespace Vulkan {
+
+class Device;
+
+using Maxwell = Tegra::Engines::Maxwell3D::Regs;
+using VideoCommon::Shader::ShaderDiskCacheEntry;
+
+/// Describes a graphics pipeline with values that are stable across emulation sessions
+struct GraphicsPipelineDiskKey {
+    /// Unique identifiers of the shaders used on each stage, zero when the stage is disabled
+    std::array<u64, Maxwell::MaxShaderProgram> unique_identifiers;
+    RenderPassKey renderpass;
+    u32 num_color_buffers;
+    FixedPipelineState fixed_state;
+
+    std::size_t Hash() const noexcept;
+
+    bool operator==(const GraphicsPipelineDiskKey& rhs) const noexcept;
+
+    bool operator!=(const GraphicsPipelineDiskKey& rhs) const noexcept {
+        return !operator==(rhs);
+    }
+
+    std::size_t Size() const noexcept {
+        return sizeof(unique_identifiers) + sizeof(renderpass) + sizeof(num_color_buffers) +
+               fixed_state.Size();
+    }
+};
+static_assert(std::is_trivially_copyable_v<GraphicsPipelineDiskKey>);
+static_assert(std::is_trivially_constructible_v<GraphicsPipelineDiskKey>);
+
+/// Describes a compute pipeline with values that are stable across emulation sessions
+struct ComputePipelineDiskKey {
+    u64 unique_identifier;
+    u32 shared_memory_size;
+    std::array<u32, 3> workgroup_size;
+
+    std::size_t Hash() const noexcept;
+
+    bool operator==(const ComputePipelineDiskKey& rhs) const noexcept;
+
+    bool operator!=(const ComputePipelineDiskKey& rhs) const noexcept {
+        return !operator==(rhs);
+    }
+};
+static_assert(std::has_unique_object_representations_v<ComputePipelineDiskKey>);
+static_assert(std::is_trivially_copyable_v<ComputePipelineDiskKey>);
+static_assert(std::is_trivially_constructible_v<ComputePipelineDiskKey>);
+
+} // namespace Vulkan
+
+namespace std {
+
+template <>
+struct hash<Vulkan::GraphicsPipelineDiskKey> {
+    std::size_t operator()(const Vulkan::GraphicsPipelineDiskKey& k) const noexcept {
+        return k.Hash();
+    }
+};
+
+template <>
+struct hash<Vulkan::ComputePipelineDiskKey> {
+    std::size_t operator()(const Vulkan::ComputePipelineDiskKey& k) const noexcept {
+        return k.Hash();
+    }
+};
+
+} // namespace std
+
+namespace Vulkan {
+
+/// Contents of the transferable cache, valid for any host device
+struct ShaderDiskCacheTransferable {
+    std::vector<ShaderDiskCacheEntry> shaders;
+    std::vector<GraphicsPipelineDiskKey> graphics_pipelines;
+    std::vector<ComputePipelineDiskKey> compute_pipelines;
+};
+
+/// Contents of the precompiled cache, only valid for the host device that generated it
+struct ShaderDiskCachePrecompiled {
+    /// SPIR-V modules of each pipeline stage indexed by the hash of the pipeline's disk key
+    std::unordered_map<u64, std::vector<std::vector<u32>>> spirv;
+    /// Serialized VkPipelineCache contents
+    std::vector<u8> driver_cache;
+};
+
+class ShaderDiskCacheVulkan {
+public:
+    explicit ShaderDiskCacheVulkan(const Device& device);
+    ~ShaderDiskCacheVulkan();
+
+    /// Binds a title ID for all future operations.
+    void BindTitleID(u64 title_id);
+
+    /// Loads transferable cache. If file has a old version or on failure, it deletes the file.
+    std::optional<ShaderDiskCacheTransferable> LoadTransferable();
+
+    /// Loads current game's precompiled cache. Invalidates on failure.
+    ShaderDiskCachePrecompiled LoadPrecompiled();
+
+    /// Removes the transferable (and precompiled) cache file.
+    void InvalidateTransferable();
+
+    /// Removes the precompiled cache file.
+    void InvalidatePrecompiled();
+
+    /// Saves a raw shader dump to the transferable file. Checks for collisions.
+    void SaveShader(const ShaderDiskCacheEntry& entry);
+
+    /// Saves a graphics pipeline description to the transferable file. Checks for collisions.
+    void SaveGraphicsPipeline(const GraphicsPipelineDiskKey& key);
+
+    /// Saves a compute pipeline description to the transferable file. Checks for collisions.
+    void SaveComputePipeline(const ComputePipelineDiskKey& key);
+
+    /// Overwrites the precompiled file with the given SPIR-V modules and driver cache.
+    void SavePrecompiled(const ShaderDiskCachePrecompiled& precompiled);
+
+    /// Appends the SPIR-V modules of new pipelines to the precompiled file, without rewriting
+    /// what it already holds. It may run on another thread, but not along with SavePrecompiled.
+    void AppendPrecompiled(const std::unordered_map<u64, std::vector<std::vector<u32>>>& spirv);
+
+    /// Returns true when the cache has been loaded and can be written to.
+    bool IsUsable() const {
+        return is_usable;
+    }
+
+private:
+    /// Opens current game's transferable file and write it's header if it doesn't exist
+    Common::FS::IOFile AppendTransferableFile() const;
+
+    /// Appends a tagged record to the transferable file, invalidating it on failure
+    template <typename Func>
+    void AppendTransferableRecord(u32 tag, Func&& func);
+
+    /// Create shader disk cache directories. Returns true on success.
+    bool EnsureDirectories() const;
+
+    /// Gets current game's transferable file path
+    std::filesystem::path GetTransferablePath() const;
+
+    /// Gets current game's precompiled file path
+    std::filesystem::path GetPrecompiledPath() const;
+
+    /// Get user's transferable directory path
+    std::filesystem::path GetTransferableDir() const;
+
+    /// Get user's precompiled directory path
+    std::filesystem::path GetPrecompiledDir() const;
+
+    /// Get user's shader directory path
+    std::filesystem::path GetBaseDir() const;
+
+    /// Get current game's title id
+    std::string GetTitleID() const;
+
+    const Device& device;
+
+    // Stored transferable shaders and pipelines
+    std::unordered_set<u64> stored_shaders;
+    std::unordered_set<GraphicsPipelineDiskKey> stored_graphics;
+    std::unordered_set<ComputePipelineDiskKey> stored_compute;
+
+    /// Title ID to operate on
+    u64 title_id = 0;
+
+    // The cache has been loaded at boot
+    bool is_usable = false;
+};
+
+} // namespace Vulkan
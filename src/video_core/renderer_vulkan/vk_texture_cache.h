@@ -79,6 +79,9 @@ struct TextureCacheRuntime {
 
     void ConvertImage(Framebuffer* dst, ImageView& dst_view, ImageView& src_view);
 
+    /// Returns a render pass compatible with the given key, creating it if it doesn't exist
+    [[nodiscard]] VkRenderPass GetRenderPass(const RenderPassKey& key);
+
     [[nodiscard]] bool CanAccelerateImageUpload(Image&) const noexcept {
         return false;
     }
@@ -97,6 +100,8 @@ struct TextureCacheRuntime {
         // All known Vulkan drivers can natively handle BGR textures
         return true;
     }
+
+    u64 GetDeviceLocalMemory() const noexcept;
 };
 
 class Image : public VideoCommon::ImageBase {
@@ -218,6 +223,10 @@ public:
         return renderpass;
     }
 
+    [[nodiscard]] const RenderPassKey& GetRenderPassKey() const noexcept {
+        return renderpass_key;
+    }
+
     [[nodiscard]] VkExtent2D RenderArea() const noexcept {
         return render_area;
     }
@@ -244,6 +253,7 @@ public:
 
 private:
     vk::Framebuffer framebuffer;
+    RenderPassKey renderpass_key{};
     VkRenderPass renderpass{};
     VkExtent2D render_area{};
     VkSampleCountFlagBits samples = VK_SAMPLE_COUNT_1_BIT;
@@ -0,0 +1,189 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <tuple>
+#include <vector>
+
+#include "common/common_types.h"
+#include "common/fs/file.h"
+#include "video_core/guest_driver.h"
+#include "video_core/shader/shader_disk_cache_entry.h"
+
+namespace VideoCommon::Shader {
+
+namespace {
+
+struct ConstBufferKey {
+    u32 cbuf = 0;
+    u32 offset = 0;
+    u32 value = 0;
+};
+
+struct BoundSamplerEntry {
+    u32 offset = 0;
+    Tegra::Engines::SamplerDescriptor sampler;
+};
+
+struct SeparateSamplerEntry {
+    u32 cbuf1 = 0;
+    u32 cbuf2 = 0;
+    u32 offset1 = 0;
+    u32 offset2 = 0;
+    Tegra::Engines::SamplerDescriptor sampler;
+};
+
+struct BindlessSamplerEntry {
+    u32 cbuf = 0;
+    u32 offset = 0;
+    Tegra::Engines::SamplerDescriptor sampler;
+};
+
+} // Anonymous namespace
+
+ShaderDiskCacheEntry::ShaderDiskCacheEntry() = default;
+
+ShaderDiskCacheEntry::~ShaderDiskCacheEntry() = default;
+
+bool ShaderDiskCacheEntry::Load(Common::FS::IOFile& file) {
+    if (!file.ReadObject(type)) {
+        return false;
+    }
+    u32 code_size;
+    u32 code_size_b;
+    if (!file.ReadObject(code_size) || !file.ReadObject(code_size_b)) {
+        return false;
+    }
+    code.resize(code_size);
+    code_b.resize(code_size_b);
+    if (file.Read(code) != code_size) {
+        return false;
+    }
+    if (HasProgramA() && file.Read(code_b) != code_size_b) {
+        return false;
+    }
+
+    u8 is_texture_handler_size_known;
+    u32 texture_handler_size_value;
+    u32 num_keys;
+    u32 num_bound_samplers;
+    u32 num_separate_samplers;
+    u32 num_bindless_samplers;
+    if (!file.ReadObject(unique_identifier) || !file.ReadObject(bound_buffer) ||
+        !file.ReadObject(is_texture_handler_size_known) ||
+        !file.ReadObject(texture_handler_size_value) || !file.ReadObject(graphics_info) ||
+        !file.ReadObject(compute_info) || !file.ReadObject(num_keys) ||
+        !file.ReadObject(num_bound_samplers) || !file.ReadObject(num_separate_samplers) ||
+        !file.ReadObject(num_bindless_samplers)) {
+        return false;
+    }
+    if (is_texture_handler_size_known) {
+        texture_handler_size = texture_handler_size_value;
+    }
+
+    std::vector<ConstBufferKey> flat_keys(num_keys);
+    std::vector<BoundSamplerEntry> flat_bound_samplers(num_bound_samplers);
+    std::vector<SeparateSamplerEntry> flat_separate_samplers(num_separate_samplers);
+    std::vector<BindlessSamplerEntry> flat_bindless_samplers(num_bindless_samplers);
+    if (file.Read(flat_keys) != flat_keys.size() ||
+        file.Read(flat_bound_samplers) != flat_bound_samplers.size() ||
+        file.Read(flat_separate_samplers) != flat_separate_samplers.size() ||
+        file.Read(flat_bindless_samplers) != flat_bindless_samplers.size()) {
+        return false;
+    }
+    for (const auto& entry : flat_keys) {
+        keys.insert({{entry.cbuf, entry.offset}, entry.value});
+    }
+    for (const auto& entry : flat_bound_samplers) {
+        bound_samplers.emplace(entry.offset, entry.sampler);
+    }
+    for (const auto& entry : flat_separate_samplers) {
+        SeparateSamplerKey key;
+        key.buffers = {entry.cbuf1, entry.cbuf2};
+        key.offsets = {entry.offset1, entry.offset2};
+        separate_samplers.emplace(key, entry.sampler);
+    }
+    for (const auto& entry : flat_bindless_samplers) {
+        bindless_samplers.insert({{entry.cbuf, entry.offset}, entry.sampler});
+    }
+
+    return true;
+}
+
+bool ShaderDiskCacheEntry::Save(Common::FS::IOFile& file) const {
+    if (!file.WriteObject(static_cast<u32>(type)) ||
+        !file.WriteObject(static_cast<u32>(code.size())) ||
+        !file.WriteObject(static_cast<u32>(code_b.size()))) {
+        return false;
+    }
+    if (file.Write(code) != code.size()) {
+        return false;
+    }
+    if (HasProgramA() && file.Write(code_b) != code_b.size()) {
+        return false;
+    }
+
+    if (!file.WriteObject(unique_identifier) || !file.WriteObject(bound_buffer) ||
+        !file.WriteObject(static_cast<u8>(texture_handler_size.has_value())) ||
+        !file.WriteObject(texture_handler_size.value_or(0)) || !file.WriteObject(graphics_info) ||
+        !file.WriteObject(compute_info) || !file.WriteObject(static_cast<u32>(keys.size())) ||
+        !file.WriteObject(static_cast<u32>(bound_samplers.size())) ||
+        !file.WriteObject(static_cast<u32>(separate_samplers.size())) ||
+        !file.WriteObject(static_cast<u32>(bindless_samplers.size()))) {
+        return false;
+    }
+
+    std::vector<ConstBufferKey> flat_keys;
+    flat_keys.reserve(keys.size());
+    for (const auto& [address, value] : keys) {
+        flat_keys.push_back(ConstBufferKey{address.first, address.second, value});
+    }
+
+    std::vector<BoundSamplerEntry> flat_bound_samplers;
+    flat_bound_samplers.reserve(bound_samplers.size());
+    for (const auto& [address, sampler] : bound_samplers) {
+        flat_bound_samplers.push_back(BoundSamplerEntry{address, sampler});
+    }
+
+    std::vector<SeparateSamplerEntry> flat_separate_samplers;
+    flat_separate_samplers.reserve(separate_samplers.size());
+    for (const auto& [key, sampler] : separate_samplers) {
+        SeparateSamplerEntry entry;
+        std::tie(entry.cbuf1, entry.cbuf2) = key.buffers;
+        std::tie(entry.offset1, entry.offset2) = key.offsets;
+        entry.sampler = sampler;
+        flat_separate_samplers.push_back(entry);
+    }
+
+    std::vector<BindlessSamplerEntry> flat_bindless_samplers;
+    flat_bindless_samplers.reserve(bindless_samplers.size());
+    for (const auto& [address, sampler] : bindless_samplers) {
+        flat_bindless_samplers.push_back(
+            BindlessSamplerEntry{address.first, address.second, sampler});
+    }
+
+    return file.Write(flat_keys) == flat_keys.size() &&
+           file.Write(flat_bound_samplers) == flat_bound_samplers.size() &&
+           file.Write(flat_separate_samplers) == flat_separate_samplers.size() &&
+           file.Write(flat_bindless_samplers) == flat_bindless_samplers.size();
+}
+
+Registry ShaderDiskCacheEntry::MakeRegistry() const {
+    const VideoCore::GuestDriverProfile guest_profile{texture_handler_size};
+    const SerializedRegistryInfo info{guest_profile, bound_buffer, graphics_info, compute_info};
+    Registry registry(type, info);
+    for (const auto& [address, value] : keys) {
+        const auto [buffer, offset] = address;
+        registry.InsertKey(buffer, offset, value);
+    }
+    for (const auto& [offset, sampler] : bound_samplers) {
+        registry.InsertBoundSampler(offset, sampler);
+    }
+    for (const auto& [key, sampler] : bindless_samplers) {
+        const auto [buffer, offset] = key;
+        registry.InsertBindlessSampler(buffer, offset, sampler);
+    }
+    return registry;
+}
+
+} // namespace VideoCommon::Shader
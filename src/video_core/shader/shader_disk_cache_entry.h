@@ -0,0 +1,51 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <optional>
+
+#include "common/common_types.h"
+#include "video_core/engines/shader_type.h"
+#include "video_core/shader/memory_util.h"
+#include "video_core/shader/registry.h"
+
+namespace Common::FS {
+class IOFile;
+}
+
+namespace VideoCommon::Shader {
+
+/// Describes a shader and how it's used by the guest GPU
+struct ShaderDiskCacheEntry {
+    ShaderDiskCacheEntry();
+    ~ShaderDiskCacheEntry();
+
+    bool Load(Common::FS::IOFile& file);
+
+    bool Save(Common::FS::IOFile& file) const;
+
+    bool HasProgramA() const {
+        return !code.empty() && !code_b.empty();
+    }
+
+    /// Builds a registry from the stored keys, detached from any engine.
+    Registry MakeRegistry() const;
+
+    Tegra::Engines::ShaderType type{};
+    ProgramCode code;
+    ProgramCode code_b;
+
+    u64 unique_identifier = 0;
+    std::optional<u32> texture_handler_size;
+    u32 bound_buffer = 0;
+    GraphicsInfo graphics_info;
+    ComputeInfo compute_info;
+    KeyMap keys;
+    BoundSamplerMap bound_samplers;
+    SeparateSamplerMap separate_samplers;
+    BindlessSamplerMap bindless_samplers;
+};
+
+} // namespace VideoCommon::Shader
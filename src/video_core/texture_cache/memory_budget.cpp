@@ -0,0 +1,45 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <atomic>
+
+#include "video_core/texture_cache/memory_budget.h"
+
+namespace VideoCommon {
+namespace {
+/// Device memory assumed when the driver doesn't report it
+constexpr u64 DEFAULT_DEVICE_LOCAL_MEMORY = 2ULL << 30;
+
+std::atomic<u64> resident_bytes_count{};
+std::atomic<u32> evicted_images_count{};
+std::atomic<u64> evicted_bytes_count{};
+} // Anonymous namespace
+
+TextureMemoryBudget ComputeTextureMemoryBudget(u64 device_local_memory) noexcept {
+    const u64 memory = device_local_memory != 0 ? device_local_memory : DEFAULT_DEVICE_LOCAL_MEMORY;
+    // Leave room for buffers, shaders, the swapchain and other applications
+    return {
+        .expected = memory / 10 * 6,
+        .critical = memory / 10 * 8,
+    };
+}
+
+TextureCacheStatistics GetAndResetTextureCacheStatistics() noexcept {
+    return {
+        .resident_bytes = resident_bytes_count.load(std::memory_order_relaxed),
+        .evicted_images = evicted_images_count.exchange(0, std::memory_order_relaxed),
+        .evicted_bytes = evicted_bytes_count.exchange(0, std::memory_order_relaxed),
+    };
+}
+
+void RecordTextureCacheResidency(u64 resident_bytes) noexcept {
+    resident_bytes_count.store(resident_bytes, std::memory_order_relaxed);
+}
+
+void RecordTextureCacheEviction(u64 size_bytes) noexcept {
+    evicted_images_count.fetch_add(1, std::memory_order_relaxed);
+    evicted_bytes_count.fetch_add(size_bytes, std::memory_order_relaxed);
+}
+
+} // namespace VideoCommon
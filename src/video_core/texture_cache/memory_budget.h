@@ -0,0 +1,36 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include "common/common_types.h"
+
+namespace VideoCommon {
+
+/// Image memory usages at which the texture cache starts evicting unused images
+struct TextureMemoryBudget {
+    u64 expected; ///< Images unused for a while are evicted above this usage
+    u64 critical; ///< Images unused for a few frames are evicted above this usage
+};
+
+struct TextureCacheStatistics {
+    u64 resident_bytes; ///< Host memory used by the images in the cache
+    u32 evicted_images; ///< Images evicted since the statistics were last queried
+    u64 evicted_bytes;  ///< Host memory freed by evictions since the statistics were last queried
+};
+
+/// Returns the texture cache budget for a device with the given amount of local memory.
+/// A device local memory of zero means it's unknown and a conservative default is used.
+[[nodiscard]] TextureMemoryBudget ComputeTextureMemoryBudget(u64 device_local_memory) noexcept;
+
+/// Returns the texture cache statistics and resets the eviction counters.
+[[nodiscard]] TextureCacheStatistics GetAndResetTextureCacheStatistics() noexcept;
+
+/// Records the host memory used by the images in the cache.
+void RecordTextureCacheResidency(u64 resident_bytes) noexcept;
+
+/// Records the eviction of an image using the given amount of host memory.
+void RecordTextureCacheEviction(u64 size_bytes) noexcept;
+
+} // namespace VideoCommon
@@ -70,6 +70,20 @@ public:
         ResetStorageBit(id.index);
     }
 
+    /// Calls func with the id and a reference of every stored object, it must not insert or erase
+    template <typename Func>
+    void ForEach(Func&& func) {
+        size_t index = 0;
+        for (u64 bits : stored_bitset) {
+            for (size_t bit = 0; bits; ++bit, bits >>= 1) {
+                if ((bits & 1) != 0) {
+                    func(SlotId{static_cast<u32>(index + bit)}, values[index + bit].object);
+                }
+            }
+            index += 64;
+        }
+    }
+
 private:
     struct NonTrivialDummy {
         NonTrivialDummy() noexcept {}
@@ -7,6 +7,7 @@
 #include <algorithm>
 #include <array>
 #include <bit>
+#include <deque>
 #include <memory>
 #include <mutex>
 #include <optional>
@@ -38,6 +39,7 @@
 #include "video_core/texture_cache/image_info.h"
 #include "video_core/texture_cache/image_view_base.h"
 #include "video_core/texture_cache/image_view_info.h"
+#include "video_core/texture_cache/memory_budget.h"
 #include "video_core/texture_cache/render_targets.h"
 #include "video_core/texture_cache/samples_helper.h"
 #include "video_core/texture_cache/slot_vector.h"
@@ -277,6 +279,15 @@ private:
     /// Delete image from the cache
     void DeleteImage(ImageId image);
 
+    /// Evict the least recently used images until the memory usage is within budget
+    void RunGarbageCollector();
+
+    /// Write back the contents of an image to guest memory if needed and delete it
+    void EvictImage(ImageId image_id);
+
+    /// Return the host memory used by an image
+    [[nodiscard]] static u64 HostSizeBytes(const ImageBase& image) noexcept;
+
     /// Remove image views references from the cache
     void RemoveImageViewReferences(std::span<const ImageViewId> removed_views);
 
@@ -342,7 +353,7 @@ private:
 
     // TODO: This data structure is not optimal and it should be reworked
     std::vector<ImageId> uncommitted_downloads;
-    std::queue<std::vector<ImageId>> committed_downloads;
+    std::deque<std::vector<ImageId>> committed_downloads;
 
     static constexpr size_t TICKS_TO_DESTROY = 6;
     DelayedDestructionRing<Image, TICKS_TO_DESTROY> sentenced_images;
@@ -351,6 +362,16 @@ private:
 
     std::unordered_map<GPUVAddr, ImageAllocId> image_allocs_table;
 
+    /// Frames an image has to go unused before it can be evicted
+    static constexpr u64 FRAMES_TO_EXPIRE = 300;
+    static constexpr u64 CRITICAL_FRAMES_TO_EXPIRE = 8;
+    /// Images evicted at most on a single frame, evicting modified images stalls the GPU
+    static constexpr size_t MAX_EVICTIONS_PER_FRAME = 32;
+    static constexpr size_t CRITICAL_MAX_EVICTIONS_PER_FRAME = 128;
+
+    TextureMemoryBudget memory_budget{};
+    u64 total_used_memory = 0;
+
     u64 modification_tick = 0;
     u64 frame_tick = 0;
 };
@@ -373,10 +394,20 @@ TextureCache<P>::TextureCache(Runtime& runtime_, VideoCore::RasterizerInterface&
     // This way the null resource becomes a compile time constant
     void(slot_image_views.insert(runtime, NullImageParams{}));
     void(slot_samplers.insert(runtime, sampler_descriptor));
+
+    const u64 device_local_memory = runtime.GetDeviceLocalMemory();
+    memory_budget = ComputeTextureMemoryBudget(device_local_memory);
+    LOG_INFO(HW_GPU, "Texture cache budget: {} MiB expected, {} MiB critical (device: {} MiB)",
+             memory_budget.expected >> 20, memory_budget.critical >> 20, device_local_memory >> 20);
 }
 
 template <class P>
 void TextureCache<P>::TickFrame() {
+    if (total_used_memory > memory_budget.expected) {
+        RunGarbageCollector();
+    }
+    RecordTextureCacheResidency(total_used_memory);
+
     // Tick sentenced resources in this order to ensure they are destroyed in the right order
     sentenced_images.Tick();
     sentenced_framebuffers.Tick();
@@ -747,13 +778,15 @@ typename P::ImageView* TextureCache<P>::TryFindFramebufferImageView(VAddr cpu_ad
     }
     const auto& image_ids = it->second;
     for (const ImageId image_id : image_ids) {
-        const ImageBase& image = slot_images[image_id];
+        ImageBase& image = slot_images[image_id];
         if (image.cpu_addr != cpu_addr) {
             continue;
         }
         if (image.image_view_ids.empty()) {
             continue;
         }
+        // Presented images are in use even when nothing draws to them
+        image.frame_tick = frame_tick;
         return &slot_image_views[image.image_view_ids.at(0)];
     }
     return nullptr;
@@ -772,7 +805,7 @@ bool TextureCache<P>::ShouldWaitAsyncFlushes() const noexcept {
 template <class P>
 void TextureCache<P>::CommitAsyncFlushes() {
     // This is intentionally passing the value by copy
-    committed_downloads.push(uncommitted_downloads);
+    committed_downloads.push_back(uncommitted_downloads);
     uncommitted_downloads.clear();
 }
 
@@ -783,7 +816,7 @@ void TextureCache<P>::PopAsyncFlushes() {
     }
     const std::span<const ImageId> download_ids = committed_downloads.front();
     if (download_ids.empty()) {
-        committed_downloads.pop();
+        committed_downloads.pop_front();
         return;
     }
     size_t total_size_bytes = 0;
@@ -810,7 +843,7 @@ void TextureCache<P>::PopAsyncFlushes() {
         download_map.offset += image.unswizzled_size_bytes;
         download_span = download_span.subspan(image.unswizzled_size_bytes);
     }
-    committed_downloads.pop();
+    committed_downloads.pop_front();
 }
 
 template <class P>
@@ -999,6 +1032,8 @@ ImageId TextureCache<P>::JoinImages(const ImageInfo& info, GPUVAddr gpu_addr, VA
     });
     const ImageId new_image_id = slot_images.insert(runtime, new_info, gpu_addr, cpu_addr);
     Image& new_image = slot_images[new_image_id];
+    new_image.frame_tick = frame_tick;
+    total_used_memory += HostSizeBytes(new_image);
 
     // TODO: Only upload what we need
     RefreshContents(new_image);
@@ -1252,6 +1287,7 @@ void TextureCache<P>::DeleteImage(ImageId image_id) {
     }
     ASSERT_MSG(False(image.flags & ImageFlagBits::Tracked), "Image was not untracked");
     ASSERT_MSG(False(image.flags & ImageFlagBits::Registered), "Image was not unregistered");
+    total_used_memory -= HostSizeBytes(image);
 
     // Mark render targets as dirty
     auto& dirty = maxwell3d.dirty.flags;
@@ -1299,6 +1335,73 @@ void TextureCache<P>::DeleteImage(ImageId image_id) {
     has_deleted_images = true;
 }
 
+template <class P>
+void TextureCache<P>::RunGarbageCollector() {
+    const bool is_critical = total_used_memory > memory_budget.critical;
+    const u64 frames_to_expire = is_critical ? CRITICAL_FRAMES_TO_EXPIRE : FRAMES_TO_EXPIRE;
+    if (frame_tick < frames_to_expire) {
+        return;
+    }
+    const u64 expired_tick = frame_tick - frames_to_expire;
+
+    // Images waiting for an asynchronous download have to stay alive until it finishes
+    std::vector<ImageId> pending_downloads = uncommitted_downloads;
+    for (const std::vector<ImageId>& download_ids : committed_downloads) {
+        pending_downloads.insert(pending_downloads.end(), download_ids.begin(), download_ids.end());
+    }
+    std::ranges::sort(pending_downloads);
+
+    std::vector<ImageId> expired_images;
+    slot_images.ForEach([&](ImageId image_id, Image& image) {
+        if (image.frame_tick > expired_tick) {
+            return;
+        }
+        // MSAA images can't be downloaded, evicting modified ones would lose their contents
+        if (True(image.flags & ImageFlagBits::GpuModified) && image.info.num_samples > 1) {
+            return;
+        }
+        if (std::ranges::binary_search(pending_downloads, image_id)) {
+            return;
+        }
+        expired_images.push_back(image_id);
+    });
+
+    // Evict the least recently used images first
+    const size_t max_evictions = is_critical ? CRITICAL_MAX_EVICTIONS_PER_FRAME
+                                             : MAX_EVICTIONS_PER_FRAME;
+    const size_t num_evictions = std::min(expired_images.size(), max_evictions);
+    std::ranges::partial_sort(expired_images, expired_images.begin() + num_evictions,
+                              [this](ImageId lhs, ImageId rhs) {
+                                  return slot_images[lhs].frame_tick < slot_images[rhs].frame_tick;
+                              });
+    for (size_t i = 0; i < num_evictions && total_used_memory > memory_budget.expected; ++i) {
+        EvictImage(expired_images[i]);
+    }
+}
+
+template <class P>
+void TextureCache<P>::EvictImage(ImageId image_id) {
+    Image& image = slot_images[image_id];
+    if (True(image.flags & ImageFlagBits::GpuModified)) {
+        // The contents are uploaded again from guest memory when the image is used
+        DownloadMemory(image.cpu_addr, image.guest_size_bytes);
+    }
+    RecordTextureCacheEviction(HostSizeBytes(image));
+    if (True(image.flags & ImageFlagBits::Tracked)) {
+        UntrackImage(image);
+    }
+    UnregisterImage(image_id);
+    DeleteImage(image_id);
+}
+
+template <class P>
+u64 TextureCache<P>::HostSizeBytes(const ImageBase& image) noexcept {
+    if (True(image.flags & ImageFlagBits::Converted)) {
+        return image.converted_size_bytes;
+    }
+    return image.unswizzled_size_bytes;
+}
+
 template <class P>
 void TextureCache<P>::RemoveImageViewReferences(std::span<const ImageViewId> removed_views) {
     auto it = image_views.begin();
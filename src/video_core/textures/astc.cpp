@@ -16,14 +16,19 @@
 // <http://gamma.cs.unc.edu/FasTC/>
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <condition_variable>
 #include <cstring>
+#include <mutex>
 #include <span>
+#include <thread>
 #include <vector>
 
 #include <boost/container/static_vector.hpp>
 
 #include "common/common_types.h"
+#include "common/thread_worker.h"
 #include "video_core/textures/astc.h"
 
 class InputBitStream {
@@ -1546,32 +1551,80 @@ static void DecompressBlock(std::span<const u8, 16> inBuf, const u32 blockWidth,
         }
 }
 
+/// Decodes a row of blocks into the output image
+static void DecompressBlockRow(std::span<const u8> data, u32 width, u32 height, u32 block_width,
+                               u32 block_height, u32 blocks_per_row, u32 rows_per_slice, u32 row,
+                               std::span<u8> output) {
+    const u32 z = row / rows_per_slice;
+    const u32 y = (row % rows_per_slice) * block_height;
+    const std::size_t depth_offset = static_cast<std::size_t>(z) * height * width * 4;
+    const u32 decompHeight = std::min(block_height, height - y);
+
+    u32 block_index = row * blocks_per_row;
+    for (u32 x = 0; x < width; x += block_width) {
+        const std::span<const u8, 16> blockPtr{data.subspan(block_index * 16, 16)};
+
+        // Blocks can be at most 12x12
+        std::array<u32, 12 * 12> uncompData;
+        DecompressBlock(blockPtr, block_width, block_height, uncompData);
+
+        const u32 decompWidth = std::min(block_width, width - x);
+
+        const std::span<u8> outRow = output.subspan(depth_offset + (y * width + x) * 4);
+        for (u32 jj = 0; jj < decompHeight; jj++) {
+            std::memcpy(outRow.data() + jj * width * 4, uncompData.data() + jj * block_width,
+                        decompWidth * 4);
+        }
+        ++block_index;
+    }
+}
+
 void Decompress(std::span<const uint8_t> data, uint32_t width, uint32_t height, uint32_t depth,
                 uint32_t block_width, uint32_t block_height, std::span<uint8_t> output) {
-    u32 block_index = 0;
-    std::size_t depth_offset = 0;
-    for (u32 z = 0; z < depth; z++) {
-        for (u32 y = 0; y < height; y += block_height) {
-            for (u32 x = 0; x < width; x += block_width) {
-                const std::span<const u8, 16> blockPtr{data.subspan(block_index * 16, 16)};
-
-                // Blocks can be at most 12x12
-                std::array<u32, 12 * 12> uncompData;
-                DecompressBlock(blockPtr, block_width, block_height, uncompData);
-
-                u32 decompWidth = std::min(block_width, width - x);
-                u32 decompHeight = std::min(block_height, height - y);
-
-                const std::span<u8> outRow = output.subspan(depth_offset + (y * width + x) * 4);
-                for (u32 jj = 0; jj < decompHeight; jj++) {
-                    std::memcpy(outRow.data() + jj * width * 4,
-                                uncompData.data() + jj * block_width, decompWidth * 4);
-                }
-                ++block_index;
-            }
+    // Images with fewer blocks than this are decoded on the calling thread
+    static constexpr u32 MIN_PARALLEL_BLOCKS = 256;
+
+    const u32 blocks_per_row = (width + block_width - 1) / block_width;
+    const u32 rows_per_slice = (height + block_height - 1) / block_height;
+    const u32 num_rows = rows_per_slice * depth;
+    const auto decode_row = [&](u32 row) {
+        DecompressBlockRow(data, width, height, block_width, block_height, blocks_per_row,
+                           rows_per_slice, row, output);
+    };
+
+    static Common::ThreadWorker workers(std::max(std::thread::hardware_concurrency(), 2U) - 1,
+                                        "yuzu:ASTCDecoder");
+    const u32 num_tasks = std::min(num_rows, std::max(std::thread::hardware_concurrency(), 2U));
+    if (num_tasks < 2 || num_rows * blocks_per_row < MIN_PARALLEL_BLOCKS) {
+        for (u32 row = 0; row < num_rows; ++row) {
+            decode_row(row);
         }
-        depth_offset += height * width * 4;
+        return;
+    }
+
+    // Rows are claimed dynamically so slow rows don't stall the other tasks. The calling thread
+    // decodes rows too, then waits for the queued tasks to release the references to this frame.
+    std::atomic<u32> next_row{0};
+    std::mutex mutex;
+    std::condition_variable cv;
+    u32 pending_tasks = num_tasks - 1;
+    const auto run_rows = [&] {
+        for (u32 row = next_row++; row < num_rows; row = next_row++) {
+            decode_row(row);
+        }
+    };
+    for (u32 task = 1; task < num_tasks; ++task) {
+        workers.QueueWork([&] {
+            run_rows();
+            std::scoped_lock lock{mutex};
+            if (--pending_tasks == 0) {
+                cv.notify_one();
+            }
+        });
     }
+    run_rows();
+    std::unique_lock lock{mutex};
+    cv.wait(lock, [&] { return pending_tasks == 0; });
 }
 
 } // namespace Tegra::Texture::ASTC
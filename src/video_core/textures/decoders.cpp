@@ -16,11 +16,137 @@
 #include "video_core/textures/decoders.h"
 #include "video_core/textures/texture.h"
 
+#ifdef ARCHITECTURE_x86_64
+#include <immintrin.h>
+#include "common/x64/cpu_detect.h"
+
+#ifdef _MSC_VER
+#define TARGET_ISA(isa)
+#else
+#define TARGET_ISA(isa) __attribute__((target(isa)))
+#endif
+#endif
+
 namespace Tegra::Texture {
 namespace {
+constexpr u32 SECTOR_SIZE = 16;
+
+/// Copies a line of bytes between linear and block linear memory
+/// Swizzled offsets are contiguous inside each 16 bytes sector, so whole sectors can be moved at
+/// once as long as pixels don't cross sector boundaries.
+template <bool TO_LINEAR>
+using SwizzleLineFunction = void (*)(u8* output, const u8* input, u32 swizzled_base,
+                                     u32 linear_base, u32 pitch, u32 x_shift, u32 y);
+
+template <bool TO_LINEAR>
+void CopySectors(u8* output, const u8* input, u32 swizzled_base, u32 linear_base, u32 x_begin,
+                 u32 pitch, u32 x_shift, const std::array<u32, GOB_SIZE_X>& table) {
+    for (u32 x = x_begin; x < pitch; x += SECTOR_SIZE) {
+        const u32 swizzled_offset =
+            swizzled_base + ((x >> GOB_SIZE_X_SHIFT) << x_shift) + table[x % GOB_SIZE_X];
+        const u32 linear_offset = linear_base + x;
+        const u32 copy_size = std::min(SECTOR_SIZE, pitch - x);
+        u8* const dst = output + (TO_LINEAR ? swizzled_offset : linear_offset);
+        const u8* const src = input + (TO_LINEAR ? linear_offset : swizzled_offset);
+        std::memcpy(dst, src, copy_size);
+    }
+}
+
+#ifdef ARCHITECTURE_x86_64
+template <bool TO_LINEAR>
+TARGET_ISA("sse4.1")
+void SwizzleLineSSE41(u8* output, const u8* input, u32 swizzled_base, u32 linear_base, u32 pitch,
+                      u32 x_shift, u32 y) {
+    const auto& table = SWIZZLE_TABLE[y % GOB_SIZE_Y];
+    u32 x = 0;
+    for (; x + SECTOR_SIZE <= pitch; x += SECTOR_SIZE) {
+        const u32 swizzled_offset =
+            swizzled_base + ((x >> GOB_SIZE_X_SHIFT) << x_shift) + table[x % GOB_SIZE_X];
+        const u32 linear_offset = linear_base + x;
+        u8* const dst = output + (TO_LINEAR ? swizzled_offset : linear_offset);
+        const u8* const src = input + (TO_LINEAR ? linear_offset : swizzled_offset);
+        const __m128i sector = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), sector);
+    }
+    CopySectors<TO_LINEAR>(output, input, swizzled_base, linear_base, x, pitch, x_shift, table);
+}
+
+template <bool TO_LINEAR>
+TARGET_ISA("avx2")
+void SwizzleLineAVX2(u8* output, const u8* input, u32 swizzled_base, u32 linear_base, u32 pitch,
+                     u32 x_shift, u32 y) {
+    const auto& table = SWIZZLE_TABLE[y % GOB_SIZE_Y];
+    // A GOB row is 64 contiguous bytes in linear memory and four sectors in the GOB
+    const std::array<u32, 4> sectors{table[0], table[16], table[32], table[48]};
+    u32 x = 0;
+    for (; x + GOB_SIZE_X <= pitch; x += GOB_SIZE_X) {
+        const u32 gob_offset = swizzled_base + ((x >> GOB_SIZE_X_SHIFT) << x_shift);
+        if constexpr (TO_LINEAR) {
+            const u8* const src = input + linear_base + x;
+            u8* const dst = output + gob_offset;
+            const __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+            const __m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 32));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + sectors[0]),
+                             _mm256_castsi256_si128(low));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + sectors[1]),
+                             _mm256_extracti128_si256(low, 1));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + sectors[2]),
+                             _mm256_castsi256_si128(high));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + sectors[3]),
+                             _mm256_extracti128_si256(high, 1));
+        } else {
+            const u8* const src = input + gob_offset;
+            u8* const dst = output + linear_base + x;
+            const __m128i sector_0 =
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + sectors[0]));
+            const __m128i sector_1 =
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + sectors[1]));
+            const __m128i sector_2 =
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + sectors[2]));
+            const __m128i sector_3 =
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + sectors[3]));
+            const __m256i low =
+                _mm256_inserti128_si256(_mm256_castsi128_si256(sector_0), sector_1, 1);
+            const __m256i high =
+                _mm256_inserti128_si256(_mm256_castsi128_si256(sector_2), sector_3, 1);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), low);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 32), high);
+        }
+    }
+    CopySectors<TO_LINEAR>(output, input, swizzled_base, linear_base, x, pitch, x_shift, table);
+}
+#endif
+
+template <bool TO_LINEAR>
+void SwizzleLineGeneric(u8* output, const u8* input, u32 swizzled_base, u32 linear_base,
+                        u32 pitch, u32 x_shift, u32 y) {
+    CopySectors<TO_LINEAR>(output, input, swizzled_base, linear_base, 0, pitch, x_shift,
+                           SWIZZLE_TABLE[y % GOB_SIZE_Y]);
+}
+
+/// Returns the line swizzler implemented by the given kernel
+template <bool TO_LINEAR>
+SwizzleLineFunction<TO_LINEAR> GetSwizzleLineFunction(SwizzleKernel kernel) {
+    switch (kernel) {
+    case SwizzleKernel::Generic:
+        return &SwizzleLineGeneric<TO_LINEAR>;
+#ifdef ARCHITECTURE_x86_64
+    case SwizzleKernel::SSE41:
+        return &SwizzleLineSSE41<TO_LINEAR>;
+    case SwizzleKernel::AVX2:
+        return &SwizzleLineAVX2<TO_LINEAR>;
+#endif
+    default:
+        UNREACHABLE_MSG("Swizzle kernel {} is not available on this host",
+                        static_cast<int>(kernel));
+        return &SwizzleLineGeneric<TO_LINEAR>;
+    }
+}
+
 template <bool TO_LINEAR>
-void Swizzle(std::span<u8> output, std::span<const u8> input, u32 bytes_per_pixel, u32 width,
-             u32 height, u32 depth, u32 block_height, u32 block_depth, u32 stride_alignment) {
+void Swizzle(SwizzleKernel kernel, std::span<u8> output, std::span<const u8> input,
+             u32 bytes_per_pixel, u32 width, u32 height, u32 depth, u32 block_height,
+             u32 block_depth, u32 stride_alignment) {
     // The origin of the transformation can be configured here, leave it as zero as the current API
     // doesn't expose it.
     static constexpr u32 origin_x = 0;
@@ -41,6 +167,10 @@ void Swizzle(std::span<u8> output, std::span<const u8> input, u32 bytes_per_pixe
     const u32 block_depth_mask = (1U << block_depth) - 1;
     const u32 x_shift = GOB_SIZE_SHIFT + block_height + block_depth;
 
+    // Lines can be copied in sectors when pixels never cross a sector boundary
+    const bool is_sector_copy = pitch > 0 && SECTOR_SIZE % bytes_per_pixel == 0;
+    const SwizzleLineFunction<TO_LINEAR> swizzle_line = GetSwizzleLineFunction<TO_LINEAR>(kernel);
+
     for (u32 slice = 0; slice < depth; ++slice) {
         const u32 z = slice + origin_z;
         const u32 offset_z = (z >> block_depth) * slice_size +
@@ -53,6 +183,22 @@ void Swizzle(std::span<u8> output, std::span<const u8> input, u32 bytes_per_pixe
             const u32 offset_y = (block_y >> block_height) * block_size +
                                  ((block_y & block_height_mask) << GOB_SIZE_SHIFT);
 
+            if (is_sector_copy) {
+                // Offsets grow with x, so checking the last byte of the line bounds all of them
+                const u32 last_x = pitch - 1;
+                const u32 swizzled_base = offset_z + offset_y;
+                const u32 linear_base = slice * pitch * height + line * pitch;
+                const u32 last_swizzled_offset = swizzled_base +
+                                                 ((last_x >> GOB_SIZE_X_SHIFT) << x_shift) +
+                                                 table[last_x % GOB_SIZE_X];
+                const u32 last_linear_offset = linear_base + last_x;
+                if ((TO_LINEAR ? last_linear_offset : last_swizzled_offset) < input.size()) {
+                    swizzle_line(output.data(), input.data(), swizzled_base, linear_base, pitch,
+                                 x_shift, y);
+                    continue;
+                }
+            }
+
             for (u32 column = 0; column < width; ++column) {
                 const u32 x = (column + origin_x) * bytes_per_pixel;
                 const u32 offset_x = (x >> GOB_SIZE_X_SHIFT) << x_shift;
@@ -80,18 +226,59 @@ void Swizzle(std::span<u8> output, std::span<const u8> input, u32 bytes_per_pixe
 }
 } // Anonymous namespace
 
+bool IsSwizzleKernelSupported(SwizzleKernel kernel) {
+    switch (kernel) {
+    case SwizzleKernel::Generic:
+        return true;
+#ifdef ARCHITECTURE_x86_64
+    case SwizzleKernel::SSE41:
+        return Common::GetCPUCaps().sse4_1;
+    case SwizzleKernel::AVX2:
+        return Common::GetCPUCaps().avx2;
+#endif
+    default:
+        return false;
+    }
+}
+
+SwizzleKernel GetFastestSwizzleKernel() {
+    static const SwizzleKernel kernel = [] {
+        for (const SwizzleKernel candidate : {SwizzleKernel::AVX2, SwizzleKernel::SSE41}) {
+            if (IsSwizzleKernelSupported(candidate)) {
+                return candidate;
+            }
+        }
+        return SwizzleKernel::Generic;
+    }();
+    return kernel;
+}
+
 void UnswizzleTexture(std::span<u8> output, std::span<const u8> input, u32 bytes_per_pixel,
                       u32 width, u32 height, u32 depth, u32 block_height, u32 block_depth,
                       u32 stride_alignment) {
-    Swizzle<false>(output, input, bytes_per_pixel, width, height, depth, block_height, block_depth,
-                   stride_alignment);
+    Swizzle<false>(GetFastestSwizzleKernel(), output, input, bytes_per_pixel, width, height, depth,
+                   block_height, block_depth, stride_alignment);
+}
+
+void UnswizzleTexture(SwizzleKernel kernel, std::span<u8> output, std::span<const u8> input,
+                      u32 bytes_per_pixel, u32 width, u32 height, u32 depth, u32 block_height,
+                      u32 block_depth, u32 stride_alignment) {
+    Swizzle<false>(kernel, output, input, bytes_per_pixel, width, height, depth, block_height,
+                   block_depth, stride_alignment);
 }
 
 void SwizzleTexture(std::span<u8> output, std::span<const u8> input, u32 bytes_per_pixel, u32 width,
                     u32 height, u32 depth, u32 block_height, u32 block_depth,
                     u32 stride_alignment) {
-    Swizzle<true>(output, input, bytes_per_pixel, width, height, depth, block_height, block_depth,
-                  stride_alignment);
+    Swizzle<true>(GetFastestSwizzleKernel(), output, input, bytes_per_pixel, width, height, depth,
+                  block_height, block_depth, stride_alignment);
+}
+
+void SwizzleTexture(SwizzleKernel kernel, std::span<u8> output, std::span<const u8> input,
+                    u32 bytes_per_pixel, u32 width, u32 height, u32 depth, u32 block_height,
+                    u32 block_depth, u32 stride_alignment) {
+    Swizzle<true>(kernel, output, input, bytes_per_pixel, width, height, depth, block_height,
+                  block_depth, stride_alignment);
 }
 
 void SwizzleSubrect(u32 subrect_width, u32 subrect_height, u32 source_pitch, u32 swizzled_width,
@@ -40,16 +40,39 @@ constexpr SwizzleTable MakeSwizzleTable() {
 }
 constexpr SwizzleTable SWIZZLE_TABLE = MakeSwizzleTable();
 
+/// Line copy kernels used to move block linear sectors
+enum class SwizzleKernel {
+    Generic,
+    SSE41,
+    AVX2,
+};
+
+/// Returns true when the host CPU can run the given swizzle kernel.
+[[nodiscard]] bool IsSwizzleKernelSupported(SwizzleKernel kernel);
+
+/// Returns the fastest swizzle kernel supported by the host CPU, used unless one is requested.
+[[nodiscard]] SwizzleKernel GetFastestSwizzleKernel();
+
 /// Unswizzles a block linear texture into linear memory.
 void UnswizzleTexture(std::span<u8> output, std::span<const u8> input, u32 bytes_per_pixel,
                       u32 width, u32 height, u32 depth, u32 block_height, u32 block_depth,
                       u32 stride_alignment = 1);
 
+/// Unswizzles a block linear texture into linear memory with the given supported kernel.
+void UnswizzleTexture(SwizzleKernel kernel, std::span<u8> output, std::span<const u8> input,
+                      u32 bytes_per_pixel, u32 width, u32 height, u32 depth, u32 block_height,
+                      u32 block_depth, u32 stride_alignment = 1);
+
 /// Swizzles linear memory into a block linear texture.
 void SwizzleTexture(std::span<u8> output, std::span<const u8> input, u32 bytes_per_pixel, u32 width,
                     u32 height, u32 depth, u32 block_height, u32 block_depth,
                     u32 stride_alignment = 1);
 
+/// Swizzles linear memory into a block linear texture with the given supported kernel.
+void SwizzleTexture(SwizzleKernel kernel, std::span<u8> output, std::span<const u8> input,
+                    u32 bytes_per_pixel, u32 width, u32 height, u32 depth, u32 block_height,
+                    u32 block_depth, u32 stride_alignment = 1);
+
 /// This function calculates the correct size of a texture depending if it's tiled or not.
 std::size_t CalculateSize(bool tiled, u32 bytes_per_pixel, u32 width, u32 height, u32 depth,
                           u32 block_height, u32 block_depth);
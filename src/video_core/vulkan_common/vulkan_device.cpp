@@ -5,6 +5,7 @@
 #include <bitset>
 #include <chrono>
 #include <optional>
+#include <span>
 #include <string_view>
 #include <thread>
 #include <unordered_set>
@@ -410,6 +411,7 @@ Device::Device(VkInstance instance_, vk::PhysicalDevice physical_, VkSurfaceKHR
 
     CollectTelemetryParameters();
     CollectToolingInfo();
+    CollectPhysicalMemoryInfo();
 
     if (ext_extended_dynamic_state && driver_id == VK_DRIVER_ID_MESA_RADV) {
         LOG_WARNING(
@@ -844,6 +846,16 @@ void Device::CollectToolingInfo() {
     }
 }
 
+void Device::CollectPhysicalMemoryInfo() {
+    const VkPhysicalDeviceMemoryProperties memory_properties = physical.GetMemoryProperties();
+    const std::span heaps{memory_properties.memoryHeaps, memory_properties.memoryHeapCount};
+    for (const VkMemoryHeap& heap : heaps) {
+        if ((heap.flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0) {
+            device_local_memory += heap.size;
+        }
+    }
+}
+
 std::vector<VkDeviceQueueCreateInfo> Device::GetDeviceQueueCreateInfos() const {
     static constexpr float QUEUE_PRIORITY = 1.0f;
 
@@ -225,6 +225,11 @@ public:
         return use_asynchronous_shaders;
     }
 
+    /// Returns the size in bytes of the device local memory heaps.
+    u64 GetDeviceLocalMemory() const {
+        return device_local_memory;
+    }
+
 private:
     /// Checks if the physical device is suitable.
     void CheckSuitability(bool requires_swapchain) const;
@@ -244,6 +249,9 @@ private:
     /// Collects information about attached tools.
     void CollectToolingInfo();
 
+    /// Collects the size of the device local memory heaps.
+    void CollectPhysicalMemoryInfo();
+
     /// Returns a list of queue initialization descriptors.
     std::vector<VkDeviceQueueCreateInfo> GetDeviceQueueCreateInfos() const;
 
@@ -269,6 +277,7 @@ private:
     u32 present_family{};                   ///< Main present queue family index.
     VkDriverIdKHR driver_id{};              ///< Driver ID.
     VkShaderStageFlags guest_warp_stages{}; ///< Stages where the guest warp size can be forced.ed
+    u64 device_local_memory{};              ///< Size of the device local memory heaps.
     bool is_optimal_astc_supported{};       ///< Support for native ASTC.
     bool is_float16_supported{};            ///< Support for float16 arithmetics.
     bool is_warp_potentially_bigger{};      ///< Host warp size can be bigger than guest.
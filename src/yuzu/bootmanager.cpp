@@ -577,6 +577,11 @@ bool GRenderWindow::InitRenderTarget() {
             return false;
         }
         break;
+    case Settings::RendererBackend::Null:
+        child_widget = new RenderWidget(this);
+        child_widget->windowHandle()->create();
+        main_context = std::make_unique<DummyContext>();
+        break;
     }
 
     // Update the Window System information with the new render target
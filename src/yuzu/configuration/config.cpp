@@ -489,6 +489,8 @@ void Config::ReadAudioValues() {
             ReadSetting(QStringLiteral("output_device"), QStringLiteral("auto"))
                 .toString()
                 .toStdString();
+        Settings::values.enable_parallel_voice_decoding =
+            ReadSetting(QStringLiteral("enable_parallel_voice_decoding"), false).toBool();
     }
     ReadSettingGlobal(Settings::values.enable_audio_stretching,
                       QStringLiteral("enable_audio_stretching"), true);
@@ -646,6 +648,8 @@ void Config::ReadDebuggingValues() {
         qt_config->value(QStringLiteral("record_frame_times"), false).toBool();
     Settings::values.program_args =
         ReadSetting(QStringLiteral("program_args"), QString{}).toString().toStdString();
+    Settings::values.gpu_trace_path =
+        ReadSetting(QStringLiteral("gpu_trace_path"), QString{}).toString().toStdString();
     Settings::values.dump_exefs = ReadSetting(QStringLiteral("dump_exefs"), false).toBool();
     Settings::values.dump_nso = ReadSetting(QStringLiteral("dump_nso"), false).toBool();
     Settings::values.enable_fs_access_log =
@@ -657,6 +661,7 @@ void Config::ReadDebuggingValues() {
         ReadSetting(QStringLiteral("disable_macro_jit"), false).toBool();
     Settings::values.extended_logging =
         ReadSetting(QStringLiteral("extended_logging"), false).toBool();
+    Settings::values.binary_logging = ReadSetting(QStringLiteral("binary_logging"), false).toBool();
     Settings::values.use_debug_asserts =
         ReadSetting(QStringLiteral("use_debug_asserts"), false).toBool();
     Settings::values.use_auto_stub = ReadSetting(QStringLiteral("use_auto_stub"), false).toBool();
@@ -1185,6 +1190,8 @@ void Config::SaveAudioValues() {
         WriteSetting(QStringLiteral("output_device"),
                      QString::fromStdString(Settings::values.audio_device_id),
                      QStringLiteral("auto"));
+        WriteSetting(QStringLiteral("enable_parallel_voice_decoding"),
+                     Settings::values.enable_parallel_voice_decoding, false);
     }
     WriteSettingGlobal(QStringLiteral("enable_audio_stretching"),
                        Settings::values.enable_audio_stretching, true);
@@ -1264,6 +1271,8 @@ void Config::SaveDebuggingValues() {
     qt_config->setValue(QStringLiteral("record_frame_times"), Settings::values.record_frame_times);
     WriteSetting(QStringLiteral("program_args"),
                  QString::fromStdString(Settings::values.program_args), QString{});
+    WriteSetting(QStringLiteral("gpu_trace_path"),
+                 QString::fromStdString(Settings::values.gpu_trace_path), QString{});
     WriteSetting(QStringLiteral("dump_exefs"), Settings::values.dump_exefs, false);
     WriteSetting(QStringLiteral("dump_nso"), Settings::values.dump_nso, false);
     WriteSetting(QStringLiteral("enable_fs_access_log"), Settings::values.enable_fs_access_log,
@@ -1271,6 +1280,7 @@ void Config::SaveDebuggingValues() {
     WriteSetting(QStringLiteral("quest_flag"), Settings::values.quest_flag, false);
     WriteSetting(QStringLiteral("use_debug_asserts"), Settings::values.use_debug_asserts, false);
     WriteSetting(QStringLiteral("disable_macro_jit"), Settings::values.disable_macro_jit, false);
+    WriteSetting(QStringLiteral("binary_logging"), Settings::values.binary_logging, false);
 
     qt_config->endGroup();
 }
@@ -182,6 +182,10 @@ static void InitializeLogging() {
     const auto log_dir = FS::GetYuzuPath(FS::YuzuPath::LogDir);
     void(FS::CreateDir(log_dir));
     Log::AddBackend(std::make_unique<Log::FileBackend>(log_dir / LOG_FILE));
+    if (Settings::values.binary_logging) {
+        Log::AddBackend(std::make_unique<Log::BinaryFileBackend>(log_dir / BINARY_LOG_FILE));
+        Log::SetDeferredFormatting(true);
+    }
 #ifdef _WIN32
     Log::AddBackend(std::make_unique<Log::DebuggerBackend>());
 #endif
@@ -470,6 +470,8 @@ void Config::ReadValues() {
     Settings::values.audio_device_id = sdl2_config->Get("Audio", "output_device", "auto");
     Settings::values.volume.SetValue(
         static_cast<float>(sdl2_config->GetReal("Audio", "volume", 1)));
+    Settings::values.enable_parallel_voice_decoding =
+        sdl2_config->GetBoolean("Audio", "enable_parallel_voice_decoding", false);
 
     // Miscellaneous
     Settings::values.log_filter = sdl2_config->Get("Miscellaneous", "log_filter", "*:Trace");
@@ -479,6 +481,7 @@ void Config::ReadValues() {
     Settings::values.record_frame_times =
         sdl2_config->GetBoolean("Debugging", "record_frame_times", false);
     Settings::values.program_args = sdl2_config->Get("Debugging", "program_args", "");
+    Settings::values.gpu_trace_path = sdl2_config->Get("Debugging", "gpu_trace_path", "");
     Settings::values.dump_exefs = sdl2_config->GetBoolean("Debugging", "dump_exefs", false);
     Settings::values.dump_nso = sdl2_config->GetBoolean("Debugging", "dump_nso", false);
     Settings::values.enable_fs_access_log =
@@ -492,6 +495,7 @@ void Config::ReadValues() {
 
     Settings::values.disable_macro_jit =
         sdl2_config->GetBoolean("Debugging", "disable_macro_jit", false);
+    Settings::values.binary_logging = sdl2_config->GetBoolean("Debugging", "binary_logging", false);
 
     const auto title_list = sdl2_config->Get("AddOns", "title_ids", "");
     std::stringstream ss(title_list);
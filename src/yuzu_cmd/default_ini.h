@@ -156,7 +156,8 @@ cpuopt_fastmem =
 
 [Renderer]
 # Which backend API to use.
-# 0 (default): OpenGL, 1: Vulkan
+# 0 (default): OpenGL, 1: Vulkan, 2: Null (no rendering, to measure the CPU side of emulation)
+# On machines without a display, combine Null with the SDL_VIDEODRIVER=dummy environment variable
 backend =
 
 # Enable graphics API debugging mode.
@@ -280,6 +281,11 @@ output_device =
 # 1.0 (default): 100%, 0.0; mute
 volume =
 
+# Whether to decode audio renderer voices on several threads before mixing them.
+# The output is the same, rendering time scales with cores instead of the voice count.
+# 0 (default): No, 1: Yes
+enable_parallel_voice_decoding =
+
 [Data Storage]
 # Whether to create a virtual SD card.
 # 1 (default): Yes, 0: No
@@ -362,6 +368,14 @@ use_debug_asserts =
 use_auto_stub =
 # Enables/Disables the macro JIT compiler
 disable_macro_jit=false
+# Defers log formatting to the logging thread and writes a compact binary log next to the text
+# log, which can be formatted with yuzu-log-decoder. Makes verbose log filters much cheaper.
+# false: Disabled (default), true: Enabled
+binary_logging=false
+# Records the GPU command lists of the session and the guest memory they use to this file, for
+# replay with yuzu-gpu-replay. Slows down emulation and keeps a copy of the GPU mapped memory.
+# Empty (default): Disabled
+gpu_trace_path =
 # Presents guest frames as they become available. Experimental.
 # false: Disabled (default), true: Enabled
 disable_fps_limit=false
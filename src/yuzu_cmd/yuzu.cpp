@@ -24,6 +24,7 @@
 #include "common/settings.h"
 #include "common/string_util.h"
 #include "common/telemetry.h"
+#include "common/trace_recorder.h"
 #include "core/core.h"
 #include "core/crypto/key_manager.h"
 #include "core/file_sys/registered_cache.h"
@@ -37,6 +38,7 @@
 #include "yuzu_cmd/config.h"
 #include "yuzu_cmd/emu_window/emu_window_sdl2.h"
 #include "yuzu_cmd/emu_window/emu_window_sdl2_gl.h"
+#include "yuzu_cmd/emu_window/emu_window_sdl2_null.h"
 #include "yuzu_cmd/emu_window/emu_window_sdl2_vk.h"
 
 #ifdef _WIN32
@@ -67,7 +69,8 @@ static void PrintHelp(const char* argv0) {
                  "-f, --fullscreen      Start in fullscreen mode\n"
                  "-h, --help            Display this help and exit\n"
                  "-v, --version         Output version information and exit\n"
-                 "-p, --program         Pass following string as arguments to executable\n";
+                 "-p, --program         Pass following string as arguments to executable\n"
+                 "-t, --trace <file>    Record a Chrome trace event file, viewable in Perfetto\n";
 }
 
 static void PrintVersion() {
@@ -86,6 +89,10 @@ static void InitializeLogging() {
     const auto& log_dir = FS::GetYuzuPath(FS::YuzuPath::LogDir);
     void(FS::CreateDir(log_dir));
     Log::AddBackend(std::make_unique<Log::FileBackend>(log_dir / LOG_FILE));
+    if (Settings::values.binary_logging) {
+        Log::AddBackend(std::make_unique<Log::BinaryFileBackend>(log_dir / BINARY_LOG_FILE));
+        Log::SetDeferredFormatting(true);
+    }
 #ifdef _WIN32
     Log::AddBackend(std::make_unique<Log::DebuggerBackend>());
 #endif
@@ -109,6 +116,7 @@ int main(int argc, char** argv) {
     }
 #endif
     std::string filepath;
+    std::string trace_path;
 
     bool fullscreen = false;
 
@@ -117,11 +125,12 @@ int main(int argc, char** argv) {
         {"help", no_argument, 0, 'h'},
         {"version", no_argument, 0, 'v'},
         {"program", optional_argument, 0, 'p'},
+        {"trace", required_argument, 0, 't'},
         {0, 0, 0, 0},
     };
 
     while (optind < argc) {
-        int arg = getopt_long(argc, argv, "g:fhvp::", long_options, &option_index);
+        int arg = getopt_long(argc, argv, "g:fhvp::t:", long_options, &option_index);
         if (arg != -1) {
             switch (static_cast<char>(arg)) {
             case 'f':
@@ -138,6 +147,9 @@ int main(int argc, char** argv) {
                 Settings::values.program_args = argv[optind];
                 ++optind;
                 break;
+            case 't':
+                trace_path = optarg;
+                break;
             }
         } else {
 #ifdef _WIN32
@@ -156,6 +168,11 @@ int main(int argc, char** argv) {
     MicroProfileOnThreadCreate("EmuThread");
     SCOPE_EXIT({ MicroProfileShutdown(); });
 
+    if (!trace_path.empty() && Common::Trace::Start(trace_path)) {
+        LOG_INFO(Frontend, "Recording trace to {}", trace_path);
+    }
+    SCOPE_EXIT({ Common::Trace::Stop(); });
+
     Common::ConfigureNvidiaEnvironmentFlags();
 
     if (filepath.empty()) {
@@ -177,6 +194,9 @@ int main(int argc, char** argv) {
     case Settings::RendererBackend::Vulkan:
         emu_window = std::make_unique<EmuWindow_SDL2_VK>(&input_subsystem);
         break;
+    case Settings::RendererBackend::Null:
+        emu_window = std::make_unique<EmuWindow_SDL2_Null>(&input_subsystem);
+        break;
     }
 
     system.SetContentProvider(std::make_unique<FileSys::ContentProviderUnion>());
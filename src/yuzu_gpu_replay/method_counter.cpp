@@ -0,0 +1,108 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include "video_core/gpu.h"
+#include "yuzu_gpu_replay/method_counter.h"
+
+namespace GPUReplay {
+
+namespace {
+
+constexpr u32 NON_PULLER_METHODS = static_cast<u32>(Tegra::BufferMethods::NonPullerMethods);
+
+EngineSlot EngineSlotFromID(u32 engine_id) {
+    switch (static_cast<Tegra::EngineID>(engine_id)) {
+    case Tegra::EngineID::FERMI_TWOD_A:
+        return EngineSlot::Fermi2D;
+    case Tegra::EngineID::MAXWELL_B:
+        return EngineSlot::Maxwell3D;
+    case Tegra::EngineID::KEPLER_COMPUTE_B:
+        return EngineSlot::KeplerCompute;
+    case Tegra::EngineID::KEPLER_INLINE_TO_MEMORY_B:
+        return EngineSlot::KeplerMemory;
+    case Tegra::EngineID::MAXWELL_DMA_COPY_A:
+        return EngineSlot::MaxwellDMA;
+    default:
+        return EngineSlot::Unbound;
+    }
+}
+
+} // Anonymous namespace
+
+const char* EngineSlotName(EngineSlot slot) {
+    switch (slot) {
+    case EngineSlot::Puller:
+        return "Puller";
+    case EngineSlot::Fermi2D:
+        return "Fermi2D";
+    case EngineSlot::Maxwell3D:
+        return "Maxwell3D";
+    case EngineSlot::KeplerCompute:
+        return "KeplerCompute";
+    case EngineSlot::KeplerMemory:
+        return "KeplerMemory";
+    case EngineSlot::MaxwellDMA:
+        return "MaxwellDMA";
+    case EngineSlot::Unbound:
+    case EngineSlot::Count:
+        break;
+    }
+    return "Unbound";
+}
+
+MethodCounter::MethodCounter() {
+    bound_slots.fill(EngineSlot::Unbound);
+}
+
+MethodCounter::~MethodCounter() = default;
+
+void MethodCounter::Count(std::span<const Tegra::CommandHeader> commands) {
+    for (const Tegra::CommandHeader& command_header : commands) {
+        if (state.method_count) {
+            // Data word of a methods command, they may continue in the next segment
+            CountMethod(command_header.argument);
+            if (!state.non_incrementing) {
+                ++state.method;
+            }
+            if (state.increment_once) {
+                state.non_incrementing = true;
+            }
+            --state.method_count;
+            continue;
+        }
+
+        // No command active - this is the first word of a new one
+        switch (command_header.mode) {
+        case Tegra::SubmissionMode::Increasing:
+        case Tegra::SubmissionMode::NonIncreasing:
+        case Tegra::SubmissionMode::IncreaseOnce:
+            state.method = command_header.method;
+            state.subchannel = command_header.subchannel;
+            state.method_count = command_header.method_count;
+            state.non_incrementing = command_header.mode == Tegra::SubmissionMode::NonIncreasing;
+            state.increment_once = command_header.mode == Tegra::SubmissionMode::IncreaseOnce;
+            break;
+        case Tegra::SubmissionMode::Inline:
+            state.method = command_header.method;
+            state.subchannel = command_header.subchannel;
+            CountMethod(command_header.arg_count);
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+void MethodCounter::CountMethod(u32 argument) {
+    if (state.method >= NON_PULLER_METHODS) {
+        ++counts[static_cast<size_t>(bound_slots[state.subchannel])];
+        return;
+    }
+    ++counts[static_cast<size_t>(EngineSlot::Puller)];
+    if (state.method == static_cast<u32>(Tegra::BufferMethods::BindObject)) {
+        bound_slots[state.subchannel] = EngineSlotFromID(argument);
+    }
+}
+
+} // namespace GPUReplay
@@ -0,0 +1,63 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <span>
+
+#include "common/common_types.h"
+#include "video_core/dma_pusher.h"
+
+namespace GPUReplay {
+
+enum class EngineSlot : u32 {
+    Puller,
+    Fermi2D,
+    Maxwell3D,
+    KeplerCompute,
+    KeplerMemory,
+    MaxwellDMA,
+    Unbound,
+    Count,
+};
+
+[[nodiscard]] const char* EngineSlotName(EngineSlot slot);
+
+/**
+ * Counts the methods of recorded pushbuffer segments by the engine they are sent to.
+ * It follows the command headers and object binds the same way the DMA pusher does, without
+ * executing anything, so the trace is counted before the replay is measured.
+ */
+class MethodCounter {
+public:
+    using Counts = std::array<u64, static_cast<size_t>(EngineSlot::Count)>;
+
+    MethodCounter();
+    ~MethodCounter();
+
+    /// Counts the methods of a recorded pushbuffer segment.
+    void Count(std::span<const Tegra::CommandHeader> commands);
+
+    [[nodiscard]] const Counts& GetCounts() const {
+        return counts;
+    }
+
+private:
+    struct State {
+        u32 method = 0;
+        u32 subchannel = 0;
+        u32 method_count = 0;
+        bool non_incrementing = false;
+        bool increment_once = false;
+    };
+
+    void CountMethod(u32 argument);
+
+    State state;
+    std::array<EngineSlot, 8> bound_slots{};
+    Counts counts{};
+};
+
+} // namespace GPUReplay
@@ -0,0 +1,21 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include "yuzu_gpu_replay/replay_window.h"
+
+namespace GPUReplay {
+
+namespace {
+class ReplayContext final : public Core::Frontend::GraphicsContext {};
+} // Anonymous namespace
+
+ReplayWindow::ReplayWindow() = default;
+
+ReplayWindow::~ReplayWindow() = default;
+
+std::unique_ptr<Core::Frontend::GraphicsContext> ReplayWindow::CreateSharedContext() const {
+    return std::make_unique<ReplayContext>();
+}
+
+} // namespace GPUReplay
@@ -0,0 +1,26 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <memory>
+
+#include "core/frontend/emu_window.h"
+
+namespace GPUReplay {
+
+/// Window without a surface, the replay never presents anything
+class ReplayWindow final : public Core::Frontend::EmuWindow {
+public:
+    ReplayWindow();
+    ~ReplayWindow() override;
+
+    std::unique_ptr<Core::Frontend::GraphicsContext> CreateSharedContext() const override;
+
+    bool IsShown() const override {
+        return false;
+    }
+};
+
+} // namespace GPUReplay
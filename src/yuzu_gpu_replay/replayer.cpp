@@ -0,0 +1,107 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <memory>
+#include <vector>
+
+#include "common/alignment.h"
+#include "common/logging/log.h"
+#include "core/core.h"
+#include "core/device_memory.h"
+#include "core/memory.h"
+#include "video_core/engines/maxwell_3d.h"
+#include "video_core/gpu.h"
+#include "video_core/memory_manager.h"
+#include "video_core/renderer_null/renderer_null.h"
+#include "yuzu_gpu_replay/replayer.h"
+
+namespace GPUReplay {
+
+namespace {
+
+/// Width of the address space of 64-bit guest processes
+constexpr size_t ADDRESS_SPACE_BITS = 39;
+
+} // Anonymous namespace
+
+Replayer::Replayer(Core::System& system_)
+    : system{system_}, next_backing_addr{Core::DramMemoryMap::Base} {
+    page_table.Resize(ADDRESS_SPACE_BITS, Core::Memory::PAGE_BITS);
+
+    auto gpu_core = std::make_unique<Tegra::GPU>(system, false, false);
+    gpu_core->BindRenderer(
+        std::make_unique<Null::RendererNull>(window, *gpu_core, window.CreateSharedContext()));
+    gpu = gpu_core.get();
+
+    // Engines read the GPU clock and the power state through the system
+    system.BootHeadlessGPU(std::move(gpu_core));
+    system.Memory().SetCurrentPageTable(page_table);
+}
+
+Replayer::~Replayer() {
+    system.ShutdownHeadlessGPU();
+}
+
+void Replayer::Map(GPUVAddr gpu_addr, VAddr cpu_addr, u64 size) {
+    BackGuestMemory(cpu_addr, size);
+    [[maybe_unused]] const GPUVAddr mapped_addr =
+        gpu->MemoryManager().Map(cpu_addr, gpu_addr, size);
+}
+
+void Replayer::Unmap(GPUVAddr gpu_addr, u64 size) {
+    gpu->MemoryManager().Unmap(gpu_addr, size);
+}
+
+void Replayer::WriteMemory(VAddr cpu_addr, std::span<const u8> data) {
+    system.Memory().WriteBlockUnsafe(cpu_addr, data.data(), data.size());
+}
+
+void Replayer::ExecuteCommandList(std::span<const Tegra::CommandHeader> commands) {
+    // Segments are pushed as prefetched command lists, the pusher decodes them like the lists
+    // built by nvdrv without reading guest memory. This is what the GPU thread does on a submit.
+    gpu->DmaPusher().Push(Tegra::CommandList{
+        std::vector<Tegra::CommandHeader>(commands.begin(), commands.end()),
+    });
+    gpu->DmaPusher().DispatchCalls();
+}
+
+const Tegra::MacroEngine::Statistics& Replayer::GetMacroStatistics() const {
+    return gpu->Maxwell3D().GetMacroStatistics();
+}
+
+void Replayer::BackGuestMemory(VAddr cpu_addr, u64 size) {
+    const VAddr start = Common::AlignDown(cpu_addr, Core::Memory::PAGE_SIZE);
+    const VAddr end = Common::AlignUp(cpu_addr + size, Core::Memory::PAGE_SIZE);
+    if (end > (1ULL << ADDRESS_SPACE_BITS)) {
+        LOG_ERROR(Frontend, "Mapping 0x{:016x} of size 0x{:x} is outside the guest address space",
+                  cpu_addr, size);
+        return;
+    }
+    const auto is_backed = [this](VAddr page) {
+        return page_table.pointers[page >> Core::Memory::PAGE_BITS].Type() !=
+               Common::PageType::Unmapped;
+    };
+    VAddr page = start;
+    while (page < end) {
+        if (is_backed(page)) {
+            page += Core::Memory::PAGE_SIZE;
+            continue;
+        }
+        // Back the whole run of pages that aren't backed yet at once
+        VAddr run_end = page + Core::Memory::PAGE_SIZE;
+        while (run_end < end && !is_backed(run_end)) {
+            run_end += Core::Memory::PAGE_SIZE;
+        }
+        const u64 run_size = run_end - page;
+        if (run_size > Core::DramMemoryMap::End - next_backing_addr) {
+            LOG_ERROR(Frontend, "Out of device memory to back the trace's guest memory");
+            return;
+        }
+        system.Memory().MapMemoryRegion(page_table, page, run_size, next_backing_addr);
+        next_backing_addr += run_size;
+        page = run_end;
+    }
+}
+
+} // namespace GPUReplay
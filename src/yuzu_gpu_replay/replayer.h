@@ -0,0 +1,63 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <span>
+
+#include "common/common_types.h"
+#include "common/page_table.h"
+#include "video_core/dma_pusher.h"
+#include "video_core/macro/macro.h"
+#include "yuzu_gpu_replay/replay_window.h"
+
+namespace Core {
+class System;
+}
+
+namespace Tegra {
+class GPU;
+}
+
+namespace GPUReplay {
+
+/**
+ * Replays recorded pushbuffer segments through the DMA pusher of a synchronous GPU.
+ * The GPU is the only part of the system that is powered on, it renders with the null backend so
+ * replays measure the emulated GPU and not a host driver.
+ * Guest memory is backed by a page table owned by the replayer, recorded mappings get device memory
+ * the first time their guest pages are seen.
+ */
+class Replayer {
+public:
+    explicit Replayer(Core::System& system);
+    ~Replayer();
+
+    /// Maps a range of guest memory into the GPU address space, backing it if needed.
+    void Map(GPUVAddr gpu_addr, VAddr cpu_addr, u64 size);
+
+    /// Unmaps a range of the GPU address space.
+    void Unmap(GPUVAddr gpu_addr, u64 size);
+
+    /// Writes recorded contents to guest memory.
+    void WriteMemory(VAddr cpu_addr, std::span<const u8> data);
+
+    /// Decodes and executes the command words of a recorded pushbuffer segment.
+    void ExecuteCommandList(std::span<const Tegra::CommandHeader> commands);
+
+    [[nodiscard]] const Tegra::MacroEngine::Statistics& GetMacroStatistics() const;
+
+private:
+    /// Backs the guest pages of a range with device memory, unless they are already backed
+    void BackGuestMemory(VAddr cpu_addr, u64 size);
+
+    Core::System& system;
+    ReplayWindow window;
+    Common::PageTable page_table;
+    /// Start of the device memory that isn't backing any guest page yet
+    PAddr next_backing_addr;
+    Tegra::GPU* gpu = nullptr;
+};
+
+} // namespace GPUReplay
@@ -0,0 +1,224 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "common/logging/backend.h"
+#include "common/logging/filter.h"
+#include "common/logging/log.h"
+#include "common/scm_rev.h"
+#include "common/settings.h"
+#include "core/core.h"
+#include "video_core/gpu_trace.h"
+#include "yuzu_gpu_replay/method_counter.h"
+#include "yuzu_gpu_replay/replayer.h"
+
+#undef _UNICODE
+#include <getopt.h>
+#ifndef _MSC_VER
+#include <unistd.h>
+#endif
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+void PrintHelp(const char* argv0) {
+    std::printf("Usage: %s [options] <trace>\n"
+                "-l, --loops N         Replay the trace N times, the default is 1\n"
+                "-h, --help            Display this help and exit\n"
+                "-v, --version         Output version information and exit\n",
+                argv0);
+}
+
+void PrintVersion() {
+    std::printf("yuzu-gpu-replay %s %s\n", Common::g_scm_branch, Common::g_scm_desc);
+}
+
+void InitializeLogging() {
+    using namespace Common;
+
+    Log::Filter log_filter(Log::Level::Warning);
+    Log::SetGlobalFilter(log_filter);
+    Log::AddBackend(std::make_unique<Log::ColorConsoleBackend>());
+}
+
+double ToMilliseconds(Clock::duration duration) {
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+double Percentage(u64 part, u64 total) {
+    return total == 0 ? 0.0 : 100.0 * static_cast<double>(part) / static_cast<double>(total);
+}
+
+/// Reads the whole trace, so reading it doesn't count against the replay
+bool LoadTrace(const std::string& filepath, std::vector<Tegra::GPUTraceRecord>& records) {
+    Tegra::GPUTraceReader reader{filepath};
+    if (!reader.IsValid()) {
+        return false;
+    }
+    Tegra::GPUTraceRecord record;
+    while (reader.ReadRecord(record)) {
+        records.push_back(std::move(record));
+        record = {};
+    }
+    return true;
+}
+
+void PrintReport(const GPUReplay::Replayer& replayer, const GPUReplay::MethodCounter& counter,
+                 std::vector<double> frame_times, Clock::duration total_time, u64 num_words,
+                 int loops) {
+    const double total_ms = ToMilliseconds(total_time);
+    std::printf("Replayed %llu command words in %.3f ms (%.1f Mwords/s)\n",
+                static_cast<unsigned long long>(num_words), total_ms,
+                static_cast<double>(num_words) / (total_ms * 1000.0));
+
+    std::printf("\nMethods per engine, each pass of the trace:\n");
+    const auto& counts = counter.GetCounts();
+    for (size_t slot = 0; slot < counts.size(); ++slot) {
+        if (counts[slot] == 0) {
+            continue;
+        }
+        const auto engine = static_cast<GPUReplay::EngineSlot>(slot);
+        std::printf("  %-14s %12llu\n", GPUReplay::EngineSlotName(engine),
+                    static_cast<unsigned long long>(counts[slot]));
+    }
+
+    // Macro programs are the host side cache the null backend still exercises
+    const auto& macros = replayer.GetMacroStatistics();
+    const u64 program_lookups = macros.program_cache_hits + macros.compilations;
+    std::printf("\nMacro caches over %d passes:\n"
+                "  calls %llu, compiled macro hits %.2f%%\n"
+                "  programs requested %llu, compiled program hits %.2f%%\n",
+                loops, static_cast<unsigned long long>(macros.executions),
+                Percentage(macros.macro_cache_hits, macros.executions),
+                static_cast<unsigned long long>(program_lookups),
+                Percentage(macros.program_cache_hits, program_lookups));
+
+    if (frame_times.empty()) {
+        return;
+    }
+    std::sort(frame_times.begin(), frame_times.end());
+    double sum = 0.0;
+    for (const double frame_time : frame_times) {
+        sum += frame_time;
+    }
+    const auto percentile = [&frame_times](double value) {
+        const size_t index = static_cast<size_t>(value * static_cast<double>(frame_times.size()));
+        return frame_times[std::min(index, frame_times.size() - 1)];
+    };
+    std::printf("\nFrame times over %zu frames, executing commands only:\n"
+                "  average %.3f ms, min %.3f ms, median %.3f ms, 99th %.3f ms, max %.3f ms\n",
+                frame_times.size(), sum / static_cast<double>(frame_times.size()),
+                frame_times.front(), percentile(0.5), percentile(0.99), frame_times.back());
+}
+
+} // Anonymous namespace
+
+/// Application entry point
+int main(int argc, char** argv) {
+    InitializeLogging();
+
+    int loops = 1;
+    std::string filepath;
+
+    static struct option long_options[] = {
+        {"loops", required_argument, 0, 'l'},
+        {"help", no_argument, 0, 'h'},
+        {"version", no_argument, 0, 'v'},
+        {0, 0, 0, 0},
+    };
+
+    int option_index = 0;
+    while (optind < argc) {
+        const int arg = getopt_long(argc, argv, "l:hv", long_options, &option_index);
+        if (arg != -1) {
+            switch (static_cast<char>(arg)) {
+            case 'l':
+                loops = std::max(std::atoi(optarg), 1);
+                break;
+            case 'h':
+                PrintHelp(argv[0]);
+                return 0;
+            case 'v':
+                PrintVersion();
+                return 0;
+            default:
+                PrintHelp(argv[0]);
+                return -1;
+            }
+        } else {
+            filepath = argv[optind];
+            optind++;
+        }
+    }
+
+    if (filepath.empty()) {
+        PrintHelp(argv[0]);
+        return -1;
+    }
+
+    std::vector<Tegra::GPUTraceRecord> records;
+    if (!LoadTrace(filepath, records)) {
+        LOG_CRITICAL(Frontend, "Failed to open GPU trace {}", filepath);
+        return -1;
+    }
+    GPUReplay::MethodCounter counter;
+    for (const Tegra::GPUTraceRecord& record : records) {
+        if (record.type == Tegra::GPUTraceRecordType::CommandList) {
+            counter.Count(record.commands);
+        }
+    }
+
+    // Only the GPU is powered on, the replayer boots it with the null renderer
+    auto& system{Core::System::GetInstance()};
+    GPUReplay::Replayer replayer{system};
+
+    std::vector<double> frame_times;
+    u64 num_words = 0;
+    Clock::duration total_time{};
+
+    for (int loop = 0; loop < loops; ++loop) {
+        // Only executing commands is measured, restoring memory is the work of the guest CPU
+        Clock::duration frame_time{};
+        for (const Tegra::GPUTraceRecord& record : records) {
+            switch (record.type) {
+            case Tegra::GPUTraceRecordType::CommandList: {
+                const auto start = Clock::now();
+                replayer.ExecuteCommandList(record.commands);
+                const auto elapsed = Clock::now() - start;
+                total_time += elapsed;
+                frame_time += elapsed;
+                num_words += record.commands.size();
+                break;
+            }
+            case Tegra::GPUTraceRecordType::FrameEnd:
+                frame_times.push_back(ToMilliseconds(frame_time));
+                frame_time = {};
+                break;
+            case Tegra::GPUTraceRecordType::Map:
+                replayer.Map(record.gpu_addr, record.cpu_addr, record.size);
+                break;
+            case Tegra::GPUTraceRecordType::Unmap:
+                replayer.Unmap(record.gpu_addr, record.size);
+                break;
+            case Tegra::GPUTraceRecordType::MemoryWrite:
+                replayer.WriteMemory(record.cpu_addr, record.data);
+                break;
+            default:
+                LOG_ERROR(Frontend, "Unknown GPU trace record type {}",
+                          static_cast<u32>(record.type));
+                break;
+            }
+        }
+    }
+
+    PrintReport(replayer, counter, std::move(frame_times), total_time, num_words, loops);
+    return 0;
+}
@@ -0,0 +1,80 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "common/common_types.h"
+#include "common/fs/file.h"
+#include "common/logging/binary_log.h"
+#include "common/logging/text_formatter.h"
+#include "common/scm_rev.h"
+
+namespace {
+
+void PrintHelp(const char* argv0) {
+    std::printf("Usage: %s <binary log> [output]\n"
+                "Formats a binary log written with binary_logging enabled, to the output file\n"
+                "or to stdout when no output file is given\n"
+                "-h, --help            Display this help and exit\n"
+                "-v, --version         Output version information and exit\n",
+                argv0);
+}
+
+void PrintVersion() {
+    std::printf("yuzu-log-decoder %s %s\n", Common::g_scm_branch, Common::g_scm_desc);
+}
+
+} // Anonymous namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2 || argc > 3) {
+        PrintHelp(argv[0]);
+        return 1;
+    }
+    const std::string first_arg = argv[1];
+    if (first_arg == "-h" || first_arg == "--help") {
+        PrintHelp(argv[0]);
+        return 0;
+    }
+    if (first_arg == "-v" || first_arg == "--version") {
+        PrintVersion();
+        return 0;
+    }
+
+    const Common::FS::IOFile input{first_arg, Common::FS::FileAccessMode::Read,
+                                   Common::FS::FileType::BinaryFile};
+    if (!input.IsOpen()) {
+        std::fprintf(stderr, "Failed to open %s\n", first_arg.c_str());
+        return 1;
+    }
+    std::vector<u8> data(input.GetSize());
+    if (input.Read(data) != data.size()) {
+        std::fprintf(stderr, "Failed to read %s\n", first_arg.c_str());
+        return 1;
+    }
+
+    std::FILE* output = stdout;
+    if (argc == 3) {
+        output = std::fopen(argv[2], "w");
+        if (output == nullptr) {
+            std::fprintf(stderr, "Failed to open %s\n", argv[2]);
+            return 1;
+        }
+    }
+
+    const bool is_valid = Common::Log::DecodeBinaryLog(data, [output](const auto& entry) {
+        const std::string message = Common::Log::FormatLogMessage(entry);
+        std::fprintf(output, "%s\n", message.c_str());
+    });
+    if (output != stdout) {
+        std::fclose(output);
+    }
+    if (!is_valid) {
+        std::fprintf(stderr, "%s is not a binary log or is truncated\n", first_arg.c_str());
+        return 1;
+    }
+    return 0;
+}